@@ -71,6 +71,7 @@ Batcher2d::~Batcher2d() { // NOLINT
 
 void Batcher2d::syncMeshBuffersToNative(uint16_t accId, ccstd::vector<UIMeshBuffer*>&& buffers) {
     _meshBuffersMap[accId] = std::move(buffers);
+    _frameCacheInvalid = true;
 }
 
 UIMeshBuffer* Batcher2d::getMeshBuffer(uint16_t accId, uint16_t bufferId) { // NOLINT(bugprone-easily-swappable-parameters)
@@ -90,17 +91,27 @@ void Batcher2d::updateDescriptorSet() {
 
 void Batcher2d::syncRootNodesToNative(ccstd::vector<Node*>&& rootNodes) {
     _rootNodeArr = std::move(rootNodes);
+    _frameCacheInvalid = true;
 }
 
 void Batcher2d::fillBuffersAndMergeBatches() {
+    _reorderStats = {};
     for (auto* rootNode : _rootNodeArr) {
-        walk(rootNode, 1);
-        generateBatch(_currEntity, _currDrawInfo);
+        walkRoot(rootNode);
     }
 }
 
+void Batcher2d::walkRoot(Node* rootNode) {
+    walk(rootNode, 1);
+    generateBatch(_currEntity, _currDrawInfo);
+    // no batch spans two roots, so the batches of each root can be cached on their own
+    resetRenderStates();
+    _currHash = 0;
+}
+
 void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recursion)
     if (!node->isActiveInHierarchy()) {
+        recordNode(node, nullptr, false);
         return;
     }
     bool breakWalk = false;
@@ -118,6 +129,7 @@ void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recurs
             for (uint32_t i = 0; i < size; i++) {
                 auto* drawInfo = entity->getRenderDrawInfoAt(i);
                 handleDrawInfo(entity, drawInfo, node);
+                recordDrawInfo(entity, i, drawInfo);
             }
             entity->setVBColorDirty(false);
         }
@@ -125,6 +137,7 @@ void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recurs
             breakWalk = true;
         }
     }
+    recordNode(node, entity, true);
 
     if (!breakWalk) {
         const auto& children = node->getChildren();
@@ -150,9 +163,26 @@ void Batcher2d::handlePostRender(RenderEntity* entity) {
     }
 }
 CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node) {
+    // masks, custom mesh buffers and local space vertices keep their place in the hierarchy
+    if (_reorderEnabled && !drawInfo->getIsMeshBuffer() && !entity->getIsMask() && !entity->getUseLocal()) {
+        entity->setEnumStencilStage(_stencilManager->getStencilStage());
+        if (node->getChangedFlags() || drawInfo->getVertDirty()) {
+            fillVertexBuffers(entity, drawInfo);
+            drawInfo->setVertDirty(false);
+        }
+        if (entity->getVBColorDirty()) {
+            fillColors(entity, drawInfo);
+        }
+        queueReorderedDraw(entity, drawInfo);
+        if (_currSegment) _currSegment->reordered = true;
+        return;
+    }
+
     ccstd::hash_t dataHash = drawInfo->getDataHash();
     if (drawInfo->getIsMeshBuffer()) {
         dataHash = 0;
+        // the data of custom mesh buffers is uploaded from their own memory every frame
+        markSegmentUncacheable();
     }
 
     // may slow
@@ -213,6 +243,8 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
 CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
+    // models update their own transforms and uniforms
+    markSegmentUncacheable();
 
     // stencil stage
     gfx::DepthStencilState* depthStencil = nullptr;
@@ -257,6 +289,8 @@ CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDraw
 
 CC_FORCE_INLINE void Batcher2d::handleIADraw(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node) {
     generateBatch(_currEntity, _currDrawInfo);
+    // the indices are written by JS
+    markSegmentUncacheable();
     uint32_t dataHash = drawInfo->getDataHash();
     entity->setEnumStencilStage(_stencilManager->getStencilStage());
     auto tempStage = static_cast<StencilStage>(entity->getStencilStage());
@@ -293,8 +327,10 @@ CC_FORCE_INLINE void Batcher2d::handleIADraw(RenderEntity* entity, RenderDrawInf
     curdrawBatch->setVisFlags(_currLayer);
     curdrawBatch->setInputAssembler(ia);
     curdrawBatch->fillPass(_currMaterial, depthStencil, dssHash);
+    recordMaterial(_currMaterial);
     const auto& pass = curdrawBatch->getPasses().at(0);
     if (entity->getUseLocal()) {
+        markSegmentUncacheable();
         drawInfo->updateLocalDescriptorSet(node, pass->getLocalSetLayout());
         curdrawBatch->setDescriptorSet(drawInfo->getLocalDes());
     } else {
@@ -304,6 +340,8 @@ CC_FORCE_INLINE void Batcher2d::handleIADraw(RenderEntity* entity, RenderDrawInf
 }
 
 CC_FORCE_INLINE void Batcher2d::handleSubNode(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT
+    // the sub node is outside the hierarchy of the root, changes to its children go unnoticed
+    markSegmentUncacheable();
     if (drawInfo->getSubNode()) {
         walk(drawInfo->getSubNode(), entity->getOpacity());
     }
@@ -333,6 +371,10 @@ CC_FORCE_INLINE void Batcher2d::handleDrawInfo(RenderEntity* entity, RenderDrawI
 }
 
 void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    // every draw queued for reordering precedes the current one
+    if (!_reorderItems.empty()) {
+        flushReorderedDraws();
+    }
     if (drawInfo == nullptr || _currMaterial == nullptr) {
         return;
     }
@@ -351,6 +393,7 @@ void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
         if (ia == nullptr) {
             return;
         }
+        recordIA(currMeshBuffer, ia);
 
         ia->setFirstIndex(_indexStart);
         ia->setIndexCount(indexCount);
@@ -370,9 +413,12 @@ void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
     curdrawBatch->setVisFlags(_currLayer);
     curdrawBatch->setInputAssembler(ia);
     curdrawBatch->fillPass(_currMaterial, depthStencil, dssHash);
+    recordMaterial(_currMaterial);
     const auto& pass = curdrawBatch->getPasses().at(0);
 
     if (entity->getUseLocal()) {
+        // the render transform is not part of the walk
+        markSegmentUncacheable();
         drawInfo->updateLocalDescriptorSet(entity->getRenderTransform(), pass->getLocalSetLayout());
         curdrawBatch->setDescriptorSet(drawInfo->getLocalDes());
     } else {
@@ -437,6 +483,7 @@ void Batcher2d::releaseDescriptorSetCache(gfx::Texture* texture, gfx::Sampler* s
     if (iter != _descriptorSetCache.end()) {
         delete iter->second;
         _descriptorSetCache.erase(hash);
+        _frameCacheInvalid = true;
     }
 }
 
@@ -446,7 +493,14 @@ bool Batcher2d::initialize() {
 }
 
 void Batcher2d::update() {
-    fillBuffersAndMergeBatches();
+    if (_incrementalEnabled) {
+        updateSegments();
+    } else {
+        if (!_segments.empty()) {
+            releaseSegments();
+        }
+        fillBuffersAndMergeBatches();
+    }
     resetRenderStates();
 
     for (const auto& scene : Root::getInstance()->getScenes()) {
@@ -491,12 +545,36 @@ void Batcher2d::uploadBuffers() {
 #endif
             buffer->uploadBuffers();
             buffer->reset();
+            // unused buffers are not uploaded, JS setting the mark again is what tells its own writes apart
+            buffer->setDirty(false);
         }
     }
     updateDescriptorSet();
 }
 
 void Batcher2d::reset() {
+    if (_segments.empty()) {
+        releaseBatches();
+    } else {
+        // the segments keep their batches and the IAs these point to, update() decides what is still valid
+        for (auto& meshRenderData : _meshRenderDrawInfo) {
+            meshRenderData->resetMeshIA();
+        }
+        _meshRenderDrawInfo.clear();
+    }
+
+    _currMeshBuffer = nullptr;
+    _indexStart = 0;
+    _currHash = 0;
+    _currLayer = 0;
+    _currMaterial = nullptr;
+    _currTexture = nullptr;
+    _currSampler = nullptr;
+
+    // stencilManager
+}
+
+void Batcher2d::releaseBatches() {
     for (auto& batch : _batches) {
         batch->clear();
         _drawBatchPool.free(batch);
@@ -517,16 +595,306 @@ void Batcher2d::reset() {
         }
     }
     //meshBuffer cannot clear because it is not transported at every frame.
+}
 
-    _currMeshBuffer = nullptr;
-    _indexStart = 0;
+void Batcher2d::setReorderEnabled(bool enabled) {
+    _reorderEnabled = enabled;
+    _frameCacheInvalid = true;
+}
+
+bool Batcher2d::canMergeDraws(const ReorderItem& a, const ReorderItem& b) {
+    const RenderDrawInfo* infoA = a.drawInfo;
+    const RenderDrawInfo* infoB = b.drawInfo;
+    // same rules as handleComponentDraw, a zero hash never merges
+    return infoA->getDataHash() != 0 && infoA->getDataHash() == infoB->getDataHash() &&
+           infoA->getMaterial() == infoB->getMaterial() && infoA->getMeshBuffer() == infoB->getMeshBuffer() &&
+           a.entity->getEnumStencilStage() == b.entity->getEnumStencilStage() &&
+           a.entity->getNode()->getLayer() == b.entity->getNode()->getLayer();
+}
+
+void Batcher2d::queueReorderedDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    if (_currDrawInfo) {
+        // close the batch of the draws preceding this one
+        generateBatch(_currEntity, _currDrawInfo);
+        resetRenderStates();
+        _currHash = 0;
+    }
+    ReorderItem item;
+    item.entity = entity;
+    item.drawInfo = drawInfo;
+    const uint8_t stride = drawInfo->getStride();
+    const uint32_t size = drawInfo->getVbCount() * stride;
+    const float* vbBuffer = drawInfo->getVbBuffer();
+    if (size > 0) {
+        float minX = vbBuffer[0];
+        float minY = vbBuffer[1];
+        float maxX = minX;
+        float maxY = minY;
+        for (uint32_t i = stride; i < size; i += stride) {
+            minX = std::min(minX, vbBuffer[i]);
+            maxX = std::max(maxX, vbBuffer[i]);
+            minY = std::min(minY, vbBuffer[i + 1]);
+            maxY = std::max(maxY, vbBuffer[i + 1]);
+        }
+        item.bounds.setRect(minX, minY, maxX - minX, maxY - minY);
+    }
+    _reorderItems.emplace_back(item);
+}
+
+void Batcher2d::flushReorderedDraws() {
+    // take the items first, generateBatch flushes whatever is queued
+    ccstd::vector<ReorderItem> items;
+    items.swap(_reorderItems);
+
+    _reorderBatches.clear();
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        const ReorderItem& item = items[i];
+        if (i == 0 || !canMergeDraws(items[i - 1], item)) {
+            ++_reorderStats.batchesBefore;
+        }
+        // a draw may only move ahead of batches it does not overlap, which keeps the visual order
+        ReorderBatch* target = nullptr;
+        uint32_t depth = 0;
+        for (auto batch = _reorderBatches.rbegin(); batch != _reorderBatches.rend() && depth < REORDER_SEARCH_DEPTH; ++batch, ++depth) {
+            if (canMergeDraws(items[batch->items.front()], item)) {
+                target = &*batch;
+                break;
+            }
+            if (batch->bounds.intersectsRect(item.bounds)) {
+                break;
+            }
+        }
+        if (target) {
+            target->bounds.merge(item.bounds);
+            target->items.push_back(i);
+        } else {
+            ReorderBatch batch;
+            batch.entity = item.entity;
+            batch.drawInfo = item.drawInfo;
+            batch.bounds = item.bounds;
+            batch.items.push_back(i);
+            _reorderBatches.emplace_back(std::move(batch));
+        }
+    }
+    _reorderStats.batchesAfter += static_cast<uint32_t>(_reorderBatches.size());
+
+    for (const auto& batch : _reorderBatches) {
+        RenderDrawInfo* drawInfo = batch.drawInfo;
+        _currMeshBuffer = drawInfo->getMeshBuffer();
+        _indexStart = _currMeshBuffer->getIndexOffset();
+        for (uint32_t index : batch.items) {
+            fillIndexBuffers(items[index].drawInfo);
+        }
+        _currMaterial = drawInfo->getMaterial();
+        _currLayer = batch.entity->getNode()->getLayer();
+        _currTexture = drawInfo->getTexture();
+        _currSampler = drawInfo->getSampler();
+        _currSamplerHash = _currSampler ? _currSampler->getHash() : 0;
+        generateBatch(batch.entity, drawInfo);
+    }
+    resetRenderStates();
     _currHash = 0;
-    _currLayer = 0;
-    _currMaterial = nullptr;
-    _currTexture = nullptr;
-    _currSampler = nullptr;
 
-    // stencilManager
+    items.clear();
+    if (_reorderItems.empty()) {
+        // keep the capacity for the next flush
+        _reorderItems.swap(items);
+    }
+}
+
+void Batcher2d::setIncrementalEnabled(bool enabled) {
+    _incrementalEnabled = enabled;
+    _frameCacheInvalid = true;
+}
+
+void Batcher2d::updateSegments() {
+    // segments line up with the root nodes, syncing new ones invalidates the cache
+    if (_frameCacheInvalid || _segments.size() != _rootNodeArr.size()) {
+        releaseSegments();
+        _segments.resize(_rootNodeArr.size());
+        _frameCacheInvalid = false;
+    }
+    _reorderStats = {};
+
+    for (auto& map : _meshBuffersMap) {
+        for (auto* buffer : map.second) {
+            // vertices JS wrote on its own can't be located, such buffers are uploaded in full
+            if (buffer && !buffer->getDirty() && !buffer->getUseLinkData()) {
+                buffer->beginPartialUpload();
+            }
+        }
+    }
+
+    // the IAs of the reusable segments are kept before the rebuilt segments require new ones
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        auto& segment = _segments[i];
+        segment.reusable = isSegmentValid(segment, _rootNodeArr[i]);
+        if (segment.reusable) {
+            for (const auto& cached : segment.ias) {
+                cached.buffer->retainIA(cached.ia);
+            }
+        }
+    }
+
+    _batches.clear();
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        auto& segment = _segments[i];
+        // the indices stay where they are, so the segments before have to end where they did last frame
+        bool reusable = segment.reusable;
+        for (const auto& range : segment.indexRanges) {
+            reusable = reusable && range.buffer->getIndexOffset() == range.begin;
+        }
+        if (reusable) {
+            reuseSegment(&segment);
+        } else {
+            rebuildSegment(&segment, _rootNodeArr[i]);
+        }
+    }
+}
+
+void Batcher2d::rebuildSegment(Segment* segment, Node* rootNode) {
+    for (auto* batch : segment->batches) {
+        batch->clear();
+        _drawBatchPool.free(batch);
+    }
+    segment->batches.clear();
+    segment->nodes.clear();
+    segment->drawInfos.clear();
+    segment->materials.clear();
+    segment->indexRanges.clear();
+    segment->ias.clear();
+    segment->root = rootNode;
+    segment->hierarchyVersion = rootNode->_hierarchyVersion;
+    segment->cacheable = true;
+    segment->reordered = false;
+
+    auto batchStart = _batches.size();
+    auto reorderStats = _reorderStats;
+    _currSegment = segment;
+    walkRoot(rootNode);
+    _currSegment = nullptr;
+
+    segment->batches.assign(_batches.begin() + static_cast<std::ptrdiff_t>(batchStart), _batches.end());
+    segment->reorderStats.batchesBefore = _reorderStats.batchesBefore - reorderStats.batchesBefore;
+    segment->reorderStats.batchesAfter = _reorderStats.batchesAfter - reorderStats.batchesAfter;
+}
+
+void Batcher2d::reuseSegment(Segment* segment) {
+    for (const auto& range : segment->indexRanges) {
+        range.buffer->setIndexOffset(range.end);
+    }
+    // moved nodes keep their batches, only their vertices are transformed again
+    for (const auto& snapshot : segment->drawInfos) {
+        RenderDrawInfo* drawInfo = snapshot.drawInfo;
+        if (snapshot.entity->getNode()->getChangedFlags() || drawInfo->getVertDirty()) {
+            fillVertexBuffers(snapshot.entity, drawInfo);
+            drawInfo->setVertDirty(false);
+        }
+    }
+    // batches copy the pass states, but uniforms still live in the material passes
+    for (const auto& snapshot : segment->materials) {
+        for (const auto& pass : *snapshot.material->getPasses()) {
+            pass->update();
+        }
+    }
+    _batches.insert(_batches.end(), segment->batches.begin(), segment->batches.end());
+    _reorderStats.batchesBefore += segment->reorderStats.batchesBefore;
+    _reorderStats.batchesAfter += segment->reorderStats.batchesAfter;
+}
+
+void Batcher2d::releaseSegments() {
+    // every batch in _batches belongs to a segment
+    releaseBatches();
+    _segments.clear();
+}
+
+ccstd::hash_t Batcher2d::getPassesHash(Material* material) {
+    ccstd::hash_t hash = 0;
+    for (const auto& pass : *material->getPasses()) {
+        ccstd::hash_combine(hash, pass->getHash());
+    }
+    return hash;
+}
+
+void Batcher2d::recordNode(Node* node, RenderEntity* entity, bool active) {
+    if (!_currSegment || !_currSegment->cacheable) return;
+    NodeSnapshot snapshot;
+    snapshot.node = node;
+    snapshot.active = active;
+    if (entity) {
+        snapshot.entity = entity;
+        snapshot.entityAttrs = entity->getEntityAttrLayout();
+        snapshot.layer = node->getLayer();
+        snapshot.drawInfoCount = entity->getRenderDrawInfosSize();
+    }
+    _currSegment->nodes.emplace_back(snapshot);
+}
+
+void Batcher2d::recordDrawInfo(RenderEntity* entity, uint32_t index, RenderDrawInfo* drawInfo) {
+    if (!_currSegment || !_currSegment->cacheable) return;
+    DrawInfoSnapshot snapshot;
+    snapshot.entity = entity;
+    snapshot.index = index;
+    snapshot.drawInfo = drawInfo;
+    drawInfo->getBatchingState(&snapshot.state);
+    _currSegment->drawInfos.emplace_back(snapshot);
+}
+
+void Batcher2d::recordMaterial(Material* material) {
+    if (!_currSegment || !_currSegment->cacheable || !material) return;
+    auto& materials = _currSegment->materials;
+    for (const auto& snapshot : materials) {
+        if (snapshot.material == material) return;
+    }
+    materials.push_back({material, getPassesHash(material)});
+}
+
+void Batcher2d::recordIndexRange(UIMeshBuffer* buffer, uint32_t begin, uint32_t end) {
+    if (!_currSegment) return;
+    // the indices of a segment are consecutive in each buffer
+    for (auto& range : _currSegment->indexRanges) {
+        if (range.buffer == buffer) {
+            range.end = end;
+            return;
+        }
+    }
+    _currSegment->indexRanges.push_back({buffer, begin, end});
+}
+
+void Batcher2d::recordIA(UIMeshBuffer* buffer, gfx::InputAssembler* ia) {
+    if (!_currSegment) return;
+    _currSegment->ias.push_back({buffer, ia});
+}
+
+bool Batcher2d::isSegmentValid(const Segment& segment, Node* rootNode) const {
+    // nodes are only dereferenced while the subtree is unchanged, destroyed nodes are detached first
+    if (!segment.cacheable || segment.root != rootNode || segment.hierarchyVersion != rootNode->_hierarchyVersion) {
+        return false;
+    }
+    for (const auto& snapshot : segment.nodes) {
+        Node* node = snapshot.node;
+        if (node->isActiveInHierarchy() != snapshot.active) return false;
+        if (!snapshot.active) continue;
+        if (node->getUserData() != snapshot.entity) return false;
+        if (!snapshot.entity) continue;
+        // reordering depends on where the draws are
+        if (segment.reordered && node->getChangedFlags()) return false;
+        if (node->getLayer() != snapshot.layer || snapshot.entity->getRenderDrawInfosSize() != snapshot.drawInfoCount ||
+            memcmp(&snapshot.entity->getEntityAttrLayout(), &snapshot.entityAttrs, sizeof(EntityAttrLayout)) != 0) {
+            return false;
+        }
+    }
+    // entities are known to be alive here, as all of them still belong to their nodes
+    for (const auto& snapshot : segment.drawInfos) {
+        if (snapshot.entity->getRenderDrawInfoAt(snapshot.index) != snapshot.drawInfo || !snapshot.drawInfo->isBatchingStateEqual(snapshot.state)) {
+            return false;
+        }
+        if (segment.reordered && snapshot.drawInfo->getVertDirty()) return false;
+    }
+    for (const auto& snapshot : segment.materials) {
+        if (getPassesHash(snapshot.material) != snapshot.passHash) return false;
+    }
+    return true;
 }
 
 void Batcher2d::insertMaskBatch(RenderEntity* entity) {
@@ -562,6 +930,7 @@ void Batcher2d::insertMaskBatch(RenderEntity* entity) {
         curdrawBatch->fillPass(_maskClearMtl, depthStencil, dssHash, &(submodel->getPatches()));
         _batches.push_back(curdrawBatch);
     }
+    recordMaterial(_maskClearMtl);
 
     _stencilManager->enterLevel(entity);
 }
@@ -32,12 +32,25 @@
 #include "base/TypeDef.h"
 #include "core/assets/Material.h"
 #include "core/memop/Pool.h"
+#include "math/Geometry.h"
 #include "renderer/gfx-base/GFXTexture.h"
 #include "renderer/gfx-base/states/GFXSampler.h"
 #include "scene/DrawBatch2D.h"
 
 namespace cc {
 class Root;
+
+/**
+ * @en Batch counts of the draws queued by the reordering mode in the last frame.
+ * @zh 上一帧重排序合批的批次统计。
+ */
+struct Batcher2dReorderStats {
+    // batches the draws would have produced in hierarchy order
+    uint32_t batchesBefore{0};
+    // batches produced after reordering
+    uint32_t batchesAfter{0};
+};
+
 using UIMeshBufferArray = ccstd::vector<UIMeshBuffer*>;
 using UIMeshBufferMap = ccstd::unordered_map<uint16_t, UIMeshBufferArray>;
 
@@ -74,7 +87,119 @@ public:
     void generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo);
     void resetRenderStates();
 
+    /**
+     * @en Whether the batches of a root node are reused from the last frame when none of the nodes, render entities,
+     * draw infos and materials they were built from changed. Moved nodes only refill their vertices, and only the
+     * changed vertex and index ranges are uploaded. Disabled by default.
+     * @zh 是否在根节点下构建批次的节点、渲染实体、绘制信息和材质都未变化时复用其上一帧的批次，并只上传变化的顶点和索引区间，默认关闭。
+     */
+    void setIncrementalEnabled(bool enabled);
+    inline bool isIncrementalEnabled() const { return _incrementalEnabled; }
+    inline void invalidateFrameCache() { _frameCacheInvalid = true; }
+    inline const ccstd::vector<scene::DrawBatch2D*>& getBatches() const { return _batches; }
+
+    /**
+     * @en Whether draws may be moved ahead of draws their world space bounds do not overlap, so that draws sharing
+     * material, texture and stencil state merge into one batch even when they are not adjacent in the hierarchy.
+     * The result looks the same as long as the UI is viewed by an orthographic camera along the z axis.
+     * @zh 是否允许将绘制移动到与其世界空间包围盒不相交的绘制之前，以合并层级中不相邻但状态相同的绘制。
+     */
+    void setReorderEnabled(bool enabled);
+    inline bool isReorderEnabled() const { return _reorderEnabled; }
+    inline const Batcher2dReorderStats& getReorderStats() const { return _reorderStats; }
+
+    // how many batches back a draw is tested for a batch to merge into
+    static constexpr uint32_t REORDER_SEARCH_DEPTH = 16;
+
 private:
+    struct ReorderItem {
+        RenderEntity* entity{nullptr};
+        RenderDrawInfo* drawInfo{nullptr};
+        Rect bounds;
+    };
+
+    struct ReorderBatch {
+        RenderEntity* entity{nullptr};
+        RenderDrawInfo* drawInfo{nullptr};
+        Rect bounds;
+        // indices into _reorderItems in draw order
+        ccstd::vector<uint32_t> items;
+    };
+
+    static bool canMergeDraws(const ReorderItem& a, const ReorderItem& b);
+    void queueReorderedDraw(RenderEntity* entity, RenderDrawInfo* drawInfo);
+    void flushReorderedDraws();
+
+    struct NodeSnapshot {
+        Node* node{nullptr};
+        RenderEntity* entity{nullptr};
+        EntityAttrLayout entityAttrs;
+        uint32_t layer{0};
+        uint32_t drawInfoCount{0};
+        bool active{false};
+    };
+
+    struct DrawInfoSnapshot {
+        RenderEntity* entity{nullptr};
+        uint32_t index{0};
+        RenderDrawInfo* drawInfo{nullptr};
+        RenderDrawInfo::BatchingState state;
+    };
+
+    struct MaterialSnapshot {
+        Material* material{nullptr};
+        ccstd::hash_t passHash{0};
+    };
+
+    struct IndexRange {
+        UIMeshBuffer* buffer{nullptr};
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
+    struct CachedIA {
+        UIMeshBuffer* buffer{nullptr};
+        gfx::InputAssembler* ia{nullptr};
+    };
+
+    // the batches of one root node and what they were built from, see setIncrementalEnabled
+    struct Segment {
+        // weak reference, only compared
+        Node* root{nullptr};
+        uint32_t hierarchyVersion{0};
+        ccstd::vector<NodeSnapshot> nodes;
+        ccstd::vector<DrawInfoSnapshot> drawInfos;
+        ccstd::vector<MaterialSnapshot> materials;
+        // the indices of the segment, one range per mesh buffer
+        ccstd::vector<IndexRange> indexRanges;
+        ccstd::vector<CachedIA> ias;
+        // manage memory manually
+        ccstd::vector<scene::DrawBatch2D*> batches;
+        Batcher2dReorderStats reorderStats;
+        // false once the walk meets something that changes without notice, like models or middleware buffers
+        bool cacheable{false};
+        // reordered batches depend on the vertex positions
+        bool reordered{false};
+        bool reusable{false};
+    };
+
+    static ccstd::hash_t getPassesHash(Material* material);
+    void walkRoot(Node* rootNode);
+    void updateSegments();
+    void rebuildSegment(Segment* segment, Node* rootNode);
+    void reuseSegment(Segment* segment);
+    bool isSegmentValid(const Segment& segment, Node* rootNode) const;
+    void releaseSegments();
+    void recordNode(Node* node, RenderEntity* entity, bool active);
+    void recordDrawInfo(RenderEntity* entity, uint32_t index, RenderDrawInfo* drawInfo);
+    void recordMaterial(Material* material);
+    void recordIndexRange(UIMeshBuffer* buffer, uint32_t begin, uint32_t end);
+    void recordIA(UIMeshBuffer* buffer, gfx::InputAssembler* ia);
+    inline void markSegmentUncacheable() {
+        if (_currSegment) _currSegment->cacheable = false;
+    }
+    void releaseBatches();
+
     bool _isInit = false;
 
     inline void fillIndexBuffers(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
@@ -87,11 +212,20 @@ private:
         uint32_t indexCount = drawInfo->getIbCount();
 
         memcpy(&ib[indexOffset], indexb, indexCount * sizeof(uint16_t));
+        buffer->markIndexDirty(indexOffset, indexOffset + indexCount);
+        recordIndexRange(buffer, indexOffset, indexOffset + indexCount);
         indexOffset += indexCount;
 
         buffer->setIndexOffset(indexOffset);
     }
 
+    static inline void markVerticesDirty(RenderDrawInfo* drawInfo) {
+        UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+        auto begin = static_cast<uint32_t>((drawInfo->getVbBuffer() - buffer->getVData()) * sizeof(float));
+        buffer->markVertexDirty(begin, begin + drawInfo->getVbCount() * drawInfo->getStride() * sizeof(float));
+        buffer->setDirty(true);
+    }
+
     inline void fillVertexBuffers(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
         Node* node = entity->getNode();
         const Mat4& matrix = node->getWorldMatrix();
@@ -105,6 +239,7 @@ private:
             // cast to reduce value copy instructions
             reinterpret_cast<Vec3*>(vbBuffer + i)->transformMat4(curLayout->position, matrix);
         }
+        markVerticesDirty(drawInfo);
     }
 
     inline void setIndexRange(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
@@ -132,6 +267,7 @@ private:
             vbBuffer[offset++] = static_cast<float>(temp.b) / 255.0F;
             vbBuffer[offset++] = entity->getOpacity();
         }
+        markVerticesDirty(drawInfo);
     }
 
     void insertMaskBatch(RenderEntity* entity);
@@ -197,6 +333,18 @@ private:
     };
     gfx::PrimitiveMode _primitiveMode{gfx::PrimitiveMode::TRIANGLE_LIST};
 
+    // one per root node while incremental batching is enabled, _batches then only lists their batches
+    ccstd::vector<Segment> _segments;
+    // the segment being rebuilt
+    Segment* _currSegment{nullptr};
+    bool _incrementalEnabled{false};
+    bool _frameCacheInvalid{false};
+
+    bool _reorderEnabled{false};
+    ccstd::vector<ReorderItem> _reorderItems;
+    ccstd::vector<ReorderBatch> _reorderBatches;
+    Batcher2dReorderStats _reorderStats;
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(Batcher2d);
 };
 } // namespace cc
@@ -61,6 +61,32 @@ class Batcher2d;
 
 class RenderDrawInfo final {
 public:
+    struct DrawInfoAttrs {
+        RenderDrawInfoType _drawInfoType{RenderDrawInfoType::COMP};
+        bool _vertDirty{false};
+        bool _isMeshBuffer{false};
+        uint8_t _stride{0};
+        uint16_t _bufferId{0};
+        uint16_t _accId{0};
+        uint32_t _vertexOffset{0};
+        uint32_t _indexOffset{0};
+        uint32_t _vbCount{0};
+        uint32_t _ibCount{0};
+        ccstd::hash_t _dataHash{0};
+    };
+
+    // everything Batcher2d reads from a draw info, compared between frames to reuse the batches of the last frame
+    struct BatchingState {
+        DrawInfoAttrs attrs;
+        Material* material{nullptr};
+        gfx::Texture* texture{nullptr};
+        gfx::Sampler* sampler{nullptr};
+        float* vbBuffer{nullptr};
+        uint16_t* ibBuffer{nullptr};
+        UIMeshBuffer* meshBuffer{nullptr};
+        void* target{nullptr};
+    };
+
     RenderDrawInfo();
     ~RenderDrawInfo();
 
@@ -127,6 +153,9 @@ public:
     inline UIMeshBuffer* getMeshBuffer() const {
         return _meshBuffer;
     }
+    inline void setMeshBuffer(UIMeshBuffer* meshBuffer) {
+        _meshBuffer = meshBuffer;
+    }
 
     inline float* getVDataBuffer() const {
         return _vDataBuffer;
@@ -215,6 +244,23 @@ public:
     void uploadBuffers();
     void resetMeshIA();
 
+    inline void getBatchingState(BatchingState* out) const {
+        // attributes are written by JS through the shared buffer, compare them byte-wise including padding
+        memcpy(&out->attrs, &_drawInfoAttrs, sizeof(DrawInfoAttrs));
+        out->material = _material;
+        out->texture = _texture;
+        out->sampler = _sampler;
+        out->vbBuffer = _vbBuffer;
+        out->ibBuffer = _ibBuffer;
+        out->meshBuffer = _meshBuffer;
+        out->target = _subNode;
+    }
+    inline bool isBatchingStateEqual(const BatchingState& state) const {
+        return memcmp(&state.attrs, &_drawInfoAttrs, sizeof(DrawInfoAttrs)) == 0 && state.material == _material &&
+               state.texture == _texture && state.sampler == _sampler && state.vbBuffer == _vbBuffer && state.ibBuffer == _ibBuffer &&
+               state.meshBuffer == _meshBuffer && state.target == _subNode;
+    }
+
     inline gfx::DescriptorSet* getLocalDes() { return _localDSBF->ds; }
     void updateLocalDescriptorSet(Node* transform, gfx::DescriptorSetLayout* dsLayout);
 
@@ -250,19 +296,7 @@ private:
 
     gfx::InputAssembler* initIAInfo(gfx::Device* device);
 
-    struct DrawInfoAttrs {
-        RenderDrawInfoType _drawInfoType{RenderDrawInfoType::COMP};
-        bool _vertDirty{false};
-        bool _isMeshBuffer{false};
-        uint8_t _stride{0};
-        uint16_t _bufferId{0};
-        uint16_t _accId{0};
-        uint32_t _vertexOffset{0};
-        uint32_t _indexOffset{0};
-        uint32_t _vbCount{0};
-        uint32_t _ibCount{0};
-        ccstd::hash_t _dataHash{0};
-    } _drawInfoAttrs{};
+    DrawInfoAttrs _drawInfoAttrs{};
 
     uint16_t _nextFreeIAHandle{0};
 
@@ -24,10 +24,16 @@
 ****************************************************************************/
 
 #include "2d/renderer/UIMeshBuffer.h"
+#include <algorithm>
 #include "renderer/gfx-base/GFXDevice.h"
 
 namespace cc {
 
+namespace {
+// dirty ranges closer than this are uploaded as one, a few stale bytes cost less than another update
+constexpr uint32_t DIRTY_RANGE_MERGE_GAP = 256;
+} // namespace
+
 static uint32_t getAttributesStride(ccstd::vector<gfx::Attribute>& attrs) {
     uint32_t stride = 0;
     for (auto& attr : attrs) {
@@ -58,6 +64,9 @@ void UIMeshBuffer::reset() {
     setIndexOffset(0);
     _nextFreeIAHandle = 0;
     _dirty = false;
+    _partialUpload = false;
+    _dirtyVertexRanges.clear();
+    _dirtyIndexRanges.clear();
 }
 
 void UIMeshBuffer::resetIA() {
@@ -100,6 +109,67 @@ gfx::InputAssembler* UIMeshBuffer::requireFreeIA(gfx::Device* device) {
     return _iaPool[_nextFreeIAHandle++];
 }
 
+void UIMeshBuffer::retainIA(gfx::InputAssembler* ia) {
+    // IAs retained in the order they were handed out last frame are found right at the handle
+    for (auto i = _nextFreeIAHandle; i < _iaPool.size(); ++i) {
+        if (_iaPool[i] == ia) {
+            std::swap(_iaPool[i], _iaPool[_nextFreeIAHandle++]);
+            return;
+        }
+    }
+}
+
+void UIMeshBuffer::beginPartialUpload() {
+    _partialUpload = true;
+    _dirtyVertexRanges.clear();
+    _dirtyIndexRanges.clear();
+}
+
+void UIMeshBuffer::markVertexDirty(uint32_t begin, uint32_t end) {
+    if (_partialUpload) {
+        addDirtyRange(_dirtyVertexRanges, begin, end);
+    }
+}
+
+void UIMeshBuffer::markIndexDirty(uint32_t begin, uint32_t end) {
+    if (_partialUpload) {
+        addDirtyRange(_dirtyIndexRanges, begin * sizeof(uint16_t), end * sizeof(uint16_t));
+    }
+}
+
+void UIMeshBuffer::addDirtyRange(ccstd::vector<DirtyRange>& ranges, uint32_t begin, uint32_t end) {
+    if (begin >= end) {
+        return;
+    }
+    // draws are mostly filled in buffer order, extend the last range when they are
+    if (!ranges.empty()) {
+        auto& last = ranges.back();
+        if (begin <= last.end + DIRTY_RANGE_MERGE_GAP && end >= last.begin) {
+            last.begin = std::min(last.begin, begin);
+            last.end = std::max(last.end, end);
+            return;
+        }
+    }
+    ranges.push_back({begin, end});
+}
+
+void UIMeshBuffer::uploadDirtyRanges(gfx::Buffer* buffer, const void* data, ccstd::vector<DirtyRange>& ranges, uint32_t size) {
+    std::sort(ranges.begin(), ranges.end(), [](const DirtyRange& a, const DirtyRange& b) { return a.begin < b.begin; });
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < ranges.size();) {
+        // 4 byte aligned, as copies into Metal and WebGPU buffers require
+        uint32_t begin = ranges[i].begin & ~3U;
+        uint32_t end = ranges[i].end;
+        for (++i; i < ranges.size() && ranges[i].begin <= end + DIRTY_RANGE_MERGE_GAP; ++i) {
+            end = std::max(end, ranges[i].end);
+        }
+        end = std::min((end + 3U) & ~3U, size);
+        if (begin < end) {
+            buffer->update(bytes + begin, end - begin, begin);
+        }
+    }
+}
+
 void UIMeshBuffer::uploadBuffers() {
     uint32_t byteOffset = getByteOffset();
     bool dirty = getDirty();
@@ -114,16 +184,29 @@ void UIMeshBuffer::uploadBuffers() {
     gfx::BufferList vBuffers = ia->getVertexBuffers();
     if (!vBuffers.empty()) {
         gfx::Buffer* vBuffer = vBuffers[0];
-        if (byteCount > vBuffer->getSize()) {
+        // resizing drops the content of the buffer
+        bool resized = byteCount > vBuffer->getSize();
+        if (resized) {
             vBuffer->resize(byteCount);
         }
-        vBuffer->update(_vData);
+        if (_partialUpload && !resized) {
+            uploadDirtyRanges(vBuffer, _vData, _dirtyVertexRanges, byteCount);
+        } else {
+            // buffers only grow, the bytes past the used range are stale and need no upload
+            vBuffer->update(_vData, byteCount);
+        }
     }
     gfx::Buffer* iBuffer = ia->getIndexBuffer();
-    if (indexCount * 2 > iBuffer->getSize()) {
-        iBuffer->resize(indexCount * 2);
+    uint32_t indexBytes = indexCount * sizeof(uint16_t);
+    bool resized = indexBytes > iBuffer->getSize();
+    if (resized) {
+        iBuffer->resize(indexBytes);
+    }
+    if (_partialUpload && !resized) {
+        uploadDirtyRanges(iBuffer, _iData, _dirtyIndexRanges, indexBytes);
+    } else if (indexCount > 0) {
+        iBuffer->update(_iData, indexBytes);
     }
-    iBuffer->update(_iData);
 
     setDirty(false);
 }
@@ -59,6 +59,19 @@ public:
 
     gfx::InputAssembler* requireFreeIA(gfx::Device* device);
     gfx::InputAssembler* createNewIA(gfx::Device* device);
+    // keeps an IA of the last frame from being handed out by requireFreeIA in this frame
+    void retainIA(gfx::InputAssembler* ia);
+
+    /**
+     * @en Makes the next uploadBuffers upload only the ranges passed to markVertexDirty and markIndexDirty,
+     * instead of all used vertices and indices. Growing the GPU buffers still uploads everything.
+     * @zh 使下一次 uploadBuffers 只上传标记过的顶点和索引区间。
+     */
+    void beginPartialUpload();
+    // byte range of vData
+    void markVertexDirty(uint32_t begin, uint32_t end);
+    // index range of iData
+    void markIndexDirty(uint32_t begin, uint32_t end);
 
     inline uint32_t getByteOffset() const { return _meshBufferLayout->byteOffset; }
     void setByteOffset(uint32_t byteOffset);
@@ -78,6 +91,14 @@ protected:
     CC_DISALLOW_COPY_MOVE_ASSIGN(UIMeshBuffer);
 
 private:
+    struct DirtyRange {
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
+    static void addDirtyRange(ccstd::vector<DirtyRange>& ranges, uint32_t begin, uint32_t end);
+    static void uploadDirtyRanges(gfx::Buffer* buffer, const void* data, ccstd::vector<DirtyRange>& ranges, uint32_t size);
+
     float* _vData{nullptr};
     uint16_t* _iData{nullptr};
 
@@ -94,5 +115,11 @@ private:
     uint32_t _nextFreeIAHandle{0};
     bool _needDeleteVData{false};
     bool _useLinkData{false};
+
+    bool _partialUpload{false};
+    // in bytes
+    ccstd::vector<DirtyRange> _dirtyVertexRanges;
+    // in bytes as well, converted by markIndexDirty
+    ccstd::vector<DirtyRange> _dirtyIndexRanges;
 };
 } // namespace cc
@@ -288,6 +288,8 @@ void Mesh::initialize() {
         return;
     }
 
+    CC_MEMORY_TAG_SCOPE(ASSETS);
+
     _initialized = true;
 
     if (_struct.dynamic.has_value()) {
@@ -608,6 +608,7 @@ public:
         _owner = owner;
         size_t nSubMeshes = _owner->_mesh->getStruct().primitives.size();
         _subMeshInstances.resize(nSubMeshes, nullptr);
+        _weights.resize(nSubMeshes);
 
         for (size_t iSubMesh = 0; iSubMesh < nSubMeshes; ++iSubMesh) {
             if (_owner->_subMeshRenderings[iSubMesh] != nullptr) {
@@ -621,9 +622,14 @@ public:
     void setWeights(index_t subMeshIndex, const MeshWeightsType &weights) override {
         if (_subMeshInstances[subMeshIndex]) {
             _subMeshInstances[subMeshIndex]->setWeights(weights);
+            _weights[subMeshIndex] = weights;
         }
     }
 
+    const MeshWeightsType *getWeights(index_t subMeshIndex) const override {
+        return _subMeshInstances[subMeshIndex] ? &_weights[subMeshIndex] : nullptr;
+    }
+
     void adaptPipelineState(index_t subMeshIndex, gfx::DescriptorSet *descriptorSet) override {
         if (_subMeshInstances[subMeshIndex]) {
             _subMeshInstances[subMeshIndex]->adaptPipelineState(descriptorSet);
@@ -686,6 +692,7 @@ public:
 private:
     IntrusivePtr<StdMorphRendering> _owner;
     ccstd::vector<IntrusivePtr<SubMeshMorphRenderingInstance>> _subMeshInstances;
+    ccstd::vector<MeshWeightsType> _weights;
 };
 
 StdMorphRendering::StdMorphRendering(Mesh *mesh, gfx::Device *gfxDevice) {
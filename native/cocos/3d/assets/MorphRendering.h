@@ -64,6 +64,12 @@ public:
 
     virtual ccstd::vector<scene::IMacroPatch> requiredPatches(index_t subMeshIndex) = 0;
 
+    /**
+     * Gets the weights last set for the specified sub mesh, for morphing on the CPU outside of the instance.
+     * @param subMeshIndex
+     */
+    virtual const MeshWeightsType *getWeights(index_t /*subMeshIndex*/) const { return nullptr; }
+
     /**
      * Destroy the rendering instance.
      */
@@ -24,6 +24,7 @@
  ****************************************************************************/
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/assets/Mesh.h"
+#include "3d/skeletal-animation/BakedAnimationCrowd.h"
 //#include "3d/skeletal-animation/DataPoolManager.h"
 #include "core/Root.h"
 #include "scene/Model.h"
@@ -57,6 +58,9 @@ BakedSkinningModel::BakedSkinningModel()
 }
 
 void BakedSkinningModel::destroy() {
+    if (_crowd) {
+        _crowd->removeModel(this);
+    }
     // CC_SAFE_DELETE(uploadedAnim);
     _jointMedium.boundsInfo.clear();
 
@@ -90,44 +94,91 @@ void BakedSkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Me
 }
 
 void BakedSkinningModel::updateTransform(uint32_t stamp) {
+    Node *node = getTransform();
+    const bool nodeChanged = node->getChangedFlags() || node->getDirtyFlag();
     Super::updateTransform(stamp);
     if (!_isUploadedAnim) {
         return;
     }
-    IAnimInfo &animInfo = _jointMedium.animInfo;
-    geometry::AABB *skelBound = nullptr;
-    const float *curFrame = animInfo.curFrame;
-    //    float curFrame = info.data[0];
-    auto index = static_cast<index_t>(std::roundf(*curFrame));
-    if (!_jointMedium.boundsInfo.empty() && index < _jointMedium.boundsInfo.size()) {
-        skelBound = &_jointMedium.boundsInfo[index].value();
+    const geometry::AABB *skelBound = nullptr;
+    if (_crowd) {
+        // crowd frames only change on the LOD ticks of the model
+        if (!nodeChanged && !_crowdFrameChanged) {
+            return;
+        }
+        _crowdFrameChanged = false;
+        skelBound = _crowdBounds;
+    } else {
+        IAnimInfo &animInfo = _jointMedium.animInfo;
+        const float *curFrame = animInfo.curFrame;
+        //    float curFrame = info.data[0];
+        auto index = static_cast<index_t>(std::roundf(*curFrame));
+        if (!_jointMedium.boundsInfo.empty() && index < _jointMedium.boundsInfo.size()) {
+            skelBound = &_jointMedium.boundsInfo[index].value();
+        }
     }
 
     if (_worldBounds && skelBound != nullptr) {
-        Node *node = getTransform();
         skelBound->transform(node->getWorldMatrix(), _worldBounds);
         _worldBoundsDirty = true;
     }
 }
 
-void BakedSkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
+void BakedSkinningModel::prepareUBOs(uint32_t stamp) {
+    Super::prepareUBOs(stamp);
 
     IAnimInfo &info = _jointMedium.animInfo;
     int idx = _instAnimInfoIdx;
-    const float *curFrame = info.curFrame;
-    uint32_t frameDataBytes = info.frameDataBytes;
-    //    float curFrame = info.data[0];
-    //    uint32_t curFrameDataBytes = info.data.byteLength();
     if (idx >= 0) {
         auto &views = getInstancedAttributeBlock().views[idx];
-        setTypedArrayValue(views, 0, *curFrame);
-    } else if (*info.dirtyForJSB != 0) {
-        info.buffer->update(curFrame, frameDataBytes);
+        setTypedArrayValue(views, 0, *info.curFrame);
+    }
+}
+
+void BakedSkinningModel::uploadUBOs() {
+    Super::uploadUBOs();
+
+    IAnimInfo &info = _jointMedium.animInfo;
+    //    float curFrame = info.data[0];
+    //    uint32_t curFrameDataBytes = info.data.byteLength();
+    // crowd frames live in uniform buffers uploaded once by the crowd
+    if (_instAnimInfoIdx < 0 && !_crowd && *info.dirtyForJSB != 0) {
+        info.buffer->update(info.curFrame, info.frameDataBytes);
         *info.dirtyForJSB = 0;
     }
 }
 
+void BakedSkinningModel::setCrowdFrame(BakedAnimationCrowd *crowd, const float *animInfo, gfx::Buffer *animInfoBuffer, const geometry::AABB *bounds) {
+    IAnimInfo &info = _jointMedium.animInfo;
+    if (!crowd) {
+        if (_crowd) {
+            info = _ownAnimInfo;
+            _isUploadedAnim = _ownUploadedAnim;
+            _crowd = nullptr;
+            _crowdBounds = nullptr;
+            for (const auto &subModel : _subModels) {
+                subModel->getDescriptorSet()->bindBuffer(pipeline::UBOSkinningAnimation::BINDING, info.buffer);
+            }
+        }
+        return;
+    }
+    if (!_crowd) {
+        _ownAnimInfo = info;
+        _ownUploadedAnim = _isUploadedAnim;
+        _crowd = crowd;
+        _isUploadedAnim = true;
+    }
+    if (info.buffer != animInfoBuffer) {
+        info.buffer = animInfoBuffer;
+        for (const auto &subModel : _subModels) {
+            subModel->getDescriptorSet()->bindBuffer(pipeline::UBOSkinningAnimation::BINDING, animInfoBuffer);
+        }
+    }
+    info.curFrame = animInfo;
+    _crowdBounds = bounds;
+    _crowdFrameChanged = true;
+}
+
 void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture) {
     auto oldTex = _jointMedium.texture;
     if (oldTex.has_value() && texture.has_value() && (&oldTex.value() != &texture.value())) {
@@ -196,10 +247,19 @@ void BakedSkinningModel::updateInstancedJointTextureInfo() {
 }
 
 void BakedSkinningModel::syncAnimInfoForJS(gfx::Buffer *buffer, const Float32Array &data, Uint8Array &dirty) {
-    _jointMedium.animInfo.buffer = buffer;
-    _jointMedium.animInfo.curFrame = &data[0];
-    _jointMedium.animInfo.frameDataBytes = data.byteLength();
-    _jointMedium.animInfo.dirtyForJSB = &dirty[0];
+    IAnimInfo &animInfo = getAnimInfoForJS();
+    animInfo.buffer = buffer;
+    animInfo.curFrame = &data[0];
+    animInfo.frameDataBytes = data.byteLength();
+    animInfo.dirtyForJSB = &dirty[0];
+}
+
+void BakedSkinningModel::setUploadedAnimForJS(bool value) {
+    if (_crowd) {
+        _ownUploadedAnim = value;
+    } else {
+        _isUploadedAnim = value;
+    }
 }
 
 void BakedSkinningModel::syncDataForJS(const ccstd::vector<ccstd::optional<geometry::AABB>> &boundsInfo,
@@ -224,8 +284,9 @@ void BakedSkinningModel::syncDataForJS(const ccstd::vector<ccstd::optional<geome
     _jointMedium.jointTextureInfo[2] = jointTextureInfo2;
     _jointMedium.jointTextureInfo[3] = jointTextureInfo3;
 
-    _jointMedium.animInfo.curFrame = &animInfoData[0];
-    _jointMedium.animInfo.frameDataBytes = animInfoData.byteLength();
+    IAnimInfo &animInfo = getAnimInfoForJS();
+    animInfo.curFrame = &animInfoData[0];
+    animInfo.frameDataBytes = animInfoData.byteLength();
 
     if (_jointMedium.texture.has_value()) {
         delete _jointMedium.texture.value();
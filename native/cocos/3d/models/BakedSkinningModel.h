@@ -39,6 +39,7 @@ class Texture;
 }
 
 class DataPoolManager;
+class BakedAnimationCrowd;
 
 struct BakedJointInfo {
     IntrusivePtr<gfx::Buffer> buffer;
@@ -59,7 +60,8 @@ public:
     ccstd::vector<scene::IMacroPatch> getMacroPatches(index_t subModelIndex) override;
     void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet) override;
     void updateTransform(uint32_t stamp) override;
-    void updateUBOs(uint32_t stamp) override;
+    void prepareUBOs(uint32_t stamp) override;
+    void uploadUBOs() override;
     void updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, scene::Pass *pass) override;
     void updateInstancedJointTextureInfo();
     // void                             uploadAnimation(AnimationClip *anim); // TODO(xwx): AnimationClip not define
@@ -84,9 +86,23 @@ public:
                        gfx::Texture *tex,
                        const Float32Array &animInfoData);
 
-    void setUploadedAnimForJS(bool value) { _isUploadedAnim = value; }
+    void setUploadedAnimForJS(bool value);
+
+    /**
+     * @en Called by [[BakedAnimationCrowd]] to point the model to the shared data of its current frame,
+     * a null crowd detaches the model and restores the animation info last synchronized from JS.
+     * @zh 由群体动画调用，使模型指向当前帧的共享数据。
+     * @param animInfo cc_jointAnimInfo of the frame, 4 floats.
+     * @param animInfoBuffer The uniform buffer holding animInfo, shared by the models at the same frame.
+     * @param bounds Skeleton bounds of the frame, may be null.
+     */
+    void setCrowdFrame(BakedAnimationCrowd *crowd, const float *animInfo, gfx::Buffer *animInfoBuffer, const geometry::AABB *bounds);
+    inline BakedAnimationCrowd *getCrowd() const { return _crowd; }
+    inline gfx::Buffer *getAnimInfoBuffer() const { return _jointMedium.animInfo.buffer; }
 
 protected:
+    // scripts keep syncing the model's own animation while it is driven by a crowd
+    inline IAnimInfo &getAnimInfoForJS() { return _crowd ? _ownAnimInfo : _jointMedium.animInfo; }
     void applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture);
 
 private:
@@ -98,6 +114,13 @@ private:
     // AnimationClip* uploadedAnim;
     bool _isUploadedAnim{false};
 
+    BakedAnimationCrowd *_crowd{nullptr};
+    const geometry::AABB *_crowdBounds{nullptr};
+    // animation info synchronized from JS while in the crowd, restored when leaving it
+    IAnimInfo _ownAnimInfo;
+    bool _ownUploadedAnim{false};
+    bool _crowdFrameChanged{false};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(BakedSkinningModel);
 };
 
@@ -0,0 +1,381 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "3d/models/CPUSkinning.h"
+#include <algorithm>
+#include <cstring>
+#include "3d/assets/Mesh.h"
+#include "base/Macros.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+// same SIMD selection as MathUtil
+#if (CC_PLATFORM == CC_PLATFORM_IOS)
+    #if defined(__arm64__)
+        #define USE_NEON64
+        #define INCLUDE_NEON64
+    #endif
+#elif (CC_PLATFORM == CC_PLATFORM_ANDROID)
+    #if defined(__arm64__) || defined(__aarch64__)
+        #define USE_NEON64
+        #define INCLUDE_NEON64
+    #elif defined(__ARM_NEON__)
+        #define INCLUDE_NEON32
+    #endif
+#endif
+
+#if defined(__SSE__)
+    #define USE_SSE
+    #define INCLUDE_SSE
+#endif
+
+#if defined(INCLUDE_SSE)
+    #include <xmmintrin.h>
+#endif
+
+#if defined(INCLUDE_NEON32) || defined(INCLUDE_NEON64)
+    #include <arm_neon.h>
+#endif
+
+namespace cc {
+
+namespace {
+
+inline void addDisplacement(const ccstd::vector<float> &displacements, float weight, uint32_t begin, uint32_t end, float *dst) {
+    if (displacements.empty()) {
+        return;
+    }
+    for (uint32_t i = begin * 3; i < end * 3; ++i) {
+        dst[i - begin * 3] += weight * displacements[i];
+    }
+}
+
+inline void writeVec3(uint8_t *dst, int32_t offset, const float *value) {
+    memcpy(dst + offset, value, sizeof(float) * 3);
+}
+
+#if defined(USE_SSE)
+
+inline void skinVertex(const float *palette, const uint16_t *joints, const float *weights, uint32_t jointCount, __m128 rows[3]) {
+    rows[0] = rows[1] = rows[2] = _mm_setzero_ps();
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (joints[i] >= jointCount || weights[i] == 0.F) {
+            continue;
+        }
+        const float *joint = palette + joints[i] * 12;
+        const __m128 weight = _mm_set1_ps(weights[i]);
+        rows[0] = _mm_add_ps(rows[0], _mm_mul_ps(_mm_loadu_ps(joint), weight));
+        rows[1] = _mm_add_ps(rows[1], _mm_mul_ps(_mm_loadu_ps(joint + 4), weight));
+        rows[2] = _mm_add_ps(rows[2], _mm_mul_ps(_mm_loadu_ps(joint + 8), weight));
+    }
+}
+
+// rows hold the matrix columns 0-2 with the translation in w
+inline __m128 transformDirection(const __m128 rows[3], const float *v) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(rows[0], _mm_set1_ps(v[0])), _mm_mul_ps(rows[1], _mm_set1_ps(v[1]))), _mm_mul_ps(rows[2], _mm_set1_ps(v[2])));
+}
+
+inline __m128 transformPoint(const __m128 rows[3], const float *v) {
+    const __m128 t01 = _mm_unpackhi_ps(rows[0], rows[1]); // (r0.z, r1.z, r0.w, r1.w)
+    const __m128 translation = _mm_shuffle_ps(t01, rows[2], _MM_SHUFFLE(3, 3, 3, 2));
+    return _mm_add_ps(transformDirection(rows, v), translation);
+}
+
+inline void storeVec3(uint8_t *dst, int32_t offset, __m128 value) {
+    float lanes[4];
+    _mm_storeu_ps(lanes, value);
+    writeVec3(dst, offset, lanes);
+}
+
+#elif defined(USE_NEON64)
+
+inline void skinVertex(const float *palette, const uint16_t *joints, const float *weights, uint32_t jointCount, float32x4_t rows[3]) {
+    rows[0] = rows[1] = rows[2] = vdupq_n_f32(0.F);
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (joints[i] >= jointCount || weights[i] == 0.F) {
+            continue;
+        }
+        const float *joint = palette + joints[i] * 12;
+        rows[0] = vmlaq_n_f32(rows[0], vld1q_f32(joint), weights[i]);
+        rows[1] = vmlaq_n_f32(rows[1], vld1q_f32(joint + 4), weights[i]);
+        rows[2] = vmlaq_n_f32(rows[2], vld1q_f32(joint + 8), weights[i]);
+    }
+}
+
+inline float32x4_t transformDirection(const float32x4_t rows[3], const float *v) {
+    return vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(rows[0], v[0]), rows[1], v[1]), rows[2], v[2]);
+}
+
+inline float32x4_t transformPoint(const float32x4_t rows[3], const float *v) {
+    float32x4_t translation = vdupq_n_f32(vgetq_lane_f32(rows[0], 3));
+    translation = vsetq_lane_f32(vgetq_lane_f32(rows[1], 3), translation, 1);
+    translation = vsetq_lane_f32(vgetq_lane_f32(rows[2], 3), translation, 2);
+    return vaddq_f32(transformDirection(rows, v), translation);
+}
+
+inline void storeVec3(uint8_t *dst, int32_t offset, float32x4_t value) {
+    float lanes[4];
+    vst1q_f32(lanes, value);
+    writeVec3(dst, offset, lanes);
+}
+
+#else
+
+inline void skinVertex(const float *palette, const uint16_t *joints, const float *weights, uint32_t jointCount, float rows[12]) {
+    memset(rows, 0, sizeof(float) * 12);
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (joints[i] >= jointCount || weights[i] == 0.F) {
+            continue;
+        }
+        const float *joint = palette + joints[i] * 12;
+        for (uint32_t j = 0; j < 12; ++j) {
+            rows[j] += joint[j] * weights[i];
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+void morphVertices(const CPUSkinningStreams &source, const ccstd::vector<CPUMorphTarget> &targets, const float *weights, uint32_t begin, uint32_t end, CPUSkinningStreams *out) {
+    memcpy(out->positions.data() + begin * 3, source.positions.data() + begin * 3, sizeof(float) * 3 * (end - begin));
+    if (!source.normals.empty()) {
+        memcpy(out->normals.data() + begin * 3, source.normals.data() + begin * 3, sizeof(float) * 3 * (end - begin));
+    }
+    if (!source.tangents.empty()) {
+        memcpy(out->tangents.data() + begin * 4, source.tangents.data() + begin * 4, sizeof(float) * 4 * (end - begin));
+    }
+
+    // tangent displacements are xyz only while the tangent stream is xyzw
+    for (uint32_t t = 0; t < targets.size(); ++t) {
+        const float weight = weights[t];
+        if (weight == 0.F) {
+            continue;
+        }
+        const CPUMorphTarget &target = targets[t];
+        addDisplacement(target.positions, weight, begin, end, out->positions.data() + begin * 3);
+        if (!source.normals.empty()) {
+            addDisplacement(target.normals, weight, begin, end, out->normals.data() + begin * 3);
+        }
+        if (!source.tangents.empty() && !target.tangents.empty()) {
+            for (uint32_t v = begin; v < end; ++v) {
+                for (uint32_t c = 0; c < 3; ++c) {
+                    out->tangents[v * 4 + c] += weight * target.tangents[v * 3 + c];
+                }
+            }
+        }
+    }
+}
+
+void skinVertices(const CPUSkinningStreams &streams, const float *palette, uint32_t jointCount, uint32_t begin, uint32_t end, uint8_t *dst, const CPUSkinningLayout &layout) {
+    const bool hasNormals = layout.normalOffset >= 0 && !streams.normals.empty();
+    const bool hasTangents = layout.tangentOffset >= 0 && !streams.tangents.empty();
+    for (uint32_t v = begin; v < end; ++v) {
+        uint8_t *vertex = dst + v * layout.stride;
+        const uint16_t *joints = streams.joints.data() + v * 4;
+        const float *weights = streams.weights.data() + v * 4;
+#if defined(USE_SSE) || defined(USE_NEON64)
+    #if defined(USE_SSE)
+        __m128 rows[3];
+    #else
+        float32x4_t rows[3];
+    #endif
+        skinVertex(palette, joints, weights, jointCount, rows);
+        storeVec3(vertex, layout.positionOffset, transformPoint(rows, streams.positions.data() + v * 3));
+        if (hasNormals) {
+            storeVec3(vertex, layout.normalOffset, transformDirection(rows, streams.normals.data() + v * 3));
+        }
+        if (hasTangents) {
+            storeVec3(vertex, layout.tangentOffset, transformDirection(rows, streams.tangents.data() + v * 4));
+            memcpy(vertex + layout.tangentOffset + sizeof(float) * 3, streams.tangents.data() + v * 4 + 3, sizeof(float));
+        }
+#else
+        float rows[12];
+        skinVertex(palette, joints, weights, jointCount, rows);
+        auto transform = [&rows](const float *in, float w, float *out) {
+            for (uint32_t c = 0; c < 3; ++c) {
+                out[c] = rows[0 + c] * in[0] + rows[4 + c] * in[1] + rows[8 + c] * in[2] + rows[c * 4 + 3] * w;
+            }
+        };
+        float result[3];
+        transform(streams.positions.data() + v * 3, 1.F, result);
+        writeVec3(vertex, layout.positionOffset, result);
+        if (hasNormals) {
+            transform(streams.normals.data() + v * 3, 0.F, result);
+            writeVec3(vertex, layout.normalOffset, result);
+        }
+        if (hasTangents) {
+            transform(streams.tangents.data() + v * 4, 0.F, result);
+            writeVec3(vertex, layout.tangentOffset, result);
+            memcpy(vertex + layout.tangentOffset + sizeof(float) * 3, streams.tangents.data() + v * 4 + 3, sizeof(float));
+        }
+#endif
+    }
+}
+
+CPUSkinnedSubMesh::~CPUSkinnedSubMesh() {
+    CC_SAFE_DESTROY(_vertexBuffer);
+}
+
+bool CPUSkinnedSubMesh::initialize(RenderingSubMesh *subMesh) {
+    _subMesh = subMesh;
+    Mesh *mesh = subMesh->getMesh();
+    if (!mesh || !subMesh->getSubMeshIdx().has_value() || !mesh->getData().buffer()) return false;
+    const auto subMeshIndex = subMesh->getSubMeshIdx().value();
+    const auto &structInfo = mesh->getStruct();
+    const auto &prim = structInfo.primitives[subMeshIndex];
+
+    // only the bundle holding the positions is rewritten, so normals and tangents have to live there as well
+    int32_t bundleSlot = -1;
+    for (size_t i = 0; i < prim.vertexBundelIndices.size() && bundleSlot < 0; ++i) {
+        const auto &bundle = structInfo.vertexBundles[prim.vertexBundelIndices[i]];
+        uint32_t offset = 0;
+        for (const auto &attr : bundle.attributes) {
+            if (attr.name == gfx::ATTR_NAME_POSITION) {
+                if (attr.format != gfx::Format::RGB32F) return false;
+                bundleSlot = static_cast<int32_t>(i);
+                _layout.positionOffset = static_cast<int32_t>(offset);
+            } else if (attr.name == gfx::ATTR_NAME_NORMAL && attr.format == gfx::Format::RGB32F) {
+                _layout.normalOffset = static_cast<int32_t>(offset);
+            } else if (attr.name == gfx::ATTR_NAME_TANGENT && attr.format == gfx::Format::RGBA32F) {
+                _layout.tangentOffset = static_cast<int32_t>(offset);
+            }
+            offset += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attr.format)].size;
+        }
+        if (bundleSlot < 0) {
+            _layout.normalOffset = -1;
+            _layout.tangentOffset = -1;
+        }
+    }
+    if (bundleSlot < 0) return false;
+    const auto &bundle = structInfo.vertexBundles[prim.vertexBundelIndices[bundleSlot]];
+    const uint32_t vertexCount = bundle.view.count;
+    _layout.stride = bundle.view.stride;
+
+    const auto positions = mesh->readAttribute(subMeshIndex, gfx::ATTR_NAME_POSITION);
+    const auto joints = mesh->readAttribute(subMeshIndex, gfx::ATTR_NAME_JOINTS);
+    const auto weights = mesh->readAttribute(subMeshIndex, gfx::ATTR_NAME_WEIGHTS);
+    if (vertexCount == 0 || positions.index() == 0 || joints.index() == 0 || weights.index() == 0) return false;
+    if (getTypedArrayLength(positions) != vertexCount * 3 || getTypedArrayLength(joints) != vertexCount * 4 || getTypedArrayLength(weights) != vertexCount * 4) {
+        return false;
+    }
+    if ((_layout.normalOffset < 0 && mesh->readAttributeFormat(subMeshIndex, gfx::ATTR_NAME_NORMAL)) ||
+        (_layout.tangentOffset < 0 && mesh->readAttributeFormat(subMeshIndex, gfx::ATTR_NAME_TANGENT))) {
+        return false;
+    }
+
+    _source.vertexCount = vertexCount;
+    _source.positions.resize(vertexCount * 3);
+    for (uint32_t i = 0; i < vertexCount * 3; ++i) {
+        _source.positions[i] = getTypedArrayValue<float>(positions, i);
+    }
+    _source.joints.resize(vertexCount * 4);
+    _source.weights.resize(vertexCount * 4);
+    for (uint32_t i = 0; i < vertexCount * 4; ++i) {
+        _source.joints[i] = static_cast<uint16_t>(getTypedArrayValue<int32_t>(joints, i));
+        _source.weights[i] = getTypedArrayValue<float>(weights, i);
+    }
+    if (_layout.normalOffset >= 0) {
+        const auto normals = mesh->readAttribute(subMeshIndex, gfx::ATTR_NAME_NORMAL);
+        _source.normals.resize(vertexCount * 3);
+        for (uint32_t i = 0; i < vertexCount * 3; ++i) {
+            _source.normals[i] = getTypedArrayValue<float>(normals, i);
+        }
+    }
+    if (_layout.tangentOffset >= 0) {
+        const auto tangents = mesh->readAttribute(subMeshIndex, gfx::ATTR_NAME_TANGENT);
+        _source.tangents.resize(vertexCount * 4);
+        for (uint32_t i = 0; i < vertexCount * 4; ++i) {
+            _source.tangents[i] = getTypedArrayValue<float>(tangents, i);
+        }
+    }
+    if (!initMorphTargets(mesh, subMeshIndex)) return false;
+
+    const uint8_t *bundleData = mesh->getData().buffer()->getData() + bundle.view.offset;
+    _vertexData.assign(bundleData, bundleData + bundle.view.length);
+    _vertexBuffer = gfx::Device::getInstance()->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+        bundle.view.length,
+        bundle.view.stride,
+    });
+    _vertexBuffers = subMesh->getIaInfo().vertexBuffers;
+    _vertexBuffers[bundleSlot] = _vertexBuffer;
+    return true;
+}
+
+void CPUSkinnedSubMesh::skin(const float *palette, uint32_t jointCount, const MeshWeightsType *morphWeights, uint32_t begin, uint32_t end) {
+    const CPUSkinningStreams *streams = &_source;
+    if (morphWeights && morphWeights->size() >= _targets.size() &&
+        std::any_of(morphWeights->begin(), morphWeights->end(), [](float w) { return w != 0.F; })) {
+        morphVertices(_source, _targets, morphWeights->data(), begin, end, &_morphed);
+        streams = &_morphed;
+    }
+    skinVertices(*streams, palette, jointCount, begin, end, _vertexData.data(), _layout);
+}
+
+void CPUSkinnedSubMesh::upload() {
+    _vertexBuffer->update(_vertexData.data(), static_cast<uint32_t>(_vertexData.size()));
+}
+
+bool CPUSkinnedSubMesh::initMorphTargets(Mesh *mesh, index_t subMeshIndex) {
+    const auto &morph = mesh->getStruct().morph;
+    if (!morph.has_value() || subMeshIndex >= morph->subMeshMorphs.size() || !morph->subMeshMorphs[subMeshIndex].has_value()) {
+        return true;
+    }
+    const auto &subMeshMorph = morph->subMeshMorphs[subMeshIndex].value();
+    const uint32_t floatCount = _source.vertexCount * 3;
+    _targets.resize(subMeshMorph.targets.size());
+    for (size_t attributeIndex = 0; attributeIndex < subMeshMorph.attributes.size(); ++attributeIndex) {
+        const auto &name = subMeshMorph.attributes[attributeIndex];
+        for (size_t t = 0; t < subMeshMorph.targets.size(); ++t) {
+            const auto &view = subMeshMorph.targets[t].displacements[attributeIndex];
+            if (view.count != floatCount) return false;
+            const uint8_t *displacements = mesh->getData().buffer()->getData() + view.offset;
+            ccstd::vector<float> *dst = nullptr;
+            if (name == gfx::ATTR_NAME_POSITION) {
+                dst = &_targets[t].positions;
+            } else if (name == gfx::ATTR_NAME_NORMAL) {
+                dst = _source.normals.empty() ? nullptr : &_targets[t].normals;
+            } else if (name == gfx::ATTR_NAME_TANGENT) {
+                dst = _source.tangents.empty() ? nullptr : &_targets[t].tangents;
+            } else {
+                // the morph shader patch is dropped, other attributes could not be morphed anymore
+                return false;
+            }
+            if (dst) {
+                dst->resize(floatCount);
+                memcpy(dst->data(), displacements, sizeof(float) * floatCount);
+            }
+        }
+    }
+    _morphed = _source;
+    return true;
+}
+
+} // namespace cc
@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "3d/assets/Types.h"
+#include "base/Ptr.h"
+#include "base/TypeDef.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+
+class Mesh;
+class RenderingSubMesh;
+
+/**
+ * @en Vertex streams of a sub mesh decoded for skinning and morphing on the CPU.
+ * @zh 为 CPU 蒙皮与形变解码的子网格顶点流。
+ */
+struct CPUSkinningStreams {
+    uint32_t vertexCount{0};
+    // 3 floats per vertex
+    ccstd::vector<float> positions;
+    // 3 floats per vertex, empty if the sub mesh has no normals
+    ccstd::vector<float> normals;
+    // 4 floats per vertex, empty if the sub mesh has no tangents
+    ccstd::vector<float> tangents;
+    // 4 skeleton joint indices per vertex
+    ccstd::vector<uint16_t> joints;
+    // 4 floats per vertex
+    ccstd::vector<float> weights;
+};
+
+/**
+ * @en Displacements of one morph target, 3 floats per vertex, empty for attributes the target does not morph.
+ * @zh 单个形变目标的位移。
+ */
+struct CPUMorphTarget {
+    ccstd::vector<float> positions;
+    ccstd::vector<float> normals;
+    ccstd::vector<float> tangents;
+};
+
+/**
+ * @en Where the skinned attributes are written in an interleaved vertex buffer, offsets are in bytes and -1 for absent attributes.
+ * @zh 蒙皮结果在交错顶点缓冲中的布局。
+ */
+struct CPUSkinningLayout {
+    uint32_t stride{0};
+    int32_t positionOffset{-1};
+    int32_t normalOffset{-1};
+    int32_t tangentOffset{-1};
+};
+
+/**
+ * @en Writes source + sum(weights[t] * targets[t]) to the positions, normals and tangents of out for vertices [begin, end).
+ * out must have the same stream sizes as source, the tangent w component is copied unchanged.
+ * @zh 对 [begin, end) 范围内的顶点叠加形变目标位移。
+ */
+void morphVertices(const CPUSkinningStreams &source, const ccstd::vector<CPUMorphTarget> &targets, const float *weights, uint32_t begin, uint32_t end, CPUSkinningStreams *out);
+
+/**
+ * @en Skins vertices [begin, end) the way the skinning shader chunk does and writes them to dst.
+ * The joint matrix of each vertex is the weighted sum of its 4 palette entries, positions are transformed as points,
+ * normals and tangent xyz as directions without renormalizing, the tangent w component is copied.
+ * @zh 按照蒙皮着色器的方式对 [begin, end) 范围内的顶点蒙皮并写入 dst。
+ * @param palette Joint matrices in the joint uniform layout: 12 floats per joint, columns 0 to 2 with the translation in w.
+ * @param jointCount Number of palette entries, influences of joints out of range are ignored.
+ */
+void skinVertices(const CPUSkinningStreams &streams, const float *palette, uint32_t jointCount, uint32_t begin, uint32_t end, uint8_t *dst, const CPUSkinningLayout &layout);
+
+/**
+ * @en Vertex data of one sub mesh skinned on the CPU, the bundle holding the positions is copied
+ * and its skinned attributes are rewritten every frame into a buffer owned by the sub mesh.
+ * @zh 在 CPU 上蒙皮的子网格顶点数据，每帧重写包含位置的顶点缓冲。
+ */
+class CPUSkinnedSubMesh final {
+public:
+    ~CPUSkinnedSubMesh();
+
+    /**
+     * @en Decodes the vertex streams and morph targets of the sub mesh and creates the skinned vertex buffer.
+     * Returns false if the sub mesh layout can not be skinned on the CPU.
+     * @zh 解码子网格的顶点流与形变目标并创建蒙皮顶点缓冲，无法在 CPU 上蒙皮时返回 false。
+     */
+    bool initialize(RenderingSubMesh *subMesh);
+
+    /**
+     * @en Morphs and skins vertices [begin, end) into the CPU copy of the vertex data, ranges may be processed in parallel.
+     * @zh 对 [begin, end) 范围内的顶点进行形变与蒙皮，不同范围可以并行处理。
+     */
+    void skin(const float *palette, uint32_t jointCount, const MeshWeightsType *morphWeights, uint32_t begin, uint32_t end);
+
+    void upload();
+
+    inline RenderingSubMesh *getSubMesh() const { return _subMesh; }
+    inline uint32_t getVertexCount() const { return _source.vertexCount; }
+    inline const gfx::BufferList &getVertexBuffers() const { return _vertexBuffers; }
+
+private:
+    bool initMorphTargets(Mesh *mesh, index_t subMeshIndex);
+
+    RenderingSubMesh *_subMesh{nullptr};
+    CPUSkinningStreams _source;
+    CPUSkinningStreams _morphed;
+    ccstd::vector<CPUMorphTarget> _targets;
+    CPUSkinningLayout _layout;
+    ccstd::vector<uint8_t> _vertexData;
+    IntrusivePtr<gfx::Buffer> _vertexBuffer;
+    gfx::BufferList _vertexBuffers;
+};
+
+} // namespace cc
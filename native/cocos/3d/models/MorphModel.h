@@ -45,6 +45,7 @@ public:
     void setSubModelMaterial(index_t idx, Material *mat) override;
 
     inline void setMorphRendering(MorphRenderingInstance *morphRendering) { _morphRenderingInstance = morphRendering; }
+    inline MorphRenderingInstance *getMorphRendering() const { return _morphRenderingInstance; }
 
 protected:
     void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet) override;
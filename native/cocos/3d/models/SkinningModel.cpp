@@ -27,9 +27,13 @@
 #include <utility>
 
 #include "3d/assets/Mesh.h"
+#include "3d/assets/MorphRendering.h"
 #include "3d/assets/Skeleton.h"
+#include "3d/models/CPUSkinning.h"
+#include "base/job-system/JobSystem.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "scene/Pass.h"
 #include "scene/RenderScene.h"
@@ -65,12 +69,14 @@ SkinningModel::SkinningModel() {
 }
 SkinningModel::~SkinningModel() {
     releaseData();
+    releaseCPUSkinning();
 }
 
 void SkinningModel::destroy() {
     bindSkeleton(nullptr, nullptr, nullptr);
     releaseData();
     Super::destroy();
+    releaseCPUSkinning();
 }
 
 void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh) {
@@ -79,6 +85,13 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     }
     _bufferIndices.clear();
     _joints.clear();
+    _jointMatrices.clear();
+    _bindposes.clear();
+    _jointBounds.clear();
+    _palette.clear();
+    _directPalette = false;
+    _jointIndices.clear();
+    _skeletonJointCount = 0;
 
     if (!skeleton || !skinningRoot || !mesh) return;
     auto jointCount = static_cast<uint32_t>(skeleton->getJoints().size());
@@ -113,6 +126,29 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
         jointInfo.buffers = std::move(buffers);
         jointInfo.indices = std::move(indices);
         _joints.emplace_back(std::move(jointInfo));
+        _jointIndices.emplace_back(index);
+    }
+    _skeletonJointCount = jointCount;
+
+    const auto boundJointCount = static_cast<uint32_t>(_joints.size());
+    const uint32_t capacity = _realTimeTextureMode ? REALTIME_JOINT_TEXTURE_WIDTH : pipeline::UBOSkinning::count / 12;
+    _directPalette = !_dataArray.empty() && boundJointCount <= capacity;
+    static_assert(sizeof(Mat4) == sizeof(float) * 16, "bindposes are passed as packed floats");
+    _jointMatrices.reserve(boundJointCount);
+    _bindposes.reserve(boundJointCount);
+    _jointBounds.reserve(boundJointCount * 6);
+    for (uint32_t i = 0; i < boundJointCount; ++i) {
+        const JointInfo &jointInfo = _joints[i];
+        // a joint bound to the skinning root itself has no transform and stays at identity, as getWorldMatrix(nullptr) does
+        _jointMatrices.emplace_back(jointInfo.transform ? jointInfo.transform->world.m : Mat4::IDENTITY.m);
+        _bindposes.emplace_back(jointInfo.bindpose);
+        const Vec3 &center = jointInfo.bound->getCenter();
+        const Vec3 &halfExtents = jointInfo.bound->getHalfExtents();
+        _jointBounds.insert(_jointBounds.end(), {center.x, center.y, center.z, halfExtents.x, halfExtents.y, halfExtents.z});
+        _directPalette = _directPalette && jointInfo.buffers.size() == 1 && jointInfo.buffers[0] == 0 && jointInfo.indices[0] == i;
+    }
+    if (!_directPalette) {
+        _palette.resize(boundJointCount * 12);
     }
 }
 
@@ -122,18 +158,35 @@ void SkinningModel::updateTransform(uint32_t stamp) {
         root->updateWorldTransform();
         _localDataUpdated = true;
     }
-    Vec3 v3Min{INFINITY, INFINITY, INFINITY};
-    Vec3 v3Max{-INFINITY, -INFINITY, -INFINITY};
-    geometry::AABB ab1;
-    Vec3 v31;
-    Vec3 v32;
     for (JointInfo &jointInfo : _joints) {
-        auto &transform = jointInfo.transform;
-        Mat4 worldMatrix = cc::getWorldMatrix(transform, static_cast<int32_t>(stamp));
-        jointInfo.bound->transform(worldMatrix, &ab1);
-        ab1.getBoundary(&v31, &v32);
-        Vec3::min(v3Min, v31, &v3Min);
-        Vec3::max(v3Max, v32, &v3Max);
+        // refreshes transform->world, which _jointMatrices points to
+        cc::getWorldMatrix(jointInfo.transform, static_cast<int32_t>(stamp));
+    }
+
+    // the joint matrices are final for this frame, so the palette is computed along with the bounds
+    const auto jointCount = static_cast<uint32_t>(_joints.size());
+    float *palette = _directPalette ? _dataArray[0] : _palette.data();
+    Vec3 v3Min;
+    Vec3 v3Max;
+    MathUtil::computeSkinningPalette(_jointMatrices.data(), reinterpret_cast<const float *>(_bindposes.data()), _jointBounds.data(), jointCount, palette, &v3Min.x, &v3Max.x);
+    if (!_directPalette) {
+        for (uint32_t i = 0; i < jointCount; ++i) {
+            const JointInfo &jointInfo = _joints[i];
+            for (size_t b = 0; b < jointInfo.buffers.size(); ++b) {
+                memcpy(_dataArray[jointInfo.buffers[b]] + jointInfo.indices[b] * 12, palette + i * 12, sizeof(float) * 12);
+            }
+        }
+    }
+    if (_cpuSkinningEnabled) {
+        // vertex data refers to skeleton joints rather than to joint map entries
+        if (_directPalette && jointCount == _skeletonJointCount) {
+            _cpuPalette.assign(palette, palette + jointCount * 12);
+        } else {
+            _cpuPalette.assign(_skeletonJointCount * 12, 0.F);
+            for (uint32_t i = 0; i < jointCount; ++i) {
+                memcpy(_cpuPalette.data() + _jointIndices[i] * 12, palette + i * 12, sizeof(float) * 12);
+            }
+        }
     }
     if (_modelBounds && _modelBounds->isValid() && _worldBounds) {
         geometry::AABB::fromPoints(v3Min, v3Max, _modelBounds);
@@ -142,22 +195,21 @@ void SkinningModel::updateTransform(uint32_t stamp) {
     }
 }
 
-void SkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
-    uint32_t bIdx = 0;
-    Mat4 mat4;
-    for (const JointInfo &jointInfo : _joints) {
-        Mat4::multiply(jointInfo.transform->world, jointInfo.bindpose, &mat4);
-        for (uint32_t buffer : jointInfo.buffers) {
-            uploadJointData(jointInfo.indices[bIdx] * 12, mat4, _dataArray[buffer]);
-            bIdx++;
+void SkinningModel::uploadUBOs() {
+    Super::uploadUBOs();
+    if (_cpuSkinningEnabled && !_cpuSubMeshes.empty()) {
+        updateCPUSkinning();
+        // the joint data is still needed by the sub meshes which could not be skinned on the CPU
+        bool allCPUSkinned = true;
+        for (index_t i = 0; i < _subModels.size(); ++i) {
+            allCPUSkinned = allCPUSkinned && isCPUSkinned(i);
         }
-        bIdx = 0;
+        if (allCPUSkinned) return;
     }
     if (_realTimeTextureMode) {
         updateRealTimeJointTextureBuffer();
     } else {
-        bIdx = 0;
+        uint32_t bIdx = 0;
         for (gfx::Buffer *buffer : _buffers) {
             buffer->update(_dataArray[bIdx], buffer->getSize());
             bIdx++;
@@ -168,12 +220,16 @@ void SkinningModel::updateUBOs(uint32_t stamp) {
 void SkinningModel::initSubModel(index_t idx, RenderingSubMesh *subMeshData, Material *mat) {
     const auto &original = subMeshData->getVertexBuffers();
     auto &iaInfo = subMeshData->getIaInfo();
-    iaInfo.vertexBuffers = subMeshData->getJointMappedBuffers();
+    iaInfo.vertexBuffers = getSkinningVertexBuffers(idx, subMeshData);
     Super::initSubModel(idx, subMeshData, mat);
     iaInfo.vertexBuffers = original;
 }
 
 ccstd::vector<scene::IMacroPatch> SkinningModel::getMacroPatches(index_t subModelIndex) {
+    if (isCPUSkinned(subModelIndex)) {
+        // skinned and morphed vertices are fed to the shader as they are
+        return scene::Model::getMacroPatches(subModelIndex);
+    }
     auto patches = Super::getMacroPatches(subModelIndex);
     auto myPatches = uniformPatches;
     if (_realTimeTextureMode) {
@@ -188,13 +244,6 @@ ccstd::vector<scene::IMacroPatch> SkinningModel::getMacroPatches(index_t subMode
     return myPatches;
 }
 
-void SkinningModel::uploadJointData(uint32_t base, const Mat4 &mat, float *dst) {
-    memcpy(reinterpret_cast<void *>(dst + base), mat.m, sizeof(float) * 12);
-    dst[base + 3] = mat.m[12];
-    dst[base + 7] = mat.m[13];
-    dst[base + 11] = mat.m[14];
-}
-
 void SkinningModel::updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) {
     Super::updateLocalDescriptors(submodelIdx, descriptorset);
     uint32_t idx = _bufferIndices[submodelIdx];
@@ -217,6 +266,105 @@ void SkinningModel::updateInstancedAttributes(const ccstd::vector<gfx::Attribute
     Super::updateInstancedAttributes(attributes, pass);
 }
 
+void SkinningModel::setCPUSkinningEnabled(bool enabled) {
+    if (_cpuSkinningEnabled == enabled) return;
+    _cpuSkinningEnabled = enabled;
+    for (index_t i = 0; i < _subModels.size(); ++i) {
+        RenderingSubMesh *subMesh = _subModels[i]->getSubMesh();
+        const auto original = subMesh->getIaInfo().vertexBuffers;
+        subMesh->getIaInfo().vertexBuffers = getSkinningVertexBuffers(i, subMesh);
+        _subModels[i]->setSubMesh(subMesh);
+        subMesh->getIaInfo().vertexBuffers = original;
+    }
+    if (!enabled) {
+        releaseCPUSkinning();
+    }
+    _localDataUpdated = true;
+    onMacroPatchesStateChanged();
+}
+
+bool SkinningModel::isCPUSkinned(index_t subModelIndex) const {
+    return _cpuSkinningEnabled && subModelIndex < _cpuSubMeshes.size() && _cpuSubMeshes[subModelIndex] != nullptr;
+}
+
+const gfx::BufferList &SkinningModel::getSkinningVertexBuffers(index_t subModelIndex, RenderingSubMesh *subMeshData) {
+    if (!_cpuSkinningEnabled) {
+        return subMeshData->getJointMappedBuffers();
+    }
+    if (_cpuSubMeshes.size() <= subModelIndex) {
+        _cpuSubMeshes.resize(subModelIndex + 1, nullptr);
+    }
+    CPUSkinnedSubMesh *&cpuSubMesh = _cpuSubMeshes[subModelIndex];
+    if (!cpuSubMesh || cpuSubMesh->getSubMesh() != subMeshData) {
+        CC_SAFE_DELETE(cpuSubMesh);
+        cpuSubMesh = ccnew CPUSkinnedSubMesh;
+        if (!cpuSubMesh->initialize(subMeshData)) {
+            CC_SAFE_DELETE(cpuSubMesh);
+            return subMeshData->getJointMappedBuffers();
+        }
+    }
+    return cpuSubMesh->getVertexBuffers();
+}
+
+void SkinningModel::updateCPUSkinning() {
+    if (_cpuPalette.empty()) return;
+    const float *palette = _cpuPalette.data();
+    auto *morphRendering = getMorphRendering();
+    uint32_t totalVertexCount = 0;
+    for (const auto *cpuSubMesh : _cpuSubMeshes) {
+        totalVertexCount += cpuSubMesh ? cpuSubMesh->getVertexCount() : 0;
+    }
+
+    auto *jobSystem = JobSystem::getInstance();
+    if (totalVertexCount < CPU_SKINNING_PARALLEL_VERTEX_COUNT || jobSystem->threadCount() <= 1) {
+        for (index_t i = 0; i < _cpuSubMeshes.size(); ++i) {
+            if (!_cpuSubMeshes[i]) continue;
+            const auto *weights = morphRendering ? morphRendering->getWeights(i) : nullptr;
+            _cpuSubMeshes[i]->skin(palette, _skeletonJointCount, weights, 0, _cpuSubMeshes[i]->getVertexCount());
+        }
+    } else {
+        // vertex ranges do not overlap, each job writes its own part of the vertex data
+        struct VertexRange {
+            CPUSkinnedSubMesh *subMesh;
+            const MeshWeightsType *weights;
+            uint32_t begin;
+            uint32_t end;
+        };
+        ccstd::vector<VertexRange> ranges;
+        ranges.reserve(totalVertexCount / CPU_SKINNING_VERTICES_PER_JOB + _cpuSubMeshes.size());
+        for (index_t i = 0; i < _cpuSubMeshes.size(); ++i) {
+            if (!_cpuSubMeshes[i]) continue;
+            const auto *weights = morphRendering ? morphRendering->getWeights(i) : nullptr;
+            const uint32_t vertexCount = _cpuSubMeshes[i]->getVertexCount();
+            for (uint32_t begin = 0; begin < vertexCount; begin += CPU_SKINNING_VERTICES_PER_JOB) {
+                ranges.push_back({_cpuSubMeshes[i], weights, begin, std::min(begin + CPU_SKINNING_VERTICES_PER_JOB, vertexCount)});
+            }
+        }
+        const uint32_t jointCount = _skeletonJointCount;
+        JobGraph g(jobSystem);
+        g.createForEachIndexJob(0U, static_cast<uint32_t>(ranges.size()), 1U, [&](uint32_t r) {
+            const VertexRange &range = ranges[r];
+            range.subMesh->skin(palette, jointCount, range.weights, range.begin, range.end);
+        });
+        g.run();
+        g.waitForAll();
+    }
+
+    for (auto *cpuSubMesh : _cpuSubMeshes) {
+        if (cpuSubMesh) {
+            cpuSubMesh->upload();
+        }
+    }
+}
+
+void SkinningModel::releaseCPUSkinning() {
+    for (auto *cpuSubMesh : _cpuSubMeshes) {
+        CC_SAFE_DELETE(cpuSubMesh);
+    }
+    _cpuSubMeshes.clear();
+    _cpuPalette.clear();
+}
+
 void SkinningModel::ensureEnoughBuffers(uint32_t count) {
     if (!_buffers.empty()) {
         for (gfx::Buffer *buffer : _buffers) {
@@ -35,6 +35,7 @@
 
 namespace cc {
 class Skeleton;
+class CPUSkinnedSubMesh;
 namespace geometry {
 class AABB;
 }
@@ -56,7 +57,7 @@ public:
 
     void updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) override;
     void updateTransform(uint32_t stamp) override;
-    void updateUBOs(uint32_t stamp) override;
+    void uploadUBOs() override;
     void destroy() override;
 
     void initSubModel(index_t idx, RenderingSubMesh *subMeshData, Material *mat) override;
@@ -65,8 +66,24 @@ public:
 
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
+    /**
+     * @en Whether to skin and morph the vertices on the CPU into vertex buffers owned by this model instead of in
+     * the vertex shader. Useful where vertex shader skinning is the bottleneck or no GPU is involved.
+     * Sub meshes whose data is not accessible (see [[Mesh.allowDataAccess]]) keep skinning on the GPU.
+     * @zh 是否在 CPU 上进行蒙皮与形变，结果写入模型自己的顶点缓冲。无法访问网格数据的子网格仍使用 GPU 蒙皮。
+     */
+    void setCPUSkinningEnabled(bool enabled);
+    inline bool isCPUSkinningEnabled() const { return _cpuSkinningEnabled; }
+
+    // from this many vertices on, CPU skinning is split into jobs of CPU_SKINNING_VERTICES_PER_JOB vertices
+    static constexpr uint32_t CPU_SKINNING_PARALLEL_VERTEX_COUNT = 4096;
+    static constexpr uint32_t CPU_SKINNING_VERTICES_PER_JOB = 1024;
+
 private:
-    static void uploadJointData(uint32_t base, const Mat4 &mat, float *dst);
+    bool isCPUSkinned(index_t subModelIndex) const;
+    const gfx::BufferList &getSkinningVertexBuffers(index_t subModelIndex, RenderingSubMesh *subMeshData);
+    void updateCPUSkinning();
+    void releaseCPUSkinning();
     void ensureEnoughBuffers(uint32_t count);
     void updateRealTimeJointTextureBuffer();
     void initRealTimeJointTexture();
@@ -77,6 +94,21 @@ private:
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
     ccstd::vector<JointInfo> _joints;
     ccstd::vector<float *> _dataArray;
+    // joint data packed for MathUtil::computeSkinningPalette, in the order of _joints
+    ccstd::vector<const float *> _jointMatrices;
+    ccstd::vector<Mat4> _bindposes;
+    ccstd::vector<float> _jointBounds;
+    // palette of meshes with joint maps, scattered into _dataArray afterwards
+    ccstd::vector<float> _palette;
+    // whether the palette is laid out like _dataArray[0] and written there directly
+    bool _directPalette{false};
+    // skeleton joint index of each entry of _joints
+    ccstd::vector<index_t> _jointIndices;
+    uint32_t _skeletonJointCount{0};
+    // palette indexed by skeleton joint, as the vertex data of the mesh refers to joints
+    ccstd::vector<float> _cpuPalette;
+    ccstd::vector<CPUSkinnedSubMesh *> _cpuSubMeshes;
+    bool _cpuSkinningEnabled{false};
     bool _realTimeTextureMode = false;
     RealTimeJointTexture *_realTimeJointTexture = nullptr;
 
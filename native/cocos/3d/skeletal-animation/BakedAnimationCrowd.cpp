@@ -0,0 +1,183 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "3d/skeletal-animation/BakedAnimationCrowd.h"
+
+#include <algorithm>
+#include <cmath>
+#include "3d/models/BakedSkinningModel.h"
+#include "base/Log.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+
+namespace cc {
+
+BakedAnimationCrowd::~BakedAnimationCrowd() {
+    clear();
+}
+
+index_t BakedAnimationCrowd::addClip(const BakedCrowdClip &clip) {
+    ClipState state;
+    state.clip = clip;
+    state.frames.resize(std::max(clip.frameCount, 1U) * 4, 0.F);
+    for (uint32_t i = 0; i < clip.frameCount; ++i) {
+        state.frames[i * 4] = static_cast<float>(i);
+    }
+    state.buffers.resize(std::max(clip.frameCount, 1U));
+    _clips.emplace_back(std::move(state));
+    return static_cast<index_t>(_clips.size() - 1);
+}
+
+void BakedAnimationCrowd::setLODLevels(const ccstd::vector<BakedCrowdLOD> &levels) {
+    _lodLevels = levels;
+    std::sort(_lodLevels.begin(), _lodLevels.end(), [](const BakedCrowdLOD &a, const BakedCrowdLOD &b) { return a.distance < b.distance; });
+    for (auto &agent : _agents) {
+        agent.lod = 0;
+    }
+}
+
+void BakedAnimationCrowd::addModel(BakedSkinningModel *model, index_t clip, float time) {
+    if (!model || clip < 0 || clip >= _clips.size()) {
+        CC_LOG_WARNING("BakedAnimationCrowd: invalid model or clip %d", clip);
+        return;
+    }
+    if (_agentIndices.count(model)) {
+        play(model, clip, time);
+        return;
+    }
+    _agentIndices[model] = static_cast<uint32_t>(_agents.size());
+    Agent agent;
+    agent.model = model;
+    agent.clip = clip;
+    agent.time = time;
+    agent.phase = static_cast<uint32_t>(_agents.size());
+    _agents.emplace_back(agent);
+    applyFrame(_agents.back(), evaluateFrame(_clips[clip], time));
+}
+
+void BakedAnimationCrowd::removeModel(BakedSkinningModel *model) {
+    auto iter = _agentIndices.find(model);
+    if (iter == _agentIndices.end()) return;
+    const uint32_t index = iter->second;
+    _agentIndices.erase(iter);
+    model->setCrowdFrame(nullptr, nullptr, nullptr, nullptr);
+    if (index != _agents.size() - 1) {
+        _agents[index] = _agents.back();
+        _agentIndices[_agents[index].model] = index;
+    }
+    _agents.pop_back();
+}
+
+void BakedAnimationCrowd::play(BakedSkinningModel *model, index_t clip, float time) {
+    auto iter = _agentIndices.find(model);
+    if (iter == _agentIndices.end() || clip < 0 || clip >= _clips.size()) return;
+    Agent &agent = _agents[iter->second];
+    agent.clip = clip;
+    agent.time = time;
+    applyFrame(agent, evaluateFrame(_clips[clip], time));
+}
+
+void BakedAnimationCrowd::update(float dt, const Vec3 &viewPosition) {
+    ++_frameCounter;
+    for (auto &agent : _agents) {
+        agent.time += dt;
+        const uint32_t interval = agent.lod == 0 ? 1 : std::max(_lodLevels[agent.lod - 1].frameInterval, 1U);
+        if ((_frameCounter + agent.phase) % interval != 0) continue;
+        // distance is only measured when the model is due, a model approaching the view is promoted on its next update
+        agent.lod = evaluateLOD(agent, viewPosition);
+        const uint32_t frame = evaluateFrame(_clips[agent.clip], agent.time);
+        if (frame != agent.frame) {
+            applyFrame(agent, frame);
+        }
+    }
+}
+
+void BakedAnimationCrowd::clear() {
+    for (auto &agent : _agents) {
+        agent.model->setCrowdFrame(nullptr, nullptr, nullptr, nullptr);
+    }
+    _agents.clear();
+    _agentIndices.clear();
+    for (auto &state : _clips) {
+        for (auto &buffer : state.buffers) {
+            CC_SAFE_DESTROY_NULL(buffer);
+        }
+    }
+    _clips.clear();
+    _frameBufferCount = 0;
+}
+
+uint32_t BakedAnimationCrowd::evaluateFrame(const ClipState &state, float time) const {
+    const BakedCrowdClip &clip = state.clip;
+    if (clip.frameCount <= 1) return 0;
+    auto frame = static_cast<int64_t>(std::floor(time * clip.sample));
+    const auto frameCount = static_cast<int64_t>(clip.frameCount);
+    if (clip.loop) {
+        frame %= frameCount;
+        return static_cast<uint32_t>(frame < 0 ? frame + frameCount : frame);
+    }
+    return static_cast<uint32_t>(std::min(std::max(frame, static_cast<int64_t>(0)), frameCount - 1));
+}
+
+uint32_t BakedAnimationCrowd::evaluateLOD(const Agent &agent, const Vec3 &viewPosition) const {
+    if (_lodLevels.empty()) return 0;
+    const Node *node = agent.model->getTransform();
+    if (!node) return 0;
+    const float distanceSquared = viewPosition.distanceSquared(node->getWorldPosition());
+    uint32_t lod = 0;
+    while (lod < _lodLevels.size() && distanceSquared >= _lodLevels[lod].distance * _lodLevels[lod].distance) {
+        ++lod;
+    }
+    return lod;
+}
+
+void BakedAnimationCrowd::applyFrame(Agent &agent, uint32_t frame) {
+    ClipState &state = _clips[agent.clip];
+    agent.frame = frame;
+    const geometry::AABB *bounds = nullptr;
+    if (frame < state.clip.boundsInfo.size() && state.clip.boundsInfo[frame].has_value()) {
+        bounds = &state.clip.boundsInfo[frame].value();
+    }
+    agent.model->setCrowdFrame(this, &state.frames[frame * 4], getFrameBuffer(state, frame), bounds);
+}
+
+gfx::Buffer *BakedAnimationCrowd::getFrameBuffer(ClipState &state, uint32_t frame) {
+    auto &buffer = state.buffers[frame];
+    if (!buffer) {
+        buffer = Root::getInstance()->getDevice()->createBuffer({
+            gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            pipeline::UBOSkinningAnimation::SIZE,
+            pipeline::UBOSkinningAnimation::SIZE,
+        });
+        buffer->update(&state.frames[frame * 4], pipeline::UBOSkinningAnimation::SIZE);
+        ++_frameBufferCount;
+    }
+    return buffer;
+}
+
+} // namespace cc
@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/TypeDef.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "base/std/optional.h"
+#include "core/geometry/AABB.h"
+#include "math/Vec3.h"
+
+namespace cc {
+
+namespace gfx {
+class Buffer;
+}
+
+class BakedSkinningModel;
+
+/**
+ * @en A baked clip played by a crowd, the joint texture of the clip is bound by the models themselves.
+ * @zh 群体播放的烘焙动画片段，骨骼贴图仍由各模型自行绑定。
+ */
+struct BakedCrowdClip {
+    uint32_t frameCount{0};
+    float sample{60.F};
+    bool loop{true};
+    // skeleton bounds of each frame, shared by every model playing the clip
+    ccstd::vector<ccstd::optional<geometry::AABB>> boundsInfo;
+};
+
+/**
+ * @en Models farther than distance from the view only advance their animation every frameInterval frames.
+ * @zh 与视点距离超过 distance 的模型每 frameInterval 帧才推进一次动画。
+ */
+struct BakedCrowdLOD {
+    float distance{0.F};
+    uint32_t frameInterval{1};
+};
+
+/**
+ * @en Drives the baked animation of many [[BakedSkinningModel]]s. Models playing the same clip at the same
+ * quantized frame share the cc_jointAnimInfo uniform buffer and the skeleton bounds of that frame, so the per model
+ * work of a frame is advancing a time and, when the frame changes, rebinding the model to the shared frame.
+ * Animation of distant models is evaluated less often according to the LOD levels.
+ * @zh 驱动大量烘焙动画模型。播放同一片段同一量化帧的模型共享帧数据与包围盒，远处的模型按 LOD 降低动画更新频率。
+ */
+class BakedAnimationCrowd final : public RefCounted {
+public:
+    BakedAnimationCrowd() = default;
+    ~BakedAnimationCrowd() override;
+
+    index_t addClip(const BakedCrowdClip &clip);
+
+    /**
+     * @en LOD levels sorted by ascending distance, models nearer than the first level update every frame.
+     * @zh 按距离升序排列的 LOD 级别。
+     */
+    void setLODLevels(const ccstd::vector<BakedCrowdLOD> &levels);
+    inline const ccstd::vector<BakedCrowdLOD> &getLODLevels() const { return _lodLevels; }
+
+    void addModel(BakedSkinningModel *model, index_t clip, float time);
+    void removeModel(BakedSkinningModel *model);
+    void play(BakedSkinningModel *model, index_t clip, float time);
+
+    inline uint32_t getModelCount() const { return static_cast<uint32_t>(_agents.size()); }
+    // uniform buffers created so far, at most one per clip frame
+    inline uint32_t getFrameBufferCount() const { return _frameBufferCount; }
+
+    /**
+     * @en Advances all models, should be called once per frame before the render scene is updated.
+     * @zh 推进所有模型的动画，应在每帧更新渲染场景前调用一次。
+     * @param viewPosition World position the LOD distances are measured from, usually the main camera.
+     */
+    void update(float dt, const Vec3 &viewPosition);
+
+    void clear();
+
+private:
+    struct ClipState {
+        BakedCrowdClip clip;
+        // cc_jointAnimInfo of every frame, 4 floats per frame with the frame id in x
+        ccstd::vector<float> frames;
+        // the same data in a uniform buffer per frame, created when a model first reaches the frame
+        ccstd::vector<IntrusivePtr<gfx::Buffer>> buffers;
+    };
+    // models point into frames and boundsInfo, whose storage has to survive the growth of _clips
+    static_assert(std::is_nothrow_move_constructible<ClipState>::value, "ClipState must be moved on reallocation");
+
+    struct Agent {
+        BakedSkinningModel *model{nullptr};
+        index_t clip{0};
+        float time{0.F};
+        uint32_t frame{0};
+        // 0 when nearer than every LOD level, otherwise 1 + index of the farthest level reached
+        uint32_t lod{0};
+        // spreads the updates of models in the same LOD level over frames
+        uint32_t phase{0};
+    };
+
+    uint32_t evaluateFrame(const ClipState &state, float time) const;
+    uint32_t evaluateLOD(const Agent &agent, const Vec3 &viewPosition) const;
+    void applyFrame(Agent &agent, uint32_t frame);
+    gfx::Buffer *getFrameBuffer(ClipState &state, uint32_t frame);
+
+    ccstd::vector<ClipState> _clips;
+    ccstd::vector<BakedCrowdLOD> _lodLevels;
+    ccstd::vector<Agent> _agents;
+    ccstd::unordered_map<BakedSkinningModel *, uint32_t> _agentIndices;
+    uint32_t _frameCounter{0};
+    uint32_t _frameBufferCount{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(BakedAnimationCrowd);
+};
+
+} // namespace cc
@@ -30,10 +30,12 @@
 #include <mutex>
 #include <thread>
 #include "base/Log.h"
+#include "base/StringUtil.h"
 #include "base/Utils.h"
 #include "base/memory/Memory.h"
 #include "base/std/container/queue.h"
 #include "platform/FileUtils.h"
+#include "profiler/Profiler.h"
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
     #include "audio/android/AudioEngine-inl.h"
@@ -90,7 +92,8 @@ class AudioEngine::AudioEngineThreadPool {
 public:
     explicit AudioEngineThreadPool(int threads = 4) {
         for (int index = 0; index < threads; ++index) {
-            _workers.emplace_back(std::thread([this]() {
+            _workers.emplace_back(std::thread([this, index]() {
+                CC_PROFILER_SET_THREAD_NAME(StringUtil::format("AudioThread %d", index));
                 threadFunc();
             }));
         }
@@ -32,6 +32,7 @@
 #include "audio/apple/AudioPlayer.h"
 #include "base/memory/Memory.h"
 #include "platform/FileUtils.h"
+#include "profiler/Profiler.h"
 
 #ifdef VERY_VERY_VERBOSE_LOGGING
     #define ALOGVV ALOGV
@@ -235,6 +236,7 @@ bool AudioPlayer::play2d() {
 
 // rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
 void AudioPlayer::rotateBufferThread(int offsetFrame) {
+    CC_PROFILER_SET_THREAD_NAME("AudioStream");
     char *tmpBuffer = nullptr;
     AudioDecoder decoder;
     long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
@@ -34,6 +34,7 @@
 #include "audio/oalsoft/AudioCache.h"
 #include "base/Log.h"
 #include "base/memory/Memory.h"
+#include "profiler/Profiler.h"
 
 using namespace cc; //NOLINT
 
@@ -219,6 +220,7 @@ bool AudioPlayer::play2d() {
 }
 
 void AudioPlayer::rotateBufferThread(int offsetFrame) {
+    CC_PROFILER_SET_THREAD_NAME("AudioStream");
     char *tmpBuffer = nullptr;
     AudioDecoder *decoder = AudioDecoderManager::createDecoder(_audioCache->_fileFullPath.c_str());
     do {
@@ -65,6 +65,21 @@
     #define USE_MEMORY_LEAK_DETECTOR 0
 #endif
 
+// tags CC_MALLOC allocations with the subsystem that made them, see base/memory/MemoryTag.h
+#ifndef CC_USE_MEMORY_TAGGING
+    #define CC_USE_MEMORY_TAGGING 1
+#endif
+
+// also tags ccnew and every other new of the process by replacing the global operator new and delete, for debugging only
+#ifndef CC_USE_MEMORY_TAGGING_NEW
+    #define CC_USE_MEMORY_TAGGING_NEW 0
+#endif
+
 #ifndef CC_USE_PROFILER
     #define CC_USE_PROFILER 0
 #endif
+
+// the profiler dumps the last frames to the writable path whenever a frame takes longer than this many milliseconds, 0 turns it off
+#ifndef CC_PROFILER_HITCH_THRESHOLD_MS
+    #define CC_PROFILER_HITCH_THRESHOLD_MS 0
+#endif
@@ -24,8 +24,12 @@
 ****************************************************************************/
 
 #include "TFJobSystem.h"
+#include <atomic>
+#include <chrono>
 #include "TFJobGraph.h"
 #include "base/Log.h"
+#include "base/StringUtil.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 
@@ -33,7 +37,29 @@ TFJobSystem *TFJobSystem::_instance = nullptr;
 
 TFJobSystem::TFJobSystem(uint32_t threadCount) noexcept
 : _executor(threadCount) {
+#if CC_USE_PROFILER
+    nameWorkers();
+#endif
     CC_LOG_INFO("Taskflow Job system initialized: %d worker threads", threadCount);
 }
 
+void TFJobSystem::nameWorkers() noexcept {
+    // taskflow gives no hook where its workers start, so each worker is handed one task
+    // that holds it until every task started, with a deadline in case a worker never wakes up
+    const uint32_t count = threadCount();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    std::atomic<uint32_t> started{0U};
+    tf::Taskflow flow;
+    for (uint32_t i = 0; i < count; ++i) {
+        flow.emplace([&started, count, deadline]() {
+            const uint32_t index = started.fetch_add(1U);
+            CC_PROFILER_SET_THREAD_NAME(StringUtil::format("JobThread %u", index));
+            while (started.load() < count && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    _executor.run(flow).wait();
+}
+
 } // namespace cc
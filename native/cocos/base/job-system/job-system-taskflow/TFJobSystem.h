@@ -53,6 +53,9 @@ public:
 private:
     friend class TFJobGraph;
 
+    // names the worker threads in profiler captures
+    void nameWorkers() noexcept;
+
     static TFJobSystem *_instance;
 
     tf::Executor _executor;
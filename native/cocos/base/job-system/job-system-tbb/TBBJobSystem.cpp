@@ -24,6 +24,8 @@
 ****************************************************************************/
 
 #include "base/Log.h"
+#include "base/StringUtil.h"
+#include "profiler/Profiler.h"
 
 #include "TBBJobGraph.h"
 #include "TBBJobSystem.h"
@@ -38,4 +40,10 @@ TBBJobSystem::TBBJobSystem(uint32_t threadCount) noexcept
     CC_LOG_INFO("TBB Job system initialized: %d worker threads", threadCount);
 }
 
+void TBBJobSystem::WorkerObserver::on_scheduler_entry(bool isWorker) {
+    if (isWorker) {
+        CC_PROFILER_SET_THREAD_NAME(StringUtil::format("JobThread %u", _workerCount.fetch_add(1u)));
+    }
+}
+
 } // namespace cc
@@ -27,8 +27,10 @@
 
 #include <algorithm>
 #include <thread>
+#include <atomic>
 #include "base/memory/Memory.h"
 #include "tbb/global_control.h"
+#include "tbb/task_scheduler_observer.h"
 
 namespace cc {
 
@@ -53,10 +55,23 @@ public:
     inline uint32_t threadCount() { return _threadCount; }
 
 private:
+    // names the worker threads in profiler captures as they join the scheduler
+    class WorkerObserver final : public tbb::task_scheduler_observer {
+    public:
+        WorkerObserver() { observe(true); }
+        ~WorkerObserver() override { observe(false); }
+
+        void on_scheduler_entry(bool isWorker) override;
+
+    private:
+        std::atomic<uint32_t> _workerCount{0u};
+    };
+
     static TBBJobSystem *_instance;
 
     tbb::global_control _control;
     uint32_t _threadCount{0u};
+    WorkerObserver _observer;
 };
 
 } // namespace cc
@@ -37,7 +37,9 @@
 
 #include <new> // std::nothrow
 
+#include "base/Config.h"
 #include "base/Macros.h"
+#include "base/memory/MemoryTag.h"
 
 namespace cc {
 class MemoryAllocDealloc final {
@@ -79,11 +81,20 @@ public:
         (ptr) = nullptr;          \
     }
 
-#define CC_MALLOC(bytes)              malloc(bytes)
-#define CC_MALLOC_ALIGN(bytes, align) ::cc::MemoryAllocDealloc::allocateBytesAligned(align, bytes)
-#define CC_REALLOC(ptr, bytes)        realloc(ptr, bytes)
-#define CC_FREE(ptr)                  free((void *)ptr)
-#define CC_FREE_ALIGN(ptr)            ::cc::MemoryAllocDealloc::deallocateBytesAligned(ptr)
+#if CC_USE_MEMORY_TAGGING
+    // accounted to the current CC_MEMORY_TAG_SCOPE, see MemoryTracker
+    #define CC_MALLOC(bytes)              ::cc::MemoryTracker::allocate(bytes)
+    #define CC_MALLOC_ALIGN(bytes, align) ::cc::MemoryTracker::allocateAligned(align, bytes)
+    #define CC_REALLOC(ptr, bytes)        ::cc::MemoryTracker::reallocate(ptr, bytes)
+    #define CC_FREE(ptr)                  ::cc::MemoryTracker::deallocate((void *)ptr)
+    #define CC_FREE_ALIGN(ptr)            ::cc::MemoryTracker::deallocateAligned(ptr)
+#else
+    #define CC_MALLOC(bytes)              malloc(bytes)
+    #define CC_MALLOC_ALIGN(bytes, align) ::cc::MemoryAllocDealloc::allocateBytesAligned(align, bytes)
+    #define CC_REALLOC(ptr, bytes)        realloc(ptr, bytes)
+    #define CC_FREE(ptr)                  free((void *)ptr)
+    #define CC_FREE_ALIGN(ptr)            ::cc::MemoryAllocDealloc::deallocateBytesAligned(ptr)
+#endif
 
 #define CC_SAFE_FREE(ptr) \
     if (ptr) {            \
@@ -0,0 +1,339 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "MemoryTag.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include "base/memory/Memory.h"
+
+namespace cc {
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+
+// on their own cache lines so that subsystems allocating on different threads don't contend
+struct alignas(64) TagCounter {
+    std::atomic<uint64_t> bytes{0U};
+    std::atomic<uint32_t> count{0U};
+};
+
+// constant initialized, CC_MALLOC may run before any dynamic initializer
+TagCounter counters[TAG_COUNT];
+
+thread_local MemoryTag currentTag{MemoryTag::UNTAGGED};
+
+const char *const TAG_NAMES[TAG_COUNT] = {
+    "untagged",
+    "gfx",
+    "scene",
+    "assets",
+    "spine",
+    "dragonbones",
+    "audio",
+    "bindings",
+};
+
+// a live tracked allocation, keyed by its address
+struct Slot {
+    uintptr_t key;
+    uint64_t bytes;
+    MemoryTag tag;
+};
+
+constexpr uintptr_t EMPTY_KEY = 0U;
+constexpr uintptr_t ERASED_KEY = 1U;
+constexpr uint32_t MIN_SLOT_COUNT = 64U;
+constexpr uint32_t SHARD_BITS = 6U;
+constexpr uint32_t SHARD_COUNT = 1U << SHARD_BITS;
+
+// Tracked allocations are found by address rather than by anything stored in the block,
+// so memory the tracker did not allocate is never taken for tracked memory, whatever it contains.
+// Open addressing with linear probing, at most half full. The slots come from malloc,
+// so the table never recurses into operator new when that is tracked as well.
+struct alignas(64) Shard {
+    std::mutex mutex;
+    Slot *slots{nullptr};
+    uint32_t mask{0U}; // slot count - 1
+    uint32_t used{0U}; // live and erased slots
+    uint32_t live{0U};
+};
+
+Shard shards[SHARD_COUNT];
+
+inline uint32_t hashKey(uintptr_t key) {
+    // malloc results are at least 8 byte aligned, the low bits carry no information
+    return static_cast<uint32_t>((static_cast<uint64_t>(key >> 3U) * 0x9E3779B97F4A7C15ULL) >> 32U);
+}
+
+inline Shard &getShard(uint32_t hash) {
+    return shards[hash >> (32U - SHARD_BITS)];
+}
+
+Slot *findSlot(const Shard &shard, uintptr_t key, uint32_t hash) {
+    if (!shard.slots) return nullptr;
+    for (uint32_t i = hash & shard.mask;; i = (i + 1) & shard.mask) {
+        Slot &slot = shard.slots[i];
+        if (slot.key == key) return &slot;
+        if (slot.key == EMPTY_KEY) return nullptr;
+    }
+}
+
+bool rehash(Shard &shard) {
+    uint32_t slotCount = MIN_SLOT_COUNT;
+    while (slotCount < (shard.live + 1) * 4) {
+        slotCount <<= 1U;
+    }
+    auto *slots = static_cast<Slot *>(malloc(sizeof(Slot) * slotCount));
+    if (!slots) return false;
+    memset(slots, 0, sizeof(Slot) * slotCount);
+
+    const uint32_t mask = slotCount - 1;
+    for (uint32_t i = 0; shard.slots && i <= shard.mask; ++i) {
+        const Slot &slot = shard.slots[i];
+        if (slot.key == EMPTY_KEY || slot.key == ERASED_KEY) continue;
+        uint32_t j = hashKey(slot.key) & mask;
+        while (slots[j].key != EMPTY_KEY) {
+            j = (j + 1) & mask;
+        }
+        slots[j] = slot;
+    }
+    free(shard.slots);
+    shard.slots = slots;
+    shard.mask = mask;
+    shard.used = shard.live;
+    return true;
+}
+
+inline void addBytes(MemoryTag tag, uint64_t bytes, uint32_t count) {
+    auto &counter = counters[static_cast<size_t>(tag)];
+    counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    counter.count.fetch_add(count, std::memory_order_relaxed);
+}
+
+inline void subBytes(MemoryTag tag, uint64_t bytes, uint32_t count) {
+    auto &counter = counters[static_cast<size_t>(tag)];
+    counter.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counter.count.fetch_sub(count, std::memory_order_relaxed);
+}
+
+// false if the table could not grow, the allocation then stays untracked
+bool insert(void *ptr, uint64_t bytes, MemoryTag tag) {
+    const auto key = reinterpret_cast<uintptr_t>(ptr);
+    const uint32_t hash = hashKey(key);
+    Shard &shard = getShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (Slot *slot = findSlot(shard, key, hash)) {
+        // a tracked block released with free() whose address came back, it is gone from its tag now
+        subBytes(slot->tag, slot->bytes, 1U);
+        *slot = {key, bytes, tag};
+        return true;
+    }
+    if (!shard.slots || (shard.used + 1) * 2 > shard.mask + 1) {
+        if (!rehash(shard)) return false;
+    }
+    uint32_t i = hash & shard.mask;
+    while (shard.slots[i].key != EMPTY_KEY && shard.slots[i].key != ERASED_KEY) {
+        i = (i + 1) & shard.mask;
+    }
+    if (shard.slots[i].key == EMPTY_KEY) ++shard.used;
+    ++shard.live;
+    shard.slots[i] = {key, bytes, tag};
+    return true;
+}
+
+// false for memory the tracker did not allocate, e.g. from a plain malloc handed to CC_FREE
+bool erase(void *ptr, uint64_t *bytes, MemoryTag *tag) {
+    const auto key = reinterpret_cast<uintptr_t>(ptr);
+    const uint32_t hash = hashKey(key);
+    Shard &shard = getShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    Slot *slot = findSlot(shard, key, hash);
+    if (!slot) return false;
+    *bytes = slot->bytes;
+    *tag = slot->tag;
+    slot->key = ERASED_KEY;
+    --shard.live;
+    return true;
+}
+
+inline void *track(void *ptr, size_t bytes) {
+    const MemoryTag tag = currentTag;
+    if (insert(ptr, bytes, tag)) {
+        addBytes(tag, bytes, 1U);
+    }
+    return ptr;
+}
+
+// has to run before the block is freed, its address may be handed out again right after
+inline void untrack(void *ptr) {
+    uint64_t bytes = 0U;
+    MemoryTag tag{MemoryTag::UNTAGGED};
+    if (erase(ptr, &bytes, &tag)) {
+        subBytes(tag, bytes, 1U);
+    }
+}
+
+} // namespace
+
+void *MemoryTracker::allocate(size_t bytes) {
+    void *ptr = malloc(bytes);
+    if (!ptr) return nullptr;
+    return track(ptr, bytes);
+}
+
+void *MemoryTracker::reallocate(void *ptr, size_t bytes) {
+    if (!ptr) return allocate(bytes);
+    if (!bytes) {
+        deallocate(ptr);
+        return nullptr;
+    }
+
+    uint64_t oldBytes = 0U;
+    MemoryTag tag{MemoryTag::UNTAGGED};
+    // untracked memory stays untracked
+    if (!erase(ptr, &oldBytes, &tag)) return realloc(ptr, bytes);
+
+    // the old address is out of the table before realloc may release it to other threads
+    void *newPtr = realloc(ptr, bytes);
+    if (!newPtr) {
+        // the old block is left untouched
+        if (!insert(ptr, oldBytes, tag)) subBytes(tag, oldBytes, 1U);
+        return nullptr;
+    }
+    // the allocation stays with the tag it was made with, unsigned wrap-around takes care of shrinking
+    if (insert(newPtr, bytes, tag)) {
+        addBytes(tag, static_cast<uint64_t>(bytes) - oldBytes, 0U);
+    } else {
+        subBytes(tag, oldBytes, 1U);
+    }
+    return newPtr;
+}
+
+void MemoryTracker::deallocate(void *ptr) {
+    if (!ptr) return;
+    untrack(ptr);
+    free(ptr);
+}
+
+void *MemoryTracker::allocateAligned(size_t alignment, size_t bytes) {
+    void *ptr = MemoryAllocDealloc::allocateBytesAligned(alignment, bytes);
+    if (!ptr) return nullptr;
+    return track(ptr, bytes);
+}
+
+void MemoryTracker::deallocateAligned(void *ptr) {
+    if (!ptr) return;
+    untrack(ptr);
+    MemoryAllocDealloc::deallocateBytesAligned(ptr);
+}
+
+MemoryTag MemoryTracker::getTag(void *ptr) {
+    if (!ptr) return MemoryTag::UNTAGGED;
+    const auto key = reinterpret_cast<uintptr_t>(ptr);
+    const uint32_t hash = hashKey(key);
+    Shard &shard = getShard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const Slot *slot = findSlot(shard, key, hash);
+    return slot ? slot->tag : MemoryTag::UNTAGGED;
+}
+
+MemoryTag MemoryTracker::getCurrentTag() {
+    return currentTag;
+}
+
+MemoryTag MemoryTracker::exchangeCurrentTag(MemoryTag tag) {
+    const MemoryTag previous = currentTag;
+    currentTag = tag;
+    return previous;
+}
+
+uint64_t MemoryTracker::getBytes(MemoryTag tag) {
+    return counters[static_cast<size_t>(tag)].bytes.load(std::memory_order_relaxed);
+}
+
+uint32_t MemoryTracker::getCount(MemoryTag tag) {
+    return counters[static_cast<size_t>(tag)].count.load(std::memory_order_relaxed);
+}
+
+const char *MemoryTracker::getTagName(MemoryTag tag) {
+    return TAG_NAMES[static_cast<size_t>(tag)];
+}
+
+} // namespace cc
+
+#if CC_USE_MEMORY_TAGGING && CC_USE_MEMORY_TAGGING_NEW
+
+// Debugging aid: ccnew and every other new of the process, engine or not, are accounted to the tag scope they run in.
+// The over-aligned overloads are left alone, they come in pairs with their own deletes.
+
+void *operator new(size_t bytes) {
+    void *ptr = cc::MemoryTracker::allocate(bytes ? bytes : 1U);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t bytes) {
+    return operator new(bytes);
+}
+
+void *operator new(size_t bytes, const std::nothrow_t & /*tag*/) noexcept {
+    return cc::MemoryTracker::allocate(bytes ? bytes : 1U);
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t & /*tag*/) noexcept {
+    return cc::MemoryTracker::allocate(bytes ? bytes : 1U);
+}
+
+void operator delete(void *ptr) noexcept {
+    cc::MemoryTracker::deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    cc::MemoryTracker::deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t /*bytes*/) noexcept {
+    cc::MemoryTracker::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t /*bytes*/) noexcept {
+    cc::MemoryTracker::deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+    cc::MemoryTracker::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+    cc::MemoryTracker::deallocate(ptr);
+}
+
+#endif
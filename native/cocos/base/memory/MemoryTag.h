@@ -0,0 +1,100 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "base/Config.h"
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * The subsystem a CC_MALLOC allocation is accounted to.
+ * An allocation keeps the tag it was made with, whichever thread frees or reallocates it later.
+ */
+enum class MemoryTag : uint8_t {
+    UNTAGGED,
+    GFX,
+    SCENE,
+    ASSETS,
+    SPINE,
+    DRAGONBONES,
+    AUDIO,
+    BINDINGS,
+    COUNT,
+};
+
+/**
+ * Per-tag live byte and allocation counters behind CC_MALLOC, CC_REALLOC, CC_FREE and their aligned variants.
+ * Live allocations are kept in a table keyed by address, sharded by address so that threads rarely share a lock.
+ * Memory from malloc handed to CC_FREE is not in the table and released without touching any counter,
+ * memory from CC_MALLOC handed to free() stays counted until its address comes back to CC_MALLOC or CC_FREE.
+ * Enabled by CC_USE_MEMORY_TAGGING. ccnew and new are only accounted with CC_USE_MEMORY_TAGGING_NEW,
+ * a debugging option that replaces the global operator new and delete of the whole process.
+ */
+class CC_DLL MemoryTracker final {
+public:
+    static void *allocate(size_t bytes);
+    static void *reallocate(void *ptr, size_t bytes);
+    static void deallocate(void *ptr);
+    static void *allocateAligned(size_t alignment, size_t bytes);
+    static void deallocateAligned(void *ptr);
+
+    // the tag a live tracked allocation is accounted to, UNTAGGED for memory the tracker did not allocate
+    static MemoryTag getTag(void *ptr);
+
+    // the tag new allocations of the calling thread are accounted to
+    static MemoryTag getCurrentTag();
+    // returns the previous tag of the calling thread
+    static MemoryTag exchangeCurrentTag(MemoryTag tag);
+
+    static uint64_t getBytes(MemoryTag tag);
+    static uint32_t getCount(MemoryTag tag);
+    static const char *getTagName(MemoryTag tag);
+};
+
+class MemoryTagScope final {
+public:
+    explicit MemoryTagScope(MemoryTag tag) : _previous(MemoryTracker::exchangeCurrentTag(tag)) {}
+    ~MemoryTagScope() { MemoryTracker::exchangeCurrentTag(_previous); }
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope(MemoryTagScope &&) = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(MemoryTagScope &&) = delete;
+
+private:
+    MemoryTag _previous{MemoryTag::UNTAGGED};
+};
+
+} // namespace cc
+
+#if CC_USE_MEMORY_TAGGING
+    // accounts the CC_MALLOC allocations the current thread makes until the end of the enclosing scope to the tag
+    #define CC_MEMORY_TAG_SCOPE(tag) ::cc::MemoryTagScope memory_tag_scope_##tag(::cc::MemoryTag::tag)
+#else
+    #define CC_MEMORY_TAG_SCOPE(tag)
+#endif
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "MessageQueue.h"
+#include <chrono>
 #include "AutoReleasePool.h"
 #include "base/Utils.h"
 
@@ -242,7 +243,9 @@ Message *MessageQueue::readMessage() noexcept {
         pullMessages();        // try pulling data from consumer
 
         if (!hasNewMessage()) { // still empty
+            auto const idleBegin = std::chrono::steady_clock::now();
             _event.wait();      // wait for the producer to wake me up
+            _reader.idleTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - idleBegin).count();
             pullMessages();     // pulling again
         }
     }
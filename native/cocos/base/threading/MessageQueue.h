@@ -87,6 +87,7 @@ struct ALIGNAS(64) ReaderContext final {
     uint32_t newMessageCount{0};
     bool terminateConsumerThread{false};
     bool flushingFinished{false};
+    uint64_t idleTime{0}; // in nanoseconds, accumulated while waiting for the producer
 };
 
 // A single-producer single-consumer circular buffer queue.
@@ -129,6 +130,10 @@ public:
 
     inline bool isImmediateMode() const noexcept { return _immediateMode; }
 
+    // total time the consumer spent waiting for new messages, in nanoseconds
+    // should only be queried on the consumer thread
+    inline uint64_t getConsumerIdleTime() const noexcept { return _reader.idleTime; }
+
     void recycleMemoryChunk(uint8_t *chunk) const noexcept;
     static void freeChunksInFreeQueue(MessageQueue *mainMessageQueue) noexcept;
 
@@ -127,6 +127,14 @@
 #define cc_RenderEntity_stencilStage_set(self_, val_) self_->setStencilStage(val_)
   
 
+#define cc_Batcher2d_incrementalEnabled_get(self_) self_->isIncrementalEnabled()
+#define cc_Batcher2d_incrementalEnabled_set(self_, val_) self_->setIncrementalEnabled(val_)
+  
+
+#define cc_Batcher2d_reorderEnabled_get(self_) self_->isReorderEnabled()
+#define cc_Batcher2d_reorderEnabled_set(self_, val_) self_->setReorderEnabled(val_)
+  
+
 
 se::Class* __jsb_cc_MeshBufferLayout_class = nullptr;
 se::Object* __jsb_cc_MeshBufferLayout_proto = nullptr;
@@ -4152,9 +4160,112 @@ static bool js_cc_Batcher2d_handlePostRender(se::State& s)
 }
 SE_BIND_FUNC(js_cc_Batcher2d_handlePostRender) 
 
+static bool js_cc_Batcher2d_getReorderStats(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::Batcher2d *arg1 = (cc::Batcher2d *) NULL ;
+    cc::Batcher2dReorderStats *result = 0 ;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::Batcher2d>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (cc::Batcher2dReorderStats *) &((cc::Batcher2d const *)arg1)->getReorderStats();
+    // %typemap(out) SWIGTYPE&
+    ok &= nativevalue_to_se(*result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "Batcher2d_getReorderStats, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(*result, s.thisObject(), s.rval()); 
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_Batcher2d_getReorderStats) 
+
+static bool js_cc_Batcher2d_incrementalEnabled_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::Batcher2d *arg1 = (cc::Batcher2d *) NULL ;
+    bool arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::Batcher2d>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) bool
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Batcher2d_incrementalEnabled_set,2,SWIGTYPE_bool"); 
+    cc_Batcher2d_incrementalEnabled_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_Batcher2d_incrementalEnabled_set) 
+
+static bool js_cc_Batcher2d_incrementalEnabled_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::Batcher2d *arg1 = (cc::Batcher2d *) NULL ;
+    bool result;
+    
+    arg1 = SE_THIS_OBJECT<cc::Batcher2d>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (bool)cc_Batcher2d_incrementalEnabled_get(arg1);
+    // out 5
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_Batcher2d_incrementalEnabled_get) 
+
+static bool js_cc_Batcher2d_reorderEnabled_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::Batcher2d *arg1 = (cc::Batcher2d *) NULL ;
+    bool arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::Batcher2d>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) bool
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Batcher2d_reorderEnabled_set,2,SWIGTYPE_bool"); 
+    cc_Batcher2d_reorderEnabled_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_Batcher2d_reorderEnabled_set) 
+
+static bool js_cc_Batcher2d_reorderEnabled_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::Batcher2d *arg1 = (cc::Batcher2d *) NULL ;
+    bool result;
+    
+    arg1 = SE_THIS_OBJECT<cc::Batcher2d>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (bool)cc_Batcher2d_reorderEnabled_get(arg1);
+    // out 5
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_Batcher2d_reorderEnabled_get) 
+
 bool js_register_cc_Batcher2d(se::Object* obj) {
     auto* cls = se::Class::create("Batcher2d", obj, nullptr, _SE(js_new_Batcher2d)); 
     
+    cls->defineProperty("incrementalEnabled", _SE(js_cc_Batcher2d_incrementalEnabled_get), _SE(js_cc_Batcher2d_incrementalEnabled_set)); 
+    cls->defineProperty("reorderEnabled", _SE(js_cc_Batcher2d_reorderEnabled_get), _SE(js_cc_Batcher2d_reorderEnabled_set)); 
     
     cls->defineFunction("syncMeshBuffersToNative", _SE(js_cc_Batcher2d_syncMeshBuffersToNative)); 
     cls->defineFunction("initialize", _SE(js_cc_Batcher2d_initialize)); 
@@ -4165,6 +4276,7 @@ bool js_register_cc_Batcher2d(se::Object* obj) {
     cls->defineFunction("releaseDescriptorSetCache", _SE(js_cc_Batcher2d_releaseDescriptorSetCache)); 
     cls->defineFunction("getDefaultAttribute", _SE(js_cc_Batcher2d_getDefaultAttribute)); 
     cls->defineFunction("handlePostRender", _SE(js_cc_Batcher2d_handlePostRender)); 
+    cls->defineFunction("getReorderStats", _SE(js_cc_Batcher2d_getReorderStats)); 
     
     
     
@@ -14797,6 +14797,214 @@ bool js_register_cc_pipeline_BatchedBuffer(se::Object* obj) {
     return true;
 }
 
+
+se::Class* __jsb_cc_pipeline_PersistentPipelineCache_class = nullptr;
+se::Object* __jsb_cc_pipeline_PersistentPipelineCache_proto = nullptr;
+SE_DECLARE_FINALIZE_FUNC(js_delete_cc_pipeline_PersistentPipelineCache) 
+
+static bool js_cc_pipeline_PersistentPipelineCache_getInstance_static(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::PersistentPipelineCache *result = 0 ;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    result = (cc::pipeline::PersistentPipelineCache *)cc::pipeline::PersistentPipelineCache::getInstance();
+    // %typemap(out) SWIGTYPE*
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "PersistentPipelineCache_getInstance, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval()); 
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_PersistentPipelineCache_getInstance_static) 
+
+static bool js_cc_pipeline_PersistentPipelineCache_warmUp__SWIG_0(se::State& s)
+{
+    // js_overloaded_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    cc::pipeline::PersistentPipelineCache *arg1 = (cc::pipeline::PersistentPipelineCache *) NULL ;
+    uint32_t arg2 ;
+    uint32_t result;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::PersistentPipelineCache>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    
+    // %typemap(in) SWIGTYPE value in
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "PersistentPipelineCache_warmUp,2,SWIGTYPE_uint32_t"); 
+    
+    result = (arg1)->warmUp(arg2);
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "PersistentPipelineCache_warmUp, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+
+static bool js_cc_pipeline_PersistentPipelineCache_warmUp__SWIG_1(se::State& s)
+{
+    // js_overloaded_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    cc::pipeline::PersistentPipelineCache *arg1 = (cc::pipeline::PersistentPipelineCache *) NULL ;
+    uint32_t result;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::PersistentPipelineCache>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (arg1)->warmUp();
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "PersistentPipelineCache_warmUp, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+
+static bool js_cc_pipeline_PersistentPipelineCache_warmUp(se::State& s)
+{
+    // js_function_dispatcher
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    // js_function_dispatch_case
+    if (argc == 1) {
+        ok = js_cc_pipeline_PersistentPipelineCache_warmUp__SWIG_0(s);
+        if (ok) {
+            return true; 
+        }
+    } // js_function_dispatch_case
+    if (argc == 0) {
+        ok = js_cc_pipeline_PersistentPipelineCache_warmUp__SWIG_1(s);
+        if (ok) {
+            return true; 
+        }
+    } 
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_FUNC(js_cc_pipeline_PersistentPipelineCache_warmUp) 
+
+static bool js_cc_pipeline_PersistentPipelineCache_getPendingWarmUpCount(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::PersistentPipelineCache *arg1 = (cc::pipeline::PersistentPipelineCache *) NULL ;
+    uint32_t result;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::pipeline::PersistentPipelineCache>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = ((cc::pipeline::PersistentPipelineCache const *)arg1)->getPendingWarmUpCount();
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "PersistentPipelineCache_getPendingWarmUpCount, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_PersistentPipelineCache_getPendingWarmUpCount) 
+
+static bool js_cc_pipeline_PersistentPipelineCache_getStats(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::PersistentPipelineCache *arg1 = (cc::pipeline::PersistentPipelineCache *) NULL ;
+    cc::pipeline::PipelineCacheStats result;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::pipeline::PersistentPipelineCache>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = ((cc::pipeline::PersistentPipelineCache const *)arg1)->getStats();
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "PersistentPipelineCache_getStats, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_PersistentPipelineCache_getStats) 
+
+// js_ctor
+static bool js_new_cc_pipeline_PersistentPipelineCache(se::State& s) // NOLINT(readability-identifier-naming)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    cc::pipeline::PersistentPipelineCache *result;
+    result = (cc::pipeline::PersistentPipelineCache *)new cc::pipeline::PersistentPipelineCache();
+    
+    
+    auto *ptr = JSB_MAKE_PRIVATE_OBJECT_WITH_INSTANCE(result);
+    s.thisObject()->setPrivateObject(ptr);
+    return true;
+}
+SE_BIND_CTOR(js_new_cc_pipeline_PersistentPipelineCache, __jsb_cc_pipeline_PersistentPipelineCache_class, js_delete_cc_pipeline_PersistentPipelineCache)
+
+static bool js_delete_cc_pipeline_PersistentPipelineCache(se::State& s)
+{
+    // js_dtoroverride
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_delete_cc_pipeline_PersistentPipelineCache) 
+
+bool js_register_cc_pipeline_PersistentPipelineCache(se::Object* obj) {
+    auto* cls = se::Class::create("PersistentPipelineCache", obj, nullptr, _SE(js_new_cc_pipeline_PersistentPipelineCache)); 
+    
+    
+    cls->defineFunction("warmUp", _SE(js_cc_pipeline_PersistentPipelineCache_warmUp)); 
+    cls->defineFunction("getPendingWarmUpCount", _SE(js_cc_pipeline_PersistentPipelineCache_getPendingWarmUpCount)); 
+    cls->defineFunction("getStats", _SE(js_cc_pipeline_PersistentPipelineCache_getStats)); 
+    
+    
+    cls->defineStaticFunction("getInstance", _SE(js_cc_pipeline_PersistentPipelineCache_getInstance_static)); 
+    
+    
+    cls->defineFinalizeFunction(_SE(js_delete_cc_pipeline_PersistentPipelineCache));
+    
+    
+    cls->install();
+    JSBClassType::registerClass<cc::pipeline::PersistentPipelineCache>(cls);
+    
+    __jsb_cc_pipeline_PersistentPipelineCache_proto = cls->getProto();
+    __jsb_cc_pipeline_PersistentPipelineCache_class = cls;
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
 #if CC_USE_GEOMETRY_RENDERER
 
 se::Class* __jsb_cc_pipeline_GeometryRenderer_class = nullptr;
@@ -21558,6 +21766,7 @@ bool register_all_pipeline(se::Object* obj) {
     js_register_cc_pipeline_PipelineSceneData(ns); 
     js_register_cc_pipeline_BatchedItem(ns); 
     js_register_cc_pipeline_BatchedBuffer(ns); 
+    js_register_cc_pipeline_PersistentPipelineCache(ns); 
 #if CC_USE_GEOMETRY_RENDERER
     js_register_cc_pipeline_GeometryRenderer(ns); 
 #endif // CC_USE_GEOMETRY_RENDERER
@@ -54,6 +54,7 @@
 #include "renderer/pipeline/deferred/PostProcessStage.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/BatchedBuffer.h"
+#include "renderer/pipeline/PersistentPipelineCache.h"
 #include "renderer/pipeline/GeometryRenderer.h"
 
 
@@ -566,6 +567,11 @@ JSB_REGISTER_OBJECT_TYPE(cc::pipeline::BatchedBuffer);
 extern se::Object *__jsb_cc_pipeline_BatchedBuffer_proto; // NOLINT
 extern se::Class * __jsb_cc_pipeline_BatchedBuffer_class; // NOLINT
 
+
+JSB_REGISTER_OBJECT_TYPE(cc::pipeline::PersistentPipelineCache);
+extern se::Object *__jsb_cc_pipeline_PersistentPipelineCache_proto; // NOLINT
+extern se::Class * __jsb_cc_pipeline_PersistentPipelineCache_class; // NOLINT
+
 #if CC_USE_GEOMETRY_RENDERER
 
 JSB_REGISTER_OBJECT_TYPE(cc::pipeline::GeometryRenderer);
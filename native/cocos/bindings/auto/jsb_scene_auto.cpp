@@ -1009,6 +1009,10 @@ using namespace cc;
 #define cc_Scene_autoReleaseAssets_set(self_, val_) self_->setAutoReleaseAssets(val_)
   
 
+#define cc_Scene_flattenedTransformEnabled_get(self_) self_->isFlattenedTransformEnabled()
+#define cc_Scene_flattenedTransformEnabled_set(self_, val_) self_->setFlattenedTransformEnabled(val_)
+  
+
 
 static bool js_cc_hasFlag__SWIG_1(se::State& s)
 {
@@ -4397,10 +4401,48 @@ static bool js_cc_Scene_autoReleaseAssets_get(se::State& s)
 }
 SE_BIND_PROP_GET(js_cc_Scene_autoReleaseAssets_get) 
 
+static bool js_cc_Scene_flattenedTransformEnabled_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::Scene *arg1 = (cc::Scene *) NULL ;
+    bool arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::Scene>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) bool
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Scene_flattenedTransformEnabled_set,2,SWIGTYPE_bool"); 
+    cc_Scene_flattenedTransformEnabled_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_Scene_flattenedTransformEnabled_set) 
+
+static bool js_cc_Scene_flattenedTransformEnabled_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::Scene *arg1 = (cc::Scene *) NULL ;
+    bool result;
+    
+    arg1 = SE_THIS_OBJECT<cc::Scene>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (bool)cc_Scene_flattenedTransformEnabled_get(arg1);
+    // out 5
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_Scene_flattenedTransformEnabled_get) 
+
 bool js_register_cc_Scene(se::Object* obj) {
     auto* cls = se::Class::create("Scene", obj, __jsb_cc_Node_proto, _SE(js_new_Scene)); 
     
     cls->defineProperty("autoReleaseAssets", _SE(js_cc_Scene_autoReleaseAssets_get), _SE(js_cc_Scene_autoReleaseAssets_set)); 
+    cls->defineProperty("flattenedTransformEnabled", _SE(js_cc_Scene_flattenedTransformEnabled_get), _SE(js_cc_Scene_flattenedTransformEnabled_set)); 
     
     cls->defineFunction("getRenderScene", _SE(js_cc_Scene_getRenderScene)); 
     cls->defineFunction("getSceneGlobals", _SE(js_cc_Scene_getSceneGlobals)); 
@@ -24356,6 +24398,718 @@ bool js_register_cc_BakedSkinningModel(se::Object* obj) {
 }
 
 
+se::Class* __jsb_cc_BakedCrowdClip_class = nullptr;
+se::Object* __jsb_cc_BakedCrowdClip_proto = nullptr;
+SE_DECLARE_FINALIZE_FUNC(js_delete_cc_BakedCrowdClip) 
+
+static bool js_cc_BakedCrowdClip_frameCount_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    
+    // %typemap(in) SWIGTYPE value in
+    ok &= sevalue_to_native(args[0], &arg1->frameCount, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedCrowdClip_frameCount_set,2,SWIGTYPE_uint32_t"); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_BakedCrowdClip_frameCount_set) 
+
+static bool js_cc_BakedCrowdClip_frameCount_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(arg1->frameCount, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "BakedCrowdClip_frameCount_get, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(arg1->frameCount, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_BakedCrowdClip_frameCount_get) 
+
+static bool js_cc_BakedCrowdClip_sample_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) int, short, long, signed char, float, double
+    ok &= sevalue_to_native(args[0], &arg1->sample, nullptr);
+    SE_PRECONDITION2(ok, false, "BakedCrowdClip_sample_set,2,SWIGTYPE_float"); 
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_BakedCrowdClip_sample_set) 
+
+static bool js_cc_BakedCrowdClip_sample_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // out 1
+    ok &= nativevalue_to_se(arg1->sample, s.rval(), s.thisObject() /*ctx*/); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_BakedCrowdClip_sample_get) 
+
+static bool js_cc_BakedCrowdClip_loop_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) bool
+    ok &= sevalue_to_native(args[0], &arg1->loop);
+    SE_PRECONDITION2(ok, false, "BakedCrowdClip_loop_set,2,SWIGTYPE_bool"); 
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_BakedCrowdClip_loop_set) 
+
+static bool js_cc_BakedCrowdClip_loop_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // out 5
+    ok &= nativevalue_to_se(arg1->loop, s.rval(), s.thisObject() /*ctx*/); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_BakedCrowdClip_loop_get) 
+
+static bool js_cc_BakedCrowdClip_boundsInfo_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    
+    // %typemap(in) SWIGTYPE value in
+    ok &= sevalue_to_native(args[0], &arg1->boundsInfo, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedCrowdClip_boundsInfo_set,2,SWIGTYPE_ccstd__vectorT_ccstd__optionalT_cc__geometry__AABB_t_t"); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_BakedCrowdClip_boundsInfo_set) 
+
+static bool js_cc_BakedCrowdClip_boundsInfo_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::BakedCrowdClip *arg1 = (cc::BakedCrowdClip *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdClip>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(arg1->boundsInfo, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "BakedCrowdClip_boundsInfo_get, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(arg1->boundsInfo, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_BakedCrowdClip_boundsInfo_get) 
+
+// js_ctor
+static bool js_new_cc_BakedCrowdClip(se::State& s) // NOLINT(readability-identifier-naming)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    cc::BakedCrowdClip *result;
+    result = (cc::BakedCrowdClip *)new cc::BakedCrowdClip();
+    
+    
+    auto *ptr = JSB_MAKE_PRIVATE_OBJECT_WITH_INSTANCE(result);
+    s.thisObject()->setPrivateObject(ptr);
+    return true;
+}
+SE_BIND_CTOR(js_new_cc_BakedCrowdClip, __jsb_cc_BakedCrowdClip_class, js_delete_cc_BakedCrowdClip)
+
+static bool js_delete_cc_BakedCrowdClip(se::State& s)
+{
+    // js_dtoroverride
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_delete_cc_BakedCrowdClip) 
+
+template<>
+bool sevalue_to_native(const se::Value &from, cc::BakedCrowdClip * to, se::Object *ctx)
+{
+    assert(from.isObject());
+    se::Object *json = from.toObject();
+    auto* data = reinterpret_cast<cc::BakedCrowdClip*>(json->getPrivateData());
+    if (data) {
+        *to = *data;
+        return true;
+    }
+    se::Value field;
+    bool ok = true;
+    
+    json->getProperty("frameCount", &field, true);
+    if (!field.isNullOrUndefined()) {
+        ok &= sevalue_to_native(field, &(to->frameCount), ctx);
+    }
+    
+    
+    json->getProperty("sample", &field, true);
+    if (!field.isNullOrUndefined()) {
+        ok &= sevalue_to_native(field, &(to->sample), ctx);
+    }
+    
+    
+    json->getProperty("loop", &field, true);
+    if (!field.isNullOrUndefined()) {
+        ok &= sevalue_to_native(field, &(to->loop), ctx);
+    }
+    
+    
+    json->getProperty("boundsInfo", &field, true);
+    if (!field.isNullOrUndefined()) {
+        ok &= sevalue_to_native(field, &(to->boundsInfo), ctx);
+    }
+    
+    
+    return ok;
+}
+
+
+bool js_register_cc_BakedCrowdClip(se::Object* obj) {
+    auto* cls = se::Class::create("BakedCrowdClip", obj, nullptr, _SE(js_new_cc_BakedCrowdClip)); 
+    
+    cls->defineProperty("frameCount", _SE(js_cc_BakedCrowdClip_frameCount_get), _SE(js_cc_BakedCrowdClip_frameCount_set)); 
+    cls->defineProperty("sample", _SE(js_cc_BakedCrowdClip_sample_get), _SE(js_cc_BakedCrowdClip_sample_set)); 
+    cls->defineProperty("loop", _SE(js_cc_BakedCrowdClip_loop_get), _SE(js_cc_BakedCrowdClip_loop_set)); 
+    cls->defineProperty("boundsInfo", _SE(js_cc_BakedCrowdClip_boundsInfo_get), _SE(js_cc_BakedCrowdClip_boundsInfo_set)); 
+    
+    
+    
+    
+    
+    cls->defineFinalizeFunction(_SE(js_delete_cc_BakedCrowdClip));
+    
+    
+    cls->install();
+    JSBClassType::registerClass<cc::BakedCrowdClip>(cls);
+    
+    __jsb_cc_BakedCrowdClip_proto = cls->getProto();
+    __jsb_cc_BakedCrowdClip_class = cls;
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
+
+se::Class* __jsb_cc_BakedCrowdLOD_class = nullptr;
+se::Object* __jsb_cc_BakedCrowdLOD_proto = nullptr;
+SE_DECLARE_FINALIZE_FUNC(js_delete_cc_BakedCrowdLOD) 
+
+static bool js_cc_BakedCrowdLOD_distance_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedCrowdLOD *arg1 = (cc::BakedCrowdLOD *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdLOD>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) int, short, long, signed char, float, double
+    ok &= sevalue_to_native(args[0], &arg1->distance, nullptr);
+    SE_PRECONDITION2(ok, false, "BakedCrowdLOD_distance_set,2,SWIGTYPE_float"); 
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_BakedCrowdLOD_distance_set) 
+
+static bool js_cc_BakedCrowdLOD_distance_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::BakedCrowdLOD *arg1 = (cc::BakedCrowdLOD *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdLOD>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // out 1
+    ok &= nativevalue_to_se(arg1->distance, s.rval(), s.thisObject() /*ctx*/); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_BakedCrowdLOD_distance_get) 
+
+static bool js_cc_BakedCrowdLOD_frameInterval_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedCrowdLOD *arg1 = (cc::BakedCrowdLOD *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdLOD>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    
+    // %typemap(in) SWIGTYPE value in
+    ok &= sevalue_to_native(args[0], &arg1->frameInterval, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedCrowdLOD_frameInterval_set,2,SWIGTYPE_uint32_t"); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_BakedCrowdLOD_frameInterval_set) 
+
+static bool js_cc_BakedCrowdLOD_frameInterval_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::BakedCrowdLOD *arg1 = (cc::BakedCrowdLOD *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::BakedCrowdLOD>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(arg1->frameInterval, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "BakedCrowdLOD_frameInterval_get, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(arg1->frameInterval, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_BakedCrowdLOD_frameInterval_get) 
+
+// js_ctor
+static bool js_new_cc_BakedCrowdLOD(se::State& s) // NOLINT(readability-identifier-naming)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    cc::BakedCrowdLOD *result;
+    result = (cc::BakedCrowdLOD *)new cc::BakedCrowdLOD();
+    
+    
+    auto *ptr = JSB_MAKE_PRIVATE_OBJECT_WITH_INSTANCE(result);
+    s.thisObject()->setPrivateObject(ptr);
+    return true;
+}
+SE_BIND_CTOR(js_new_cc_BakedCrowdLOD, __jsb_cc_BakedCrowdLOD_class, js_delete_cc_BakedCrowdLOD)
+
+static bool js_delete_cc_BakedCrowdLOD(se::State& s)
+{
+    // js_dtoroverride
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_delete_cc_BakedCrowdLOD) 
+
+template<>
+bool sevalue_to_native(const se::Value &from, cc::BakedCrowdLOD * to, se::Object *ctx)
+{
+    assert(from.isObject());
+    se::Object *json = from.toObject();
+    auto* data = reinterpret_cast<cc::BakedCrowdLOD*>(json->getPrivateData());
+    if (data) {
+        *to = *data;
+        return true;
+    }
+    se::Value field;
+    bool ok = true;
+    
+    json->getProperty("distance", &field, true);
+    if (!field.isNullOrUndefined()) {
+        ok &= sevalue_to_native(field, &(to->distance), ctx);
+    }
+    
+    
+    json->getProperty("frameInterval", &field, true);
+    if (!field.isNullOrUndefined()) {
+        ok &= sevalue_to_native(field, &(to->frameInterval), ctx);
+    }
+    
+    
+    return ok;
+}
+
+
+bool js_register_cc_BakedCrowdLOD(se::Object* obj) {
+    auto* cls = se::Class::create("BakedCrowdLOD", obj, nullptr, _SE(js_new_cc_BakedCrowdLOD)); 
+    
+    cls->defineProperty("distance", _SE(js_cc_BakedCrowdLOD_distance_get), _SE(js_cc_BakedCrowdLOD_distance_set)); 
+    cls->defineProperty("frameInterval", _SE(js_cc_BakedCrowdLOD_frameInterval_get), _SE(js_cc_BakedCrowdLOD_frameInterval_set)); 
+    
+    
+    
+    
+    
+    cls->defineFinalizeFunction(_SE(js_delete_cc_BakedCrowdLOD));
+    
+    
+    cls->install();
+    JSBClassType::registerClass<cc::BakedCrowdLOD>(cls);
+    
+    __jsb_cc_BakedCrowdLOD_proto = cls->getProto();
+    __jsb_cc_BakedCrowdLOD_class = cls;
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
+
+se::Class* __jsb_cc_BakedAnimationCrowd_class = nullptr;
+se::Object* __jsb_cc_BakedAnimationCrowd_proto = nullptr;
+SE_DECLARE_FINALIZE_FUNC(js_delete_cc_BakedAnimationCrowd) 
+
+// js_ctor
+static bool js_new_cc_BakedAnimationCrowd(se::State& s) // NOLINT(readability-identifier-naming)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    cc::BakedAnimationCrowd *result;
+    result = (cc::BakedAnimationCrowd *)new cc::BakedAnimationCrowd();
+    
+    
+    auto *ptr = JSB_MAKE_PRIVATE_OBJECT_WITH_INSTANCE(result);
+    s.thisObject()->setPrivateObject(ptr);
+    return true;
+}
+SE_BIND_CTOR(js_new_cc_BakedAnimationCrowd, __jsb_cc_BakedAnimationCrowd_class, js_delete_cc_BakedAnimationCrowd)
+
+static bool js_delete_cc_BakedAnimationCrowd(se::State& s)
+{
+    // js_dtoroverride
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_delete_cc_BakedAnimationCrowd) 
+
+static bool js_cc_BakedAnimationCrowd_addClip(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    cc::BakedCrowdClip *arg2 = 0 ;
+    index_t result;
+    cc::BakedCrowdClip temp2 ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) SWIGTYPE&
+    ok &= sevalue_to_native(args[0], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_addClip,2,SWIGTYPE_p_cc__BakedCrowdClip");
+    arg2 = &temp2;
+    
+    result = (arg1)->addClip((cc::BakedCrowdClip const &)*arg2);
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_addClip, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_addClip) 
+
+static bool js_cc_BakedAnimationCrowd_setLODLevels(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    ccstd::vector< cc::BakedCrowdLOD > *arg2 = 0 ;
+    ccstd::vector< cc::BakedCrowdLOD > temp2 ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) SWIGTYPE&
+    ok &= sevalue_to_native(args[0], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_setLODLevels,2,SWIGTYPE_p_ccstd__vectorT_cc__BakedCrowdLOD_t");
+    arg2 = &temp2;
+    
+    (arg1)->setLODLevels((ccstd::vector< cc::BakedCrowdLOD > const &)*arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_setLODLevels) 
+
+static bool js_cc_BakedAnimationCrowd_addModel(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    cc::BakedSkinningModel *arg2 = (cc::BakedSkinningModel *) NULL ;
+    index_t arg3 ;
+    float arg4 ;
+    
+    if(argc != 3) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) SWIGTYPE*
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_addModel,2,SWIGTYPE_p_cc__BakedSkinningModel"); 
+    
+    // %typemap(in) SWIGTYPE value in
+    ok &= sevalue_to_native(args[1], &arg3, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_addModel,3,SWIGTYPE_int32_t"); 
+    
+    // %typemap(in) int, short, long, signed char, float, double
+    ok &= sevalue_to_native(args[2], &arg4, nullptr);
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_addModel,4,SWIGTYPE_float"); 
+    (arg1)->addModel(arg2,arg3,arg4);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_addModel) 
+
+static bool js_cc_BakedAnimationCrowd_removeModel(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    cc::BakedSkinningModel *arg2 = (cc::BakedSkinningModel *) NULL ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) SWIGTYPE*
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_removeModel,2,SWIGTYPE_p_cc__BakedSkinningModel"); 
+    (arg1)->removeModel(arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_removeModel) 
+
+static bool js_cc_BakedAnimationCrowd_play(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    cc::BakedSkinningModel *arg2 = (cc::BakedSkinningModel *) NULL ;
+    index_t arg3 ;
+    float arg4 ;
+    
+    if(argc != 3) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) SWIGTYPE*
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_play,2,SWIGTYPE_p_cc__BakedSkinningModel"); 
+    
+    // %typemap(in) SWIGTYPE value in
+    ok &= sevalue_to_native(args[1], &arg3, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_play,3,SWIGTYPE_int32_t"); 
+    
+    // %typemap(in) int, short, long, signed char, float, double
+    ok &= sevalue_to_native(args[2], &arg4, nullptr);
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_play,4,SWIGTYPE_float"); 
+    (arg1)->play(arg2,arg3,arg4);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_play) 
+
+static bool js_cc_BakedAnimationCrowd_getModelCount(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    uint32_t result;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (arg1)->getModelCount();
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_getModelCount, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_getModelCount) 
+
+static bool js_cc_BakedAnimationCrowd_getFrameBufferCount(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    uint32_t result;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    result = (arg1)->getFrameBufferCount();
+    // %typemap(out) SWIGTYPE
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_getFrameBufferCount, Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_getFrameBufferCount) 
+
+static bool js_cc_BakedAnimationCrowd_update(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    float arg2 ;
+    cc::Vec3 *arg3 = 0 ;
+    cc::Vec3 temp3 ;
+    
+    if(argc != 2) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    // %typemap(in) int, short, long, signed char, float, double
+    ok &= sevalue_to_native(args[0], &arg2, nullptr);
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_update,2,SWIGTYPE_float"); 
+    // %typemap(in) SWIGTYPE&
+    ok &= sevalue_to_native(args[1], &temp3, s.thisObject());
+    SE_PRECONDITION2(ok, false, "BakedAnimationCrowd_update,3,SWIGTYPE_p_cc__Vec3");
+    arg3 = &temp3;
+    
+    (arg1)->update(arg2,(cc::Vec3 const &)*arg3);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_update) 
+
+static bool js_cc_BakedAnimationCrowd_clear(se::State& s)
+{
+    // js_function
+    
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::BakedAnimationCrowd *arg1 = (cc::BakedAnimationCrowd *) NULL ;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::BakedAnimationCrowd>(s);
+    SE_PRECONDITION2(arg1, false, "%s: Invalid Native Object", __FUNCTION__); 
+    (arg1)->clear();
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_BakedAnimationCrowd_clear) 
+
+bool js_register_cc_BakedAnimationCrowd(se::Object* obj) {
+    auto* cls = se::Class::create("BakedAnimationCrowd", obj, nullptr, _SE(js_new_cc_BakedAnimationCrowd)); 
+    
+    
+    cls->defineFunction("addClip", _SE(js_cc_BakedAnimationCrowd_addClip)); 
+    cls->defineFunction("setLODLevels", _SE(js_cc_BakedAnimationCrowd_setLODLevels)); 
+    cls->defineFunction("addModel", _SE(js_cc_BakedAnimationCrowd_addModel)); 
+    cls->defineFunction("removeModel", _SE(js_cc_BakedAnimationCrowd_removeModel)); 
+    cls->defineFunction("play", _SE(js_cc_BakedAnimationCrowd_play)); 
+    cls->defineFunction("getModelCount", _SE(js_cc_BakedAnimationCrowd_getModelCount)); 
+    cls->defineFunction("getFrameBufferCount", _SE(js_cc_BakedAnimationCrowd_getFrameBufferCount)); 
+    cls->defineFunction("update", _SE(js_cc_BakedAnimationCrowd_update)); 
+    cls->defineFunction("clear", _SE(js_cc_BakedAnimationCrowd_clear)); 
+    
+    
+    
+    
+    cls->defineFinalizeFunction(_SE(js_delete_cc_BakedAnimationCrowd));
+    
+    
+    cls->install();
+    JSBClassType::registerClass<cc::BakedAnimationCrowd>(cls);
+    
+    __jsb_cc_BakedAnimationCrowd_proto = cls->getProto();
+    __jsb_cc_BakedAnimationCrowd_class = cls;
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
+
 se::Class* __jsb_cc_IDefineRecord_class = nullptr;
 se::Object* __jsb_cc_IDefineRecord_proto = nullptr;
 SE_DECLARE_FINALIZE_FUNC(js_delete_cc_IDefineRecord) 
@@ -26857,6 +27611,9 @@ bool register_all_scene(se::Object* obj) {
     js_register_cc_MorphModel(ns); 
     js_register_cc_SkinningModel(ns); 
     js_register_cc_BakedSkinningModel(ns); 
+    js_register_cc_BakedCrowdClip(ns); 
+    js_register_cc_BakedCrowdLOD(ns); 
+    js_register_cc_BakedAnimationCrowd(ns); 
     js_register_cc_IDefineRecord(ns); 
     js_register_cc_IMacroInfo(ns); 
     js_register_cc_IProgramInfo(ns); 
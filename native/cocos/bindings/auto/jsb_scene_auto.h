@@ -63,6 +63,7 @@
 #include "3d/models/MorphModel.h"
 #include "3d/models/SkinningModel.h"
 #include "3d/models/BakedSkinningModel.h"
+#include "3d/skeletal-animation/BakedAnimationCrowd.h"
 #include "renderer/core/ProgramLib.h"
 #include "scene/Octree.h"
 
@@ -306,6 +307,29 @@ extern se::Object *__jsb_cc_BakedSkinningModel_proto; // NOLINT
 extern se::Class * __jsb_cc_BakedSkinningModel_class; // NOLINT
 
 
+JSB_REGISTER_OBJECT_TYPE(cc::BakedCrowdClip);
+extern se::Object *__jsb_cc_BakedCrowdClip_proto; // NOLINT
+extern se::Class * __jsb_cc_BakedCrowdClip_class; // NOLINT
+
+
+template<>
+bool sevalue_to_native(const se::Value &from, cc::BakedCrowdClip * to, se::Object *ctx);
+
+
+JSB_REGISTER_OBJECT_TYPE(cc::BakedCrowdLOD);
+extern se::Object *__jsb_cc_BakedCrowdLOD_proto; // NOLINT
+extern se::Class * __jsb_cc_BakedCrowdLOD_class; // NOLINT
+
+
+template<>
+bool sevalue_to_native(const se::Value &from, cc::BakedCrowdLOD * to, se::Object *ctx);
+
+
+JSB_REGISTER_OBJECT_TYPE(cc::BakedAnimationCrowd);
+extern se::Object *__jsb_cc_BakedAnimationCrowd_proto; // NOLINT
+extern se::Class * __jsb_cc_BakedAnimationCrowd_class; // NOLINT
+
+
 JSB_REGISTER_OBJECT_TYPE(cc::IDefineRecord);
 extern se::Object *__jsb_cc_IDefineRecord_proto; // NOLINT
 extern se::Class * __jsb_cc_IDefineRecord_class; // NOLINT
@@ -20,6 +20,7 @@
 ****************************************************************************/
 
 #include <sstream>
+#include "2d/renderer/Batcher2d.h"
 #include "base/Value.h"
 #include "cocos/base/DeferredReleasePool.h"
 #include "cocos/base/RefMap.h"
@@ -37,6 +38,7 @@
 #include "extensions/cocos-ext.h"
 #include "jsb_conversions.h"
 #include "network/Downloader.h"
+#include "renderer/pipeline/PersistentPipelineCache.h"
 
 #include "bindings/auto/jsb_assets_auto.h"
 #include "cocos/core/geometry/Geometry.h"
@@ -1273,6 +1275,29 @@ bool nativevalue_to_se(const cc::network::DownloadTask &from, se::Value &to, se:
     return true;
 }
 
+bool nativevalue_to_se(const cc::pipeline::PipelineCacheStats &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
+    se::HandleObject obj(se::Object::createPlainObject());
+    obj->setProperty("shaderHits", se::Value(from.shaderHits));
+    obj->setProperty("shaderMisses", se::Value(from.shaderMisses));
+    obj->setProperty("shaderStores", se::Value(from.shaderStores));
+    obj->setProperty("recordedPermutations", se::Value(from.recordedPermutations));
+    obj->setProperty("warmedUpPermutations", se::Value(from.warmedUpPermutations));
+    obj->setProperty("warmedUpPipelines", se::Value(from.warmedUpPipelines));
+    obj->setProperty("evictedBinaries", se::Value(from.evictedBinaries));
+    obj->setProperty("binaryBytes", se::Value(from.binaryBytes));
+    obj->setProperty("pipelineCacheBytes", se::Value(from.pipelineCacheBytes));
+    to.setObject(obj);
+    return true;
+}
+
+bool nativevalue_to_se(const cc::Batcher2dReorderStats &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
+    se::HandleObject obj(se::Object::createPlainObject());
+    obj->setProperty("batchesBefore", se::Value(from.batchesBefore));
+    obj->setProperty("batchesAfter", se::Value(from.batchesAfter));
+    to.setObject(obj);
+    return true;
+}
+
 #if CC_USE_SPINE
 // NOLINTNEXTLINE(readability-identifier-naming)
 bool nativevalue_to_se(const spine::String &obj, se::Value &val, se::Object * /*unused*/) {
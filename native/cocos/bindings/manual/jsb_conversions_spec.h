@@ -59,6 +59,8 @@ class ArrayBuffer;
 // class TypedArray;
 // class IBArray;
 
+struct Batcher2dReorderStats;
+
 namespace network {
 struct DownloaderHints;
 class DownloadTask;
@@ -122,6 +124,10 @@ struct FramebufferInfo;
 struct CommandBufferInfo;
 struct InputAssemblerInfo;
 } // namespace gfx
+
+namespace pipeline {
+struct PipelineCacheStats;
+} // namespace pipeline
 } // namespace cc
 
 #if CC_USE_SPINE
@@ -577,6 +583,10 @@ bool nativevalue_to_se(const cc::gfx::Rect &from, se::Value &to, se::Object *ctx
 
 bool nativevalue_to_se(const cc::network::DownloadTask &from, se::Value &to, se::Object * /*ctx*/); // NOLINT(readability-identifier-naming)
 
+bool nativevalue_to_se(const cc::pipeline::PipelineCacheStats &from, se::Value &to, se::Object * /*ctx*/); // NOLINT(readability-identifier-naming)
+
+bool nativevalue_to_se(const cc::Batcher2dReorderStats &from, se::Value &to, se::Object * /*ctx*/); // NOLINT(readability-identifier-naming)
+
 inline bool nativevalue_to_se(const ccstd::monostate & /*from*/, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     to.setUndefined();
     return true;
@@ -643,7 +643,8 @@ static bool js_Model_setInstancedAttribute(se::State &s) // NOLINT(readability-i
                 if (len <= static_cast<uint32_t>(stackData.size())) {
                     pData = stackData.data();
                 } else {
-                    pData = static_cast<float *>(CC_MALLOC(len));
+                    CC_MEMORY_TAG_SCOPE(BINDINGS);
+                    pData = static_cast<float *>(CC_MALLOC(len * sizeof(float)));
                     needFree = true;
                 }
 
@@ -37,6 +37,7 @@
 #include "renderer/gfx-base/GFXSwapchain.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/GeometryRenderer.h"
+#include "renderer/pipeline/PersistentPipelineCache.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/NativePipelineTypes.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -94,6 +95,8 @@ void Root::initialize(gfx::Swapchain * /*swapchain*/) {
     uint32_t maxJoints = (_device->getCapabilities().maxVertexUniformVectors - 38) / 3;
     maxJoints = maxJoints < 256 ? maxJoints : 256;
     pipeline::localDescriptorSetLayoutResizeMaxJoints(maxJoints);
+
+    pipeline::PersistentPipelineCache::getInstance()->open(_device);
 }
 
 render::Pipeline *Root::getCustomPipeline() const {
@@ -149,6 +152,7 @@ cc::scene::RenderWindow *Root::createRenderWindowFromSystemWindow(uint32_t windo
 void Root::destroy() {
     destroyScenes();
     removeWindowEventListener();
+    pipeline::PersistentPipelineCache::getInstance()->setPipeline(nullptr);
     if (_usesCustomPipeline && _pipelineRuntime) {
         _pipelineRuntime->destroy();
     }
@@ -156,6 +160,8 @@ void Root::destroy() {
 
     CC_SAFE_DESTROY_NULL(_pipeline);
 
+    pipeline::PersistentPipelineCache::getInstance()->close();
+
     CC_SAFE_DELETE(_batcher);
 
     for (auto *swapchain : _swapchains) {
@@ -344,6 +350,8 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
     //        scene->getSceneGlobals()->activate();
     //    }
 
+    // recorded permutations are warmed up with the active pipeline from now on
+    pipeline::PersistentPipelineCache::getInstance()->setPipeline(_pipelineRuntime.get());
     onGlobalPipelineStateChanged();
 
     if (_batcher == nullptr) {
@@ -459,6 +467,8 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
         frameMoveProcess(true, totalFrames, _renderWindows);
         frameMoveEnd();
     }
+
+    pipeline::PersistentPipelineCache::getInstance()->update(deltaTime);
 }
 
 scene::RenderWindow *Root::createWindow(scene::IRenderWindowInfo &info) {
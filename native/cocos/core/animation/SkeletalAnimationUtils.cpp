@@ -29,7 +29,8 @@
 namespace cc {
 
 namespace {
-ccstd::vector<IJointTransform *> stack;
+// getWorldMatrix() runs on job system workers when the render scene updates models in parallel
+thread_local ccstd::vector<IJointTransform *> stack;
 ccstd::unordered_map<ccstd::string, IJointTransform *> pool;
 } // namespace
 
@@ -41,10 +41,31 @@ uint32_t Node::clearFrame{0};
 uint32_t Node::clearRound{1000};
 const uint32_t Node::TRANSFORM_ON{1 << 0};
 uint32_t Node::globalFlagChangeVersion{0};
+uint32_t Node::globalHierarchyVersion{0};
 
 namespace {
 const ccstd::string EMPTY_NODE_NAME;
 IDGenerator idGenerator("Node");
+
+// diagonal of the inverse world rotation times the world matrix, i.e. the world scale,
+// without building the two intermediate Mat3
+void extractWorldScale(const Quaternion &q, const Mat4 &m, Vec3 *out) {
+    const float x2 = q.x + q.x;
+    const float y2 = q.y + q.y;
+    const float z2 = q.z + q.z;
+    const float xx = q.x * x2;
+    const float yy = q.y * y2;
+    const float zz = q.z * z2;
+    const float xy = q.x * y2;
+    const float xz = q.x * z2;
+    const float yz = q.y * z2;
+    const float wx = q.w * x2;
+    const float wy = q.w * y2;
+    const float wz = q.w * z2;
+    out->x = (1.F - yy - zz) * m.m[0] + (xy + wz) * m.m[1] + (xz - wy) * m.m[2];
+    out->y = (xy - wz) * m.m[4] + (1.F - xx - zz) * m.m[5] + (yz + wx) * m.m[6];
+    out->z = (xz + wy) * m.m[8] + (yz - wx) * m.m[9] + (1.F - xx - yy) * m.m[10];
+}
 } // namespace
 
 Node::Node() : Node(EMPTY_NODE_NAME) {
@@ -227,6 +248,9 @@ void Node::setParent(Node *parent, bool isKeepWorld /* = false */) {
 #endif
     _parent = newParent;
     _siblingIndex = 0;
+    // both the subtree the node leaves and the one it joins change
+    if (oldParent) oldParent->markHierarchyChanged();
+    if (newParent) newParent->markHierarchyChanged();
     onSetParent(oldParent, isKeepWorld);
     emit(NodeEventType::PARENT_CHANGED, oldParent);
     if (oldParent) {
@@ -314,6 +338,7 @@ bool Node::onPreDestroyBase() {
             index_t childIdx = getIdxOfChild(_parent->_children, this);
             if (childIdx != -1) {
                 _parent->_children.erase(_parent->_children.begin() + childIdx);
+                _parent->markHierarchyChanged();
             }
             _siblingIndex = 0;
             _parent->updateSiblingIndex();
@@ -359,6 +384,13 @@ void Node::updateScene() {
     emit(EventTypesToJS::NODE_SCENE_UPDATED, _scene);
 }
 
+void Node::markHierarchyChanged() {
+    ++globalHierarchyVersion;
+    for (Node *node = this; node != nullptr; node = node->_parent) {
+        node->_hierarchyVersion = globalHierarchyVersion;
+    }
+}
+
 /* static */
 index_t Node::getIdxOfChild(const ccstd::vector<IntrusivePtr<Node>> &child, Node *target) {
     auto iteChild = std::find(child.begin(), child.end(), target);
@@ -422,6 +454,7 @@ void Node::setSiblingIndex(index_t index) {
             siblings.emplace_back(this);
         }
         _parent->updateSiblingIndex();
+        _parent->markHierarchyChanged();
         if (onSiblingIndexChanged != nullptr) {
             onSiblingIndexChanged(index);
         }
@@ -521,6 +554,11 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { //NOLINT(misc-no
         parent->updateWorldTransformRecursive(dirtyBits);
     }
     dirtyBits |= currDirtyBits;
+    updateWorldTransformFromParent(dirtyBits);
+}
+
+void Node::updateWorldTransformFromParent(uint32_t dirtyBits) {
+    Node *parent = getParent();
     if (parent) {
         if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
             _worldPosition.transformMat4(_localPosition, parent->_worldMatrix);
@@ -534,12 +572,7 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { //NOLINT(misc-no
             if (dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
                 Quaternion::multiply(parent->_worldRotation, _localRotation, &_worldRotation);
             }
-            Quaternion quat = _worldRotation;
-            quat.conjugate();
-            Mat3 m3Out(quat);
-            Mat3 m32WorldMat(_worldMatrix);
-            Mat3::multiply(m3Out, m32WorldMat, &m3Out);
-            _worldScale.set(m3Out.m[0], m3Out.m[4], m3Out.m[8]);
+            extractWorldScale(_worldRotation, _worldMatrix, &_worldScale);
         }
     } else {
         if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
@@ -580,16 +613,24 @@ Mat4 Node::getWorldRT() {
     return target;
 }
 
-void Node::invalidateChildren(TransformBit dirtyBit) { //NOLINT(misc-no-recursion)
-    auto curDirtyBit{static_cast<uint32_t>(dirtyBit)};
-    const uint32_t hasChangedFlags = getChangedFlags();
-    const uint32_t dirtyFlags = getDirtyFlag();
-    if (isValid() && (dirtyFlags & hasChangedFlags & curDirtyBit) != curDirtyBit) {
-        setDirtyFlag(dirtyFlags | curDirtyBit);
-        setChangedFlags(hasChangedFlags | curDirtyBit);
-
-        for (Node *child : getChildren()) {
-            child->invalidateChildren(dirtyBit | TransformBit::POSITION);
+void Node::invalidateChildren(TransformBit dirtyBit) {
+    // descendants always get the position bit on top of the one of this node
+    static thread_local ccstd::vector<Node *> stack;
+    const auto childDirtyBit{static_cast<uint32_t>(dirtyBit | TransformBit::POSITION)};
+    const size_t base = stack.size();
+    stack.emplace_back(this);
+    while (stack.size() > base) {
+        Node *node = stack.back();
+        stack.pop_back();
+        const uint32_t curDirtyBit = node == this ? static_cast<uint32_t>(dirtyBit) : childDirtyBit;
+        const uint32_t hasChangedFlags = node->getChangedFlags();
+        const uint32_t dirtyFlags = node->getDirtyFlag();
+        if (node->isValid() && (dirtyFlags & hasChangedFlags & curDirtyBit) != curDirtyBit) {
+            node->setDirtyFlag(dirtyFlags | curDirtyBit);
+            node->setChangedFlags(hasChangedFlags | curDirtyBit);
+            for (const auto &child : node->_children) {
+                stack.emplace_back(child.get());
+            }
         }
     }
 }
@@ -932,6 +973,7 @@ void Node::onHierarchyChanged(Node *oldParent) {
 //
 void Node::_setChildren(ccstd::vector<IntrusivePtr<Node>> &&children) {
     _children = std::move(children);
+    markHierarchyChanged();
 }
 
 //
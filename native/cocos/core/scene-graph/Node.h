@@ -640,9 +640,13 @@ private:
     void onSetParent(Node *oldParent, bool keepWorldTransform);
     void onHierarchyChanged(Node *);
     void onHierarchyChangedBase(Node *oldParent);
+    // bumps globalHierarchyVersion and stamps it on this node and its ancestors
+    void markHierarchyChanged();
 
     void inverseTransformPointRecursive(Vec3 &out) const;
     void updateWorldTransformRecursive(uint32_t &superDirtyBits);
+    // recomputes the world transform from the parent one, which has to be up to date
+    void updateWorldTransformFromParent(uint32_t dirtyBits);
 
     inline void notifyLocalPositionUpdated() {
         emit(EventTypesToJS::NODE_LOCAL_POSITION_UPDATED, _localPosition.x, _localPosition.y, _localPosition.z);
@@ -671,6 +675,8 @@ private:
 
     // increase on every frame, used to identify the frame
     static uint32_t globalFlagChangeVersion;
+    // increase whenever a node is attached to or detached from a parent, or the order of children changes
+    static uint32_t globalHierarchyVersion;
 
     static uint32_t clearFrame;
     static uint32_t clearRound;
@@ -708,11 +714,15 @@ private:
      */
     uint32_t _hasChangedFlagsVersion{0};
     uint32_t _hasChangedFlags{0};
+    // globalHierarchyVersion when a node was last attached, detached or reordered in the subtree of this node
+    uint32_t _hierarchyVersion{0};
 
     bool _eulerDirty{false};
 
     friend class NodeActivator;
     friend class Scene;
+    friend class TransformStore;
+    friend class Batcher2d;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Node);
 };
@@ -25,6 +25,7 @@
 
 #include "core/scene-graph/Scene.h"
 #include "core/scene-graph/SceneGlobals.h"
+#include "core/scene-graph/TransformStore.h"
 // #include "core/Director.h"
 #include "core/Root.h"
 //#include "core/scene-graph/NodeActivator.h"
@@ -42,10 +43,26 @@ Scene::Scene(const ccstd::string &name)
 
 Scene::Scene() : Scene("") {}
 
-Scene::~Scene() = default;
+Scene::~Scene() {
+    CC_SAFE_DELETE(_transformStore);
+}
 
 void Scene::setSceneGlobals(SceneGlobals *globals) { _globals = globals; }
 
+void Scene::setFlattenedTransformEnabled(bool enabled) {
+    if (enabled == isFlattenedTransformEnabled()) {
+        return;
+    }
+    if (enabled) {
+        _transformStore = ccnew TransformStore(this);
+    } else {
+        CC_SAFE_DELETE(_transformStore);
+    }
+    if (_renderScene) {
+        _renderScene->setTransformStore(_transformStore);
+    }
+}
+
 void Scene::load() {
     EventDispatcher::dispatchSceneLoadEvent();
     if (!_inited) {
@@ -103,6 +120,7 @@ bool Scene::destroy() {
         }
     }
 
+    setFlattenedTransformEnabled(false);
     if (_renderScene != nullptr) {
         Root::getInstance()->destroyScene(_renderScene);
     }
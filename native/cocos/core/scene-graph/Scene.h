@@ -29,6 +29,7 @@
 
 namespace cc {
 class SceneGlobals;
+class TransformStore;
 namespace scene {
 class RenderScene;
 }
@@ -46,6 +47,14 @@ public:
     inline bool isAutoReleaseAssets() const { return _autoReleaseAssets; }
     inline void setAutoReleaseAssets(bool val) { _autoReleaseAssets = val; }
 
+    /**
+     * @en Whether to update all the world transforms of the scene in one flattened, parallel pass every frame
+     * instead of lazily per node. Useful for scenes with many animated nodes.
+     * @zh 是否每帧以扁平化并行的方式统一更新场景内所有节点的世界变换。适用于大量节点运动的场景。
+     */
+    void setFlattenedTransformEnabled(bool enabled);
+    inline bool isFlattenedTransformEnabled() const { return _transformStore != nullptr; }
+
     void load();
     void activate(bool active = true);
 
@@ -62,6 +71,7 @@ protected:
      */
     //    @serializable
     IntrusivePtr<SceneGlobals> _globals;
+    TransformStore *_transformStore{nullptr};
     bool _inited{false};
 
     /**
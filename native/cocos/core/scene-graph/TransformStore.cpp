@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/scene-graph/TransformStore.h"
+#include <algorithm>
+#include "base/job-system/JobSystem.h"
+#include "core/scene-graph/Node.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+
+TransformStore::TransformStore(Node *root)
+: _root(root) {
+}
+
+void TransformStore::rebuild() {
+    _nodes.clear();
+    _subtreeEnds.clear();
+    _serialNodes.clear();
+    _ranges.clear();
+    _jobOffsets.clear();
+
+    // depth-first layout, the subtree ends are patched once all the descendants are in
+    ccstd::vector<std::pair<Node *, uint32_t>> stack;
+    for (auto it = _root->_children.rbegin(); it != _root->_children.rend(); ++it) {
+        stack.emplace_back(it->get(), 0);
+    }
+    ccstd::vector<uint32_t> openNodes;
+    while (!stack.empty()) {
+        auto [node, depth] = stack.back();
+        stack.pop_back();
+        while (openNodes.size() > depth) {
+            _subtreeEnds[openNodes.back()] = static_cast<uint32_t>(_nodes.size());
+            openNodes.pop_back();
+        }
+        openNodes.emplace_back(static_cast<uint32_t>(_nodes.size()));
+        _nodes.emplace_back(node);
+        _subtreeEnds.emplace_back(0);
+        for (auto it = node->_children.rbegin(); it != node->_children.rend(); ++it) {
+            stack.emplace_back(it->get(), depth + 1);
+        }
+    }
+    for (auto idx : openNodes) {
+        _subtreeEnds[idx] = static_cast<uint32_t>(_nodes.size());
+    }
+
+    // split into subtrees small enough for a job, their ancestors are updated serially
+    const auto nodeCount = static_cast<uint32_t>(_nodes.size());
+    const uint32_t jobCount = JobSystem::getInstance()->threadCount() * 4;
+    const uint32_t grain = std::max(MIN_NODES_PER_JOB, nodeCount / std::max(jobCount, 1U));
+    for (uint32_t i = 0; i < nodeCount;) {
+        if (_subtreeEnds[i] - i <= grain) {
+            _ranges.push_back({i, _subtreeEnds[i]});
+            i = _subtreeEnds[i];
+        } else {
+            _serialNodes.emplace_back(i++);
+        }
+    }
+
+    // merge neighbouring ranges into jobs of about `grain` nodes
+    uint32_t jobSize = 0;
+    for (uint32_t i = 0; i < _ranges.size(); ++i) {
+        if (!jobSize) _jobOffsets.emplace_back(i);
+        jobSize += _ranges[i].end - _ranges[i].begin;
+        if (jobSize >= grain) jobSize = 0;
+    }
+    _jobOffsets.emplace_back(static_cast<uint32_t>(_ranges.size()));
+
+    _hierarchyVersion = Node::globalHierarchyVersion;
+    _built = true;
+}
+
+void TransformStore::updateRange(uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+        Node *node = _nodes[i];
+        // invalidateChildren already propagated the dirty bits of the ancestors
+        const uint32_t dirtyBits = node->getDirtyFlag();
+        if (dirtyBits) {
+            node->updateWorldTransformFromParent(dirtyBits);
+        }
+    }
+}
+
+void TransformStore::update() {
+    CC_PROFILE(TransformStoreUpdate);
+    if (!_built || _hierarchyVersion != Node::globalHierarchyVersion) {
+        rebuild();
+    }
+
+    _root->updateWorldTransform();
+    for (auto idx : _serialNodes) {
+        updateRange(idx, idx + 1);
+    }
+
+    const auto jobCount = static_cast<uint32_t>(_jobOffsets.size() - 1);
+    auto updateJob = [this](uint32_t job) {
+        for (uint32_t i = _jobOffsets[job]; i < _jobOffsets[job + 1]; ++i) {
+            updateRange(_ranges[i].begin, _ranges[i].end);
+        }
+    };
+    if (getNodeCount() >= PARALLEL_NODE_COUNT && jobCount > 1 && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, jobCount, 1U, updateJob);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t job = 0; job < jobCount; ++job) {
+            updateJob(job);
+        }
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,84 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Flattened view of a node hierarchy, bringing every dirty world transform up to date in one batched pass
+ * instead of lazily when it is read. Nodes are laid out depth-first, so a parent is always updated before its
+ * children and every subtree occupies a contiguous range; small enough subtrees are updated concurrently on the
+ * job system. The layout is rebuilt whenever the node hierarchy changes.
+ * Every node is visited once per update, so this pays off for hierarchies where many transforms change per frame.
+ * @zh 节点树的扁平化视图，在一次批处理中更新所有脏的世界变换。
+ */
+class TransformStore final {
+public:
+    explicit TransformStore(Node *root);
+    ~TransformStore() = default;
+
+    void update();
+
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+
+    // below this many nodes the whole hierarchy is updated on the calling thread
+    static constexpr uint32_t PARALLEL_NODE_COUNT = 1024;
+    static constexpr uint32_t MIN_NODES_PER_JOB = 256;
+
+private:
+    void rebuild();
+    void updateRange(uint32_t begin, uint32_t end);
+
+    struct Range {
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
+    // weak reference, the scene owns the store
+    Node *_root{nullptr};
+    // descendants of the root in depth-first order, weak references only valid while _hierarchyVersion is current:
+    // removing or destroying a node bumps Node::globalHierarchyVersion, which makes the next update rebuild first
+    ccstd::vector<Node *> _nodes;
+    // one past the last descendant of each node
+    ccstd::vector<uint32_t> _subtreeEnds;
+    // nodes whose subtree is too large for a single job, updated first on the calling thread
+    ccstd::vector<uint32_t> _serialNodes;
+    // the remaining subtrees, independent from each other once the serial nodes are up to date
+    ccstd::vector<Range> _ranges;
+    // ranges [_jobOffsets[i], _jobOffsets[i + 1]) make up the i-th job
+    ccstd::vector<uint32_t> _jobOffsets;
+    uint32_t _hierarchyVersion{0};
+    bool _built{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TransformStore);
+};
+
+} // namespace cc
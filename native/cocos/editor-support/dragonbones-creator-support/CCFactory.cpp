@@ -22,6 +22,7 @@
  */
 
 #include "dragonbones-creator-support/CCFactory.h"
+#include "base/memory/Memory.h"
 #include "dragonbones-creator-support/CCArmatureDisplay.h"
 #include "dragonbones-creator-support/CCSlot.h"
 #include "dragonbones-creator-support/CCTextureAtlasData.h"
@@ -77,6 +78,7 @@ Slot *CCFactory::_buildSlot(const BuildArmaturePackage &dataPackage, const SlotD
 }
 
 DragonBonesData *CCFactory::loadDragonBonesData(const std::string &filePath, const std::string &name, float scale) {
+    CC_MEMORY_TAG_SCOPE(DRAGONBONES);
     if (!name.empty()) {
         const auto existedData = getDragonBonesData(name);
         if (existedData) {
@@ -105,6 +107,7 @@ DragonBonesData *CCFactory::loadDragonBonesData(const std::string &filePath, con
 }
 
 DragonBonesData *CCFactory::parseDragonBonesDataByPath(const std::string &filePath, const std::string &name, float scale) {
+    CC_MEMORY_TAG_SCOPE(DRAGONBONES);
     if (!name.empty()) {
         const auto existedData = getDragonBonesData(name);
         if (existedData) {
@@ -143,6 +146,7 @@ void CCFactory::removeDragonBonesDataByUUID(const std::string &uuid, bool dispos
 }
 
 TextureAtlasData *CCFactory::loadTextureAtlasData(const std::string &filePath, const std::string &name, float scale) {
+    CC_MEMORY_TAG_SCOPE(DRAGONBONES);
     _prevPath = cc::FileUtils::getInstance()->fullPathForFilename(filePath);
     const auto data = cc::FileUtils::getInstance()->getStringFromFile(_prevPath);
     if (data.empty()) {
@@ -153,6 +157,7 @@ TextureAtlasData *CCFactory::loadTextureAtlasData(const std::string &filePath, c
 }
 
 CCArmatureDisplay *CCFactory::buildArmatureDisplay(const std::string &armatureName, const std::string &dragonBonesName, const std::string &skinName, const std::string &textureAtlasName) const {
+    CC_MEMORY_TAG_SCOPE(DRAGONBONES);
     const auto armature = buildArmature(armatureName, dragonBonesName, skinName, textureAtlasName);
     if (armature != nullptr) {
         return static_cast<CCArmatureDisplay *>(armature->getDisplay());
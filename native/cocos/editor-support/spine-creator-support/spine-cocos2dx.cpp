@@ -29,6 +29,7 @@
 
 #include "spine-creator-support/spine-cocos2dx.h"
 #include "base/Data.h"
+#include "base/memory/Memory.h"
 #include "middleware-adapter.h"
 #include "platform/FileUtils.h"
 #include "spine-creator-support/AttachmentVertices.h"
@@ -146,7 +147,25 @@ SpineExtension *spine::getDefaultExtension() {
     return new Cocos2dExtension();
 }
 
-void Cocos2dExtension::_free(void *mem, const char *file, int line) {
+void *Cocos2dExtension::_alloc(size_t size, const char * /*file*/, int /*line*/) {
+    if (size == 0) return nullptr;
+    CC_MEMORY_TAG_SCOPE(SPINE);
+    return CC_MALLOC(size);
+}
+
+void *Cocos2dExtension::_calloc(size_t size, const char *file, int line) {
+    void *ptr = _alloc(size, file, line);
+    if (ptr) memset(ptr, 0, size);
+    return ptr;
+}
+
+void *Cocos2dExtension::_realloc(void *ptr, size_t size, const char *file, int line) {
+    if (size == 0) return nullptr;
+    if (!ptr) return _alloc(size, file, line);
+    return CC_REALLOC(ptr, size);
+}
+
+void Cocos2dExtension::_free(void *mem, const char * /*file*/, int /*line*/) {
     spineObjectDisposeCallback(mem);
-    DefaultSpineExtension::_free(mem, file, line);
+    CC_FREE(mem);
 }
@@ -66,6 +66,13 @@ public:
 
     virtual ~Cocos2dExtension();
 
+    // spine memory is accounted to MemoryTag::SPINE
+    virtual void *_alloc(size_t size, const char *file, int line);
+
+    virtual void *_calloc(size_t size, const char *file, int line);
+
+    virtual void *_realloc(void *ptr, size_t size, const char *file, int line);
+
     virtual void _free(void *mem, const char *file, int line);
 
 protected:
@@ -113,6 +113,16 @@ Engine::~Engine() {
 int32_t Engine::init() {
     _scheduler = std::make_shared<Scheduler>();
     _fs = createFileUtils();
+#if CC_USE_PROFILER
+    // before the device, so the device thread gets named
+    _profiler = ccnew Profiler();
+    #if CC_PROFILER_HITCH_THRESHOLD_MS > 0
+    ProfilerHitchOptions hitchOptions;
+    hitchOptions.thresholdMs = static_cast<float>(CC_PROFILER_HITCH_THRESHOLD_MS);
+    _profiler->setHitchDetection(hitchOptions);
+    #endif
+#endif
+
     // May create gfx device in render subsystem in future.
     _gfxDevice = gfx::DeviceManager::create();
     _programLib = ccnew ProgramLib();
@@ -122,10 +132,6 @@ int32_t Engine::init() {
     _debugRenderer = ccnew DebugRenderer();
 #endif
 
-#if CC_USE_PROFILER
-    _profiler = ccnew Profiler();
-#endif
-
     EventDispatcher::init();
 
     BasePlatform *platform = BasePlatform::getPlatform();
@@ -23,6 +23,10 @@ This file was modified to fit the cocos2d-x project
 #include "math/MathUtil.h"
 #include "base/Macros.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
     #include <cpu-features.h>
 #endif
@@ -53,6 +57,10 @@ This file was modified to fit the cocos2d-x project
     #define INCLUDE_SSE
 #endif
 
+#if defined(INCLUDE_NEON32) || defined(INCLUDE_NEON64)
+    #include <arm_neon.h>
+#endif
+
 #ifdef INCLUDE_NEON32
     #include "math/MathUtilNeon.inl"
 #endif
@@ -64,7 +72,6 @@ This file was modified to fit the cocos2d-x project
 #ifdef INCLUDE_SSE
     #include "math/MathUtilSSE.inl"
 #endif
-#include <cstring>
 #include "math/MathUtil.inl"
 
 NS_CC_MATH_BEGIN
@@ -279,6 +286,47 @@ void MathUtil::crossVec3(const float *v1, const float *v2, float *dst) {
 #endif
 }
 
+uint32_t MathUtil::cullAABBs(const float *const bounds[6], uint32_t count, const float *planes, uint32_t planeCount, uint32_t *outIndices) {
+    // The SIMD paths only handle whole batches of 4 boxes, the tail goes through the C path.
+    const uint32_t batchCount = count & ~3U;
+    uint32_t visibleCount = 0;
+    uint32_t begin = 0;
+#ifdef USE_NEON32
+    visibleCount = MathUtilNeon::cullAABBs(bounds, batchCount, planes, planeCount, outIndices);
+    begin = batchCount;
+#elif defined(USE_NEON64)
+    visibleCount = MathUtilNeon64::cullAABBs(bounds, batchCount, planes, planeCount, outIndices);
+    begin = batchCount;
+#elif defined(INCLUDE_NEON32)
+    if (isNeon32Enabled()) {
+        visibleCount = MathUtilNeon::cullAABBs(bounds, batchCount, planes, planeCount, outIndices);
+        begin = batchCount;
+    }
+#elif defined(USE_SSE)
+    visibleCount = cullAABBsSSE(bounds, batchCount, planes, planeCount, outIndices);
+    begin = batchCount;
+#endif
+    return visibleCount + MathUtilC::cullAABBs(bounds, begin, count, planes, planeCount, outIndices + visibleCount);
+}
+
+void MathUtil::computeSkinningPalette(const float *const *jointMatrices, const float *bindposes, const float *jointBounds, uint32_t count, float *outPalette, float *outMin, float *outMax) {
+#ifdef USE_NEON32
+    MathUtilNeon::computeSkinningPalette(jointMatrices, bindposes, jointBounds, count, outPalette, outMin, outMax);
+#elif defined(USE_NEON64)
+    MathUtilNeon64::computeSkinningPalette(jointMatrices, bindposes, jointBounds, count, outPalette, outMin, outMax);
+#elif defined(INCLUDE_NEON32)
+    if (isNeon32Enabled()) {
+        MathUtilNeon::computeSkinningPalette(jointMatrices, bindposes, jointBounds, count, outPalette, outMin, outMax);
+    } else {
+        MathUtilC::computeSkinningPalette(jointMatrices, bindposes, jointBounds, count, outPalette, outMin, outMax);
+    }
+#elif defined(USE_SSE)
+    computeSkinningPaletteSSE(jointMatrices, bindposes, jointBounds, count, outPalette, outMin, outMax);
+#else
+    MathUtilC::computeSkinningPalette(jointMatrices, bindposes, jointBounds, count, outPalette, outMin, outMax);
+#endif
+}
+
 void MathUtil::combineHash(size_t &seed, const size_t &v) {
     seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
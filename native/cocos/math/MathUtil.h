@@ -24,6 +24,7 @@
 #define MATHUTIL_H_
 
 #ifdef __SSE__
+    #include <emmintrin.h>
     #include <xmmintrin.h>
 #endif
 
@@ -95,6 +96,41 @@ public:
      */
     static void combineHash(size_t &seed, const size_t &v);
 
+    /**
+     * Culls a batch of axis aligned bounding boxes against a set of planes.
+     * Boxes are stored as structure-of-arrays: bounds[0..2] are the center x/y/z arrays
+     * and bounds[3..5] are the half extent x/y/z arrays, each holding count elements.
+     * A box is culled when it lies completely on the negative side of any plane,
+     * i.e. the plane normals point to the inside, matching geometry::aabbFrustum.
+     *
+     * @param bounds the six SoA arrays of box centers and half extents.
+     * @param count the number of boxes.
+     * @param planes the plane equations packed as (nx, ny, nz, d), planeCount * 4 floats.
+     * @param planeCount the number of planes.
+     * @param outIndices receives the indices of the boxes that are not culled, in ascending order,
+     *                   must be able to hold count elements.
+     *
+     * @return the number of indices written to outIndices.
+     */
+    static uint32_t cullAABBs(const float *const bounds[6], uint32_t count, const float *planes, uint32_t planeCount, uint32_t *outIndices);
+
+    /**
+     * Computes the skinning matrix palette of a skeleton and the bounds of its joints in one pass.
+     * For every joint the palette receives world * bindpose as 12 floats: matrix columns 0 to 2,
+     * each with its w component replaced by the x, y and z translation, the joint uniform layout.
+     * Joint bounds are transformed by the joint world matrix and merged into a single box.
+     * All matrices are column major and affine.
+     *
+     * @param jointMatrices the world matrices of the joints, count pointers to 16 floats.
+     * @param bindposes the bind pose matrices packed as count * 16 floats.
+     * @param jointBounds the bone space bounds packed as (center x/y/z, half extent x/y/z), count * 6 floats.
+     * @param count the number of joints.
+     * @param outPalette receives count * 12 floats.
+     * @param outMin receives the minimum corner of the merged bounds, 3 floats.
+     * @param outMax receives the maximum corner of the merged bounds, 3 floats.
+     */
+    static void computeSkinningPalette(const float *const *jointMatrices, const float *bindposes, const float *jointBounds, uint32_t count, float *outPalette, float *outMin, float *outMax);
+
 private:
     //Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -117,6 +153,10 @@ private:
     static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
 
     static void transformVec4(const __m128 m[4], const __m128 &v, __m128 &dst);
+
+    static uint32_t cullAABBsSSE(const float *const bounds[6], uint32_t count, const float *planes, uint32_t planeCount, uint32_t *outIndices);
+
+    static void computeSkinningPaletteSSE(const float *const *jointMatrices, const float *bindposes, const float *jointBounds, uint32_t count, float *outPalette, float *outMin, float *outMax);
 #endif
     static void addMatrix(const float *m, float scalar, float *dst);
 
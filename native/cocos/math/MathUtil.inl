@@ -42,6 +42,10 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static uint32_t cullAABBs(const float* const bounds[6], uint32_t begin, uint32_t count, const float* planes, uint32_t planeCount, uint32_t* outIndices);
+
+    inline static void computeSkinningPalette(const float* const* jointMatrices, const float* bindposes, const float* jointBounds, uint32_t count, float* outPalette, float* outMin, float* outMax);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +219,72 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline uint32_t MathUtilC::cullAABBs(const float* const bounds[6], uint32_t begin, uint32_t count, const float* planes, uint32_t planeCount, uint32_t* outIndices)
+{
+    uint32_t visibleCount = 0;
+    for (uint32_t i = begin; i < count; ++i) {
+        bool visible = true;
+        for (uint32_t p = 0; p < planeCount; ++p) {
+            const float* plane = planes + p * 4;
+            float dot = plane[0] * bounds[0][i] + plane[1] * bounds[1][i] + plane[2] * bounds[2][i];
+            float r = std::abs(plane[0]) * bounds[3][i] + std::abs(plane[1]) * bounds[4][i] + std::abs(plane[2]) * bounds[5][i];
+            if (dot + r < plane[3]) {
+                visible = false;
+                break;
+            }
+        }
+        if (visible) {
+            outIndices[visibleCount++] = i;
+        }
+    }
+    return visibleCount;
+}
+
+inline void MathUtilC::computeSkinningPalette(const float* const* jointMatrices, const float* bindposes, const float* jointBounds, uint32_t count, float* outPalette, float* outMin, float* outMax)
+{
+    float minX = INFINITY, minY = INFINITY, minZ = INFINITY;
+    float maxX = -INFINITY, maxY = -INFINITY, maxZ = -INFINITY;
+    for (uint32_t i = 0; i < count; ++i) {
+        const float* w = jointMatrices[i];
+        const float* b = bindposes + i * 16;
+        float* dst = outPalette + i * 12;
+        // Columns 0-2 of world * bindpose, the w lane carries the translation.
+        for (uint32_t c = 0; c < 4; ++c) {
+            const float* bc = b + c * 4;
+            float x = w[0] * bc[0] + w[4] * bc[1] + w[8] * bc[2];
+            float y = w[1] * bc[0] + w[5] * bc[1] + w[9] * bc[2];
+            float z = w[2] * bc[0] + w[6] * bc[1] + w[10] * bc[2];
+            if (c < 3) {
+                dst[c * 4 + 0] = x;
+                dst[c * 4 + 1] = y;
+                dst[c * 4 + 2] = z;
+            } else {
+                dst[3] = x + w[12];
+                dst[7] = y + w[13];
+                dst[11] = z + w[14];
+            }
+        }
+
+        const float* bound = jointBounds + i * 6;
+        float cx = w[0] * bound[0] + w[4] * bound[1] + w[8] * bound[2] + w[12];
+        float cy = w[1] * bound[0] + w[5] * bound[1] + w[9] * bound[2] + w[13];
+        float cz = w[2] * bound[0] + w[6] * bound[1] + w[10] * bound[2] + w[14];
+        float hx = std::abs(w[0]) * bound[3] + std::abs(w[4]) * bound[4] + std::abs(w[8]) * bound[5];
+        float hy = std::abs(w[1]) * bound[3] + std::abs(w[5]) * bound[4] + std::abs(w[9]) * bound[5];
+        float hz = std::abs(w[2]) * bound[3] + std::abs(w[6]) * bound[4] + std::abs(w[10]) * bound[5];
+        minX = std::min(minX, cx - hx);
+        minY = std::min(minY, cy - hy);
+        minZ = std::min(minZ, cz - hz);
+        maxX = std::max(maxX, cx + hx);
+        maxY = std::max(maxY, cy + hy);
+        maxZ = std::max(maxZ, cz + hz);
+    }
+    outMin[0] = minX;
+    outMin[1] = minY;
+    outMin[2] = minZ;
+    outMax[0] = maxX;
+    outMax[1] = maxY;
+    outMax[2] = maxZ;
+}
+
 NS_CC_MATH_END
@@ -42,6 +42,10 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static uint32_t cullAABBs(const float* const bounds[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* outIndices);
+
+    inline static void computeSkinningPalette(const float* const* jointMatrices, const float* bindposes, const float* jointBounds, uint32_t count, float* outPalette, float* outMin, float* outMax);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -260,4 +264,88 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline uint32_t MathUtilNeon64::cullAABBs(const float* const bounds[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* outIndices)
+{
+    const uint32_t batchCount = count & ~3U;
+    uint32_t visibleCount = 0;
+
+    // Test 4 boxes against one plane at a time, the plane is splatted over all lanes.
+    // The remaining count % 4 boxes are left to the caller.
+    for (uint32_t i = 0; i < batchCount; i += 4) {
+        float32x4_t cx = vld1q_f32(bounds[0] + i);
+        float32x4_t cy = vld1q_f32(bounds[1] + i);
+        float32x4_t cz = vld1q_f32(bounds[2] + i);
+        float32x4_t hx = vld1q_f32(bounds[3] + i);
+        float32x4_t hy = vld1q_f32(bounds[4] + i);
+        float32x4_t hz = vld1q_f32(bounds[5] + i);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < planeCount; ++p) {
+            const float* plane = planes + p * 4;
+            float32x4_t nx = vdupq_n_f32(plane[0]);
+            float32x4_t ny = vdupq_n_f32(plane[1]);
+            float32x4_t nz = vdupq_n_f32(plane[2]);
+            float32x4_t d = vdupq_n_f32(plane[3]);
+
+            float32x4_t dot = vmlaq_f32(vmlaq_f32(vmulq_f32(nx, cx), ny, cy), nz, cz);
+            float32x4_t r = vmlaq_f32(vmlaq_f32(vmulq_f32(vabsq_f32(nx), hx), vabsq_f32(ny), hy), vabsq_f32(nz), hz);
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), d));
+
+            uint32x2_t allOutside = vand_u32(vget_low_u32(outside), vget_high_u32(outside));
+            if (vget_lane_u32(vpmin_u32(allOutside, allOutside), 0)) {
+                break;
+            }
+        }
+
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if (!lanes[lane]) {
+                outIndices[visibleCount++] = i + lane;
+            }
+        }
+    }
+
+    return visibleCount;
+}
+
+inline void MathUtilNeon64::computeSkinningPalette(const float* const* jointMatrices, const float* bindposes, const float* jointBounds, uint32_t count, float* outPalette, float* outMin, float* outMax)
+{
+    float32x4_t boundsMin = vdupq_n_f32(INFINITY);
+    float32x4_t boundsMax = vdupq_n_f32(-INFINITY);
+
+    // One joint per iteration with the matrix columns in registers, the palette is written as
+    // columns 0-2 of world * bindpose with the translation in the w lanes.
+    for (uint32_t i = 0; i < count; ++i) {
+        const float* w = jointMatrices[i];
+        const float* b = bindposes + i * 16;
+        float32x4_t w0 = vld1q_f32(w);
+        float32x4_t w1 = vld1q_f32(w + 4);
+        float32x4_t w2 = vld1q_f32(w + 8);
+        float32x4_t w3 = vld1q_f32(w + 12);
+
+        float32x4_t c0 = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(w0, b[0]), w1, b[1]), w2, b[2]);
+        float32x4_t c1 = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(w0, b[4]), w1, b[5]), w2, b[6]);
+        float32x4_t c2 = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(w0, b[8]), w1, b[9]), w2, b[10]);
+        float32x4_t t = vaddq_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(w0, b[12]), w1, b[13]), w2, b[14]), w3);
+
+        float* dst = outPalette + i * 12;
+        vst1q_f32(dst, vsetq_lane_f32(vgetq_lane_f32(t, 0), c0, 3));
+        vst1q_f32(dst + 4, vsetq_lane_f32(vgetq_lane_f32(t, 1), c1, 3));
+        vst1q_f32(dst + 8, vsetq_lane_f32(vgetq_lane_f32(t, 2), c2, 3));
+
+        const float* bound = jointBounds + i * 6;
+        float32x4_t center = vaddq_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(w0, bound[0]), w1, bound[1]), w2, bound[2]), w3);
+        float32x4_t extent = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(vabsq_f32(w0), bound[3]), vabsq_f32(w1), bound[4]), vabsq_f32(w2), bound[5]);
+        boundsMin = vminq_f32(boundsMin, vsubq_f32(center, extent));
+        boundsMax = vmaxq_f32(boundsMax, vaddq_f32(center, extent));
+    }
+
+    float lanes[4];
+    vst1q_f32(lanes, boundsMin);
+    memcpy(outMin, lanes, sizeof(float) * 3);
+    vst1q_f32(lanes, boundsMax);
+    memcpy(outMax, lanes, sizeof(float) * 3);
+}
+
 NS_CC_MATH_END
@@ -151,6 +151,97 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+uint32_t MathUtil::cullAABBsSSE(const float* const bounds[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* outIndices)
+{
+    const __m128 signBit = _mm_set1_ps(-0.0F);
+    const uint32_t batchCount = count & ~3U;
+    uint32_t visibleCount = 0;
+
+    // Test 4 boxes against one plane at a time, the plane is splatted over all lanes.
+    // The remaining count % 4 boxes are left to the caller.
+    for (uint32_t i = 0; i < batchCount; i += 4) {
+        __m128 cx = _mm_loadu_ps(bounds[0] + i);
+        __m128 cy = _mm_loadu_ps(bounds[1] + i);
+        __m128 cz = _mm_loadu_ps(bounds[2] + i);
+        __m128 hx = _mm_loadu_ps(bounds[3] + i);
+        __m128 hy = _mm_loadu_ps(bounds[4] + i);
+        __m128 hz = _mm_loadu_ps(bounds[5] + i);
+
+        __m128 outside = _mm_setzero_ps();
+        for (uint32_t p = 0; p < planeCount; ++p) {
+            const float* plane = planes + p * 4;
+            __m128 nx = _mm_set1_ps(plane[0]);
+            __m128 ny = _mm_set1_ps(plane[1]);
+            __m128 nz = _mm_set1_ps(plane[2]);
+            __m128 d = _mm_set1_ps(plane[3]);
+
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signBit, nx), hx),
+                                             _mm_mul_ps(_mm_andnot_ps(signBit, ny), hy)),
+                                  _mm_mul_ps(_mm_andnot_ps(signBit, nz), hz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), d));
+            if (_mm_movemask_ps(outside) == 0xF) {
+                break;
+            }
+        }
+
+        int visibleMask = ~_mm_movemask_ps(outside) & 0xF;
+        while (visibleMask) {
+            int lane = 0;
+            while (!(visibleMask & (1 << lane))) {
+                ++lane;
+            }
+            outIndices[visibleCount++] = i + static_cast<uint32_t>(lane);
+            visibleMask &= visibleMask - 1;
+        }
+    }
+
+    return visibleCount;
+}
+
+void MathUtil::computeSkinningPaletteSSE(const float* const* jointMatrices, const float* bindposes, const float* jointBounds, uint32_t count, float* outPalette, float* outMin, float* outMax)
+{
+    const __m128 signBit = _mm_set1_ps(-0.0F);
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 boundsMin = _mm_set1_ps(INFINITY);
+    __m128 boundsMax = _mm_set1_ps(-INFINITY);
+
+    // One joint per iteration with the matrix columns in registers, the palette is written as
+    // columns 0-2 of world * bindpose with the translation in the w lanes.
+    for (uint32_t i = 0; i < count; ++i) {
+        const float* w = jointMatrices[i];
+        const float* b = bindposes + i * 16;
+        __m128 w0 = _mm_loadu_ps(w);
+        __m128 w1 = _mm_loadu_ps(w + 4);
+        __m128 w2 = _mm_loadu_ps(w + 8);
+        __m128 w3 = _mm_loadu_ps(w + 12);
+
+        __m128 c0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(b[0])), _mm_mul_ps(w1, _mm_set1_ps(b[1]))), _mm_mul_ps(w2, _mm_set1_ps(b[2])));
+        __m128 c1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(b[4])), _mm_mul_ps(w1, _mm_set1_ps(b[5]))), _mm_mul_ps(w2, _mm_set1_ps(b[6])));
+        __m128 c2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(b[8])), _mm_mul_ps(w1, _mm_set1_ps(b[9]))), _mm_mul_ps(w2, _mm_set1_ps(b[10])));
+        __m128 t = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(b[12])), _mm_mul_ps(w1, _mm_set1_ps(b[13]))), _mm_mul_ps(w2, _mm_set1_ps(b[14]))), w3);
+
+        float* dst = outPalette + i * 12;
+        _mm_storeu_ps(dst, _mm_or_ps(_mm_and_ps(xyzMask, c0), _mm_andnot_ps(xyzMask, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)))));
+        _mm_storeu_ps(dst + 4, _mm_or_ps(_mm_and_ps(xyzMask, c1), _mm_andnot_ps(xyzMask, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))));
+        _mm_storeu_ps(dst + 8, _mm_or_ps(_mm_and_ps(xyzMask, c2), _mm_andnot_ps(xyzMask, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)))));
+
+        const float* bound = jointBounds + i * 6;
+        __m128 center = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(bound[0])), _mm_mul_ps(w1, _mm_set1_ps(bound[1]))), _mm_mul_ps(w2, _mm_set1_ps(bound[2]))), w3);
+        __m128 extent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signBit, w0), _mm_set1_ps(bound[3])),
+                                              _mm_mul_ps(_mm_andnot_ps(signBit, w1), _mm_set1_ps(bound[4]))),
+                                   _mm_mul_ps(_mm_andnot_ps(signBit, w2), _mm_set1_ps(bound[5])));
+        boundsMin = _mm_min_ps(boundsMin, _mm_sub_ps(center, extent));
+        boundsMax = _mm_max_ps(boundsMax, _mm_add_ps(center, extent));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, boundsMin);
+    memcpy(outMin, lanes, sizeof(float) * 3);
+    _mm_storeu_ps(lanes, boundsMax);
+    memcpy(outMax, lanes, sizeof(float) * 3);
+}
+
 #endif
 
 
@@ -127,6 +127,12 @@ struct MemoryCounter {
         total -= value;
         count--;
     }
+
+    inline void set(uint64_t value, uint32_t number) {
+        total = value;
+        totalMax = std::max(totalMax, total);
+        count = number;
+    }
 };
 
 struct ObjectCounter {
@@ -179,6 +185,11 @@ struct MemoryStats {
         memories[name] = value;
     }
 
+    inline void update(const ccstd::string &name, uint64_t value, uint32_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        memories[name].set(value, count);
+    }
+
     inline void inc(const ccstd::string &name, uint64_t value) {
         std::lock_guard<std::mutex> lock(mutex);
         memories[name] += value;
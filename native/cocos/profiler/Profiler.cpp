@@ -24,6 +24,8 @@
  ****************************************************************************/
 
 #include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
 #if CC_USE_DEBUG_RENDERER
     #include "DebugRenderer.h"
 #endif
@@ -31,6 +33,7 @@
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/memory/MemoryHook.h"
+#include "base/memory/MemoryTag.h"
 #include "core/Root.h"
 #include "core/assets/Font.h"
 #include "gfx-base/GFXDevice.h"
@@ -120,10 +123,182 @@ struct ProfilerBlockDepth {
     uint32_t depth{0U};
 };
 
+/**
+ * ProfilerThreadTimeline: blocks closed on one thread, written by that thread only.
+ * The main thread collects them at the end of every captured frame, the write index is
+ * the only synchronization, so recording never takes a lock.
+ */
+class ProfilerThreadTimeline {
+public:
+    static constexpr uint32_t CAPACITY = 1U << 14U; // power of two
+    static constexpr uint32_t MAX_DEPTH = 64U;
+
+    ProfilerThreadTimeline(uint32_t index, ccstd::string name)
+    : _index(index), _name(std::move(name)), _events(CAPACITY) {}
+
+    inline void begin(const std::string_view &name, uint64_t time) {
+        if (_depth < MAX_DEPTH) {
+            _stack[_depth] = {name, time};
+        }
+        ++_depth;
+    }
+
+    inline void end(uint64_t time) {
+        --_depth;
+        if (_depth >= MAX_DEPTH) return;
+
+        const uint32_t writeIndex = _writeIndex.load(std::memory_order_relaxed);
+        auto &event = _events[writeIndex & (CAPACITY - 1)];
+        event.name = _stack[_depth].name;
+        event.begin = _stack[_depth].time;
+        event.end = time;
+        event.threadIndex = _index;
+        event.depth = _depth;
+        _writeIndex.store(writeIndex + 1, std::memory_order_release);
+    }
+
+    inline uint32_t getDepth() const { return _depth; }
+
+    // skip whatever was recorded before the capture started
+    inline void resetReadIndex() { _readIndex = _writeIndex.load(std::memory_order_acquire); }
+
+    // returns the number of events lost to overwrites
+    uint32_t collect(ccstd::vector<ProfilerTraceEvent> &outEvents) {
+        const uint32_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+        uint32_t readIndex = _readIndex;
+        uint32_t dropped = 0U;
+        if (writeIndex - readIndex > CAPACITY) {
+            dropped = writeIndex - readIndex - CAPACITY;
+            readIndex = writeIndex - CAPACITY;
+        }
+
+        const size_t first = outEvents.size();
+        for (uint32_t i = readIndex; i != writeIndex; ++i) {
+            outEvents.push_back(_events[i & (CAPACITY - 1)]);
+        }
+
+        // the owner thread keeps writing meanwhile, anything it may have overwritten is discarded
+        const uint32_t safeIndex = _writeIndex.load(std::memory_order_acquire) - CAPACITY + 1;
+        if (static_cast<int32_t>(safeIndex - readIndex) > 0) {
+            const uint32_t torn = std::min(safeIndex - readIndex, writeIndex - readIndex);
+            outEvents.erase(outEvents.begin() + static_cast<std::ptrdiff_t>(first), outEvents.begin() + static_cast<std::ptrdiff_t>(first + torn));
+            dropped += torn;
+        }
+
+        _readIndex = writeIndex;
+        return dropped;
+    }
+
+private:
+    struct OpenBlock {
+        std::string_view name;
+        uint64_t time{0U};
+    };
+
+    uint32_t _index{0U};
+    ccstd::string _name;
+    bool _released{false}; // the owner thread exited, guarded by the timelines mutex
+    ccstd::vector<ProfilerTraceEvent> _events;
+    std::atomic<uint32_t> _writeIndex{0U};
+    uint32_t _readIndex{0U}; // main thread only
+    uint32_t _depth{0U};     // owner thread only
+    OpenBlock _stack[MAX_DEPTH];
+
+    friend class Profiler;
+};
+
+namespace {
+
+std::atomic<uint32_t> profilerInstanceCounter{0U};
+
+template <typename T>
+void appendBytes(ccstd::vector<uint8_t> &buffer, const T &value) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void appendString(ccstd::vector<uint8_t> &buffer, const std::string_view &str) {
+    appendBytes(buffer, static_cast<uint32_t>(str.size()));
+    buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+void appendJsonString(ccstd::string &json, const std::string_view &str) {
+    json += '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') json += '\\';
+        json += c;
+    }
+    json += '"';
+}
+
+// metadata is an optional JSON object stored next to the trace events
+void writeChromeTrace(const ProfilerCapture &capture, const ccstd::string &metadata, ccstd::string &json) {
+    json.reserve(capture.events.size() * 96 + capture.counters.size() * 64 + metadata.size() + 256);
+    json += "{\"displayTimeUnit\":\"ms\",";
+    if (!metadata.empty()) {
+        json += "\"metadata\":";
+        json += metadata;
+        json += ',';
+    }
+    json += "\"traceEvents\":[\n";
+
+    char buffer[128];
+    bool first = true;
+    auto separate = [&]() {
+        if (!first) json += ",\n";
+        first = false;
+    };
+
+    for (uint32_t i = 0; i < capture.threadNames.size(); ++i) {
+        separate();
+        snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", i);
+        json += buffer;
+        appendJsonString(json, capture.threadNames[i]);
+        json += "}}";
+    }
+
+    // frames go onto their own track, after all the threads
+    const auto frameTrack = static_cast<uint32_t>(capture.threadNames.size());
+    separate();
+    snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"Frames\"}}", frameTrack);
+    json += buffer;
+    for (uint32_t i = 0; i < capture.frames.size(); ++i) {
+        const auto &frame = capture.frames[i];
+        separate();
+        snprintf(buffer, sizeof(buffer), "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":\"Frame %u\"}",
+                 frameTrack, static_cast<double>(frame.begin) * 1e-3, static_cast<double>(frame.end - frame.begin) * 1e-3, i);
+        json += buffer;
+    }
+
+    for (const auto &event : capture.events) {
+        separate();
+        snprintf(buffer, sizeof(buffer), "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+                 event.threadIndex, static_cast<double>(event.begin) * 1e-3, static_cast<double>(event.end - event.begin) * 1e-3);
+        json += buffer;
+        appendJsonString(json, event.name);
+        json += '}';
+    }
+
+    // counters are sampled at the end of each frame
+    for (const auto &counter : capture.counters) {
+        separate();
+        snprintf(buffer, sizeof(buffer), "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":", static_cast<double>(capture.frames[counter.frame].end) * 1e-3);
+        json += buffer;
+        appendJsonString(json, capture.counterNames[counter.name]);
+        snprintf(buffer, sizeof(buffer), ",\"args\":{\"value\":%u}}", counter.value);
+        json += buffer;
+    }
+    json += "\n]}\n";
+}
+
+} // namespace
+
 /**
  * Profiler
  */
 Profiler *Profiler::instance = nullptr;
+thread_local Profiler::ThreadSlot Profiler::threadSlot;
+
 Profiler *Profiler::getInstance() {
     return instance;
 }
@@ -132,13 +307,20 @@ Profiler::Profiler() {
     _mainThreadId = std::this_thread::get_id();
     _root = ccnew ProfilerBlock(nullptr, "MainThread");
     _current = _root;
+    _id = ++profilerInstanceCounter;
+    _epoch = std::chrono::steady_clock::now();
 
     Profiler::instance = this;
 }
 
 Profiler::~Profiler() {
+    if (_hitchWriter.joinable()) _hitchWriter.join();
     CC_SAFE_DELETE(_root);
     _current = nullptr;
+    for (auto *timeline : _timelines) {
+        CC_SAFE_DELETE(timeline);
+    }
+    _timelines.clear();
     Profiler::instance = nullptr;
 }
 
@@ -158,6 +340,7 @@ bool Profiler::isEnabled(ShowOption option) const {
 
 void Profiler::beginFrame() {
     _objectStats.onFrameBegin();
+    _frameBegin = getTimestamp();
 
     _current = _root;
     _root->onFrameBegin();
@@ -171,6 +354,12 @@ void Profiler::endFrame() {
     _root->onFrameEnd();
 
     _objectStats.onFrameEnd();
+
+    if (_recording.load(std::memory_order_relaxed)) {
+        const ProfilerTraceFrame frame{_frameBegin, getTimestamp()};
+        recordFrame(frame);
+        detectHitch(frame);
+    }
 }
 
 void Profiler::update() {
@@ -218,6 +407,22 @@ void Profiler::doFrameUpdate() {
 #if USE_MEMORY_LEAK_DETECTOR
     CC_PROFILE_MEMORY_UPDATE(HeapMemory, GMemoryHook.getTotalSize());
 #endif
+
+#if CC_USE_MEMORY_TAGGING
+    // live CC_MALLOC memory of every subsystem
+    static const auto TAG_STAT_NAMES = [] {
+        ccstd::vector<ccstd::string> names;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryTag::COUNT); ++i) {
+            names.emplace_back(StringUtil::format("Tag.%s", MemoryTracker::getTagName(static_cast<MemoryTag>(i))));
+        }
+        return names;
+    }();
+    auto &memoryStats = getInstance()->getMemoryStats();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryTag::COUNT); ++i) {
+        const auto tag = static_cast<MemoryTag>(i);
+        memoryStats.update(TAG_STAT_NAMES[i], MemoryTracker::getBytes(tag), MemoryTracker::getCount(tag));
+    }
+#endif
 }
 
 void Profiler::printStats() {
@@ -394,6 +599,10 @@ void Profiler::beginBlock(const std::string_view &name) {
         _current = _current->getOrCreateChild(name);
         _current->begin();
     }
+
+    if (_recording.load(std::memory_order_relaxed)) {
+        getThreadTimeline(true)->begin(name, getTimestamp());
+    }
 }
 
 void Profiler::endBlock() {
@@ -401,6 +610,388 @@ void Profiler::endBlock() {
         _current->end();
         _current = _current->_parent;
     }
+
+    // blocks opened before the recording started have no begin recorded
+    auto *timeline = getThreadTimeline(false);
+    if (timeline && timeline->getDepth()) {
+        timeline->end(getTimestamp());
+    }
+}
+
+uint64_t Profiler::getTimestamp() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+ProfilerThreadTimeline *Profiler::getThreadTimeline(bool create) {
+    auto &slot = threadSlot;
+    if (slot.profilerID == _id) {
+        return slot.timeline;
+    }
+    if (!create) return nullptr;
+
+    // once per thread, the lock is not on the recording path
+    std::lock_guard<std::mutex> lock(_timelinesMutex);
+    auto iter = std::find_if(_timelines.begin(), _timelines.end(), [](const ProfilerThreadTimeline *timeline) {
+        return timeline->_released;
+    });
+    if (iter != _timelines.end()) {
+        // events the exited thread left are still collected, on the same track
+        slot.timeline = *iter;
+        slot.timeline->_released = false;
+        slot.timeline->_depth = 0U;
+    } else {
+        slot.timeline = ccnew ProfilerThreadTimeline(static_cast<uint32_t>(_timelines.size()), "");
+        slot.timeline->resetReadIndex();
+        _timelines.push_back(slot.timeline);
+    }
+    const uint32_t index = slot.timeline->_index;
+    slot.timeline->_name = isMainThread() ? ccstd::string("MainThread") : StringUtil::format("Thread %u", index);
+    slot.profilerID = _id;
+    return slot.timeline;
+}
+
+Profiler::ThreadSlot::~ThreadSlot() {
+    // threads may outlive the profiler
+    auto *profiler = Profiler::instance;
+    if (!timeline || !profiler || profiler->_id != profilerID) return;
+
+    std::lock_guard<std::mutex> lock(profiler->_timelinesMutex);
+    timeline->_released = true;
+}
+
+void Profiler::setThreadName(const ccstd::string &name) {
+    auto *timeline = getThreadTimeline(true);
+    std::lock_guard<std::mutex> lock(_timelinesMutex);
+    timeline->_name = name;
+}
+
+void Profiler::beginCapture(uint32_t maxFrames) {
+    if (isCapturing()) return;
+
+    _capture = {};
+    _captureFramesLeft = maxFrames;
+    _capturing = true;
+    updateRecording();
+}
+
+void Profiler::endCapture() {
+    if (!isCapturing()) return;
+    _capturing = false;
+    updateRecording();
+
+    _capture.droppedEvents += collectTimelines(_capture.events);
+    {
+        std::lock_guard<std::mutex> lock(_timelinesMutex);
+        _capture.threadNames.clear();
+        for (auto *timeline : _timelines) {
+            _capture.threadNames.push_back(timeline->_name);
+        }
+    }
+    _capture.counterNames = _counterNames;
+
+    std::stable_sort(_capture.events.begin(), _capture.events.end(), [](const ProfilerTraceEvent &lhs, const ProfilerTraceEvent &rhs) {
+        return lhs.begin < rhs.begin || (lhs.begin == rhs.begin && lhs.depth < rhs.depth);
+    });
+
+    if (_capture.droppedEvents) {
+        CC_LOG_WARNING("Profiler: %u events dropped during the capture, thread buffers overflowed within a frame", _capture.droppedEvents);
+    }
+}
+
+void Profiler::setHitchDetection(const ProfilerHitchOptions &options) {
+    _hitchOptions = options;
+    // the hitched frame has to stay in the history until the dump
+    _hitchOptions.historyFrames = std::max(options.historyFrames, HITCH_DUMP_DELAY + 1U);
+    _history.clear();
+    _history.resize(_hitchOptions.thresholdMs > 0.F ? _hitchOptions.historyFrames : 0U);
+    _historyHead = 0U;
+    _historySize = 0U;
+    _framesToHitchDump = 0U;
+    _framesSinceHitchDump = _hitchOptions.historyFrames;
+    _lastFrameEnd = 0U;
+    updateRecording();
+}
+
+void Profiler::updateRecording() {
+    const bool recording = _capturing || _hitchOptions.thresholdMs > 0.F;
+    if (recording && !_recording.load(std::memory_order_relaxed)) {
+        // skip whatever was recorded before
+        std::lock_guard<std::mutex> lock(_timelinesMutex);
+        for (auto *timeline : _timelines) {
+            timeline->resetReadIndex();
+        }
+    }
+    _recording.store(recording, std::memory_order_relaxed);
+}
+
+uint32_t Profiler::collectTimelines(ccstd::vector<ProfilerTraceEvent> &outEvents) {
+    uint32_t dropped = 0U;
+    std::lock_guard<std::mutex> lock(_timelinesMutex);
+    for (auto *timeline : _timelines) {
+        dropped += timeline->collect(outEvents);
+    }
+    return dropped;
+}
+
+uint32_t Profiler::getCounterName(ccstd::unordered_map<ccstd::string, uint32_t> &indices, const char *category, const ccstd::string &name) {
+    auto iter = indices.find(name);
+    if (iter != indices.end()) return iter->second;
+
+    auto index = static_cast<uint32_t>(_counterNames.size());
+    _counterNames.push_back(StringUtil::format("%s.%s", category, name.c_str()));
+    indices.emplace(name, index);
+    return index;
+}
+
+void Profiler::recordFrame(const ProfilerTraceFrame &frame) {
+    HistoryFrame *history = nullptr;
+    uint32_t dropped = 0U;
+    if (!_history.empty()) {
+        // overwrite the oldest entry, its vectors keep their capacity
+        history = &_history[_historyHead];
+        _historyHead = (_historyHead + 1) % static_cast<uint32_t>(_history.size());
+        _historySize = std::min(_historySize + 1, static_cast<uint32_t>(_history.size()));
+
+        history->frame = frame;
+        history->events.clear();
+        history->counters.clear();
+        dropped = collectTimelines(history->events);
+        for (const auto &iter : _objectStats.renders) {
+            history->counters.emplace_back(getCounterName(_renderCounterIndices, "renders", iter.first), iter.second.lastTotal);
+        }
+        for (const auto &iter : _objectStats.objects) {
+            history->counters.emplace_back(getCounterName(_objectCounterIndices, "objects", iter.first), iter.second.lastTotal);
+        }
+    }
+
+    if (!isCapturing()) return;
+
+    const auto frameIndex = static_cast<uint32_t>(_capture.frames.size());
+    _capture.frames.push_back(frame);
+    if (history) {
+        _capture.events.insert(_capture.events.end(), history->events.begin(), history->events.end());
+        for (const auto &counter : history->counters) {
+            _capture.counters.push_back({frameIndex, counter.first, counter.second});
+        }
+        _capture.droppedEvents += dropped;
+    } else {
+        _capture.droppedEvents += collectTimelines(_capture.events);
+        for (const auto &iter : _objectStats.renders) {
+            _capture.counters.push_back({frameIndex, getCounterName(_renderCounterIndices, "renders", iter.first), iter.second.lastTotal});
+        }
+        for (const auto &iter : _objectStats.objects) {
+            _capture.counters.push_back({frameIndex, getCounterName(_objectCounterIndices, "objects", iter.first), iter.second.lastTotal});
+        }
+    }
+
+    if (_captureFramesLeft && --_captureFramesLeft == 0U) {
+        endCapture();
+    }
+}
+
+void Profiler::detectHitch(const ProfilerTraceFrame &frame) {
+    if (_history.empty()) return;
+    ++_framesSinceHitchDump;
+
+    if (_framesToHitchDump) {
+        _lastFrameEnd = frame.end;
+        if (--_framesToHitchDump == 0U) {
+            dumpHitch();
+            // the snapshot still takes some time, don't let it count towards the next frame
+            _lastFrameEnd = 0U;
+        }
+        return;
+    }
+
+    // frame to frame, so stalls outside of beginFrame / endFrame count as well
+    const uint64_t lastFrameEnd = _lastFrameEnd;
+    _lastFrameEnd = frame.end;
+    const float frameTimeMs = static_cast<float>(frame.end - (lastFrameEnd ? lastFrameEnd : frame.begin)) * 1e-6F;
+    if (frameTimeMs <= _hitchOptions.thresholdMs) return;
+
+    ++_hitchCount;
+    // one dump per history length, a burst of hitches ends up in the same file anyway
+    if (_framesSinceHitchDump < _history.size()) return;
+
+    CC_LOG_WARNING("Profiler: %.1fms frame over the %.1fms threshold, dumping the last %u frames", frameTimeMs, _hitchOptions.thresholdMs, _historySize);
+    // the block tree and the stats are only valid for this very frame
+    _hitchStats = getStatsJson(frameTimeMs);
+    _framesToHitchDump = HITCH_DUMP_DELAY;
+    _framesSinceHitchDump = 0U;
+}
+
+void Profiler::dumpHitch() {
+    // only the snapshot of the history happens here, sorting, serializing and writing it is left to a worker thread
+    ProfilerCapture capture;
+    {
+        std::lock_guard<std::mutex> lock(_timelinesMutex);
+        for (auto *timeline : _timelines) {
+            capture.threadNames.push_back(timeline->_name);
+        }
+    }
+    capture.counterNames = _counterNames;
+
+    const auto historyCount = static_cast<uint32_t>(_history.size());
+    for (uint32_t i = 0; i < _historySize; ++i) {
+        const auto &history = _history[(_historyHead + historyCount - _historySize + i) % historyCount];
+        capture.frames.push_back(history.frame);
+        capture.events.insert(capture.events.end(), history.events.begin(), history.events.end());
+        for (const auto &counter : history.counters) {
+            capture.counters.push_back({i, counter.first, counter.second});
+        }
+    }
+
+    auto *fileUtils = FileUtils::getInstance();
+    ccstd::string directory = _hitchOptions.directory.empty() ? fileUtils->getWritablePath() : _hitchOptions.directory;
+    if (!directory.empty() && directory.back() != '/') directory += '/';
+    ccstd::string path = StringUtil::format("%shitch-%u.json", directory.c_str(), _hitchCount);
+
+    // dumps are at least a history length apart, so the previous one is long done by now
+    if (_hitchWriter.joinable()) _hitchWriter.join();
+    _hitchWriter = std::thread([capture = std::move(capture), stats = std::move(_hitchStats), path = std::move(path)]() mutable {
+        std::stable_sort(capture.events.begin(), capture.events.end(), [](const ProfilerTraceEvent &lhs, const ProfilerTraceEvent &rhs) {
+            return lhs.begin < rhs.begin || (lhs.begin == rhs.begin && lhs.depth < rhs.depth);
+        });
+
+        ccstd::string json;
+        writeChromeTrace(capture, stats, json);
+        if (!FileUtils::getInstance()->writeStringToFile(json, path)) {
+            CC_LOG_WARNING("Profiler: failed to write %s", path.c_str());
+            return;
+        }
+        CC_LOG_INFO("Profiler: hitch dumped to %s", path.c_str());
+    });
+    _hitchStats.clear();
+}
+
+ccstd::string Profiler::getStatsJson(float frameTimeMs) {
+    ccstd::string json;
+    json += StringUtil::format("{\"frameTimeMs\":%.3f,\"thresholdMs\":%.3f,", frameTimeMs, _hitchOptions.thresholdMs);
+
+    json += StringUtil::format("\"coreStats\":{\"fps\":%u,\"frameTime\":%.3f,\"gfx\":", _coreStats.fps, _coreStats.frameTime);
+    appendJsonString(json, _coreStats.gfx);
+    json += StringUtil::format(",\"multiThread\":%s,\"occlusionQuery\":%s,\"shadowMap\":%s,\"screenWidth\":%u,\"screenHeight\":%u},",
+                               _coreStats.multiThread ? "true" : "false", _coreStats.occlusionQuery ? "true" : "false",
+                               _coreStats.shadowMap ? "true" : "false", _coreStats.screenWidth, _coreStats.screenHeight);
+
+    // main thread block tree of the hitched frame, in microseconds
+    std::vector<ProfilerBlockDepth> blocks;
+    for (auto *child : _root->_children) {
+        gatherBlocks(child, 0U, blocks);
+    }
+    json += "\"blocks\":[";
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const auto *block = blocks[i].block;
+        json += i ? ",{\"name\":" : "{\"name\":";
+        appendJsonString(json, block->_name);
+        json += StringUtil::format(",\"depth\":%u,\"time\":%llu,\"max\":%llu,\"count\":%u}", blocks[i].depth,
+                                   static_cast<unsigned long long>(block->_item.time), static_cast<unsigned long long>(block->_item.max), block->_item.count);
+    }
+    json += "],";
+
+    auto appendObjectCounters = [&json](const char *key, const ccstd::unordered_map<ccstd::string, ObjectCounter> &counters) {
+        json += StringUtil::format("\"%s\":{", key);
+        bool first = true;
+        for (const auto &iter : counters) {
+            if (!first) json += ',';
+            first = false;
+            appendJsonString(json, iter.first);
+            json += StringUtil::format(":{\"total\":%u,\"totalMax\":%u}", iter.second.lastTotal, iter.second.totalMax);
+        }
+        json += '}';
+    };
+    appendObjectCounters("renders", _objectStats.renders);
+    json += ',';
+    appendObjectCounters("objects", _objectStats.objects);
+
+    json += ",\"memories\":{";
+    {
+        std::lock_guard<std::mutex> lock(_memoryStats.mutex);
+        bool first = true;
+        for (const auto &iter : _memoryStats.memories) {
+            if (!first) json += ',';
+            first = false;
+            appendJsonString(json, iter.first);
+            json += StringUtil::format(":{\"total\":%llu,\"count\":%u,\"totalMax\":%llu}", static_cast<unsigned long long>(iter.second.total),
+                                       iter.second.count, static_cast<unsigned long long>(iter.second.totalMax));
+        }
+    }
+    json += "}}";
+    return json;
+}
+
+bool Profiler::exportChromeTrace(const ccstd::string &path) const {
+    ccstd::string json;
+    writeChromeTrace(_capture, {}, json);
+    if (!FileUtils::getInstance()->writeStringToFile(json, path)) {
+        CC_LOG_WARNING("Profiler: failed to write %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Profiler::exportBinaryCapture(const ccstd::string &path) const {
+    static constexpr uint32_t CAPTURE_MAGIC = 0x46504343; // "CCPF"
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    // event names are interned, every event then costs 24 bytes
+    ccstd::unordered_map<std::string_view, uint32_t> nameIndices;
+    ccstd::vector<std::string_view> names;
+    for (const auto &event : _capture.events) {
+        if (nameIndices.emplace(event.name, static_cast<uint32_t>(names.size())).second) {
+            names.push_back(event.name);
+        }
+    }
+
+    ccstd::vector<uint8_t> buffer;
+    buffer.reserve(_capture.events.size() * 24 + 1024);
+    appendBytes(buffer, CAPTURE_MAGIC);
+    appendBytes(buffer, FORMAT_VERSION);
+    appendBytes(buffer, _capture.droppedEvents);
+
+    appendBytes(buffer, static_cast<uint32_t>(_capture.threadNames.size()));
+    for (const auto &name : _capture.threadNames) {
+        appendString(buffer, name);
+    }
+
+    appendBytes(buffer, static_cast<uint32_t>(names.size()));
+    for (const auto &name : names) {
+        appendString(buffer, name);
+    }
+
+    appendBytes(buffer, static_cast<uint32_t>(_capture.events.size()));
+    for (const auto &event : _capture.events) {
+        appendBytes(buffer, event.begin);
+        appendBytes(buffer, static_cast<uint32_t>(event.end - event.begin));
+        appendBytes(buffer, nameIndices[event.name]);
+        appendBytes(buffer, static_cast<uint16_t>(event.threadIndex));
+        appendBytes(buffer, static_cast<uint16_t>(event.depth));
+        appendBytes(buffer, 0U); // reserved
+    }
+
+    appendBytes(buffer, static_cast<uint32_t>(_capture.frames.size()));
+    for (const auto &frame : _capture.frames) {
+        appendBytes(buffer, frame.begin);
+        appendBytes(buffer, frame.end);
+    }
+
+    appendBytes(buffer, static_cast<uint32_t>(_capture.counterNames.size()));
+    for (const auto &name : _capture.counterNames) {
+        appendString(buffer, name);
+    }
+
+    appendBytes(buffer, static_cast<uint32_t>(_capture.counters.size()));
+    for (const auto &counter : _capture.counters) {
+        appendBytes(buffer, counter);
+    }
+
+    Data data;
+    data.copy(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    if (!FileUtils::getInstance()->writeDataToFile(data, path)) {
+        CC_LOG_WARNING("Profiler: failed to write %s", path.c_str());
+        return false;
+    }
+    return true;
 }
 
 void Profiler::gatherBlocks(ProfilerBlock *parent, uint32_t depth, std::vector<ProfilerBlockDepth> &outBlocks) { //NOLINT(misc-no-recursion)
@@ -24,16 +24,21 @@
  ****************************************************************************/
 
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string_view>
 #include <thread>
 #include "GameStats.h"
 #include "base/Config.h"
 #include "base/Timer.h"
+#include "base/std/container/vector.h"
 #include "gfx-base/GFXDef-common.h"
 
 namespace cc {
 
 class ProfilerBlock;
+class ProfilerThreadTimeline;
 struct ProfilerBlockDepth;
 
 enum class ShowOption : uint32_t {
@@ -44,6 +49,49 @@ enum class ShowOption : uint32_t {
     ALL = CORE_STATS | MEMORY_STATS | OBJECT_STATS | PERFORMANCE_STATS,
 };
 
+/**
+ * A CC_PROFILE block recorded on any thread during a capture.
+ * Names are not copied, they are expected to be string literals as CC_PROFILE produces.
+ */
+struct ProfilerTraceEvent {
+    std::string_view name;
+    uint64_t begin{0U}; // nanoseconds since the profiler was created
+    uint64_t end{0U};
+    uint32_t threadIndex{0U};
+    uint32_t depth{0U};
+};
+
+struct ProfilerTraceFrame {
+    uint64_t begin{0U};
+    uint64_t end{0U};
+};
+
+// value of a CC_PROFILE_RENDER_* / CC_PROFILE_OBJECT_* counter at the end of a frame
+struct ProfilerCounterSample {
+    uint32_t frame{0U}; // index into ProfilerCapture::frames
+    uint32_t name{0U};  // index into ProfilerCapture::counterNames
+    uint32_t value{0U};
+};
+
+// hitch detection is off while thresholdMs is 0
+struct ProfilerHitchOptions {
+    float thresholdMs{0.F};
+    uint32_t historyFrames{60U};
+    ccstd::string directory; // the writable path if empty
+};
+
+/**
+ * All the threads merged into one timeline, events are sorted by begin time once the capture ends.
+ */
+struct ProfilerCapture {
+    ccstd::vector<ccstd::string> threadNames;
+    ccstd::vector<ProfilerTraceEvent> events;
+    ccstd::vector<ProfilerTraceFrame> frames;
+    ccstd::vector<ccstd::string> counterNames;
+    ccstd::vector<ProfilerCounterSample> counters;
+    uint32_t droppedEvents{0U}; // overwritten in a thread buffer before the frame end collected them
+};
+
 /**
  * Profiler
  */
@@ -69,6 +117,25 @@ public:
     inline MemoryStats &getMemoryStats() { return _memoryStats; }
     inline ObjectStats &getObjectStats() { return _objectStats; }
 
+    // records the CC_PROFILE blocks of every thread, stops by itself after maxFrames if not 0
+    void beginCapture(uint32_t maxFrames = 0U);
+    void endCapture();
+    inline bool isCapturing() const { return _capturing; }
+    inline const ProfilerCapture &getCapture() const { return _capture; }
+    // names the calling thread in captures, meant to be called where the thread starts
+    void setThreadName(const ccstd::string &name);
+
+    // keeps the last historyFrames frames of blocks and counters around and dumps them to disk,
+    // along with the block tree and the stats, whenever a frame takes longer than thresholdMs
+    void setHitchDetection(const ProfilerHitchOptions &options);
+    inline const ProfilerHitchOptions &getHitchDetection() const { return _hitchOptions; }
+    inline uint32_t getHitchCount() const { return _hitchCount; }
+
+    // chrome://tracing or Perfetto compatible trace event JSON
+    bool exportChromeTrace(const ccstd::string &path) const;
+    // compact binary capture: header, thread names, string table, events, frames and counters
+    bool exportBinaryCapture(const ccstd::string &path) const;
+
 private:
     static void doFrameUpdate();
 
@@ -79,7 +146,34 @@ private:
     void endBlock();
     void gatherBlocks(ProfilerBlock *parent, uint32_t depth, std::vector<ProfilerBlockDepth> &outBlocks);
 
+    // lets the other threads finish the hitched frame before dumping it
+    static constexpr uint32_t HITCH_DUMP_DELAY = 2U;
+
+    struct HistoryFrame {
+        ProfilerTraceFrame frame;
+        ccstd::vector<ProfilerTraceEvent> events;
+        ccstd::vector<std::pair<uint32_t, uint32_t>> counters; // name, value
+    };
+
+    // the timeline of the calling thread, handed back to the profiler for reuse when the thread exits
+    struct ThreadSlot {
+        uint32_t profilerID{0U};
+        ProfilerThreadTimeline *timeline{nullptr};
+        ~ThreadSlot();
+    };
+
+    ProfilerThreadTimeline *getThreadTimeline(bool create);
+    uint32_t collectTimelines(ccstd::vector<ProfilerTraceEvent> &outEvents);
+    void recordFrame(const ProfilerTraceFrame &frame);
+    void detectHitch(const ProfilerTraceFrame &frame);
+    void dumpHitch();
+    void updateRecording();
+    uint32_t getCounterName(ccstd::unordered_map<ccstd::string, uint32_t> &indices, const char *category, const ccstd::string &name);
+    ccstd::string getStatsJson(float frameTimeMs);
+    uint64_t getTimestamp() const;
+
     static Profiler *instance;
+    static thread_local ThreadSlot threadSlot;
     uint32_t _options{static_cast<uint32_t>(ShowOption::ALL)};
     utils::Timer _timer;
     CoreStats _coreStats;
@@ -89,6 +183,30 @@ private:
     ProfilerBlock *_current{nullptr};
     std::thread::id _mainThreadId;
 
+    uint32_t _id{0U};
+    std::chrono::steady_clock::time_point _epoch;
+    std::atomic<bool> _recording{false}; // capturing or detecting hitches
+    bool _capturing{false};
+    uint32_t _captureFramesLeft{0U};
+    uint64_t _frameBegin{0U};
+    ProfilerCapture _capture;
+
+    ProfilerHitchOptions _hitchOptions;
+    ccstd::vector<HistoryFrame> _history; // ring of historyFrames entries
+    uint32_t _historyHead{0U};
+    uint32_t _historySize{0U};
+    uint32_t _framesToHitchDump{0U}; // waits for the other threads to finish the hitched frame
+    uint32_t _framesSinceHitchDump{0U};
+    uint32_t _hitchCount{0U};
+    uint64_t _lastFrameEnd{0U};
+    ccstd::string _hitchStats; // taken when the hitch is detected, written with the dump
+    std::thread _hitchWriter;  // serializes and writes the last dump off the main thread
+    ccstd::unordered_map<ccstd::string, uint32_t> _renderCounterIndices;
+    ccstd::unordered_map<ccstd::string, uint32_t> _objectCounterIndices;
+    ccstd::vector<ccstd::string> _counterNames;
+    ccstd::vector<ProfilerThreadTimeline *> _timelines; // timelines of exited threads are reused, never freed
+    std::mutex _timelinesMutex;
+
     friend class AutoProfiler;
 };
 
@@ -137,6 +255,10 @@ private:
         if (CC_PROFILER) {           \
             CC_PROFILER->endFrame(); \
         }
+    #define CC_PROFILER_SET_THREAD_NAME(name)   \
+        if (CC_PROFILER) {                      \
+            CC_PROFILER->setThreadName((name)); \
+        }
     #define CC_PROFILE(name) cc::AutoProfiler auto_profiler_##name(CC_PROFILER, #name)
     #define CC_PROFILE_MEMORY_UPDATE(name, count)                 \
         if (CC_PROFILER) {                                        \
@@ -181,6 +303,7 @@ private:
     #define CC_PROFILER_UPDATE
     #define CC_PROFILER_BEGIN_FRAME
     #define CC_PROFILER_END_FRAME
+    #define CC_PROFILER_SET_THREAD_NAME(name)
     #define CC_PROFILE(name)
     #define CC_PROFILE_MEMORY_UPDATE(name, count)
     #define CC_PROFILE_MEMORY_INC(name, count)
@@ -219,19 +219,28 @@ void DevicePass::execute() {
         for (LogicPass &pass : subpass.logicPasses) {
             gfx::Viewport &viewport = pass.customViewport ? pass.viewport : _viewport;
             gfx::Rect &scissor = pass.customViewport ? pass.scissor : _scissor;
-
-            if (viewport != _curViewport) {
-                cmdBuff->setViewport(viewport);
-                _curViewport = viewport;
-            }
-            if (scissor != _curScissor) {
-                cmdBuff->setScissor(scissor);
-                _curScissor = scissor;
+            _resourceTable._viewport = viewport;
+            _resourceTable._scissor = scissor;
+
+            if (_resourceTable._secondaryCommandBuffers) {
+                // the primary command buffer may only execute the secondary ones in this subpass
+                _curViewport = {};
+                _curScissor = {};
+            } else {
+                if (viewport != _curViewport) {
+                    cmdBuff->setViewport(viewport);
+                    _curViewport = viewport;
+                }
+                if (scissor != _curScissor) {
+                    cmdBuff->setScissor(scissor);
+                    _curScissor = scissor;
+                }
             }
 
             pass.pass->execute(_resourceTable);
         }
 
+        _resourceTable._secondaryCommandBuffers = nullptr;
         if (i < _subpasses.size() - 1) next(cmdBuff);
     }
 
@@ -249,6 +258,7 @@ void DevicePass::append(const FrameGraph &graph, const PassNode *passNode, ccstd
         logicPass.customViewport = passNode->_customViewport;
         logicPass.viewport = passNode->_viewport;
         logicPass.scissor = passNode->_scissor;
+        logicPass.secondaryCommandBuffers = passNode->_secondaryCommandBuffers.empty() ? nullptr : &passNode->_secondaryCommandBuffers;
 
         for (const auto &attachment : passNode->_attachments) {
             append(graph, attachment, attachments, &subpass.desc, passNode->_reads);
@@ -337,6 +347,7 @@ void DevicePass::append(const FrameGraph &graph, const RenderTargetAttachment &a
 }
 
 void DevicePass::begin(gfx::CommandBuffer *cmdBuff) {
+    _resourceTable._secondaryCommandBuffers = nullptr;
     if (_attachments.empty()) return;
 
     gfx::RenderPassInfo rpInfo;
@@ -418,7 +429,17 @@ void DevicePass::begin(gfx::CommandBuffer *cmdBuff) {
     _fbo = Framebuffer(fboInfo);
     _fbo.createTransient();
 
-    cmdBuff->beginRenderPass(_renderPass.get(), _fbo.get(), _scissor, clearColors.data(), clearDepth, clearStencil);
+    // secondary command buffers are only used when the render pass is a single subpass holding a single pass:
+    // the subpass contents chosen at beginRenderPass carry over to every following subpass,
+    // which would then have to be recorded through secondary command buffers as well
+    const LogicPass &firstPass = _subpasses[0].logicPasses[0];
+    if (firstPass.secondaryCommandBuffers && _subpasses.size() == 1 && _subpasses[0].logicPasses.size() == 1) {
+        _resourceTable._secondaryCommandBuffers = firstPass.secondaryCommandBuffers;
+    }
+
+    const auto *secondaryCBs = _resourceTable._secondaryCommandBuffers;
+    cmdBuff->beginRenderPass(_renderPass.get(), _fbo.get(), _scissor, clearColors.data(), clearDepth, clearStencil,
+                             secondaryCBs ? secondaryCBs->data() : nullptr, secondaryCBs ? utils::toUint(secondaryCBs->size()) : 0);
     _curViewport = _viewport;
     _curScissor = _scissor;
 }
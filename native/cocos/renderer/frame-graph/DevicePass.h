@@ -53,6 +53,7 @@ private:
         bool customViewport{false};
         gfx::Viewport viewport;
         gfx::Rect scissor;
+        const ccstd::vector<gfx::CommandBuffer *> *secondaryCommandBuffers{nullptr};
     };
 
     struct Subpass final {
@@ -56,6 +56,11 @@ public:
 
     gfx::RenderPass *getRenderPass() const { return _renderPass; }
     uint32_t getSubpassIndex() const { return _subpassIndex; }
+    const gfx::Viewport &getViewport() const { return _viewport; }
+    const gfx::Rect &getScissor() const { return _scissor; }
+    // not null if the pass has to be recorded into these secondary command buffers and executed by the primary one,
+    // in which case none of the render pass states, viewport and scissor included, are inherited
+    const ccstd::vector<gfx::CommandBuffer *> *getSecondaryCommandBuffers() const { return _secondaryCommandBuffers; }
 
 private:
     using ResourceDictionary = ccstd::unordered_map<Handle, gfx::GFXObject *, Handle::Hasher>;
@@ -69,6 +74,9 @@ private:
 
     gfx::RenderPass *_renderPass{nullptr};
     uint32_t _subpassIndex{0U};
+    gfx::Viewport _viewport;
+    gfx::Rect _scissor;
+    const ccstd::vector<gfx::CommandBuffer *> *_secondaryCommandBuffers{nullptr};
 
     friend class DevicePass;
 };
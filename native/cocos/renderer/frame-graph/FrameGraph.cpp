@@ -125,6 +125,11 @@ void FrameGraph::compile() {
     }
 
     computeStoreActionAndMemoryless();
+
+    if (_aliasing) {
+        planTransientAliasing();
+    }
+
     generateDevicePasses();
 }
 
@@ -140,6 +145,7 @@ void FrameGraph::reset() noexcept {
     _resourceNodes.clear();
     _virtualResources.clear();
     _devicePasses.clear();
+    _transientResources.clear();
     _blackboard.clear();
 }
 
@@ -297,6 +303,10 @@ void FrameGraph::computeResourceLifetime() {
 
         resource->_firstUsePass->_resourceRequestArray.push_back(resource.get());
         resource->_lastUsePass->_resourceReleaseArray.push_back(resource.get());
+
+        if (!resource->isImported()) {
+            _transientResources.push_back(resource.get());
+        }
     }
 }
 
@@ -431,6 +441,105 @@ void FrameGraph::computeStoreActionAndMemoryless() {
     }
 }
 
+void FrameGraph::planTransientAliasing() {
+    _transientMemoryStats = {};
+
+    if (_transientResources.empty()) {
+        return;
+    }
+
+    // resources are requested before their first device pass and released after their last one,
+    // so two of them can share a device resource if one is last used before the other is first used
+    std::stable_sort(_transientResources.begin(), _transientResources.end(), [](const VirtualResource *x, const VirtualResource *y) {
+        return x->_firstUsePass->_devicePassId < y->_firstUsePass->_devicePassId;
+    });
+
+    const size_t count = _transientResources.size();
+    ID lastDevicePassId = 0;
+
+    for (const VirtualResource *const resource : _transientResources) {
+        lastDevicePassId = std::max(lastDevicePassId, resource->_lastUsePass->_devicePassId);
+        _transientMemoryStats.unaliasedBytes += resource->getTransientBytes();
+    }
+
+    auto &deltas = _liveByteDeltas;
+    deltas.assign(lastDevicePassId + 2, 0);
+
+    for (const VirtualResource *const resource : _transientResources) {
+        const auto bytes = static_cast<int64_t>(resource->getTransientBytes());
+        deltas[resource->_firstUsePass->_devicePassId] += bytes;
+        deltas[resource->_lastUsePass->_devicePassId + 1] -= bytes;
+    }
+
+    int64_t liveBytes = 0;
+
+    for (const int64_t delta : deltas) {
+        liveBytes += delta;
+        _transientMemoryStats.peakBytes = std::max(_transientMemoryStats.peakBytes, static_cast<uint64_t>(liveBytes));
+    }
+
+    // the allocator already hands a released resource to a later request with an identical descriptor,
+    // this is what the frame would cost without planning
+    auto &baselineGroups = _baselineGroups;
+    baselineGroups.clear();
+
+    for (VirtualResource *const resource : _transientResources) {
+        ID const firstUse = resource->_firstUsePass->_devicePassId;
+        ID const lastUse = resource->_lastUsePass->_devicePassId;
+
+        const auto it = std::find_if(baselineGroups.begin(), baselineGroups.end(), [&](const AliasingGroup &group) {
+            return group.lastUse < firstUse && group.head->hasSameDescriptor(*resource);
+        });
+
+        if (it == baselineGroups.end()) {
+            baselineGroups.push_back({resource, lastUse});
+            _transientMemoryStats.baselineBytes += resource->getTransientBytes();
+        } else {
+            it->lastUse = lastUse;
+        }
+    }
+
+    // the group head accumulates the merged descriptor (e.g. the largest buffer) as members join,
+    // so later candidates are checked against what will actually be allocated
+    auto &groups = _aliasingGroups;
+    auto &groupIndices = _aliasingGroupIndices;
+    groups.clear();
+    groupIndices.clear();
+
+    for (VirtualResource *const resource : _transientResources) {
+        ID const firstUse = resource->_firstUsePass->_devicePassId;
+        ID const lastUse = resource->_lastUsePass->_devicePassId;
+
+        const auto it = std::find_if(groups.begin(), groups.end(), [&](const AliasingGroup &group) {
+            return group.lastUse < firstUse && group.head->canAlias(*resource);
+        });
+
+        if (it == groups.end()) {
+            groupIndices.push_back(static_cast<uint32_t>(groups.size()));
+            groups.push_back({resource, lastUse});
+        } else {
+            groupIndices.push_back(static_cast<uint32_t>(it - groups.begin()));
+            it->head->mergeDescriptor(*resource);
+            it->lastUse = lastUse;
+        }
+    }
+
+    // all members of a group end up with the same descriptor, so the allocator hands them the same device resource
+    for (size_t i = 0; i < count; ++i) {
+        VirtualResource *const head = groups[groupIndices[i]].head;
+        if (head != _transientResources[i]) {
+            _transientResources[i]->mergeDescriptor(*head);
+        }
+    }
+
+    for (const AliasingGroup &group : groups) {
+        _transientMemoryStats.allocatedBytes += group.head->getTransientBytes();
+    }
+
+    _transientMemoryStats.resourceCount = static_cast<uint32_t>(count);
+    _transientMemoryStats.allocationCount = static_cast<uint32_t>(groups.size());
+}
+
 void FrameGraph::generateDevicePasses() {
     Buffer::Allocator::getInstance().tick();
     Framebuffer::Allocator::getInstance().tick();
@@ -439,7 +548,7 @@ void FrameGraph::generateDevicePasses() {
 
     ID passId = 1;
 
-    static ccstd::vector<PassNode *> subpassNodes;
+    auto &subpassNodes = _subpassNodes;
     subpassNodes.clear();
 
     for (const auto &passNode : _passNodes) {
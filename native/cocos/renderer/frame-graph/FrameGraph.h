@@ -38,6 +38,15 @@
 namespace cc {
 namespace framegraph {
 
+struct TransientMemoryStats final {
+    uint64_t unaliasedBytes{0}; // if every transient resource had its own device resource
+    uint64_t baselineBytes{0};  // if the allocator only reused released resources of identical descriptors
+    uint64_t allocatedBytes{0}; // device resources actually used after aliasing
+    uint64_t peakBytes{0};      // largest amount of memory used by live transient resources at once
+    uint32_t resourceCount{0};
+    uint32_t allocationCount{0};
+};
+
 class FrameGraph final {
 public:
     using ResourceHandleBlackboard = Blackboard<StringHandle, Handle::IndexType, Handle::UNINITIALIZED>;
@@ -75,9 +84,16 @@ public:
 
     void exportGraphViz(const ccstd::string &path);
     inline void enableMerge(bool enable) noexcept;
+    inline void enableAliasing(bool enable) noexcept;
+    inline const TransientMemoryStats &getTransientMemoryStats() const noexcept { return _transientMemoryStats; }
     bool hasPass(StringHandle handle);
 
 private:
+    struct AliasingGroup {
+        VirtualResource *head{nullptr};
+        ID lastUse{0};
+    };
+
     Handle create(VirtualResource *virtualResource);
     PassNode &createPassNode(PassInsertPoint insertPoint, const StringHandle &name, Executable *pass);
     Handle createResourceNode(VirtualResource *virtualResource);
@@ -86,6 +102,7 @@ private:
     void computeResourceLifetime();
     void mergePassNodes() noexcept;
     void computeStoreActionAndMemoryless();
+    void planTransientAliasing();
     void generateDevicePasses();
     ResourceNode *getResourceNode(const VirtualResource *virtualResource, uint8_t version) noexcept;
 
@@ -93,8 +110,17 @@ private:
     ccstd::vector<ResourceNode> _resourceNodes{};
     ccstd::vector<std::unique_ptr<VirtualResource>> _virtualResources{};
     ccstd::vector<std::unique_ptr<DevicePass>> _devicePasses{};
+    ccstd::vector<VirtualResource *> _transientResources{};
     ResourceHandleBlackboard _blackboard;
+    TransientMemoryStats _transientMemoryStats{};
+    // scratch storage for compile(), cleared before each use
+    ccstd::vector<AliasingGroup> _aliasingGroups{};
+    ccstd::vector<uint32_t> _aliasingGroupIndices{};
+    ccstd::vector<AliasingGroup> _baselineGroups{};
+    ccstd::vector<int64_t> _liveByteDeltas{};
+    ccstd::vector<PassNode *> _subpassNodes{};
     bool _merge{true};
+    bool _aliasing{true};
 
     friend class PassNode;
     friend class PassNodeBuilder;
@@ -129,6 +155,10 @@ void FrameGraph::enableMerge(bool const enable) noexcept {
     _merge = enable;
 }
 
+void FrameGraph::enableAliasing(bool const enable) noexcept {
+    _aliasing = enable;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template <typename DescriptorType, typename ResourceType>
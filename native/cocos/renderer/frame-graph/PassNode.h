@@ -56,6 +56,7 @@ public:
     inline void sideEffect();
     inline void subpass(bool end, bool clearActionIgnorable);
     inline void setViewport(const gfx::Viewport &viewport, const gfx::Rect &scissor);
+    inline void setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs);
     inline const PassBarrierPair &getBarriers() const;
 
 private:
@@ -92,6 +93,8 @@ private:
     gfx::Viewport _viewport;
     gfx::Rect _scissor;
 
+    ccstd::vector<gfx::CommandBuffer *> _secondaryCommandBuffers{};
+
     PassBarrierPair _barriers;
 
     friend class FrameGraph;
@@ -121,5 +124,9 @@ void PassNode::setViewport(const gfx::Viewport &viewport, const gfx::Rect &sciss
     _scissor = scissor;
 }
 
+void PassNode::setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs) {
+    _secondaryCommandBuffers = cmdBuffs;
+}
+
 } // namespace framegraph
 } // namespace cc
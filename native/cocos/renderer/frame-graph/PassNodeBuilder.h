@@ -56,6 +56,8 @@ public:
     inline void setViewport(const gfx::Rect &scissor) noexcept;
     inline void setViewport(const gfx::Viewport &viewport, const gfx::Rect &scissor) noexcept;
     inline void setBarrier(const PassBarrierPair &barrier);
+    // ask to record the pass into these secondary command buffers, see DevicePassResourceTable::getSecondaryCommandBuffers
+    inline void setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs) noexcept;
 
     void writeToBlackboard(const StringHandle &name, const Handle &handle) const noexcept;
     Handle readFromBlackboard(const StringHandle &name) const noexcept;
@@ -100,5 +102,9 @@ void PassNodeBuilder::setBarrier(const PassBarrierPair &barrier) {
     _passNode.setBarrier(barrier);
 }
 
+void PassNodeBuilder::setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs) noexcept {
+    _passNode.setSecondaryCommandBuffers(cmdBuffs);
+}
+
 } // namespace framegraph
 } // namespace cc
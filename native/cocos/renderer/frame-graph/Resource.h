@@ -76,8 +76,11 @@ private:
 
     Descriptor _desc;
     DeviceResourceType *_deviceObject{nullptr};
+    uint32_t _allocatorSlot{Allocator::INVALID_SLOT};
 
     friend class FrameGraph;
+    template <typename ResourceType, typename Enable>
+    friend class ResourceEntry;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -94,7 +97,7 @@ Resource<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::Resourc
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 void Resource<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::createTransient() noexcept {
-    _deviceObject = Allocator::getInstance().alloc(_desc);
+    _deviceObject = Allocator::getInstance().alloc(_desc, _allocatorSlot);
 }
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
@@ -108,7 +111,8 @@ void Resource<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::cr
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 void Resource<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::destroyTransient() noexcept {
-    Allocator::getInstance().free(_deviceObject);
+    Allocator::getInstance().free(_allocatorSlot);
+    _allocatorSlot = Allocator::INVALID_SLOT;
     _deviceObject = nullptr;
 }
 
@@ -26,38 +26,156 @@
 #pragma once
 
 #include <algorithm>
-#include "base/RefVector.h"
+#include <functional>
+#include "base/Ptr.h"
 #include "base/memory/Memory.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
 namespace framegraph {
 
+struct ResourceAllocatorStats final {
+    uint32_t hits{0};
+    uint32_t misses{0};
+    uint32_t evictions{0};
+    uint32_t residentCount{0};
+    uint64_t residentBytes{0};
+};
+
+// How resources are pooled, how much memory they are accounted for
+// and which descriptors may be merged to share a device resource within a frame
+template <typename DescriptorType>
+struct ResourceAllocatorTraits final {
+    using Key = DescriptorType;
+    using KeyHasher = gfx::Hasher<DescriptorType>;
+    static const Key &getKey(const DescriptorType &desc) noexcept { return desc; }
+    static uint64_t getBytes(const DescriptorType & /*desc*/) noexcept { return 0; }
+    static bool canAlias(const DescriptorType & /*lhs*/, const DescriptorType & /*rhs*/) noexcept { return false; }
+    static void merge(DescriptorType & /*dst*/, const DescriptorType & /*src*/) noexcept {}
+};
+
+template <>
+struct ResourceAllocatorTraits<gfx::TextureInfo> final {
+    using Key = gfx::TextureInfo;
+    using KeyHasher = gfx::Hasher<gfx::TextureInfo>;
+    static const Key &getKey(const gfx::TextureInfo &desc) noexcept { return desc; }
+    // multisampled storage is not accounted for
+    static uint64_t getBytes(const gfx::TextureInfo &desc) noexcept {
+        return static_cast<uint64_t>(gfx::formatSurfaceSize(desc.format, desc.width, desc.height, desc.depth, desc.levelCount)) * desc.layerCount;
+    }
+    // usages are merged, but lazily allocated attachments only alias each other.
+    // extents must match: textures are sampled with normalized coordinates and
+    // render areas are taken from the texture, so a larger one cannot stand in
+    static bool canAlias(const gfx::TextureInfo &lhs, const gfx::TextureInfo &rhs) noexcept {
+        return lhs.type == rhs.type && lhs.format == rhs.format && lhs.width == rhs.width && lhs.height == rhs.height &&
+               lhs.flags == rhs.flags && lhs.layerCount == rhs.layerCount && lhs.levelCount == rhs.levelCount &&
+               lhs.samples == rhs.samples && lhs.depth == rhs.depth && !lhs.externalRes && !rhs.externalRes &&
+               hasAllFlags(gfx::TEXTURE_USAGE_TRANSIENT, lhs.usage) == hasAllFlags(gfx::TEXTURE_USAGE_TRANSIENT, rhs.usage);
+    }
+    static void merge(gfx::TextureInfo &dst, const gfx::TextureInfo &src) noexcept { dst.usage |= src.usage; }
+};
+
+template <>
+struct ResourceAllocatorTraits<gfx::BufferInfo> final {
+    using Key = gfx::BufferInfo;
+    using KeyHasher = gfx::Hasher<gfx::BufferInfo>;
+    static const Key &getKey(const gfx::BufferInfo &desc) noexcept { return desc; }
+    static uint64_t getBytes(const gfx::BufferInfo &desc) noexcept { return desc.size; }
+    // buffers of different sizes share the largest one, except uniform and indirect
+    // buffers which are consumed by their whole range
+    static bool canAlias(const gfx::BufferInfo &lhs, const gfx::BufferInfo &rhs) noexcept {
+        if (lhs.memUsage != rhs.memUsage || lhs.flags != rhs.flags) {
+            return false;
+        }
+        if (hasAnyFlags(lhs.usage | rhs.usage, gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::INDIRECT)) {
+            return lhs.size == rhs.size && lhs.stride == rhs.stride;
+        }
+        return lhs.stride == rhs.stride || (lhs.stride == lhs.size && rhs.stride == rhs.size);
+    }
+    static void merge(gfx::BufferInfo &dst, const gfx::BufferInfo &src) noexcept {
+        bool const wholeStride = dst.stride == dst.size && src.stride == src.size;
+        dst.usage |= src.usage;
+        dst.size = std::max(dst.size, src.size);
+        if (wholeStride) {
+            dst.stride = dst.size;
+        }
+    }
+};
+
+template <>
+struct ResourceAllocatorTraits<gfx::FramebufferInfo> final {
+    using Key = ccstd::hash_t;
+    using KeyHasher = std::hash<ccstd::hash_t>;
+    static Key getKey(const gfx::FramebufferInfo &desc) noexcept { return gfx::Hasher<gfx::FramebufferInfo>()(desc); }
+    static uint64_t getBytes(const gfx::FramebufferInfo & /*desc*/) noexcept { return 0; }
+    static bool canAlias(const gfx::FramebufferInfo & /*lhs*/, const gfx::FramebufferInfo & /*rhs*/) noexcept { return false; }
+    static void merge(gfx::FramebufferInfo & /*dst*/, const gfx::FramebufferInfo & /*src*/) noexcept {}
+};
+
+// Pools transient device resources by descriptor.
+// Released resources are kept in a free list per descriptor and in a global list ordered by release time,
+// so both reuse and eviction of the least recently used resources are O(1).
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 class ResourceAllocator final {
 public:
     using DeviceResourceCreator = DeviceResourceCreatorType;
 
+    static constexpr uint32_t INVALID_SLOT{0xFFFFFFFF};
+
     ResourceAllocator(const ResourceAllocator &) = delete;
     ResourceAllocator(ResourceAllocator &&) noexcept = delete;
     ResourceAllocator &operator=(const ResourceAllocator &) = delete;
     ResourceAllocator &operator=(ResourceAllocator &&) noexcept = delete;
 
     static ResourceAllocator &getInstance() noexcept;
-    DeviceResourceType *alloc(const DescriptorType &desc) noexcept;
-    void free(DeviceResourceType *resource) noexcept;
+    // slot identifies the allocation and must be passed back to free
+    DeviceResourceType *alloc(const DescriptorType &desc, uint32_t &slot) noexcept;
+    void free(uint32_t slot) noexcept;
     inline void tick() noexcept;
     void gc(uint32_t unusedFrameCount) noexcept;
 
+    // 0 means unlimited, otherwise unused resources are evicted on tick until the resident bytes fit in the budget
+    inline void setBudget(uint64_t bytes) noexcept { _budget = bytes; }
+    inline uint64_t getBudget() const noexcept { return _budget; }
+    inline const ResourceAllocatorStats &getStats() const noexcept { return _stats; }
+    inline void resetStats() noexcept;
+
 private:
-    using DeviceResourcePool = RefVector<DeviceResourceType *>;
+    using Traits = ResourceAllocatorTraits<DescriptorType>;
+
+    struct FreeList final {
+        uint32_t head{INVALID_SLOT};
+        uint32_t tail{INVALID_SLOT};
+    };
+
+    struct Entry final {
+        IntrusivePtr<DeviceResourceType> resource;
+        FreeList *pool{nullptr};
+        uint64_t bytes{0};
+        int64_t age{-1}; // frame of the last release, negative while in use
+        uint32_t poolPrev{INVALID_SLOT};
+        uint32_t poolNext{INVALID_SLOT};
+        uint32_t lruPrev{INVALID_SLOT};
+        uint32_t lruNext{INVALID_SLOT};
+    };
 
     ResourceAllocator() noexcept = default;
     ~ResourceAllocator() = default;
 
-    ccstd::unordered_map<DescriptorType, DeviceResourcePool, gfx::Hasher<DescriptorType>> _pool{};
-    ccstd::unordered_map<DeviceResourceType *, int64_t> _ages{};
+    template <uint32_t Entry::*Prev, uint32_t Entry::*Next>
+    void pushBack(FreeList &list, uint32_t slot) noexcept;
+    template <uint32_t Entry::*Prev, uint32_t Entry::*Next>
+    void remove(FreeList &list, uint32_t slot) noexcept;
+    void destroy(uint32_t slot) noexcept;
+
+    ccstd::unordered_map<typename Traits::Key, FreeList, typename Traits::KeyHasher> _pool{};
+    ccstd::vector<Entry> _entries{};
+    ccstd::vector<uint32_t> _emptySlots{};
+    FreeList _lru{};
+    ResourceAllocatorStats _stats{};
+    uint64_t _budget{0};
     uint64_t _age{0};
 };
 
@@ -71,199 +189,123 @@ ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>
 }
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
-DeviceResourceType *ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::alloc(const DescriptorType &desc) noexcept {
-    DeviceResourcePool &pool{_pool[desc]};
-
-    DeviceResourceType *resource{nullptr};
-    for (DeviceResourceType *res : pool) {
-        if (_ages[res] >= 0) {
-            resource = res;
-            break;
+DeviceResourceType *ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::alloc(const DescriptorType &desc, uint32_t &slot) noexcept {
+    FreeList &pool{_pool[Traits::getKey(desc)]};
+
+    // reuse the most recently released resource, it is the least likely to be evicted
+    slot = pool.tail;
+    if (slot != INVALID_SLOT) {
+        remove<&Entry::poolPrev, &Entry::poolNext>(pool, slot);
+        remove<&Entry::lruPrev, &Entry::lruNext>(_lru, slot);
+        ++_stats.hits;
+    } else {
+        if (_emptySlots.empty()) {
+            slot = static_cast<uint32_t>(_entries.size());
+            _entries.emplace_back();
+        } else {
+            slot = _emptySlots.back();
+            _emptySlots.pop_back();
         }
-    }
-    if (!resource) {
+
         DeviceResourceCreator creator;
-        resource = creator(desc);
-        pool.pushBack(resource);
+        Entry &entry = _entries[slot];
+        entry.resource = creator(desc);
+        entry.pool = &pool;
+        entry.bytes = Traits::getBytes(desc);
+
+        ++_stats.misses;
+        ++_stats.residentCount;
+        _stats.residentBytes += entry.bytes;
     }
 
-    _ages[resource] = -1;
-    return resource;
+    Entry &entry = _entries[slot];
+    entry.age = -1;
+    return entry.resource.get();
 }
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
-void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::free(DeviceResourceType *const resource) noexcept {
-    CC_ASSERT(_ages.count(resource) && _ages[resource] < 0);
-    _ages[resource] = _age;
+void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::free(uint32_t const slot) noexcept {
+    CC_ASSERT(slot < _entries.size() && _entries[slot].age < 0);
+    Entry &entry = _entries[slot];
+    entry.age = static_cast<int64_t>(_age);
+    pushBack<&Entry::poolPrev, &Entry::poolNext>(*entry.pool, slot);
+    // ages never decrease, so the global list stays sorted from the least recently used
+    pushBack<&Entry::lruPrev, &Entry::lruNext>(_lru, slot);
 }
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::tick() noexcept {
     ++_age;
+
+    while (_budget && _stats.residentBytes > _budget && _lru.head != INVALID_SLOT) {
+        destroy(_lru.head);
+        ++_stats.evictions;
+    }
 }
 
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::gc(uint32_t const unusedFrameCount) noexcept {
-    for (auto &pair : _pool) {
-        DeviceResourcePool &pool = pair.second;
-
-        auto count = static_cast<int>(pool.size());
-
-        if (!count) {
-            continue;
-        }
-
-        int destroyBegin = count - 1;
-
-        for (int i = 0; i < count; ++i) {
-            int64_t ageI = _ages[pool.at(i)];
-            if (ageI < 0 || _age - ageI < unusedFrameCount) {
-                continue;
-            }
-
-            int j = destroyBegin;
-
-            for (; j > i; --j) {
-                int64_t ageJ = _ages[pool.at(j)];
-                if (ageJ < 0 || _age - ageJ < unusedFrameCount) {
-                    std::swap(pool.at(i), pool.at(j));
-                    destroyBegin = j - 1;
-                    break;
-                }
-            }
-
-            if (i >= j) {
-                destroyBegin = i - 1;
-            }
-
-            if (i >= destroyBegin) {
-                break;
-            }
-        }
-
-        while (++destroyBegin < count) {
-            auto *resource = pool.back();
-            _ages.erase(resource);
-            pool.popBack();
-        }
+    while (_lru.head != INVALID_SLOT && _age - _entries[_lru.head].age >= unusedFrameCount) {
+        destroy(_lru.head);
     }
 }
 
-template <typename DeviceResourceType, typename DeviceResourceCreatorType>
-class ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType> final {
-public:
-    using DeviceResourceCreator = DeviceResourceCreatorType;
-
-    ResourceAllocator(const ResourceAllocator &) = delete;
-    ResourceAllocator(ResourceAllocator &&) noexcept = delete;
-    ResourceAllocator &operator=(const ResourceAllocator &) = delete;
-    ResourceAllocator &operator=(ResourceAllocator &&) noexcept = delete;
-
-    static ResourceAllocator &getInstance() noexcept;
-    DeviceResourceType *alloc(const gfx::FramebufferInfo &desc) noexcept;
-    void free(DeviceResourceType *resource) noexcept;
-    inline void tick() noexcept;
-    void gc(uint32_t unusedFrameCount) noexcept;
-
-private:
-    using DeviceResourcePool = RefVector<DeviceResourceType *>;
-
-    ResourceAllocator() noexcept = default;
-    ~ResourceAllocator() = default;
-
-    std::unordered_map<ccstd::hash_t, DeviceResourcePool> _pool{};
-    std::unordered_map<DeviceResourceType *, int64_t> _ages{};
-    uint64_t _age{0};
-};
-
-//////////////////////////////////////////////////////////////////////////
-
-template <typename DeviceResourceType, typename DeviceResourceCreatorType>
-ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType> &
-ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType>::getInstance() noexcept {
-    static ResourceAllocator instance;
-    return instance;
+template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::resetStats() noexcept {
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.evictions = 0;
 }
 
-template <typename DeviceResourceType, typename DeviceResourceCreatorType>
-DeviceResourceType *ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType>::alloc(const gfx::FramebufferInfo &desc) noexcept {
-    ccstd::hash_t hash = gfx::Hasher<gfx::FramebufferInfo>()(desc);
-    DeviceResourcePool &pool{_pool[hash]};
-
-    DeviceResourceType *resource{nullptr};
-    for (DeviceResourceType *res : pool) {
-        if (_ages[res] >= 0) {
-            resource = res;
-            break;
-        }
-    }
-    if (!resource) {
-        DeviceResourceCreator creator;
-        resource = creator(desc);
-        pool.pushBack(resource);
+template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
+template <uint32_t ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::Entry::*Prev,
+          uint32_t ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::Entry::*Next>
+void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::pushBack(FreeList &list, uint32_t const slot) noexcept {
+    Entry &entry = _entries[slot];
+    entry.*Prev = list.tail;
+    entry.*Next = INVALID_SLOT;
+    if (list.tail != INVALID_SLOT) {
+        _entries[list.tail].*Next = slot;
+    } else {
+        list.head = slot;
     }
-
-    _ages[resource] = -1;
-    return resource;
-}
-
-template <typename DeviceResourceType, typename DeviceResourceCreatorType>
-void ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType>::free(DeviceResourceType *const resource) noexcept {
-    CC_ASSERT(_ages.count(resource) && _ages[resource] < 0);
-    _ages[resource] = _age;
+    list.tail = slot;
 }
 
-template <typename DeviceResourceType, typename DeviceResourceCreatorType>
-void ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType>::tick() noexcept {
-    ++_age;
+template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
+template <uint32_t ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::Entry::*Prev,
+          uint32_t ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::Entry::*Next>
+void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::remove(FreeList &list, uint32_t const slot) noexcept {
+    Entry &entry = _entries[slot];
+    if (entry.*Prev != INVALID_SLOT) {
+        _entries[entry.*Prev].*Next = entry.*Next;
+    } else {
+        list.head = entry.*Next;
+    }
+    if (entry.*Next != INVALID_SLOT) {
+        _entries[entry.*Next].*Prev = entry.*Prev;
+    } else {
+        list.tail = entry.*Prev;
+    }
+    entry.*Prev = INVALID_SLOT;
+    entry.*Next = INVALID_SLOT;
 }
 
-template <typename DeviceResourceType, typename DeviceResourceCreatorType>
-void ResourceAllocator<DeviceResourceType, gfx::FramebufferInfo, DeviceResourceCreatorType>::gc(uint32_t const unusedFrameCount) noexcept {
-    for (auto &pair : _pool) {
-        DeviceResourcePool &pool = pair.second;
-
-        auto count = static_cast<int>(pool.size());
-
-        if (!count) {
-            continue;
-        }
-
-        int destroyBegin = count - 1;
-
-        for (int i = 0; i < count; ++i) {
-            int64_t ageI = _ages[pool.at(i)];
-            if (ageI < 0 || _age - ageI < unusedFrameCount) {
-                continue;
-            }
-
-            int j = destroyBegin;
-
-            for (; j > i; --j) {
-                int64_t ageJ = _ages[pool.at(j)];
-                if (ageJ < 0 || _age - ageJ < unusedFrameCount) {
-                    std::swap(pool.at(i), pool.at(j));
-                    destroyBegin = j - 1;
-                    break;
-                }
-            }
-
-            if (i >= j) {
-                destroyBegin = i - 1;
-            }
-
-            if (i >= destroyBegin) {
-                break;
-            }
-        }
-
-        while (++destroyBegin < count) {
-            auto *resource = pool.back();
-            //            delete resource;
-            _ages.erase(resource);
-            pool.popBack();
-        }
-    }
+template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
+void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::destroy(uint32_t const slot) noexcept {
+    Entry &entry = _entries[slot];
+    CC_ASSERT(entry.age >= 0);
+    remove<&Entry::poolPrev, &Entry::poolNext>(*entry.pool, slot);
+    remove<&Entry::lruPrev, &Entry::lruNext>(_lru, slot);
+
+    --_stats.residentCount;
+    _stats.residentBytes -= entry.bytes;
+
+    entry.resource = nullptr;
+    entry.pool = nullptr;
+    entry.bytes = 0;
+    entry.age = -1;
+    _emptySlots.push_back(slot);
 }
 
 } // namespace framegraph
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "ResourceAllocator.h"
 #include "VirtualResource.h"
 
 namespace cc {
@@ -45,10 +46,19 @@ public:
     void request() noexcept override;
     void release() noexcept override;
     typename ResourceType::DeviceResource *getDeviceResource() const noexcept override;
+    bool canAlias(const VirtualResource &other) const noexcept override;
+    bool hasSameDescriptor(const VirtualResource &other) const noexcept override;
+    void mergeDescriptor(const VirtualResource &other) noexcept override;
+    uint64_t getTransientBytes() const noexcept override;
+    const void *getResourceTypeKey() const noexcept override { return getTypeKey(); }
 
     inline const ResourceType &get() const noexcept { return _resource; }
 
 private:
+    using Traits = ResourceAllocatorTraits<typename ResourceType::Descriptor>;
+
+    static const void *getTypeKey() noexcept;
+
     ResourceType _resource;
 };
 
@@ -81,5 +91,34 @@ typename ResourceType::DeviceResource *ResourceEntry<ResourceType, Enable>::getD
     return _resource.get();
 }
 
+template <typename ResourceType, typename Enable>
+bool ResourceEntry<ResourceType, Enable>::canAlias(const VirtualResource &other) const noexcept {
+    return other.getResourceTypeKey() == getTypeKey() &&
+           Traits::canAlias(_resource.getDesc(), static_cast<const ResourceEntry &>(other)._resource.getDesc());
+}
+
+template <typename ResourceType, typename Enable>
+bool ResourceEntry<ResourceType, Enable>::hasSameDescriptor(const VirtualResource &other) const noexcept {
+    return other.getResourceTypeKey() == getTypeKey() &&
+           _resource.getDesc() == static_cast<const ResourceEntry &>(other)._resource.getDesc();
+}
+
+template <typename ResourceType, typename Enable>
+void ResourceEntry<ResourceType, Enable>::mergeDescriptor(const VirtualResource &other) noexcept {
+    CC_ASSERT(canAlias(other) && !_resource.get());
+    Traits::merge(_resource._desc, static_cast<const ResourceEntry &>(other)._resource.getDesc());
+}
+
+template <typename ResourceType, typename Enable>
+uint64_t ResourceEntry<ResourceType, Enable>::getTransientBytes() const noexcept {
+    return Traits::getBytes(_resource.getDesc());
+}
+
+template <typename ResourceType, typename Enable>
+const void *ResourceEntry<ResourceType, Enable>::getTypeKey() noexcept {
+    static const char key{0};
+    return &key;
+}
+
 } // namespace framegraph
 } // namespace cc
@@ -53,6 +53,13 @@ public:
 
     virtual gfx::GFXObject *getDeviceResource() const noexcept = 0;
 
+    // transient resources with compatible descriptors may share a device resource if their lifetimes do not overlap
+    virtual bool canAlias(const VirtualResource & /*other*/) const noexcept { return false; }
+    virtual bool hasSameDescriptor(const VirtualResource & /*other*/) const noexcept { return false; }
+    virtual void mergeDescriptor(const VirtualResource & /*other*/) noexcept {}
+    virtual uint64_t getTransientBytes() const noexcept { return 0; }
+    virtual const void *getResourceTypeKey() const noexcept { return nullptr; }
+
 private:
     PassNode *_firstUsePass{nullptr};
     PassNode *_lastUsePass{nullptr};
@@ -28,6 +28,7 @@
 #include <cstring>
 #include "BufferAgent.h"
 #include "DeviceAgent.h"
+#include "base/threading/ThreadSafeLinearAllocator.h"
 
 namespace cc {
 namespace gfx {
@@ -55,9 +56,8 @@ BufferAgent::~BufferAgent() {
 void BufferAgent::doInit(const BufferInfo &info) {
     uint32_t size = getSize();
     if (size > STAGING_BUFFER_THRESHOLD && hasFlag(_memUsage, MemoryUsageBit::HOST)) {
-        for (size_t i = 0; i < DeviceAgent::MAX_FRAME_INDEX; ++i) {
-            _stagingBuffers.push_back(reinterpret_cast<uint8_t *>(malloc(size)));
-        }
+        // one per frame slot, allocated on first use since only getFrameCount() slots are in use
+        _stagingBuffers.resize(DeviceAgent::MAX_FRAME_INDEX, nullptr);
     }
 
     ENQUEUE_MESSAGE_2(
@@ -106,9 +106,8 @@ void BufferAgent::doResize(uint32_t size, uint32_t /*count*/) {
     }
 
     if (size > STAGING_BUFFER_THRESHOLD && hasFlag(_memUsage, MemoryUsageBit::HOST)) {
-        for (size_t i = 0; i < DeviceAgent::MAX_FRAME_INDEX; ++i) {
-            _stagingBuffers.push_back(reinterpret_cast<uint8_t *>(malloc(size)));
-        }
+        // one per frame slot, allocated on first use since only getFrameCount() slots are in use
+        _stagingBuffers.resize(DeviceAgent::MAX_FRAME_INDEX, nullptr);
     }
 
     ENQUEUE_MESSAGE_2(
@@ -145,7 +144,7 @@ void BufferAgent::doDestroy() {
         });
 }
 
-void BufferAgent::update(const void *buffer, uint32_t size) {
+void BufferAgent::update(const void *buffer, uint32_t size, uint32_t offset) {
     uint8_t *actorBuffer{nullptr};
     bool needFreeing{false};
     auto *mq{DeviceAgent::getInstance()->getMessageQueue()};
@@ -153,25 +152,31 @@ void BufferAgent::update(const void *buffer, uint32_t size) {
     getActorBuffer(this, mq, size, &actorBuffer, &needFreeing);
     memcpy(actorBuffer, buffer, size);
 
-    ENQUEUE_MESSAGE_4(
+    ENQUEUE_MESSAGE_5(
         mq, BufferUpdate,
         actor, getActor(),
         buffer, actorBuffer,
         size, size,
+        offset, offset,
         needFreeing, needFreeing,
         {
-            actor->update(buffer, size);
+            actor->update(buffer, size, offset);
             if (needFreeing) free(buffer);
         });
 }
 
-void BufferAgent::getActorBuffer(const BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing) {
+void BufferAgent::getActorBuffer(BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing) {
     if (!buffer->_stagingBuffers.empty()) { // for frequent updates on big buffers
         uint32_t frameIndex = DeviceAgent::getInstance()->getCurrentIndex();
-        *pActorBuffer = buffer->_stagingBuffers[frameIndex];
+        uint8_t *&stagingBuffer = buffer->_stagingBuffers[frameIndex];
+        if (!stagingBuffer) stagingBuffer = reinterpret_cast<uint8_t *>(malloc(buffer->getSize()));
+        *pActorBuffer = stagingBuffer;
     } else if (size > STAGING_BUFFER_THRESHOLD) { // less frequent updates on big buffers
-        *pActorBuffer = reinterpret_cast<uint8_t *>(malloc(size));
-        *pNeedFreeing = true;
+        *pActorBuffer = DeviceAgent::getInstance()->getFrameAllocator()->allocate<uint8_t>(size, 16);
+        if (!*pActorBuffer) {
+            *pActorBuffer = reinterpret_cast<uint8_t *>(malloc(size));
+            *pNeedFreeing = true;
+        }
     } else { // for small enough buffers
         *pActorBuffer = mq->allocate<uint8_t>(size);
     }
@@ -40,9 +40,9 @@ public:
     explicit BufferAgent(Buffer *actor);
     ~BufferAgent() override;
 
-    void update(const void *buffer, uint32_t size) override;
+    void update(const void *buffer, uint32_t size, uint32_t offset) override;
 
-    static void getActorBuffer(const BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing);
+    static void getActorBuffer(BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing);
 
 private:
     void doInit(const BufferInfo &info) override;
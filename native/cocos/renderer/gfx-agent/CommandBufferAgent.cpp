@@ -98,6 +98,7 @@ void CommandBufferAgent::initMessageQueue() {
 void CommandBufferAgent::destroyMessageQueue() {
     DeviceAgent::getInstance()->getMessageQueue()->kickAndWait();
 
+    _stream.clear();
     CC_SAFE_DELETE(_messageQueue);
 
     DeviceAgent::getInstance()->_cmdBuffRefs.erase(this);
@@ -138,6 +139,8 @@ void CommandBufferAgent::doDestroy() {
 }
 
 void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    flushStream();
+
     ENQUEUE_MESSAGE_4(
         _messageQueue,
         CommandBufferBegin,
@@ -151,6 +154,8 @@ void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebu
 }
 
 void CommandBufferAgent::end() {
+    flushStream();
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEnd,
         actor, getActor(),
@@ -160,6 +165,8 @@ void CommandBufferAgent::end() {
 }
 
 void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
+    flushStream();
+
     auto attachmentCount = utils::toUint(renderPass->getColorAttachments().size());
     Color *actorColors = nullptr;
     if (attachmentCount) {
@@ -192,6 +199,8 @@ void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fb
 }
 
 void CommandBufferAgent::endRenderPass() {
+    flushStream();
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEndRenderPass,
         actor, getActor(),
@@ -201,83 +210,87 @@ void CommandBufferAgent::endRenderPass() {
 }
 
 void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    flushStream();
+
     if (!count) return;
 
     auto **actorCmdBuffs = _messageQueue->allocate<CommandBuffer *>(count);
+    auto **agentCmdBuffs = _messageQueue->allocate<CommandBufferAgent *>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        actorCmdBuffs[i] = static_cast<CommandBufferAgent *>(cmdBuffs[i])->getActor();
+        agentCmdBuffs[i] = static_cast<CommandBufferAgent *>(cmdBuffs[i]);
+        actorCmdBuffs[i] = agentCmdBuffs[i]->getActor();
+        // secondary command buffers may be recorded on other threads, their commands
+        // are replayed on the device thread right before they get executed
+        agentCmdBuffs[i]->flushStream();
+        MessageQueue::freeChunksInFreeQueue(agentCmdBuffs[i]->_messageQueue);
+        agentCmdBuffs[i]->_messageQueue->finishWriting();
     }
 
-    ENQUEUE_MESSAGE_3(
+    ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferExecute,
         actor, getActor(),
         cmdBuffs, actorCmdBuffs,
+        agentCmdBuffs, agentCmdBuffs,
         count, count,
         {
+            for (uint32_t i = 0; i < count; ++i) {
+                MessageQueue *queue = agentCmdBuffs[i]->getMessageQueue();
+                if (!queue->isImmediateMode()) queue->flushMessages();
+            }
             actor->execute(cmdBuffs, count);
         });
 }
 
 void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
-    ENQUEUE_MESSAGE_2(
-        _messageQueue, CommandBufferBindPipelineState,
-        actor, getActor(),
-        pso, static_cast<PipelineStateAgent *>(pso)->getActor(),
-        {
-            actor->bindPipelineState(pso);
-        });
+    auto *actorPSO = static_cast<PipelineStateAgent *>(pso)->getActor();
+    if (_messageQueue->isImmediateMode()) {
+        _actor->bindPipelineState(actorPSO);
+        return;
+    }
+    _stream.bindPipelineState(actorPSO);
+    if (_stream.full()) flushStream();
 }
 
 void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
-    uint32_t *actorDynamicOffsets = nullptr;
-    if (dynamicOffsetCount) {
-        actorDynamicOffsets = _messageQueue->allocate<uint32_t>(dynamicOffsetCount);
-        memcpy(actorDynamicOffsets, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+    auto *actorDescriptorSet = static_cast<DescriptorSetAgent *>(descriptorSet)->getActor();
+    if (_messageQueue->isImmediateMode()) {
+        _actor->bindDescriptorSet(set, actorDescriptorSet, dynamicOffsetCount, dynamicOffsets);
+        return;
     }
-
-    ENQUEUE_MESSAGE_5(
-        _messageQueue, CommandBufferBindDescriptorSet,
-        actor, getActor(),
-        set, set,
-        descriptorSet, static_cast<DescriptorSetAgent *>(descriptorSet)->getActor(),
-        dynamicOffsetCount, dynamicOffsetCount,
-        dynamicOffsets, actorDynamicOffsets,
-        {
-            actor->bindDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets);
-        });
+    _stream.bindDescriptorSet(set, actorDescriptorSet, dynamicOffsetCount, dynamicOffsets);
+    if (_stream.full()) flushStream();
 }
 
 void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
-    ENQUEUE_MESSAGE_2(
-        _messageQueue, CommandBufferBindInputAssembler,
-        actor, getActor(),
-        ia, static_cast<InputAssemblerAgent *>(ia)->getActor(),
-        {
-            actor->bindInputAssembler(ia);
-        });
+    auto *actorIA = static_cast<InputAssemblerAgent *>(ia)->getActor();
+    if (_messageQueue->isImmediateMode()) {
+        _actor->bindInputAssembler(actorIA);
+        return;
+    }
+    _stream.bindInputAssembler(actorIA);
 }
 
 void CommandBufferAgent::setViewport(const Viewport &vp) {
-    ENQUEUE_MESSAGE_2(
-        _messageQueue, CommandBufferSetViewport,
-        actor, getActor(),
-        vp, vp,
-        {
-            actor->setViewport(vp);
-        });
+    if (_messageQueue->isImmediateMode()) {
+        _actor->setViewport(vp);
+        return;
+    }
+    _stream.setViewport(vp);
+    if (_stream.full()) flushStream();
 }
 
 void CommandBufferAgent::setScissor(const Rect &rect) {
-    ENQUEUE_MESSAGE_2(
-        _messageQueue, CommandBufferSetScissor,
-        actor, getActor(),
-        rect, rect,
-        {
-            actor->setScissor(rect);
-        });
+    if (_messageQueue->isImmediateMode()) {
+        _actor->setScissor(rect);
+        return;
+    }
+    _stream.setScissor(rect);
+    if (_stream.full()) flushStream();
 }
 
 void CommandBufferAgent::setLineWidth(float width) {
+    flushStream();
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetLineWidth,
         actor, getActor(),
@@ -288,6 +301,8 @@ void CommandBufferAgent::setLineWidth(float width) {
 }
 
 void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope) {
+    flushStream();
+
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetDepthBias,
         actor, getActor(),
@@ -300,6 +315,8 @@ void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope)
 }
 
 void CommandBufferAgent::setBlendConstants(const Color &constants) {
+    flushStream();
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetBlendConstants,
         actor, getActor(),
@@ -310,6 +327,8 @@ void CommandBufferAgent::setBlendConstants(const Color &constants) {
 }
 
 void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
+    flushStream();
+
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetDepthBound,
         actor, getActor(),
@@ -321,6 +340,8 @@ void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    flushStream();
+
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetStencilWriteMask,
         actor, getActor(),
@@ -332,6 +353,8 @@ void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint32_t mask) {
 }
 
 void CommandBufferAgent::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    flushStream();
+
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetStencilCompareMask,
         actor, getActor(),
@@ -344,6 +367,8 @@ void CommandBufferAgent::setStencilCompareMask(StencilFace face, uint32_t ref, u
 }
 
 void CommandBufferAgent::nextSubpass() {
+    flushStream();
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferNextSubpass,
         actor, getActor(),
@@ -353,16 +378,35 @@ void CommandBufferAgent::nextSubpass() {
 }
 
 void CommandBufferAgent::draw(const DrawInfo &info) {
-    ENQUEUE_MESSAGE_2(
-        _messageQueue, CommandBufferDraw,
+    if (_messageQueue->isImmediateMode()) {
+        _actor->draw(info);
+        return;
+    }
+    _stream.draw(info);
+    if (_stream.full()) flushStream();
+}
+
+void CommandBufferAgent::flushStream() {
+    if (_stream.empty()) return;
+    _stream.finish();
+
+    const uint32_t size = _stream.size();
+    auto *data = _messageQueue->allocateAndCopy<uint8_t>(size, _stream.data());
+    _stream.clear();
+
+    ENQUEUE_MESSAGE_3(
+        _messageQueue, CommandBufferExecuteStream,
         actor, getActor(),
-        info, info,
+        data, data,
+        size, size,
         {
-            actor->draw(info);
+            CommandStream::execute(actor, data, size);
         });
 }
 
-void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
+    flushStream();
+
     auto *bufferAgent = static_cast<BufferAgent *>(buff);
 
     uint8_t *actorBuffer{nullptr};
@@ -371,20 +415,23 @@ void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t s
     BufferAgent::getActorBuffer(bufferAgent, _messageQueue, size, &actorBuffer, &needFreeing);
     memcpy(actorBuffer, data, size);
 
-    ENQUEUE_MESSAGE_5(
+    ENQUEUE_MESSAGE_6(
         _messageQueue, CommandBufferUpdateBuffer,
         actor, getActor(),
         buff, bufferAgent->getActor(),
         data, actorBuffer,
         size, size,
+        offset, offset,
         needFreeing, needFreeing,
         {
-            actor->updateBuffer(buff, data, size);
+            actor->updateBuffer(buff, data, size, offset);
             if (needFreeing) free(data);
         });
 }
 
 void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
+    flushStream();
+
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
     if (srcTexture) actorSrcTexture = static_cast<TextureAgent *>(srcTexture)->getActor();
@@ -407,6 +454,8 @@ void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, c
 }
 
 void CommandBufferAgent::dispatch(const DispatchInfo &info) {
+    flushStream();
+
     DispatchInfo actorInfo = info;
     if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferAgent *>(info.indirectBuffer)->getActor();
 
@@ -420,6 +469,8 @@ void CommandBufferAgent::dispatch(const DispatchInfo &info) {
 }
 
 void CommandBufferAgent::pipelineBarrier(const GeneralBarrier *barrier, const BufferBarrier *const *bufferBarriers, const Buffer *const *buffers, uint32_t bufferBarrierCount, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {
+    flushStream();
+
     TextureBarrier **actorTextureBarriers = nullptr;
     Texture **actorTextures = nullptr;
 
@@ -462,6 +513,8 @@ void CommandBufferAgent::pipelineBarrier(const GeneralBarrier *barrier, const Bu
 }
 
 void CommandBufferAgent::beginQuery(QueryPool *queryPool, uint32_t id) {
+    flushStream();
+
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_3(
@@ -475,6 +528,8 @@ void CommandBufferAgent::beginQuery(QueryPool *queryPool, uint32_t id) {
 }
 
 void CommandBufferAgent::endQuery(QueryPool *queryPool, uint32_t id) {
+    flushStream();
+
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_3(
@@ -488,6 +543,8 @@ void CommandBufferAgent::endQuery(QueryPool *queryPool, uint32_t id) {
 }
 
 void CommandBufferAgent::resetQueryPool(QueryPool *queryPool) {
+    flushStream();
+
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_2(
@@ -500,6 +557,8 @@ void CommandBufferAgent::resetQueryPool(QueryPool *queryPool) {
 }
 
 void CommandBufferAgent::completeQueryPool(QueryPool *queryPool) {
+    flushStream();
+
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_2(
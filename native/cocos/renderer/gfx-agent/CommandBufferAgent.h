@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "CommandStream.h"
 #include "base/Agent.h"
 #include "gfx-base/GFXCommandBuffer.h"
 
@@ -58,7 +59,7 @@ public:
     void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) override;
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
-    void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
+    void updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
@@ -86,7 +87,12 @@ protected:
 
     void initMessageQueue();
     void destroyMessageQueue();
+    // ships the batched commands recorded so far as one message,
+    // has to be done before anything else goes into the message queue
+    void flushStream();
+
     MessageQueue *_messageQueue = nullptr;
+    CommandStream _stream;
 };
 
 } // namespace gfx
@@ -0,0 +1,222 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "CommandStream.h"
+#include <cstring>
+#include <type_traits>
+#include "base/threading/MessageQueue.h"
+#include "gfx-base/GFXCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+
+// every payload is padded to 8 bytes so the pointers they carry stay aligned,
+// the alignment on the structs pads them the same way on 32 bit ABIs
+constexpr uint32_t PAYLOAD_ALIGNMENT = 8;
+
+struct alignas(PAYLOAD_ALIGNMENT) BindPipelineStateCmd {
+    PipelineState *pso;
+};
+
+struct alignas(PAYLOAD_ALIGNMENT) BindDescriptorSetCmd {
+    DescriptorSet *descriptorSet;
+    uint32_t set;
+    uint32_t dynamicOffsetCount;
+    // followed by the dynamic offsets, padded to PAYLOAD_ALIGNMENT
+};
+
+struct alignas(PAYLOAD_ALIGNMENT) BindInputAssemblerCmd {
+    InputAssembler *ia;
+};
+
+struct alignas(PAYLOAD_ALIGNMENT) DrawCmd {
+    InputAssembler *ia; // bound right before the draw, if not null
+    DrawInfo info;
+};
+
+struct alignas(PAYLOAD_ALIGNMENT) SetViewportCmd {
+    Viewport vp;
+};
+
+struct alignas(PAYLOAD_ALIGNMENT) SetScissorCmd {
+    Rect rect;
+};
+
+} // namespace
+
+CommandStream::CommandStream() {
+    static_assert(sizeof(RecordHeader) == HEADER_SIZE, "record headers keep the payloads aligned");
+    _data.reserve(FLUSH_THRESHOLD + MessageQueue::MEMORY_CHUNK_SIZE / 16);
+}
+
+template <typename T>
+T *CommandStream::append(Opcode opcode, uint32_t extraSize) {
+    static_assert(std::is_trivially_destructible<T>::value, "command payloads should be POD");
+    static_assert(sizeof(T) % PAYLOAD_ALIGNMENT == 0, "fixed size payloads are read back as plain arrays");
+    const uint32_t payloadSize = align(sizeof(T) + extraSize, PAYLOAD_ALIGNMENT);
+    auto offset = static_cast<uint32_t>(_data.size());
+
+    auto *lastHeader = offset ? reinterpret_cast<RecordHeader *>(_data.data() + _lastHeaderOffset) : nullptr;
+    if (lastHeader && lastHeader->opcode == opcode) {
+        ++lastHeader->count;
+        _data.resize(offset + payloadSize);
+    } else {
+        _lastHeaderOffset = offset;
+        _data.resize(offset + sizeof(RecordHeader) + payloadSize);
+        auto *header = reinterpret_cast<RecordHeader *>(_data.data() + offset);
+        header->opcode = opcode;
+        header->count = 1;
+        offset += sizeof(RecordHeader);
+    }
+    return reinterpret_cast<T *>(_data.data() + offset);
+}
+
+uint32_t CommandStream::getPayloadSize(Opcode opcode, uint32_t dynamicOffsetCount) {
+    switch (opcode) {
+        case Opcode::BIND_PIPELINE_STATE: return sizeof(BindPipelineStateCmd);
+        case Opcode::BIND_DESCRIPTOR_SET: return align(sizeof(BindDescriptorSetCmd) + dynamicOffsetCount * sizeof(uint32_t), PAYLOAD_ALIGNMENT);
+        case Opcode::BIND_INPUT_ASSEMBLER: return sizeof(BindInputAssemblerCmd);
+        case Opcode::DRAW: return sizeof(DrawCmd);
+        case Opcode::SET_VIEWPORT: return sizeof(SetViewportCmd);
+        case Opcode::SET_SCISSOR: return sizeof(SetScissorCmd);
+    }
+    return 0;
+}
+
+void CommandStream::bindPipelineState(PipelineState *pso) {
+    finish();
+    append<BindPipelineStateCmd>(Opcode::BIND_PIPELINE_STATE)->pso = pso;
+}
+
+void CommandStream::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    finish();
+    const uint32_t offsetsSize = dynamicOffsetCount * sizeof(uint32_t);
+    auto *cmd = append<BindDescriptorSetCmd>(Opcode::BIND_DESCRIPTOR_SET, offsetsSize);
+    cmd->descriptorSet = descriptorSet;
+    cmd->set = set;
+    cmd->dynamicOffsetCount = dynamicOffsetCount;
+    if (dynamicOffsetCount) {
+        memcpy(cmd + 1, dynamicOffsets, offsetsSize);
+    }
+}
+
+void CommandStream::draw(const DrawInfo &info) {
+    auto *cmd = append<DrawCmd>(Opcode::DRAW);
+    cmd->ia = _pendingInputAssembler;
+    cmd->info = info;
+    _pendingInputAssembler = nullptr;
+}
+
+void CommandStream::setViewport(const Viewport &vp) {
+    finish();
+    append<SetViewportCmd>(Opcode::SET_VIEWPORT)->vp = vp;
+}
+
+void CommandStream::setScissor(const Rect &rect) {
+    finish();
+    append<SetScissorCmd>(Opcode::SET_SCISSOR)->rect = rect;
+}
+
+void CommandStream::finish() {
+    if (!_pendingInputAssembler) return;
+    append<BindInputAssemblerCmd>(Opcode::BIND_INPUT_ASSEMBLER)->ia = _pendingInputAssembler;
+    _pendingInputAssembler = nullptr;
+}
+
+void CommandStream::clear() {
+    _data.clear();
+    _pendingInputAssembler = nullptr;
+}
+
+void CommandStream::execute(CommandBuffer *actor, const uint8_t *data, uint32_t size) {
+    const uint8_t *cursor = data;
+    const uint8_t *const end = data + size;
+
+    while (cursor < end) {
+        const auto *header = reinterpret_cast<const RecordHeader *>(cursor);
+        cursor += sizeof(RecordHeader);
+
+        switch (header->opcode) {
+            case Opcode::BIND_PIPELINE_STATE: {
+                const auto *cmds = reinterpret_cast<const BindPipelineStateCmd *>(cursor);
+                for (uint32_t i = 0; i < header->count; ++i) {
+                    actor->bindPipelineState(cmds[i].pso);
+                }
+                cursor += header->count * sizeof(BindPipelineStateCmd);
+                break;
+            }
+            case Opcode::BIND_DESCRIPTOR_SET: {
+                for (uint32_t i = 0; i < header->count; ++i) {
+                    const auto *cmd = reinterpret_cast<const BindDescriptorSetCmd *>(cursor);
+                    const auto *dynamicOffsets = cmd->dynamicOffsetCount ? reinterpret_cast<const uint32_t *>(cmd + 1) : nullptr;
+                    actor->bindDescriptorSet(cmd->set, cmd->descriptorSet, cmd->dynamicOffsetCount, dynamicOffsets);
+                    cursor += align(sizeof(BindDescriptorSetCmd) + cmd->dynamicOffsetCount * sizeof(uint32_t), PAYLOAD_ALIGNMENT);
+                }
+                break;
+            }
+            case Opcode::BIND_INPUT_ASSEMBLER: {
+                const auto *cmds = reinterpret_cast<const BindInputAssemblerCmd *>(cursor);
+                for (uint32_t i = 0; i < header->count; ++i) {
+                    actor->bindInputAssembler(cmds[i].ia);
+                }
+                cursor += header->count * sizeof(BindInputAssemblerCmd);
+                break;
+            }
+            case Opcode::DRAW: {
+                const auto *cmds = reinterpret_cast<const DrawCmd *>(cursor);
+                for (uint32_t i = 0; i < header->count; ++i) {
+                    if (cmds[i].ia) actor->bindInputAssembler(cmds[i].ia);
+                    actor->draw(cmds[i].info);
+                }
+                cursor += header->count * sizeof(DrawCmd);
+                break;
+            }
+            case Opcode::SET_VIEWPORT: {
+                const auto *cmds = reinterpret_cast<const SetViewportCmd *>(cursor);
+                for (uint32_t i = 0; i < header->count; ++i) {
+                    actor->setViewport(cmds[i].vp);
+                }
+                cursor += header->count * sizeof(SetViewportCmd);
+                break;
+            }
+            case Opcode::SET_SCISSOR: {
+                const auto *cmds = reinterpret_cast<const SetScissorCmd *>(cursor);
+                for (uint32_t i = 0; i < header->count; ++i) {
+                    actor->setScissor(cmds[i].rect);
+                }
+                cursor += header->count * sizeof(SetScissorCmd);
+                break;
+            }
+            default:
+                CC_ASSERT(false);
+                return;
+        }
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/std/container/vector.h"
+#include "gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace gfx {
+
+class CommandBuffer;
+class DescriptorSet;
+class InputAssembler;
+class PipelineState;
+
+// A compact, POD encoding of the hottest command buffer calls.
+// Instead of allocating one virtual message per call, command buffer agents append
+// fixed-layout records into a byte stream which is shipped to the device thread as a
+// single message and replayed there through a switch over the opcodes.
+// Consecutive records of the same kind share one header, and an input assembler binding
+// is folded into the draw that follows it, so the usual
+// bindInputAssembler / draw / bindInputAssembler / draw sequence ends up as one record.
+// All the objects referenced here are expected to be actors already.
+class CommandStream final {
+public:
+    // flush the stream into the message queue once it gets this large,
+    // checked after every call so long runs without draws stay well within a message queue chunk
+    static constexpr uint32_t FLUSH_THRESHOLD = 16 * 1024;
+
+    enum class Opcode : uint32_t {
+        BIND_PIPELINE_STATE,
+        BIND_DESCRIPTOR_SET,
+        BIND_INPUT_ASSEMBLER,
+        DRAW,
+        SET_VIEWPORT,
+        SET_SCISSOR,
+    };
+
+    CommandStream();
+
+    void bindPipelineState(PipelineState *pso);
+    void bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets);
+    void bindInputAssembler(InputAssembler *ia) { _pendingInputAssembler = ia; }
+    void draw(const DrawInfo &info);
+    void setViewport(const Viewport &vp);
+    void setScissor(const Rect &rect);
+
+    // writes out the deferred input assembler binding, if any
+    void finish();
+    void clear();
+
+    inline bool empty() const { return _data.empty() && !_pendingInputAssembler; }
+    inline uint32_t size() const { return static_cast<uint32_t>(_data.size()); }
+    inline bool full() const { return _data.size() >= FLUSH_THRESHOLD; }
+    inline const uint8_t *data() const { return _data.data(); }
+
+    static void execute(CommandBuffer *actor, const uint8_t *data, uint32_t size);
+
+    // consecutive records with the same opcode share one header
+    static constexpr uint32_t HEADER_SIZE = 8;
+    // the padded size of a single record, dynamicOffsetCount only matters for BIND_DESCRIPTOR_SET
+    static uint32_t getPayloadSize(Opcode opcode, uint32_t dynamicOffsetCount = 0);
+
+private:
+    struct RecordHeader {
+        Opcode opcode;
+        uint32_t count;
+    };
+
+    template <typename T>
+    T *append(Opcode opcode, uint32_t extraSize = 0);
+
+    ccstd::vector<uint8_t> _data;
+    uint32_t _lastHeaderOffset{0};
+    InputAssembler *_pendingInputAssembler{nullptr};
+};
+
+} // namespace gfx
+} // namespace cc
@@ -23,13 +23,16 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <boost/align/align_up.hpp>
+#include <chrono>
 #include <cstring>
 #include "base/Log.h"
 #include "base/threading/MessageQueue.h"
 #include "base/threading/ThreadSafeLinearAllocator.h"
 #include "application/ApplicationManager.h"
 #include "platform/interfaces/modules/IXRInterface.h"
+#include "profiler/Profiler.h"
 
 #include "BufferAgent.h"
 #include "CommandBufferAgent.h"
@@ -77,11 +80,15 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
     _cmdBuff = ccnew CommandBufferAgent(_actor->getCommandBuffer());
     _renderer = _actor->getRenderer();
     _vendor = _actor->getVendor();
+    _version = _actor->getVersion();
     _caps = _actor->_caps;
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
     memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
 
     _mainMessageQueue = ccnew MessageQueue;
+    for (uint32_t i = 0; i < getFrameCount(); ++i) {
+        _frameAllocators[i] = ccnew ThreadSafeLinearAllocator(FRAME_ALLOCATOR_SIZE, 16);
+    }
 
     static_cast<CommandBufferAgent *>(_cmdBuff)->_queue = _queue;
     static_cast<CommandBufferAgent *>(_cmdBuff)->initAgent();
@@ -126,6 +133,10 @@ void DeviceAgent::doDestroy() {
         delete _mainMessageQueue;
         _mainMessageQueue = nullptr;
     }
+
+    for (auto *&allocator : _frameAllocators) {
+        CC_SAFE_DELETE(allocator);
+    }
 }
 
 void DeviceAgent::acquire(Swapchain *const *swapchains, uint32_t count) {
@@ -155,25 +166,73 @@ void DeviceAgent::present() {
                 actor->present();
             });
     } else {
-        ENQUEUE_MESSAGE_2(
+        ENQUEUE_MESSAGE_4(
             _mainMessageQueue, DevicePresent,
+            device, this,
             actor, _actor,
+            stats, &_frameStats[_currentIndex],
             frameBoundarySemaphore, &_frameBoundarySemaphore,
             {
                 actor->present();
+
+                uint64_t idleTime = device->_mainMessageQueue->getConsumerIdleTime();
+                stats->consumerIdleMs = static_cast<float>(idleTime - device->_consumerIdleMark) * 1e-6F;
+                device->_consumerIdleMark = idleTime;
+
                 frameBoundarySemaphore->signal();
             });
 
         MessageQueue::freeChunksInFreeQueue(_mainMessageQueue);
         _mainMessageQueue->finishWriting();
-        _currentIndex = (_currentIndex + 1) % MAX_FRAME_INDEX;
-        _frameBoundarySemaphore.wait();
+        advanceFrame();
+    }
+}
+
+void DeviceAgent::advanceFrame() {
+    FrameStats &stats = _frameStats[_currentIndex];
+    stats.framesInFlight = _framesInFlight;
+    _currentIndex = (_currentIndex + 1) % getFrameCount();
+
+    auto stallBegin = std::chrono::steady_clock::now();
+    _frameBoundarySemaphore.wait();
+    stats.producerStallMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stallBegin).count();
+
+    // the frame previously recorded into this slot is fully consumed by now
+    _lastFrameStats = _frameStats[_currentIndex];
+    _frameAllocators[_currentIndex]->recycle();
+}
+
+void DeviceAgent::setMaxFramesInFlight(uint32_t count) {
+    count = std::min(std::max(count, 1U), MAX_CPU_FRAME_AHEAD);
+    // XR runtimes pace the frames themselves through presentWait / presentSignal
+    if (count == _framesInFlight || _xr) return;
+
+    // let the device thread drain so every frame slot is free before remapping them
+    _mainMessageQueue->kickAndWait();
+    if (count > _framesInFlight) {
+        _frameBoundarySemaphore.signal(static_cast<int>(count - _framesInFlight));
+    } else {
+        for (uint32_t i = count; i < _framesInFlight; ++i) {
+            _frameBoundarySemaphore.wait(); // won't block, all frames are consumed
+        }
+    }
+    _framesInFlight = count;
+
+    for (uint32_t i = 0; i < getFrameCount(); ++i) {
+        if (!_frameAllocators[i]) _frameAllocators[i] = ccnew ThreadSafeLinearAllocator(FRAME_ALLOCATOR_SIZE, 16);
+    }
+    if (_currentIndex >= getFrameCount()) {
+        // commands recorded so far may still point into the old slot, so leave it as is
+        _currentIndex = 0;
+        _frameAllocators[_currentIndex]->recycle();
     }
 }
 
 void DeviceAgent::setMultithreaded(bool multithreaded) {
     if (multithreaded == _multithreaded) return;
     _multithreaded = multithreaded;
+    // commands only go into per command buffer message queues when the device thread is detached
+    _multithreadedCommandRecording = multithreaded || _actor->_multithreadedCommandRecording;
 
     if (multithreaded) {
         _mainMessageQueue->setImmediateMode(false);
@@ -184,6 +243,7 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
             actor, _actor,
             {
                 actor->bindContext(true);
+                CC_PROFILER_SET_THREAD_NAME("DeviceThread");
                 CC_LOG_INFO("Device thread detached.");
             });
         for (CommandBufferAgent *cmdBuff : _cmdBuffRefs) {
@@ -200,6 +260,7 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
         _mainMessageQueue->setImmediateMode(true);
         _actor->bindContext(true);
         for (CommandBufferAgent *cmdBuff : _cmdBuffRefs) {
+            cmdBuff->flushStream();
             cmdBuff->_messageQueue->setImmediateMode(true);
         }
         CC_LOG_INFO("Device thread joined.");
@@ -306,12 +367,20 @@ void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const
         totalSize += boost::alignment::align_up(size, alignment) * region.texSubres.layerCount;
     }
 
-    auto *allocator = ccnew ThreadSafeLinearAllocator(totalSize, alignment);
+    // goes into the per frame ring if it fits, otherwise into a dedicated allocation
+    ThreadSafeLinearAllocator *allocator = nullptr;
+    auto *cursor = DeviceAgent::getInstance()->getFrameAllocator()->allocate<uint8_t>(totalSize, alignment);
+    if (!cursor) {
+        allocator = ccnew ThreadSafeLinearAllocator(totalSize, alignment);
+        cursor = allocator->allocate<uint8_t>(totalSize, alignment);
+    }
 
-    auto *actorRegions = allocator->allocate<BufferTextureCopy>(count);
+    auto *actorRegions = reinterpret_cast<BufferTextureCopy *>(cursor);
     memcpy(actorRegions, regions, count * sizeof(BufferTextureCopy));
+    cursor += sizeof(BufferTextureCopy) * count;
 
-    const auto **actorBuffers = allocator->allocate<const uint8_t *>(bufferCount);
+    const auto **actorBuffers = reinterpret_cast<const uint8_t **>(cursor);
+    cursor += sizeof(uint8_t *) * bufferCount;
     const auto blockHeight = formatAlignment(format).second;
     for (uint32_t i = 0U, n = 0U; i < count; i++) {
         const BufferTextureCopy &region = regions[i];
@@ -328,7 +397,8 @@ void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const
         uint32_t size = formatSize(format, width, height, depth);
 
         for (uint32_t l = 0; l < region.texSubres.layerCount; l++) {
-            auto *buffer = allocator->allocate<uint8_t>(size, alignment);
+            auto *buffer = static_cast<uint8_t *>(boost::alignment::align_up(cursor, alignment));
+            cursor = buffer + size;
             uint32_t destOffset = 0;
             uint32_t buffOffset = 0;
             for (uint32_t d = 0; d < depth; d++) {
@@ -356,7 +426,7 @@ void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const
         allocator, allocator,
         {
             actor->copyBuffersToTexture(buffers, dst, regions, count);
-            delete allocator;
+            delete allocator; // null if the frame allocator was used
         });
 }
 
@@ -365,6 +435,7 @@ void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *d
 }
 
 void CommandBufferAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    flushStream();
     doBufferTextureCopy(buffers, texture, regions, count, _messageQueue, _actor);
 }
 
@@ -391,6 +462,7 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count)
 
     for (uint32_t i = 0; i < count; ++i) {
         agentCmdBuffs[i] = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
+        agentCmdBuffs[i]->flushStream();
         MessageQueue::freeChunksInFreeQueue(agentCmdBuffs[i]->_messageQueue);
         agentCmdBuffs[i]->_messageQueue->finishWriting();
     }
@@ -422,6 +494,29 @@ void DeviceAgent::getQueryPoolResults(QueryPool *queryPool) {
     queryPoolAgent->_results = actorQueryPoolAgent->_results;
 }
 
+void DeviceAgent::setBinaryCache(BinaryCache *cache) {
+    _binaryCache = cache;
+    // expected to be set up front, before the device thread starts creating shaders
+    _actor->setBinaryCache(cache);
+}
+
+bool DeviceAgent::getPipelineCacheData(ccstd::vector<uint8_t> &data) {
+    // pipelines still queued for creation should make it into the blob
+    _mainMessageQueue->kickAndWait();
+    return _actor->getPipelineCacheData(data);
+}
+
+void DeviceAgent::mergePipelineCacheData(const uint8_t *data, uint32_t size) {
+    _mainMessageQueue->kickAndWait();
+    _actor->mergePipelineCacheData(data, size);
+}
+
+void DeviceAgent::setAsyncPipelineCompile(bool enabled) {
+    _mainMessageQueue->kickAndWait();
+    _actor->setAsyncPipelineCompile(enabled);
+    _asyncPipelineCompile = _actor->isAsyncPipelineCompile();
+}
+
 void DeviceAgent::presentSignal() {
     _frameBoundarySemaphore.signal();
 }
@@ -429,8 +524,7 @@ void DeviceAgent::presentSignal() {
 void DeviceAgent::presentWait() {
     MessageQueue::freeChunksInFreeQueue(_mainMessageQueue);
     _mainMessageQueue->finishWriting();
-    _currentIndex = (_currentIndex + 1) % MAX_FRAME_INDEX;
-    _frameBoundarySemaphore.wait();
+    advanceFrame();
 }
 
 } // namespace gfx
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "base/Agent.h"
+#include "base/std/container/array.h"
 #include "base/std/container/unordered_set.h"
 #include "base/threading/Semaphore.h"
 #include "gfx-base/GFXDevice.h"
@@ -33,6 +34,7 @@
 namespace cc {
 class IXRInterface;
 class MessageQueue;
+class ThreadSafeLinearAllocator;
 
 namespace gfx {
 
@@ -42,8 +44,17 @@ class CommandBufferAgent;
 class CC_DLL DeviceAgent final : public Agent<Device> {
 public:
     static DeviceAgent *getInstance();
-    static constexpr uint32_t MAX_CPU_FRAME_AHEAD = 1;
+    // upper bound of the configurable frames in flight, per frame resources are sized by this
+    static constexpr uint32_t MAX_CPU_FRAME_AHEAD = 3;
     static constexpr uint32_t MAX_FRAME_INDEX = MAX_CPU_FRAME_AHEAD + 1;
+    static constexpr uint32_t DEFAULT_CPU_FRAME_AHEAD = 1;
+    static constexpr uint32_t FRAME_ALLOCATOR_SIZE = 2 * 1024 * 1024;
+
+    struct FrameStats {
+        uint32_t framesInFlight{0};
+        float producerStallMs{0.F}; // main thread blocked waiting for the device thread to catch up
+        float consumerIdleMs{0.F};  // device thread starved of messages
+    };
 
     ~DeviceAgent() override;
 
@@ -96,9 +107,25 @@ public:
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
 
+    void setBinaryCache(BinaryCache *cache) override;
+    bool getPipelineCacheData(ccstd::vector<uint8_t> &data) override;
+    void mergePipelineCacheData(const uint8_t *data, uint32_t size) override;
+    void setAsyncPipelineCompile(bool enabled) override;
+
     uint32_t getCurrentIndex() const { return _currentIndex; }
     void setMultithreaded(bool multithreaded);
 
+    // how many frames the main thread may record ahead of the device thread, clamped to [1, MAX_CPU_FRAME_AHEAD]
+    // deeper pipelines absorb hitches on either side at the cost of latency
+    void setMaxFramesInFlight(uint32_t count);
+    inline uint32_t getMaxFramesInFlight() const { return _framesInFlight; }
+    inline uint32_t getFrameCount() const { return _framesInFlight + 1; }
+
+    // transient per frame memory, recycled once the device thread is done with the frame
+    inline ThreadSafeLinearAllocator *getFrameAllocator() const { return _frameAllocators[_currentIndex]; }
+    // stats of the latest frame fully consumed by the device thread
+    inline const FrameStats &getFrameStats() const { return _lastFrameStats; }
+
     inline MessageQueue *getMessageQueue() const { return _mainMessageQueue; }
 
     void presentWait();
@@ -118,13 +145,21 @@ protected:
     bool _multithreaded{false};
     MessageQueue *_mainMessageQueue{nullptr};
 
+    void advanceFrame();
+
     uint32_t _currentIndex = 0U;
+    uint32_t _framesInFlight = DEFAULT_CPU_FRAME_AHEAD;
 #if CC_USE_XR
     Semaphore _frameBoundarySemaphore{0};
 #else
-    Semaphore _frameBoundarySemaphore{MAX_CPU_FRAME_AHEAD};
+    Semaphore _frameBoundarySemaphore{DEFAULT_CPU_FRAME_AHEAD};
 #endif
 
+    ccstd::array<ThreadSafeLinearAllocator *, MAX_FRAME_INDEX> _frameAllocators{};
+    ccstd::array<FrameStats, MAX_FRAME_INDEX> _frameStats{};
+    FrameStats _lastFrameStats;
+    uint64_t _consumerIdleMark{0U}; // only touched on the device thread
+
     ccstd::unordered_set<CommandBufferAgent *> _cmdBuffRefs;
     IXRInterface *_xr{nullptr};
 };
@@ -49,6 +49,10 @@ PipelineStateAgent::~PipelineStateAgent() {
         });
 }
 
+bool PipelineStateAgent::isReady() const {
+    return !DeviceAgent::getInstance()->isAsyncPipelineCompile() || _actor->isReady();
+}
+
 void PipelineStateAgent::doInit(const PipelineStateInfo &info) {
     PipelineStateInfo actorInfo = info;
     actorInfo.shader = static_cast<ShaderAgent *>(info.shader)->getActor();
@@ -36,6 +36,9 @@ public:
     explicit PipelineStateAgent(PipelineState *actor);
     ~PipelineStateAgent() override;
 
+    // the actor is only initialized on the device thread, without async compile it is bound as soon as that has run
+    bool isReady() const override;
+
 protected:
     void doInit(const PipelineStateInfo &info) override;
     void doDestroy() override;
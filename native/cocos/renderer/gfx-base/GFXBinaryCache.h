@@ -0,0 +1,59 @@
+/****************************************************************************
+ Copyright (c) 2019-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * Storage for compiled shader binaries, keyed by a 64-bit hash of everything
+ * that went into the compilation. Backends consult it from the device thread,
+ * so implementations must be thread safe.
+ */
+class CC_DLL BinaryCache {
+public:
+    virtual ~BinaryCache() = default;
+
+    virtual bool load(uint64_t key, ccstd::vector<uint8_t> &data) = 0;
+    virtual void store(uint64_t key, const uint8_t *data, uint32_t size) = 0;
+
+    // FNV-1a, stable across runs and platforms unlike std::hash
+    static inline uint64_t hashBytes(uint64_t seed, const void *data, size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            seed = (seed ^ bytes[i]) * 0x100000001B3ULL;
+        }
+        return seed;
+    }
+
+    static constexpr uint64_t HASH_SEED = 0xCBF29CE484222325ULL;
+};
+
+} // namespace gfx
+} // namespace cc
@@ -43,9 +43,10 @@ public:
     void resize(uint32_t size);
     void destroy();
 
-    virtual void update(const void *buffer, uint32_t size) = 0;
+    virtual void update(const void *buffer, uint32_t size, uint32_t offset) = 0;
 
-    inline void update(const void *buffer) { update(buffer, _size); }
+    inline void update(const void *buffer) { update(buffer, _size, 0); }
+    inline void update(const void *buffer, uint32_t size) { update(buffer, size, 0); }
 
     inline BufferUsage getUsage() const { return _usage; }
     inline MemoryUsage getMemUsage() const { return _memUsage; }
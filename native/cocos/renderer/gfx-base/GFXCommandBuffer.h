@@ -60,7 +60,7 @@ public:
     virtual void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) = 0;
     virtual void nextSubpass() = 0;
     virtual void draw(const DrawInfo &info) = 0;
-    virtual void updateBuffer(Buffer *buff, const void *data, uint32_t size) = 0;
+    virtual void updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) = 0;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) = 0;
     virtual void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) = 0;
     virtual void execute(CommandBuffer *const *cmdBuffs, uint32_t count) = 0;
@@ -84,6 +84,7 @@ public:
     inline void begin(RenderPass *renderPass, uint32_t subpass);
 
     inline void updateBuffer(Buffer *buff, const void *data);
+    inline void updateBuffer(Buffer *buff, const void *data, uint32_t size);
 
     inline void execute(const CommandBufferList &cmdBuffs, uint32_t count);
 
@@ -136,7 +137,11 @@ void CommandBuffer::begin(RenderPass *renderPass, uint32_t subpass) {
 }
 
 void CommandBuffer::updateBuffer(Buffer *buff, const void *data) {
-    updateBuffer(buff, data, buff->getSize());
+    updateBuffer(buff, data, buff->getSize(), 0);
+}
+
+void CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+    updateBuffer(buff, data, size, 0);
 }
 
 void CommandBuffer::execute(const CommandBufferList &cmdBuffs, uint32_t count) {
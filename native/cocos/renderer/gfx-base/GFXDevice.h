@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "GFXBinaryCache.h"
 #include "GFXBuffer.h"
 #include "GFXCommandBuffer.h"
 #include "GFXDescriptorSet.h"
@@ -109,8 +110,11 @@ public:
     inline const ccstd::string &getDeviceName() const { return _deviceName; }
     inline const ccstd::string &getRenderer() const { return _renderer; }
     inline const ccstd::string &getVendor() const { return _vendor; }
+    inline const ccstd::string &getVersion() const { return _version; }
     inline bool hasFeature(Feature feature) const { return _features[toNumber(feature)]; }
     inline FormatFeature getFormatFeatures(Format format) const { return _formatFeatures[toNumber(format)]; }
+    // whether command buffers may be recorded concurrently from job system workers
+    inline bool isMultithreadedCommandRecording() const { return _multithreadedCommandRecording; }
 
     inline const BindingMappingInfo &bindingMappingInfo() const { return _bindingMappingInfo; }
 
@@ -122,6 +126,19 @@ public:
     inline void setOptions(const DeviceOptions &opts) { _options = opts; }
     inline const DeviceOptions &getOptions() const { return _options; }
 
+    // shader binary storage consulted by the backends, not owned by the device
+    virtual void setBinaryCache(BinaryCache *cache) { _binaryCache = cache; }
+    inline BinaryCache *getBinaryCache() const { return _binaryCache; }
+
+    // serialized driver pipeline cache, for backends that expose one (Vulkan)
+    virtual bool getPipelineCacheData(ccstd::vector<uint8_t> & /*data*/) { return false; }
+    virtual void mergePipelineCacheData(const uint8_t * /*data*/, uint32_t /*size*/) {}
+
+    // compile pipelines on background threads where the backend supports it (Vulkan),
+    // PipelineState::isReady reports when a pipeline can be bound without blocking
+    virtual void setAsyncPipelineCompile(bool /*enabled*/) {}
+    inline bool isAsyncPipelineCompile() const { return _asyncPipelineCompile; }
+
 protected:
     static Device *instance;
     static bool isSupportDetachDeviceThread;
@@ -168,6 +185,7 @@ protected:
     DeviceOptions _options;
 
     bool _multithreadedCommandRecording{true};
+    bool _asyncPipelineCompile{false};
 
     ccstd::array<bool, static_cast<size_t>(Feature::COUNT)> _features;
     ccstd::array<FormatFeature, static_cast<size_t>(Format::COUNT)> _formatFeatures;
@@ -176,6 +194,7 @@ protected:
     QueryPool *_queryPool{nullptr};
     CommandBuffer *_cmdBuff{nullptr};
     Executable *_onAcquire{nullptr};
+    BinaryCache *_binaryCache{nullptr};
 
     uint32_t _numDrawCalls{0U};
     uint32_t _numInstances{0U};
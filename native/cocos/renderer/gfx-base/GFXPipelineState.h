@@ -50,6 +50,9 @@ public:
     inline const RenderPass *getRenderPass() const { return _renderPass; }
     inline const PipelineLayout *getPipelineLayout() const { return _pipelineLayout; }
 
+    // false while the backend is still compiling the pipeline in the background
+    virtual bool isReady() const { return true; }
+
 protected:
     virtual void doInit(const PipelineStateInfo &info) = 0;
     virtual void doDestroy() = 0;
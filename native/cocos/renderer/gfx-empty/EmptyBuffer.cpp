@@ -40,7 +40,7 @@ void EmptyBuffer::doResize(uint32_t size, uint32_t count) {
 void EmptyBuffer::doDestroy() {
 }
 
-void EmptyBuffer::update(const void *buffer, uint32_t size) {
+void EmptyBuffer::update(const void *buffer, uint32_t size, uint32_t offset) {
 }
 
 } // namespace gfx
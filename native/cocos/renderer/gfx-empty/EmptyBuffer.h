@@ -32,7 +32,7 @@ namespace gfx {
 
 class CC_DLL EmptyBuffer final : public Buffer {
 public:
-    void update(const void *buffer, uint32_t size) override;
+    void update(const void *buffer, uint32_t size, uint32_t offset) override;
 
 protected:
     void doInit(const BufferInfo &info) override;
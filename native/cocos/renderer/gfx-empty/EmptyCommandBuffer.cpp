@@ -88,7 +88,7 @@ void EmptyCommandBuffer::nextSubpass() {
 void EmptyCommandBuffer::draw(const DrawInfo &info) {
 }
 
-void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
 }
 
 void EmptyCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
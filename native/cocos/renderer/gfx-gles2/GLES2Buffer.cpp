@@ -88,9 +88,9 @@ void GLES2Buffer::doResize(uint32_t size, uint32_t count) {
     CC_PROFILE_MEMORY_INC(Buffer, size);
 }
 
-void GLES2Buffer::update(const void *buffer, uint32_t size) {
+void GLES2Buffer::update(const void *buffer, uint32_t size, uint32_t offset) {
     CC_PROFILE(GLES2BufferUpdate);
-    cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), _gpuBuffer, buffer, 0U, size);
+    cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), _gpuBuffer, buffer, offset, size);
 }
 
 } // namespace gfx
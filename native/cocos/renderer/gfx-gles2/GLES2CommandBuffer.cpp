@@ -286,12 +286,13 @@ void GLES2CommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
-void GLES2CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void GLES2CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     GLES2GPUBuffer *gpuBuffer = static_cast<GLES2Buffer *>(buff)->gpuBuffer();
     if (gpuBuffer) {
         GLES2CmdUpdateBuffer *cmd = _cmdAllocator->updateBufferCmdPool.alloc();
         cmd->gpuBuffer = gpuBuffer;
         cmd->size = size;
+        cmd->offset = offset;
         cmd->buffer = static_cast<const uint8_t *>(data);
 
         _curCmdPackage->updateBufferCmds.push(cmd);
@@ -422,6 +422,7 @@ const GLenum GLES2_BLEND_FACTORS[] = {
 } // namespace
 
 void cmdFuncGLES2CreateBuffer(GLES2Device *device, GLES2GPUBuffer *gpuBuffer) {
+    CC_MEMORY_TAG_SCOPE(GFX);
     GLES2ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
     GLenum glUsage = (hasFlag(gpuBuffer->memUsage, MemoryUsageBit::HOST) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 
@@ -513,6 +514,7 @@ void cmdFuncGLES2DestroyBuffer(GLES2Device *device, GLES2GPUBuffer *gpuBuffer) {
 }
 
 void cmdFuncGLES2ResizeBuffer(GLES2Device *device, GLES2GPUBuffer *gpuBuffer) {
+    CC_MEMORY_TAG_SCOPE(GFX);
     GLES2ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
     GLenum glUsage = (hasFlag(gpuBuffer->memUsage, MemoryUsageBit::HOST) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 
@@ -85,6 +85,7 @@ public:
 
     inline uint8_t *getStagingBuffer(uint32_t size = 0) {
         if (size > _stagingBufferSize) {
+            CC_MEMORY_TAG_SCOPE(GFX);
             CC_FREE(_stagingBuffer);
             _stagingBuffer = static_cast<uint8_t *>(CC_MALLOC(size));
             _stagingBufferSize = size;
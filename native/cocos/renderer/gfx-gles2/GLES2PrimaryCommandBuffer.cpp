@@ -136,10 +136,10 @@ void GLES2PrimaryCommandBuffer::setScissor(const Rect &rect) {
     }
 }
 
-void GLES2PrimaryCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void GLES2PrimaryCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     GLES2GPUBuffer *gpuBuffer = static_cast<GLES2Buffer *>(buff)->gpuBuffer();
     if (gpuBuffer) {
-        cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), gpuBuffer, data, 0U, size);
+        cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), gpuBuffer, data, offset, size);
     }
 }
 
@@ -43,7 +43,7 @@ public:
     void draw(const DrawInfo &info) override;
     void setViewport(const Viewport &vp) override;
     void setScissor(const Rect &rect) override;
-    void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
+    void updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
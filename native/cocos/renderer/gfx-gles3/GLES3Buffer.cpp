@@ -97,9 +97,9 @@ void GLES3Buffer::doResize(uint32_t size, uint32_t count) {
     CC_PROFILE_MEMORY_INC(Buffer, size);
 }
 
-void GLES3Buffer::update(const void *buffer, uint32_t size) {
+void GLES3Buffer::update(const void *buffer, uint32_t size, uint32_t offset) {
     CC_PROFILE(GLES3BufferUpdate);
-    cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), _gpuBuffer, buffer, 0U, size);
+    cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), _gpuBuffer, buffer, offset, size);
 }
 
 } // namespace gfx
@@ -38,7 +38,7 @@ public:
     GLES3Buffer();
     ~GLES3Buffer() override;
 
-    void update(const void *buffer, uint32_t size) override;
+    void update(const void *buffer, uint32_t size, uint32_t offset) override;
 
     inline GLES3GPUBuffer *gpuBuffer() const { return _gpuBuffer; }
 
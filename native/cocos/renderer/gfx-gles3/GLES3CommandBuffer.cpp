@@ -287,12 +287,13 @@ void GLES3CommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
-void GLES3CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void GLES3CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     GLES3GPUBuffer *gpuBuffer = static_cast<GLES3Buffer *>(buff)->gpuBuffer();
     if (gpuBuffer) {
         GLES3CmdUpdateBuffer *cmd = _cmdAllocator->updateBufferCmdPool.alloc();
         cmd->gpuBuffer = gpuBuffer;
         cmd->size = size;
+        cmd->offset = offset;
         cmd->buffer = static_cast<const uint8_t *>(data);
 
         _curCmdPackage->updateBufferCmds.push(cmd);
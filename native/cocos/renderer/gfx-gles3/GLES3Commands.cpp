@@ -588,6 +588,7 @@ const GLint GL_SAMPLE_COUNT[] = {
 } // namespace
 
 void cmdFuncGLES3CreateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
+    CC_MEMORY_TAG_SCOPE(GFX);
     GLenum glUsage = hasFlag(gpuBuffer->memUsage, MemoryUsageBit::HOST) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
 
@@ -730,6 +731,7 @@ void cmdFuncGLES3DestroyBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
 }
 
 void cmdFuncGLES3ResizeBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
+    CC_MEMORY_TAG_SCOPE(GFX);
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
 
     GLenum glUsage = (hasFlag(gpuBuffer->memUsage, MemoryUsageBit::HOST) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
@@ -997,8 +999,53 @@ GLuint GLES3GPUSampler::getGLSampler(uint16_t minLod, uint16_t maxLod) {
     return _cache[hash];
 }
 
-// NOLINTNEXTLINE(google-readability-function-size, readability-function-size)
-void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
+namespace {
+
+uint64_t getProgramBinaryKey(const GLES3GPUShader *gpuShader, uint32_t version) {
+    uint64_t key = BinaryCache::hashBytes(BinaryCache::HASH_SEED, &version, sizeof(version));
+    for (const auto &gpuStage : gpuShader->gpuStages) {
+        key = BinaryCache::hashBytes(key, &gpuStage.type, sizeof(gpuStage.type));
+        key = BinaryCache::hashBytes(key, gpuStage.source.data(), gpuStage.source.size());
+    }
+    return key;
+}
+
+// cached blobs are laid out as [binary format][program binary]
+bool loadProgramBinary(GLES3GPUShader *gpuShader, const ccstd::vector<uint8_t> &blob) {
+    if (blob.size() <= sizeof(GLenum)) return false;
+
+    GLenum format = 0;
+    memcpy(&format, blob.data(), sizeof(GLenum));
+    GL_CHECK(gpuShader->glProgram = glCreateProgram());
+    GL_CHECK(glProgramBinary(gpuShader->glProgram, format, blob.data() + sizeof(GLenum), static_cast<GLsizei>(blob.size() - sizeof(GLenum))));
+
+    // drivers reject binaries from other driver versions, fall back to compiling from source
+    GLint status = 0;
+    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        GL_CHECK(glDeleteProgram(gpuShader->glProgram));
+        gpuShader->glProgram = 0;
+        return false;
+    }
+    return true;
+}
+
+void storeProgramBinary(BinaryCache *cache, uint64_t key, const GLES3GPUShader *gpuShader) {
+    GLint length = 0;
+    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) return;
+
+    ccstd::vector<uint8_t> blob(sizeof(GLenum) + length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    GL_CHECK(glGetProgramBinary(gpuShader->glProgram, length, &written, &format, blob.data() + sizeof(GLenum)));
+    if (written <= 0) return;
+
+    memcpy(blob.data(), &format, sizeof(GLenum));
+    cache->store(key, blob.data(), static_cast<uint32_t>(sizeof(GLenum) + written));
+}
+
+bool compileAndLinkProgram(GLES3Device *device, GLES3GPUShader *gpuShader, bool retrievable) {
     GLenum glShaderStage = 0;
     ccstd::string shaderStageStr;
     GLint status;
@@ -1024,7 +1071,7 @@ void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
             }
             default: {
                 CC_ASSERT(false);
-                return;
+                return false;
             }
         }
         GL_CHECK(gpuStage.glShader = glCreateShader(glShaderStage));
@@ -1048,11 +1095,14 @@ void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
             CC_FREE(logs);
             GL_CHECK(glDeleteShader(gpuStage.glShader));
             gpuStage.glShader = 0;
-            return;
+            return false;
         }
     }
 
     GL_CHECK(gpuShader->glProgram = glCreateProgram());
+    if (retrievable) {
+        GL_CHECK(glProgramParameteri(gpuShader->glProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
 
     // link program
     for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
@@ -1084,12 +1134,13 @@ void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
 
             CC_LOG_ERROR(logs);
             CC_FREE(logs);
-            return;
+            return false;
         }
     }
+    return true;
+}
 
-    CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
-
+void reflectProgramInterfaces(GLES3Device *device, GLES3GPUShader *gpuShader) {
     GLint attrMaxLength = 0;
     GLint attrCount = 0;
     GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &attrMaxLength));
@@ -1184,7 +1235,9 @@ void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
             }
         }
     }
+}
 
+void mapSamplerTextureUnits(GLES3Device *device, GLES3GPUShader *gpuShader) {
     // fallback subpassInputs into samplerTextures if not using FBF
     if (device->constantRegistry()->mFBF == FBFSupportLevel::NONE) {
         for (const auto &subpassInput : gpuShader->subpassInputs) {
@@ -1325,6 +1378,39 @@ void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
     }
 }
 
+} // namespace
+
+void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
+    // program binaries are unusable when the driver reports no binary formats
+    BinaryCache *cache = device->getBinaryCache();
+    if (cache) {
+        GLint formatCount = 0;
+        GL_CHECK(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+        if (formatCount <= 0) cache = nullptr;
+    }
+
+    uint64_t cacheKey = 0U;
+    ccstd::vector<uint8_t> blob;
+    uint32_t version = device->constantRegistry()->glMinorVersion ? 310 : 300;
+    if (cache) {
+        cacheKey = getProgramBinaryKey(gpuShader, version);
+    }
+
+    if (!cache || !cache->load(cacheKey, blob) || !loadProgramBinary(gpuShader, blob)) {
+        if (!compileAndLinkProgram(device, gpuShader, cache != nullptr)) {
+            return;
+        }
+        if (cache) {
+            storeProgramBinary(cache, cacheKey, gpuShader);
+        }
+    }
+
+    CC_LOG_INFO("Shader '%s' compilation succeeded.", gpuShader->name.c_str());
+
+    reflectProgramInterfaces(device, gpuShader);
+    mapSamplerTextureUnits(device, gpuShader);
+}
+
 void cmdFuncGLES3DestroyShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
     if (gpuShader->glProgram) {
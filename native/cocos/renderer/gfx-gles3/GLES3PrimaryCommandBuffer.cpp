@@ -128,10 +128,10 @@ void GLES3PrimaryCommandBuffer::setScissor(const Rect &rect) {
     }
 }
 
-void GLES3PrimaryCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void GLES3PrimaryCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     GLES3GPUBuffer *gpuBuffer = static_cast<GLES3Buffer *>(buff)->gpuBuffer();
     if (gpuBuffer) {
-        cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), gpuBuffer, data, 0U, size);
+        cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), gpuBuffer, data, offset, size);
     }
 }
 
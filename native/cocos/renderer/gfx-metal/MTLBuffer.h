@@ -46,7 +46,7 @@ public:
     CCMTLBuffer &operator=(const CCMTLBuffer &) = default;
     CCMTLBuffer &operator=(CCMTLBuffer &&) = delete;
 
-    void update(const void *buffer, uint32_t offset) override;
+    void update(const void *buffer, uint32_t size, uint32_t offset) override;
 
     void encodeBuffer(CCMTLCommandEncoder &encoder, uint32_t offset, uint32_t binding, ShaderStageFlags stages);
 
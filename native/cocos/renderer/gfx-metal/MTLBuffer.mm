@@ -188,7 +188,7 @@ void CCMTLBuffer::doResize(uint32_t size, uint32_t count) {
     }
 }
 
-void CCMTLBuffer::update(const void *buffer, uint32_t size) {
+void CCMTLBuffer::update(const void *buffer, uint32_t size, uint32_t offset) {
     CC_PROFILE(CCMTLBufferUpdate);
     if (_isBufferView) {
         CC_LOG_WARNING("Cannot update a buffer view.");
@@ -239,18 +239,18 @@ void CCMTLBuffer::update(const void *buffer, uint32_t size) {
             memcpy(_drawInfos.data(), buffer, size);
         }
     } else {
-        updateMTLBuffer(buffer, 0, size);
+        updateMTLBuffer(buffer, offset, size);
     }
 }
 
-void CCMTLBuffer::updateMTLBuffer(const void *buffer, uint32_t /*offset*/, uint32_t size) {
+void CCMTLBuffer::updateMTLBuffer(const void *buffer, uint32_t offset, uint32_t size) {
     if (_gpuBuffer->mtlBuffer) {
         CommandBuffer *cmdBuffer = CCMTLDevice::getInstance()->getCommandBuffer();
         cmdBuffer->begin();
-        static_cast<CCMTLCommandBuffer *>(cmdBuffer)->updateBuffer(this, buffer, size);
+        static_cast<CCMTLCommandBuffer *>(cmdBuffer)->updateBuffer(this, buffer, size, offset);
 #if (CC_PLATFORM == CC_PLATFORM_MACOS)
         if (_mtlResourceOptions == MTLResourceStorageModeManaged) {
-            [_gpuBuffer->mtlBuffer didModifyRange:NSMakeRange(0, _size)]; // Synchronize the managed buffer.
+            [_gpuBuffer->mtlBuffer didModifyRange:NSMakeRange(offset, size)]; // Synchronize the managed buffer.
         }
 #endif
     }
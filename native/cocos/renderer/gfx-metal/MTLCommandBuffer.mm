@@ -661,7 +661,7 @@ void CCMTLCommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
-void CCMTLCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void CCMTLCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     CC_PROFILE(CCMTLCmdBufUpdateBuffer);
     if (!buff) {
         CC_LOG_ERROR("CCMTLCommandBuffer::updateBuffer: buffer is nullptr.");
@@ -676,7 +676,7 @@ void CCMTLCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t s
     [encoder copyFromBuffer:stagingBuffer.mtlBuffer
                sourceOffset:stagingBuffer.startOffset
                    toBuffer:static_cast<CCMTLBuffer *>(buff)->getMTLBuffer()
-          destinationOffset:0
+          destinationOffset:offset
                        size:size];
     [encoder endEncoding];
 }
@@ -741,9 +741,9 @@ void CCMTLCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Tex
         for(size_t l = region.texSubres.baseArrayLayer; l < region.texSubres.layerCount + region.texSubres.baseArrayLayer; ++l) {
             for(size_t d = targetOffset.z; d < targetSize.depth + targetOffset.z; ++d) {
                 if(compactMemory) {
-                    const auto *convertedData = mu::convertData(buffers[i] + region.buffOffset + (l - region.texSubres.baseArrayLayer) * bufferBytesPerImage
-                                                                + (d - targetOffset.z) * bufferSliceSize,
-                                                                bufferPixelWidth * blockSize.second, format);
+                    const uint8_t *source = buffers[i] + region.buffOffset + (l - region.texSubres.baseArrayLayer) * bufferBytesPerImage
+                                            + (d - targetOffset.z) * bufferSliceSize;
+                    const auto *convertedData = mu::convertData(source, bufferPixelWidth * blockSize.second, format);
                     
                     ccstd::vector<uint8_t> data(bufferSliceSize);
                     memcpy(data.data(), convertedData, bufferSliceSize);
@@ -760,14 +760,15 @@ void CCMTLCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Tex
                                   bytesPerRow:bytesPerRowForTarget
                                 bytesPerImage:bytesPerImageForTarget];
                     
-                    if (format == Format::RGB8 || format == Format::RGB32F) {
+                    // the source comes back as is when no conversion is needed or the allocation failed
+                    if (convertedData != source) {
                         CC_FREE(convertedData);
                     }
                 } else {
                     for(size_t h = targetOffset.y; h < targetSize.height + targetOffset.y; h += blockSize.second) {
-                        const auto *convertedData = mu::convertData(buffers[i] + region.buffOffset + (l - region.texSubres.baseArrayLayer) * bufferBytesPerImage
-                                                                    + (d - targetOffset.z) * bufferSliceSize + h / blockSize.second * bufferBytesPerRow,
-                                                                    bufferPixelWidth * blockSize.second, format);
+                        const uint8_t *source = buffers[i] + region.buffOffset + (l - region.texSubres.baseArrayLayer) * bufferBytesPerImage
+                                                + (d - targetOffset.z) * bufferSliceSize + h / blockSize.second * bufferBytesPerRow;
+                        const auto *convertedData = mu::convertData(source, bufferPixelWidth * blockSize.second, format);
                         
                         ccstd::vector<uint8_t> data(bytesPerRowForTarget);
                         memcpy(data.data(), convertedData, bytesPerRowForTarget );
@@ -784,7 +785,7 @@ void CCMTLCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Tex
                                       bytesPerRow:bytesPerRowForTarget
                                     bytesPerImage:bytesPerImageForTarget];
                         
-                        if (format == Format::RGB8 || format == Format::RGB32F) {
+                        if (convertedData != source) {
                             CC_FREE(convertedData);
                         }
                     }
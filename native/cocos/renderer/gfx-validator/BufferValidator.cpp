@@ -138,12 +138,12 @@ void BufferValidator::doDestroy() {
     _actor->destroy();
 }
 
-void BufferValidator::update(const void *buffer, uint32_t size) {
+void BufferValidator::update(const void *buffer, uint32_t size, uint32_t offset) {
     CC_ASSERT(isInited());
 
     // Cannot update through buffer views.
     CC_ASSERT(!_isBufferView);
-    CC_ASSERT(size && size <= _size);
+    CC_ASSERT(size && offset + size <= _size);
     CC_ASSERT(buffer);
 
     if (hasFlag(_usage, BufferUsageBit::INDIRECT)) {
@@ -158,15 +158,15 @@ void BufferValidator::update(const void *buffer, uint32_t size) {
         }
     }
 
-    sanityCheck(buffer, size);
+    sanityCheck(buffer, size, offset);
     ++_totalUpdateTimes; // only count direct updates
 
     /////////// execute ///////////
 
-    _actor->update(buffer, size);
+    _actor->update(buffer, size, offset);
 }
 
-void BufferValidator::sanityCheck(const void *buffer, uint32_t size) {
+void BufferValidator::sanityCheck(const void *buffer, uint32_t size, uint32_t offset) {
     uint64_t cur = DeviceValidator::getInstance()->currentFrame();
 
     if (cur == _lastUpdateFrame) {
@@ -178,7 +178,7 @@ void BufferValidator::sanityCheck(const void *buffer, uint32_t size) {
 
     if (DeviceValidator::getInstance()->isRecording()) {
         _buffer.resize(_size);
-        memcpy(_buffer.data(), buffer, size);
+        memcpy(_buffer.data() + offset, buffer, size);
     }
 
     _lastUpdateFrame = cur;
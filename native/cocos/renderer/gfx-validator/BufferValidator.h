@@ -36,9 +36,9 @@ public:
     explicit BufferValidator(Buffer *actor);
     ~BufferValidator() override;
 
-    void update(const void *buffer, uint32_t size) override;
+    void update(const void *buffer, uint32_t size, uint32_t offset) override;
 
-    void sanityCheck(const void *buffer, uint32_t size);
+    void sanityCheck(const void *buffer, uint32_t size, uint32_t offset = 0);
 
     inline bool isInited() const { return _inited; }
 
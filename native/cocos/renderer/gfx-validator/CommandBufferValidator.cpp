@@ -385,7 +385,7 @@ void CommandBufferValidator::draw(const DrawInfo &info) {
     _actor->draw(info);
 }
 
-void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     CC_ASSERT(isInited());
     CC_ASSERT(buff && static_cast<BufferValidator *>(buff)->isInited());
 
@@ -395,11 +395,15 @@ void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint32
     CC_ASSERT(!_insideRenderPass);
 
     auto *bufferValidator = static_cast<BufferValidator *>(buff);
-    bufferValidator->sanityCheck(data, size);
+    // The updated range must lie inside the buffer.
+    CC_ASSERT(offset + size <= buff->getSize());
+    // Indirect buffers must be updated as a whole.
+    CC_ASSERT(!offset || !hasFlag(buff->getUsage(), BufferUsageBit::INDIRECT));
+    bufferValidator->sanityCheck(data, size, offset);
 
     /////////// execute ///////////
 
-    _actor->updateBuffer(bufferValidator->getActor(), data, size);
+    _actor->updateBuffer(bufferValidator->getActor(), data, size, offset);
 }
 
 void CommandBufferValidator::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
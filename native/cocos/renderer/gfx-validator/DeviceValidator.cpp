@@ -84,7 +84,9 @@ bool DeviceValidator::doInit(const DeviceInfo &info) {
     _cmdBuff = ccnew CommandBufferValidator(_actor->getCommandBuffer());
     _renderer = _actor->getRenderer();
     _vendor = _actor->getVendor();
+    _version = _actor->getVersion();
     _caps = _actor->_caps;
+    _multithreadedCommandRecording = _actor->_multithreadedCommandRecording;
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
     memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
 
@@ -361,5 +363,15 @@ void DeviceValidator::getQueryPoolResults(QueryPool *queryPool) {
     queryPoolValidator->_results = actorQueryPoolValidator->_results;
 }
 
+void DeviceValidator::setAsyncPipelineCompile(bool enabled) {
+    _actor->setAsyncPipelineCompile(enabled);
+    _asyncPipelineCompile = _actor->isAsyncPipelineCompile();
+}
+
+void DeviceValidator::setBinaryCache(BinaryCache *cache) {
+    _binaryCache = cache;
+    _actor->setBinaryCache(cache);
+}
+
 } // namespace gfx
 } // namespace cc
@@ -88,6 +88,11 @@ public:
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
 
+    void setBinaryCache(BinaryCache *cache) override;
+    bool getPipelineCacheData(ccstd::vector<uint8_t> &data) override { return _actor->getPipelineCacheData(data); }
+    void mergePipelineCacheData(const uint8_t *data, uint32_t size) override { _actor->mergePipelineCacheData(data, size); }
+    void setAsyncPipelineCompile(bool enabled) override;
+
     inline void enableRecording(bool recording) { _recording = recording; }
     inline bool isRecording() const { return _recording; }
     inline uint64_t currentFrame() const { return _currentFrame; }
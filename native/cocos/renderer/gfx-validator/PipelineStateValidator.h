@@ -38,6 +38,8 @@ public:
 
     inline bool isInited() const { return _inited; }
 
+    bool isReady() const override { return _actor->isReady(); }
+
 protected:
     void doInit(const PipelineStateInfo &info) override;
     void doDestroy() override;
@@ -119,9 +119,9 @@ void CCVKBuffer::doResize(uint32_t size, uint32_t count) {
     CC_PROFILE_MEMORY_INC(Buffer, size);
 }
 
-void CCVKBuffer::update(const void *buffer, uint32_t size) {
+void CCVKBuffer::update(const void *buffer, uint32_t size, uint32_t offset) {
     CC_PROFILE(CCVKBufferUpdate);
-    cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), _gpuBuffer, buffer, size, nullptr);
+    cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), _gpuBuffer, buffer, size, nullptr, offset);
 }
 
 } // namespace gfx
@@ -473,10 +473,10 @@ void CCVKCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
     }
 }
 
-void CCVKCommandBuffer::updateBuffer(Buffer *buffer, const void *data, uint32_t size) {
+void CCVKCommandBuffer::updateBuffer(Buffer *buffer, const void *data, uint32_t size, uint32_t offset) {
     CC_PROFILE(CCVKCmdBufUpdateBuffer);
     CCVKGPUBuffer *gpuBuffer = static_cast<CCVKBuffer *>(buffer)->gpuBuffer();
-    cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), gpuBuffer, data, size, _gpuCommandBuffer);
+    cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), gpuBuffer, data, size, _gpuCommandBuffer, offset);
 }
 
 void CCVKCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
@@ -838,14 +838,103 @@ void cmdFuncCCVKCreateFramebuffer(CCVKDevice *device, CCVKGPUFramebuffer *gpuFra
     }
 }
 
+namespace {
+
+constexpr uint32_t SPIRV_MAGIC_NUMBER = 0x07230203U;
+
+uint64_t getSPIRVCacheKey(const CCVKGPUShaderStage &stage, const ccstd::string &source, const AttributeList &attributes) {
+    uint64_t key = BinaryCache::hashBytes(BinaryCache::HASH_SEED, &stage.type, sizeof(stage.type));
+    key = BinaryCache::hashBytes(key, source.data(), source.size());
+    if (stage.type == ShaderStageFlagBit::VERTEX) {
+        for (const auto &attribute : attributes) {
+            key = BinaryCache::hashBytes(key, attribute.name.data(), attribute.name.size());
+            key = BinaryCache::hashBytes(key, &attribute.location, sizeof(attribute.location));
+        }
+    }
+    return key;
+}
+
+/**
+ * Cached blobs are laid out as [location count][remapped attribute locations][SPIR-V words],
+ * so a hit replays what compressInputLocations did to the attribute list on the original compile.
+ */
+bool loadCachedSPIRV(const ccstd::vector<uint8_t> &blob, AttributeList &attributes, ccstd::vector<uint32_t> &code) {
+    if (blob.size() < sizeof(uint32_t) || blob.size() % sizeof(uint32_t)) return false;
+
+    uint32_t locationCount = 0U;
+    memcpy(&locationCount, blob.data(), sizeof(uint32_t));
+    size_t codeOffset = (1U + locationCount) * sizeof(uint32_t);
+    if (codeOffset >= blob.size()) return false;
+
+    code.resize((blob.size() - codeOffset) / sizeof(uint32_t));
+    memcpy(code.data(), blob.data() + codeOffset, code.size() * sizeof(uint32_t));
+    if (code[0] != SPIRV_MAGIC_NUMBER) return false;
+
+    if (locationCount) {
+        if (locationCount != attributes.size()) return false;
+        const auto *locations = reinterpret_cast<const uint32_t *>(blob.data()) + 1;
+        for (uint32_t i = 0U; i < locationCount; ++i) {
+            memcpy(&attributes[i].location, locations + i, sizeof(uint32_t));
+        }
+        attributes.erase(std::remove_if(attributes.begin(), attributes.end(), [](const auto &attr) {
+                             return attr.location == UINT_MAX;
+                         }),
+                         attributes.end());
+    }
+    return true;
+}
+
+void storeCachedSPIRV(BinaryCache *cache, uint64_t key, const AttributeList &originalAttributes,
+                      const AttributeList &attributes, const uint32_t *code, size_t codeSize) {
+    ccstd::vector<uint32_t> blob;
+    blob.reserve(1U + originalAttributes.size() + codeSize / sizeof(uint32_t));
+    blob.push_back(utils::toUint(originalAttributes.size()));
+    for (const auto &original : originalAttributes) {
+        auto iter = std::find_if(attributes.begin(), attributes.end(), [&original](const auto &attr) {
+            return attr.name == original.name;
+        });
+        blob.push_back(iter == attributes.end() ? UINT_MAX : iter->location);
+    }
+    blob.insert(blob.end(), code, code + codeSize / sizeof(uint32_t));
+    cache->store(key, reinterpret_cast<const uint8_t *>(blob.data()), utils::toUint(blob.size() * sizeof(uint32_t)));
+}
+
+} // namespace
+
 void cmdFuncCCVKCreateShader(CCVKDevice *device, CCVKGPUShader *gpuShader) {
     SPIRVUtils *spirv = SPIRVUtils::getInstance();
+    BinaryCache *cache = device->getBinaryCache();
+    ccstd::vector<uint8_t> blob;
+    ccstd::vector<uint32_t> cachedCode;
 
     for (CCVKGPUShaderStage &stage : gpuShader->gpuStages) {
-        spirv->compileGLSL(stage.type, "#version 450\n" + stage.source);
-        if (stage.type == ShaderStageFlagBit::VERTEX) spirv->compressInputLocations(gpuShader->attributes);
+        ccstd::string source = "#version 450\n" + stage.source;
+        bool isVertex = stage.type == ShaderStageFlagBit::VERTEX;
 
         VkShaderModuleCreateInfo createInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+        uint64_t cacheKey = 0U;
+        if (cache) {
+            cacheKey = getSPIRVCacheKey(stage, source, gpuShader->attributes);
+            AttributeList attributes = gpuShader->attributes;
+            if (cache->load(cacheKey, blob) && loadCachedSPIRV(blob, attributes, cachedCode)) {
+                gpuShader->attributes = std::move(attributes);
+                createInfo.codeSize = cachedCode.size() * sizeof(uint32_t);
+                createInfo.pCode = cachedCode.data();
+                VK_CHECK(vkCreateShaderModule(device->gpuDevice()->vkDevice, &createInfo, nullptr, &stage.vkShader));
+                continue;
+            }
+        }
+
+        spirv->compileGLSL(stage.type, source);
+        if (isVertex) {
+            AttributeList originalAttributes;
+            if (cache) originalAttributes = gpuShader->attributes;
+            spirv->compressInputLocations(gpuShader->attributes);
+            if (cache) storeCachedSPIRV(cache, cacheKey, originalAttributes, gpuShader->attributes, spirv->getOutputData(), spirv->getOutputSize());
+        } else if (cache) {
+            storeCachedSPIRV(cache, cacheKey, {}, {}, spirv->getOutputData(), spirv->getOutputSize());
+        }
+
         createInfo.codeSize = spirv->getOutputSize();
         createInfo.pCode = spirv->getOutputData();
         VK_CHECK(vkCreateShaderModule(device->gpuDevice()->vkDevice, &createInfo, nullptr, &stage.vkShader));
@@ -944,12 +1033,13 @@ void cmdFuncCCVKCreateComputePipelineState(CCVKDevice *device, CCVKGPUPipelineSt
 }
 
 void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineState *gpuPipelineState) {
-    static ccstd::vector<VkPipelineShaderStageCreateInfo> stageInfos;
-    static ccstd::vector<VkVertexInputBindingDescription> bindingDescriptions;
-    static ccstd::vector<VkVertexInputAttributeDescription> attributeDescriptions;
-    static ccstd::vector<uint32_t> offsets;
-    static ccstd::vector<VkDynamicState> dynamicStates;
-    static ccstd::vector<VkPipelineColorBlendAttachmentState> blendTargets;
+    // may run on pipeline compile workers
+    thread_local ccstd::vector<VkPipelineShaderStageCreateInfo> stageInfos;
+    thread_local ccstd::vector<VkVertexInputBindingDescription> bindingDescriptions;
+    thread_local ccstd::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+    thread_local ccstd::vector<uint32_t> offsets;
+    thread_local ccstd::vector<VkDynamicState> dynamicStates;
+    thread_local ccstd::vector<VkPipelineColorBlendAttachmentState> blendTargets;
 
     VkGraphicsPipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
 
@@ -1158,7 +1248,7 @@ void cmdFuncCCVKCreateGeneralBarrier(CCVKDevice * /*device*/, CCVKGPUGeneralBarr
     thsvsGetVulkanMemoryBarrier(gpuGeneralBarrier->barrier, &gpuGeneralBarrier->srcStageMask, &gpuGeneralBarrier->dstStageMask, &gpuGeneralBarrier->vkBarrier);
 }
 
-void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint32_t size, const CCVKGPUCommandBuffer *cmdBuffer) {
+void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint32_t size, const CCVKGPUCommandBuffer *cmdBuffer, uint32_t offset) {
     if (!gpuBuffer) return;
 
     const void *dataToUpload = nullptr;
@@ -1201,9 +1291,10 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
     // back buffer instances update command
     uint32_t backBufferIndex = device->gpuDevice()->curBackBufferIndex;
     if (gpuBuffer->instanceSize) {
-        device->gpuBufferHub()->record(gpuBuffer, backBufferIndex, sizeToUpload, !cmdBuffer);
+        // the other back buffers are synced from the start of the buffer up to the updated range
+        device->gpuBufferHub()->record(gpuBuffer, backBufferIndex, offset + sizeToUpload, !cmdBuffer);
         if (!cmdBuffer) {
-            uint8_t *dst = gpuBuffer->mappedData + backBufferIndex * gpuBuffer->instanceSize;
+            uint8_t *dst = gpuBuffer->mappedData + backBufferIndex * gpuBuffer->instanceSize + offset;
             memcpy(dst, dataToUpload, sizeToUpload);
             return;
         }
@@ -1216,7 +1307,7 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
 
     VkBufferCopy region{
         stagingBuffer.startOffset,
-        gpuBuffer->getStartOffset(backBufferIndex),
+        gpuBuffer->getStartOffset(backBufferIndex) + offset,
         sizeToUpload,
     };
     auto upload = [&stagingBuffer, &gpuBuffer, &region](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
@@ -496,6 +496,13 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
 void CCVKDevice::doDestroy() {
     waitAllFences();
 
+    // every pipeline waits for its own compile task on destruction, so the pool is idle by now
+    if (_pipelineCompilePool) {
+        _pipelineCompilePool->stop();
+        CC_SAFE_DELETE(_pipelineCompilePool);
+    }
+    _asyncPipelineCompile = false;
+
     SPIRVUtils::getInstance()->destroy();
 
     for (CCVKTexture *texture : _depthStencilTextures) {
@@ -912,6 +919,44 @@ void CCVKDevice::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buffe
     }
 }
 
+bool CCVKDevice::getPipelineCacheData(ccstd::vector<uint8_t> &data) {
+    if (!_gpuDevice->vkPipelineCache) return false;
+
+    size_t size = 0U;
+    VK_CHECK(vkGetPipelineCacheData(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, &size, nullptr));
+    data.resize(size);
+    if (!size) return false;
+    VK_CHECK(vkGetPipelineCacheData(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, &size, data.data()));
+    data.resize(size);
+    return true;
+}
+
+void CCVKDevice::setAsyncPipelineCompile(bool enabled) {
+    // there is no thread to offload to on single core devices
+    if (ThreadPool::CPU_CORE_COUNT < 2) enabled = false;
+
+    // the pool is kept alive after disabling, pipelines already dispatched still complete on it
+    if (enabled && !_pipelineCompilePool) {
+        _pipelineCompilePool = ccnew ThreadPool;
+        _pipelineCompilePool->start();
+    }
+    _asyncPipelineCompile = enabled;
+}
+
+void CCVKDevice::mergePipelineCacheData(const uint8_t *data, uint32_t size) {
+    if (!_gpuDevice->vkPipelineCache || !size) return;
+
+    // the driver validates the blob header (vendor, device and cache UUID) and
+    // ignores incompatible data, so a stale blob simply yields an empty cache
+    VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    createInfo.initialDataSize = size;
+    createInfo.pInitialData = data;
+    VkPipelineCache srcCache = VK_NULL_HANDLE;
+    if (vkCreatePipelineCache(_gpuDevice->vkDevice, &createInfo, nullptr, &srcCache) != VK_SUCCESS) return;
+    VK_CHECK(vkMergePipelineCaches(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, 1, &srcCache));
+    vkDestroyPipelineCache(_gpuDevice->vkDevice, srcCache, nullptr);
+}
+
 void CCVKDevice::getQueryPoolResults(QueryPool *queryPool) {
     CC_PROFILE(CCVKDeviceGetQueryPoolResults);
     auto *vkQueryPool = static_cast<CCVKQueryPool *>(queryPool);
@@ -26,7 +26,9 @@
 #pragma once
 
 #include <cstring>
+#include <future>
 #include "VKStd.h"
+#include "base/threading/ThreadPool.h"
 #include "gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -78,6 +80,15 @@ public:
     void acquire(Swapchain *const *swapchains, uint32_t count) override;
     void present() override;
 
+    bool getPipelineCacheData(ccstd::vector<uint8_t> &data) override;
+    void mergePipelineCacheData(const uint8_t *data, uint32_t size) override;
+    void setAsyncPipelineCompile(bool enabled) override;
+
+    template <typename Function>
+    std::future<void> dispatchPipelineCompile(Function &&func) {
+        return _pipelineCompilePool->dispatchTask(std::forward<Function>(func));
+    }
+
     inline bool checkExtension(const ccstd::string &extension) const {
         return std::any_of(_extensions.begin(), _extensions.end(), [&extension](auto &ext) {
             return std::strcmp(ext, extension.c_str()) == 0;
@@ -154,6 +165,7 @@ protected:
     ccstd::vector<const char *> _extensions;
 
     IXRInterface *_xr{nullptr};
+    ThreadPool *_pipelineCompilePool{nullptr};
 };
 
 } // namespace gfx
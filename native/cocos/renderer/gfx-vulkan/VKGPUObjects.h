@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include "VKStd.h"
 #include "VKUtils.h"
 #include "base/Log.h"
@@ -273,7 +275,7 @@ struct CCVKGPUShader {
     ccstd::string name;
     AttributeList attributes;
     ccstd::vector<CCVKGPUShaderStage> gpuStages;
-    bool initialized = false;
+    std::atomic<bool> initialized{false};
 };
 
 struct CCVKGPUInputAssembler {
@@ -1325,7 +1327,9 @@ public:
             if (i == backBufferIndex) {
                 _buffersToBeUpdated[i].erase(gpuBuffer);
             } else {
-                _buffersToBeUpdated[i][gpuBuffer] = {backBufferIndex, size, canMemcpy};
+                // keep the largest pending range, partial updates must not shrink it
+                auto &update = _buffersToBeUpdated[i][gpuBuffer];
+                update = {backBufferIndex, std::max(update.size, size), canMemcpy};
             }
         }
     }
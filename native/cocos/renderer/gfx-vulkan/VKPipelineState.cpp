@@ -45,7 +45,6 @@ void CCVKPipelineState::doInit(const PipelineStateInfo & /*info*/) {
     _gpuPipelineState = ccnew CCVKGPUPipelineState;
     _gpuPipelineState->bindPoint = _bindPoint;
     _gpuPipelineState->primitive = _primitive;
-    _gpuPipelineState->gpuShader = static_cast<CCVKShader *>(_shader)->gpuShader();
     _gpuPipelineState->inputState = _inputState;
     _gpuPipelineState->rs = _rasterizerState;
     _gpuPipelineState->dss = _depthStencilState;
@@ -60,14 +59,38 @@ void CCVKPipelineState::doInit(const PipelineStateInfo & /*info*/) {
         }
     }
 
+    auto *device = CCVKDevice::getInstance();
+    auto *shader = static_cast<CCVKShader *>(_shader);
+    if (_bindPoint == PipelineBindPoint::GRAPHICS && device->isAsyncPipelineCompile()) {
+        // shader modules are created lazily, so both the SPIR-V and the pipeline compile move off this thread
+        _compileTask = device->dispatchPipelineCompile([this, device, shader]() {
+            _gpuPipelineState->gpuShader = shader->gpuShader();
+            cmdFuncCCVKCreateGraphicsPipelineState(device, _gpuPipelineState);
+            _ready.store(true, std::memory_order_release);
+        });
+        return;
+    }
+
+    _gpuPipelineState->gpuShader = shader->gpuShader();
     if (_bindPoint == PipelineBindPoint::GRAPHICS) {
-        cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice::getInstance(), _gpuPipelineState);
+        cmdFuncCCVKCreateGraphicsPipelineState(device, _gpuPipelineState);
     } else {
-        cmdFuncCCVKCreateComputePipelineState(CCVKDevice::getInstance(), _gpuPipelineState);
+        cmdFuncCCVKCreateComputePipelineState(device, _gpuPipelineState);
     }
+    _ready.store(true, std::memory_order_release);
+}
+
+bool CCVKPipelineState::isReady() const {
+    return _ready.load(std::memory_order_acquire) || !CCVKDevice::getInstance()->isAsyncPipelineCompile();
 }
 
 void CCVKPipelineState::doDestroy() {
+    if (_compileTask.valid()) {
+        _compileTask.wait();
+        _compileTask = {};
+    }
+    _ready.store(false, std::memory_order_release);
+
     if (_gpuPipelineState) {
         CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuPipelineState);
         _gpuPipelineState = nullptr;
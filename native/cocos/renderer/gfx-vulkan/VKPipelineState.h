@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include "VKStd.h"
 #include "gfx-base/GFXPipelineState.h"
 
@@ -38,13 +40,22 @@ public:
     CCVKPipelineState();
     ~CCVKPipelineState() override;
 
-    inline CCVKGPUPipelineState *gpuPipelineState() const { return _gpuPipelineState; }
+    // blocks until a background compile has finished
+    inline CCVKGPUPipelineState *gpuPipelineState() const {
+        if (!isReady() && _compileTask.valid()) _compileTask.wait();
+        return _gpuPipelineState;
+    }
+
+    // with async compile off, binding waits for a compile that is still in flight
+    bool isReady() const override;
 
 protected:
     void doInit(const PipelineStateInfo &info) override;
     void doDestroy() override;
 
     CCVKGPUPipelineState *_gpuPipelineState = nullptr;
+    std::future<void> _compileTask;
+    std::atomic<bool> _ready{false};
 };
 
 } // namespace gfx
@@ -25,6 +25,7 @@
 
 #include "VKStd.h"
 
+#include <mutex>
 #include "VKCommands.h"
 #include "VKDevice.h"
 #include "VKShader.h"
@@ -42,7 +43,13 @@ CCVKShader::~CCVKShader() {
 
 namespace {
 
+// SPIRVUtils is a shared singleton, pipelines compiled in the background serialize on this
+std::mutex shaderCompileMutex;
+
 void initGpuShader(CCVKGPUShader *gpuShader) {
+    std::lock_guard<std::mutex> lock(shaderCompileMutex);
+    if (gpuShader->initialized) return;
+
     cmdFuncCCVKCreateShader(CCVKDevice::getInstance(), gpuShader);
 
     // Clear shader source after they're uploaded to GPU
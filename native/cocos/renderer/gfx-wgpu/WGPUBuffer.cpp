@@ -126,7 +126,7 @@ void bufferUpdateCallback(WGPUBufferMapAsyncStatus status, void *userdata) {
     }
 }
 
-void CCWGPUBuffer::update(const void *buffer, uint32_t size) {
+void CCWGPUBuffer::update(const void *buffer, uint32_t size, uint32_t offset) {
     // uint32_t alignedSize = ceil(size / 4.0) * 4;
     // size_t   buffSize    = alignedSize;
     // // if (hasFlag(_memUsage, MemoryUsageBit::DEVICE)) {
@@ -157,10 +157,10 @@ void CCWGPUBuffer::update(const void *buffer, uint32_t size) {
     // wgpuCommandEncoderRelease(cmdEncoder);
     // wgpuCommandBufferRelease(commandBuffer);
 
-    size_t offset = _isBufferView ? _offset : 0;
+    size_t dstOffset = (_isBufferView ? _offset : 0) + offset;
     uint32_t alignedSize = ceil(size / 4.0) * 4;
     size_t buffSize = alignedSize;
-    wgpuQueueWriteBuffer(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuQueue, _gpuBufferObject->wgpuBuffer, offset, buffer, buffSize);
+    wgpuQueueWriteBuffer(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuQueue, _gpuBufferObject->wgpuBuffer, dstOffset, buffer, buffSize);
     //wgpuBufferUnmap(_gpuBufferObject->wgpuBuffer);
 }
 
@@ -40,7 +40,7 @@ public:
     CCWGPUBuffer();
     ~CCWGPUBuffer() = default;
 
-    void update(const void *buffer, uint32_t size) override;
+    void update(const void *buffer, uint32_t size, uint32_t offset) override;
 
     inline CCWGPUBufferObject *gpuBufferObject() const { return _gpuBufferObject; }
 
@@ -52,7 +52,7 @@ public:
 
     void update(const emscripten::val &v, uint32_t size) {
         ccstd::vector<uint8_t> buffer = emscripten::convertJSArrayToNumberVector<uint8_t>(v);
-        update(reinterpret_cast<const void *>(buffer.data()), size);
+        update(reinterpret_cast<const void *>(buffer.data()), size, 0);
     }
 
     void update(const DrawInfoList &drawInfos);
@@ -525,7 +525,7 @@ void CCWGPUCommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
-void CCWGPUCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+void CCWGPUCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size, uint32_t offset) {
     uint32_t alignedSize = ceil(size / 4.0) * 4;
     size_t buffSize = alignedSize;
 
@@ -543,15 +543,15 @@ void CCWGPUCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t
     wgpuBufferUnmap(static_cast<WGPUBuffer>(stagingBuffer));
 
     auto *ccBuffer = static_cast<CCWGPUBuffer *>(buff);
-    size_t offset = ccBuffer->getOffset();
+    size_t dstOffset = ccBuffer->getOffset() + offset;
 
     CCWGPUBufferObject *bufferObj = ccBuffer->gpuBufferObject();
 
     if (_gpuCommandBufferObj->wgpuCommandEncoder) {
-        wgpuCommandEncoderCopyBufferToBuffer(_gpuCommandBufferObj->wgpuCommandEncoder, stagingBuffer, 0, bufferObj->wgpuBuffer, offset, alignedSize);
+        wgpuCommandEncoderCopyBufferToBuffer(_gpuCommandBufferObj->wgpuCommandEncoder, stagingBuffer, 0, bufferObj->wgpuBuffer, dstOffset, alignedSize);
     } else {
         WGPUCommandEncoder cmdEncoder = wgpuDeviceCreateCommandEncoder(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, nullptr);
-        wgpuCommandEncoderCopyBufferToBuffer(cmdEncoder, stagingBuffer, 0, bufferObj->wgpuBuffer, offset, alignedSize);
+        wgpuCommandEncoderCopyBufferToBuffer(cmdEncoder, stagingBuffer, 0, bufferObj->wgpuBuffer, dstOffset, alignedSize);
         WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(cmdEncoder, nullptr);
         wgpuQueueSubmit(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuQueue, 1, &commandBuffer);
         wgpuBufferRelease(stagingBuffer);
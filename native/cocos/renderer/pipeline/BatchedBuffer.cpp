@@ -24,7 +24,12 @@
 ****************************************************************************/
 
 #include "BatchedBuffer.h"
+#include <algorithm>
+#include "IndirectDraw.h"
+#include "InstanceCompaction.h"
+#include "RenderPipeline.h"
 #include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXInputAssembler.h"
@@ -54,6 +59,7 @@ void BatchedBuffer::destroy() {
 
         CC_SAFE_DESTROY_AND_DELETE(batch.indexBuffer);
         CC_SAFE_DESTROY_AND_DELETE(batch.ia);
+        CC_SAFE_DESTROY_AND_DELETE(batch.indirectBuffer);
         CC_SAFE_DESTROY_AND_DELETE(batch.ubo);
 
         CC_FREE(batch.indexData);
@@ -102,12 +108,13 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint32_t passIdx, con
                         batchVB->resize(vbSize);
                         CC_FREE(vbData);
                         batch.vbDatas[j] = vbDataNew;
-                        vbData = vbDataNew;
+                        // the resized buffer starts out undefined
+                        batch.validCount = 0;
                     }
 
-                    auto offset = batch.vbCount * flatBuffer.stride;
-                    memcpy(vbData + offset, flatBuffer.buffer.buffer()->getData(), flatBuffer.buffer.buffer()->byteLength());
+                    batch.vbSources[j].emplace_back(flatBuffer.buffer.buffer()->getData());
                 }
+                batch.vertexCounts.emplace_back(vbCount);
 
                 auto *indexData = batch.indexData;
                 indexSize = (vbCount + batch.vbCount) * sizeof(float);
@@ -223,6 +230,11 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint32_t passIdx, con
         pass,                            //pass
         shader,                          //shader
     };
+    item.vbSources.resize(flatBuffersCount);
+    for (uint32_t i = 0; i < flatBuffersCount; ++i) {
+        item.vbSources[i].emplace_back(flatBuffers[i].buffer.buffer()->getData());
+    }
+    item.vertexCounts.emplace_back(vbCount);
     _batches.emplace_back(std::move(item));
 }
 
@@ -231,6 +243,37 @@ void BatchedBuffer::clear() {
         batch.vbCount = 0;
         batch.mergeCount = 0;
         batch.ia->setVertexCount(0);
+        for (auto &sources : batch.vbSources) {
+            sources.clear();
+        }
+        batch.vertexCounts.clear();
+    }
+}
+
+void BatchedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) {
+    const auto *pipeline = RenderPipeline::getInstance();
+    const bool indirect = pipeline && pipeline->isIndirectDrawEnabled();
+    for (auto &batch : _batches) {
+        if (!batch.mergeCount) continue;
+
+        // only the slice spanning the changed models is uploaded
+        const auto modelCount = static_cast<uint32_t>(batch.vertexCounts.size());
+        for (size_t i = 0; i < batch.vbs.size(); ++i) {
+            auto *vb = batch.vbs[i];
+            const auto stride = vb->getStride();
+            const auto dirty = compactVisibleVertices(batch.vbSources[i].data(), batch.vertexCounts.data(), modelCount, stride, batch.vbDatas[i], batch.validCount);
+            if (!dirty.empty()) {
+                cmdBuff->updateBuffer(vb, batch.vbDatas[i] + stride * dirty.first, stride * (dirty.last - dirty.first), stride * dirty.first);
+            }
+        }
+        batch.validCount = std::max(batch.validCount, batch.vbCount);
+        cmdBuff->updateBuffer(batch.indexBuffer, batch.indexData, batch.indexBuffer->getSize());
+        cmdBuff->updateBuffer(batch.ubo, batch.uboData.data(), batch.ubo->getSize());
+
+        setIndirectDraw(_device, batch.ia, batch.indirectBuffer, batch.drawArgs, indirect);
+        if (batch.indirectBuffer) {
+            updateIndirectDrawArgs(cmdBuff, batch.indirectBuffer, batch.ia->getDrawInfo(), batch.drawArgs);
+        }
     }
 }
 
@@ -51,6 +51,16 @@ struct CC_DLL BatchedItem {
     gfx::DescriptorSet *descriptorSet = nullptr;
     const scene::Pass *pass = nullptr;
     gfx::Shader *shader = nullptr;
+    // vertex data of the models merged since the last clear, one list per vertex buffer, compacted into vbDatas on upload
+    ccstd::vector<ccstd::vector<const uint8_t *>> vbSources;
+    // vertex count of each model merged since the last clear
+    ccstd::vector<uint32_t> vertexCounts;
+    // vertices [0, validCount) of vbDatas are known to match the GPU buffers
+    uint32_t validCount = 0;
+    // draw-args buffer of the indirect path, null when drawing directly
+    gfx::Buffer *indirectBuffer = nullptr;
+    // the arguments last uploaded into indirectBuffer
+    gfx::DrawInfo drawArgs;
 };
 using BatchedItemList = ccstd::vector<BatchedItem>;
 using DynamicOffsetList = ccstd::vector<uint32_t>;
@@ -62,6 +72,7 @@ public:
 
     void destroy();
     void merge(const scene::SubModel *, uint32_t passIdx, const scene::Model *);
+    void uploadBuffers(gfx::CommandBuffer *cmdBuff);
     void clear();
     void setDynamicOffset(uint32_t idx, uint32_t value);
 
@@ -139,10 +139,20 @@ struct CC_DLL InternalBindingInst : public InternalBindingDesc {
     gfx::Texture *texture = nullptr;
 };
 
+enum class CC_DLL RenderQueueSortMode {
+    FRONT_TO_BACK,
+    BACK_TO_FRONT,
+};
+CC_ENUM_CONVERSION_OPERATOR(RenderQueueSortMode)
+
 struct CC_DLL RenderQueueCreateInfo {
     bool isTransparent = false;
     uint32_t phases = 0;
+    // opaqueCompareFn and transparentCompareFn are replaced by a radix sort over a key built for the matching sort mode,
+    // any other comparator is used as it is with a stable sort
     std::function<bool(const RenderPass &a, const RenderPass &b)> sortFunc;
+    // the order RenderQueue sorts by when sortFunc is left empty
+    RenderQueueSortMode sortMode = RenderQueueSortMode::FRONT_TO_BACK;
 };
 
 enum class CC_DLL RenderPriority {
@@ -152,12 +162,6 @@ enum class CC_DLL RenderPriority {
 };
 CC_ENUM_CONVERSION_OPERATOR(RenderPriority)
 
-enum class CC_DLL RenderQueueSortMode {
-    FRONT_TO_BACK,
-    BACK_TO_FRONT,
-};
-CC_ENUM_CONVERSION_OPERATOR(RenderQueueSortMode)
-
 struct CC_DLL RenderQueueDesc {
     bool isTransparent = false;
     RenderQueueSortMode sortMode = RenderQueueSortMode::FRONT_TO_BACK;
@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "IndirectDraw.h"
+#include <cstring>
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXInputAssembler.h"
+
+namespace cc {
+namespace pipeline {
+
+gfx::DrawInfo getIndirectDrawArgs(const gfx::DrawInfo &drawInfo, uint32_t instanceCount) {
+    gfx::DrawInfo args = drawInfo;
+    args.instanceCount = instanceCount;
+    args.firstInstance = 0;
+    return args;
+}
+
+void setIndirectDraw(gfx::Device *device, gfx::InputAssembler *&ia, gfx::Buffer *&indirectBuffer, gfx::DrawInfo &uploadedArgs, bool enabled) {
+    if (enabled == (indirectBuffer != nullptr)) return;
+
+    uploadedArgs = {};
+    gfx::InputAssemblerInfo info = {ia->getAttributes(), ia->getVertexBuffers(), ia->getIndexBuffer()};
+    const auto drawInfo = ia->getDrawInfo();
+    if (enabled) {
+        indirectBuffer = device->createBuffer({
+            gfx::BufferUsageBit::INDIRECT | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            sizeof(gfx::DrawInfo),
+            sizeof(gfx::DrawInfo),
+        });
+        info.indirectBuffer = indirectBuffer;
+    } else {
+        CC_SAFE_DESTROY_AND_DELETE(indirectBuffer);
+    }
+
+    CC_SAFE_DESTROY_AND_DELETE(ia);
+    ia = device->createInputAssembler(info);
+    ia->setVertexCount(drawInfo.vertexCount);
+    ia->setInstanceCount(drawInfo.instanceCount);
+}
+
+bool updateIndirectDrawArgs(gfx::CommandBuffer *cmdBuff, gfx::Buffer *indirectBuffer, const gfx::DrawInfo &args, gfx::DrawInfo &uploadedArgs) {
+    if (!memcmp(&args, &uploadedArgs, sizeof(gfx::DrawInfo))) return false;
+
+    cmdBuff->updateBuffer(indirectBuffer, &args, sizeof(gfx::DrawInfo));
+    uploadedArgs = args;
+    return true;
+}
+
+} // namespace pipeline
+} // namespace cc
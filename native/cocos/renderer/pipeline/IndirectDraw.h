@@ -0,0 +1,56 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "gfx-base/GFXDef.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+class CommandBuffer;
+} // namespace gfx
+namespace pipeline {
+
+/**
+ * The indirect draw arguments drawing `instanceCount` instances of the geometry described by `drawInfo`.
+ */
+gfx::DrawInfo getIndirectDrawArgs(const gfx::DrawInfo &drawInfo, uint32_t instanceCount);
+
+/**
+ * Switches `ia` between direct and indirect drawing, recreating it with or without a draw-args buffer
+ * holding a single gfx::DrawInfo, and forgets the uploaded arguments. Does nothing if it is already in the requested mode.
+ * Once the input assembler owns a draw-args buffer, CommandBuffer::draw(ia) is submitted by the backends as a drawIndirect.
+ */
+void setIndirectDraw(gfx::Device *device, gfx::InputAssembler *&ia, gfx::Buffer *&indirectBuffer, gfx::DrawInfo &uploadedArgs, bool enabled);
+
+/**
+ * Uploads `args` into the draw-args buffer unless they match `uploadedArgs`, the arguments it already holds.
+ * @return Whether the arguments were uploaded.
+ */
+bool updateIndirectDrawArgs(gfx::CommandBuffer *cmdBuff, gfx::Buffer *indirectBuffer, const gfx::DrawInfo &args, gfx::DrawInfo &uploadedArgs);
+
+} // namespace pipeline
+} // namespace cc
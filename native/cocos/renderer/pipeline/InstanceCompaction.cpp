@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "InstanceCompaction.h"
+#include <algorithm>
+#include <cstring>
+
+namespace cc {
+namespace pipeline {
+
+InstanceDirtyRange compactVisibleInstances(const uint8_t *const *sources, uint32_t count, uint32_t stride, uint8_t *dst, uint32_t validCount) {
+    InstanceDirtyRange range;
+    // slots past validCount were never uploaded, copy them without comparing
+    const uint32_t compareCount = std::min(count, validCount);
+    for (uint32_t i = 0; i < compareCount; ++i) {
+        auto *slot = dst + stride * i;
+        // instances keep their slots as long as the visible set is stable, compare the bytes instead of
+        // trusting update stamps: attribute views can be written directly from scripts
+        if (memcmp(slot, sources[i], stride) != 0) {
+            memcpy(slot, sources[i], stride);
+            if (range.empty()) range.first = i;
+            range.last = i + 1;
+        }
+    }
+    for (uint32_t i = compareCount; i < count; ++i) {
+        memcpy(dst + stride * i, sources[i], stride);
+    }
+    if (compareCount < count) {
+        if (range.empty()) range.first = compareCount;
+        range.last = count;
+    }
+    return range;
+}
+
+InstanceDirtyRange compactVisibleVertices(const uint8_t *const *sources, const uint32_t *vertexCounts, uint32_t count, uint32_t stride, uint8_t *dst, uint32_t validCount) {
+    InstanceDirtyRange range;
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t last = first + vertexCounts[i];
+        auto *slot = dst + stride * first;
+        const uint32_t size = stride * vertexCounts[i];
+        // a model straddling validCount is copied as a whole, its tail was never uploaded
+        if (last > validCount || memcmp(slot, sources[i], size) != 0) {
+            memcpy(slot, sources[i], size);
+            if (range.empty()) range.first = first;
+            range.last = last;
+        }
+        first = last;
+    }
+    return range;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,59 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace cc {
+namespace pipeline {
+
+struct InstanceDirtyRange {
+    uint32_t first{0};
+    uint32_t last{0}; // exclusive
+
+    inline bool empty() const { return first == last; }
+};
+
+/**
+ * Packs the per-instance data of the visible instances, in visiting order, into the instance buffer of an InstancedItem.
+ * This is the CPU reference a GPU culling and compaction pass would have to match.
+ * @param sources The per-instance data of each visible instance, `stride` bytes each.
+ * @param dst The instance buffer, slots [0, validCount) are known to match the GPU copy.
+ * @return The slots [first, last) spanning every changed instance, empty if none changed.
+ */
+InstanceDirtyRange compactVisibleInstances(const uint8_t *const *sources, uint32_t count, uint32_t stride, uint8_t *dst, uint32_t validCount);
+
+/**
+ * Packs the vertex data of the visible models, in visiting order, into one vertex buffer of a BatchedItem.
+ * Same as compactVisibleInstances, except that every model contributes `vertexCounts[i]` vertices instead of a single slot.
+ * @param sources The vertex data of each visible model, `vertexCounts[i] * stride` bytes each.
+ * @param dst The vertex buffer, vertices [0, validCount) are known to match the GPU copy.
+ * @return The vertices [first, last) spanning every changed model, empty if none changed.
+ */
+InstanceDirtyRange compactVisibleVertices(const uint8_t *const *sources, const uint32_t *vertexCounts, uint32_t count, uint32_t stride, uint8_t *dst, uint32_t validCount);
+
+} // namespace pipeline
+} // namespace cc
@@ -24,7 +24,11 @@
 ****************************************************************************/
 
 #include "InstancedBuffer.h"
+#include <algorithm>
 #include "Define.h"
+#include "IndirectDraw.h"
+#include "InstanceCompaction.h"
+#include "RenderPipeline.h"
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
@@ -45,6 +49,7 @@ void InstancedBuffer::destroy() {
     for (auto &instance : _instances) {
         CC_SAFE_DESTROY_AND_DELETE(instance.vb);
         CC_SAFE_DESTROY_AND_DELETE(instance.ia);
+        CC_SAFE_DESTROY_AND_DELETE(instance.indirectBuffer);
         CC_FREE(instance.data);
     }
     _instances.clear();
@@ -85,6 +90,8 @@ void InstancedBuffer::merge(const scene::Model *model, const scene::SubModel *su
             const auto newSize = instance.stride * instance.capacity;
             instance.data = static_cast<uint8_t *>(CC_REALLOC(instance.data, newSize));
             instance.vb->resize(newSize);
+            // the resized buffer starts out undefined
+            instance.validCount = 0;
         }
         if (instance.shader != shader) {
             instance.shader = shader;
@@ -92,7 +99,8 @@ void InstancedBuffer::merge(const scene::Model *model, const scene::SubModel *su
         if (instance.descriptorSet != descriptorSet) {
             instance.descriptorSet = descriptorSet;
         }
-        memcpy(instance.data + instance.stride * instance.count++, instancedBuffer, stride);
+        instance.sources.emplace_back(instancedBuffer);
+        ++instance.count;
         _hasPendingModels = true;
         return;
     }
@@ -123,27 +131,41 @@ void InstancedBuffer::merge(const scene::Model *model, const scene::SubModel *su
     }
 
     auto *data = static_cast<uint8_t *>(CC_MALLOC(newSize));
-    memcpy(data, instancedBuffer, stride);
     vertexBuffers.emplace_back(vb);
     gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto *ia = _device->createInputAssembler(iaInfo);
     InstancedItem item = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet, lightingMap};
-    _instances.emplace_back(item);
+    item.sources.emplace_back(instancedBuffer);
+    _instances.emplace_back(std::move(item));
     _hasPendingModels = true;
 }
 
 void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) {
+    const auto *pipeline = RenderPipeline::getInstance();
+    const bool indirect = pipeline && pipeline->isIndirectDrawEnabled();
     for (auto &instance : _instances) {
         if (!instance.count) continue;
 
-        cmdBuff->updateBuffer(instance.vb, instance.data, instance.vb->getSize());
+        // only the slice spanning the changed instances is uploaded
+        const auto dirty = compactVisibleInstances(instance.sources.data(), instance.count, instance.stride, instance.data, instance.validCount);
+        if (!dirty.empty()) {
+            cmdBuff->updateBuffer(instance.vb, instance.data + instance.stride * dirty.first, instance.stride * (dirty.last - dirty.first), instance.stride * dirty.first);
+            instance.validCount = std::max(instance.validCount, dirty.last);
+        }
+
+        setIndirectDraw(_device, instance.ia, instance.indirectBuffer, instance.drawArgs, indirect);
         instance.ia->setInstanceCount(instance.count);
+        if (instance.indirectBuffer) {
+            // the draw arguments are built from the compacted count, they only change when the visible set grows or shrinks
+            updateIndirectDrawArgs(cmdBuff, instance.indirectBuffer, getIndirectDrawArgs(instance.ia->getDrawInfo(), instance.count), instance.drawArgs);
+        }
     }
 }
 
 void InstancedBuffer::clear() {
     for (auto &instance : _instances) {
         instance.count = 0;
+        instance.sources.clear();
     }
     _hasPendingModels = false;
 }
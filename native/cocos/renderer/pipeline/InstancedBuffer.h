@@ -48,6 +48,14 @@ struct CC_DLL InstancedItem {
     gfx::Shader *shader = nullptr;
     gfx::DescriptorSet *descriptorSet = nullptr;
     gfx::Texture *lightingMap = nullptr;
+    // instances [0, validCount) of data are known to match the GPU buffer
+    uint32_t validCount = 0;
+    // per-instance data of the instances merged since the last clear, compacted into data on upload
+    ccstd::vector<const uint8_t *> sources;
+    // draw-args buffer of the indirect path, null when drawing directly
+    gfx::Buffer *indirectBuffer = nullptr;
+    // the arguments last uploaded into indirectBuffer
+    gfx::DrawInfo drawArgs;
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
 using DynamicOffsetList = ccstd::vector<uint32_t>;
@@ -0,0 +1,737 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "PersistentPipelineCache.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include "base/Data.h"
+#include "base/Log.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXPipelineState.h"
+#include "gfx-base/GFXRenderPass.h"
+#include "platform/FileUtils.h"
+#include "renderer/core/ProgramLib.h"
+#include "renderer/pipeline/custom/RenderInterfaceTypes.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x43504343U; // "CCPC"
+constexpr const char *CACHE_FILE_NAME = "pipeline-cache.bin";
+
+enum class MacroType : uint8_t {
+    INT,
+    BOOL,
+    STRING,
+};
+
+class BlobWriter {
+public:
+    template <typename T>
+    void write(const T &value) {
+        append(&value, sizeof(T));
+    }
+
+    void write(const ccstd::string &str) {
+        write(static_cast<uint32_t>(str.size()));
+        append(str.data(), str.size());
+    }
+
+    void append(const void *data, size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        _data.insert(_data.end(), bytes, bytes + size);
+    }
+
+    inline const ccstd::vector<uint8_t> &getData() const { return _data; }
+    inline ccstd::vector<uint8_t> release() { return std::move(_data); }
+
+private:
+    ccstd::vector<uint8_t> _data;
+};
+
+class BlobReader {
+public:
+    BlobReader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    bool read(T &value) {
+        return read(reinterpret_cast<uint8_t *>(&value), sizeof(T));
+    }
+
+    bool read(ccstd::string &str) {
+        uint32_t length = 0;
+        if (!read(length) || length > _size - _offset) return false;
+        str.assign(reinterpret_cast<const char *>(_data + _offset), length);
+        _offset += length;
+        return true;
+    }
+
+    bool read(uint8_t *dst, size_t size) {
+        if (size > _size - _offset) return false;
+        memcpy(dst, _data + _offset, size);
+        _offset += size;
+        return true;
+    }
+
+    // guards vector sizes read from a corrupted file
+    inline size_t remaining() const { return _size - _offset; }
+
+private:
+    const uint8_t *_data{nullptr};
+    size_t _size{0};
+    size_t _offset{0};
+};
+
+void writeMacro(BlobWriter &writer, const ccstd::string &name, const MacroValue &value) {
+    writer.write(name);
+    if (ccstd::holds_alternative<int32_t>(value)) {
+        writer.write(MacroType::INT);
+        writer.write(ccstd::get<int32_t>(value));
+    } else if (ccstd::holds_alternative<bool>(value)) {
+        writer.write(MacroType::BOOL);
+        writer.write(static_cast<uint8_t>(ccstd::get<bool>(value)));
+    } else {
+        writer.write(MacroType::STRING);
+        writer.write(ccstd::get<ccstd::string>(value));
+    }
+}
+
+void writeDefines(BlobWriter &writer, const MacroRecord &defines) {
+    writer.write(static_cast<uint32_t>(defines.size()));
+    for (const auto &it : defines) {
+        writeMacro(writer, it.first, it.second);
+    }
+}
+
+bool readDefines(BlobReader &reader, MacroRecord &defines) {
+    uint32_t count = 0;
+    if (!reader.read(count) || count > reader.remaining()) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        ccstd::string name;
+        MacroType type{MacroType::INT};
+        if (!reader.read(name) || !reader.read(type)) return false;
+        switch (type) {
+            case MacroType::INT: {
+                int32_t value = 0;
+                if (!reader.read(value)) return false;
+                defines[name] = value;
+            } break;
+            case MacroType::BOOL: {
+                uint8_t value = 0;
+                if (!reader.read(value)) return false;
+                defines[name] = value != 0;
+            } break;
+            case MacroType::STRING: {
+                ccstd::string value;
+                if (!reader.read(value)) return false;
+                defines[name] = value;
+            } break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+void writeIndices(BlobWriter &writer, const gfx::IndexList &indices) {
+    writer.write(static_cast<uint32_t>(indices.size()));
+    writer.append(indices.data(), indices.size() * sizeof(uint32_t));
+}
+
+bool readIndices(BlobReader &reader, gfx::IndexList &indices) {
+    uint32_t count = 0;
+    if (!reader.read(count) || count > reader.remaining() / sizeof(uint32_t)) return false;
+    indices.resize(count);
+    return reader.read(reinterpret_cast<uint8_t *>(indices.data()), count * sizeof(uint32_t));
+}
+
+// barriers and subpass dependencies do not affect render pass compatibility, so they are left out
+void writeRenderPass(BlobWriter &writer, const gfx::RenderPass &renderPass) {
+    const auto &colors = renderPass.getColorAttachments();
+    writer.write(static_cast<uint32_t>(colors.size()));
+    for (const auto &color : colors) {
+        writer.write(color.format);
+        writer.write(color.sampleCount);
+        writer.write(color.loadOp);
+        writer.write(color.storeOp);
+        writer.write(color.isGeneralLayout);
+    }
+
+    const auto &depthStencil = renderPass.getDepthStencilAttachment();
+    writer.write(depthStencil.format);
+    writer.write(depthStencil.sampleCount);
+    writer.write(depthStencil.depthLoadOp);
+    writer.write(depthStencil.depthStoreOp);
+    writer.write(depthStencil.stencilLoadOp);
+    writer.write(depthStencil.stencilStoreOp);
+    writer.write(depthStencil.isGeneralLayout);
+
+    const auto &subpasses = renderPass.getSubpasses();
+    writer.write(static_cast<uint32_t>(subpasses.size()));
+    for (const auto &subpass : subpasses) {
+        writeIndices(writer, subpass.inputs);
+        writeIndices(writer, subpass.colors);
+        writeIndices(writer, subpass.resolves);
+        writeIndices(writer, subpass.preserves);
+        writer.write(subpass.depthStencil);
+        writer.write(subpass.depthStencilResolve);
+        writer.write(subpass.depthResolveMode);
+        writer.write(subpass.stencilResolveMode);
+    }
+}
+
+bool readRenderPass(BlobReader &reader, gfx::RenderPassInfo &info) {
+    uint32_t colorCount = 0;
+    if (!reader.read(colorCount) || colorCount > reader.remaining()) return false;
+    info.colorAttachments.resize(colorCount);
+    for (auto &color : info.colorAttachments) {
+        if (!reader.read(color.format) || !reader.read(color.sampleCount) || !reader.read(color.loadOp) ||
+            !reader.read(color.storeOp) || !reader.read(color.isGeneralLayout)) return false;
+    }
+
+    auto &depthStencil = info.depthStencilAttachment;
+    if (!reader.read(depthStencil.format) || !reader.read(depthStencil.sampleCount) ||
+        !reader.read(depthStencil.depthLoadOp) || !reader.read(depthStencil.depthStoreOp) ||
+        !reader.read(depthStencil.stencilLoadOp) || !reader.read(depthStencil.stencilStoreOp) ||
+        !reader.read(depthStencil.isGeneralLayout)) return false;
+
+    uint32_t subpassCount = 0;
+    if (!reader.read(subpassCount) || subpassCount > reader.remaining()) return false;
+    info.subpasses.resize(subpassCount);
+    for (auto &subpass : info.subpasses) {
+        if (!readIndices(reader, subpass.inputs) || !readIndices(reader, subpass.colors) ||
+            !readIndices(reader, subpass.resolves) || !readIndices(reader, subpass.preserves) ||
+            !reader.read(subpass.depthStencil) || !reader.read(subpass.depthStencilResolve) ||
+            !reader.read(subpass.depthResolveMode) || !reader.read(subpass.stencilResolveMode)) return false;
+    }
+    return true;
+}
+
+// everything a pipeline state is created from but the shader and pipeline layout, which come from the program
+void writePipelineState(BlobWriter &writer, const gfx::PipelineStateInfo &info) {
+    writeRenderPass(writer, *info.renderPass);
+
+    const auto &attributes = info.inputState.attributes;
+    writer.write(static_cast<uint32_t>(attributes.size()));
+    for (const auto &attribute : attributes) {
+        writer.write(attribute.name);
+        writer.write(attribute.format);
+        writer.write(static_cast<uint8_t>(attribute.isNormalized));
+        writer.write(attribute.stream);
+        writer.write(static_cast<uint8_t>(attribute.isInstanced));
+        writer.write(attribute.location);
+    }
+
+    writer.write(info.rasterizerState);
+    writer.write(info.depthStencilState);
+    writer.write(info.blendState.isA2C);
+    writer.write(info.blendState.isIndepend);
+    writer.write(info.blendState.blendColor);
+    writer.write(static_cast<uint32_t>(info.blendState.targets.size()));
+    writer.append(info.blendState.targets.data(), info.blendState.targets.size() * sizeof(gfx::BlendTarget));
+    writer.write(info.primitive);
+    writer.write(info.dynamicStates);
+    writer.write(info.bindPoint);
+    writer.write(info.subpass);
+}
+
+bool readPipelineState(BlobReader &reader, gfx::PipelineStateInfo &info, gfx::RenderPassInfo &renderPassInfo) {
+    if (!readRenderPass(reader, renderPassInfo)) return false;
+
+    uint32_t attributeCount = 0;
+    if (!reader.read(attributeCount) || attributeCount > reader.remaining()) return false;
+    auto &attributes = info.inputState.attributes;
+    attributes.resize(attributeCount);
+    for (auto &attribute : attributes) {
+        uint8_t isNormalized = 0;
+        uint8_t isInstanced = 0;
+        if (!reader.read(attribute.name) || !reader.read(attribute.format) || !reader.read(isNormalized) ||
+            !reader.read(attribute.stream) || !reader.read(isInstanced) || !reader.read(attribute.location)) return false;
+        attribute.isNormalized = isNormalized != 0;
+        attribute.isInstanced = isInstanced != 0;
+    }
+
+    uint32_t targetCount = 0;
+    if (!reader.read(info.rasterizerState) || !reader.read(info.depthStencilState) ||
+        !reader.read(info.blendState.isA2C) || !reader.read(info.blendState.isIndepend) ||
+        !reader.read(info.blendState.blendColor) || !reader.read(targetCount) ||
+        targetCount > reader.remaining() / sizeof(gfx::BlendTarget)) return false;
+    info.blendState.targets.resize(targetCount);
+    return reader.read(reinterpret_cast<uint8_t *>(info.blendState.targets.data()), targetCount * sizeof(gfx::BlendTarget)) &&
+           reader.read(info.primitive) && reader.read(info.dynamicStates) && reader.read(info.bindPoint) &&
+           reader.read(info.subpass) && reader.remaining() == 0;
+}
+
+// defines are unordered, sort them so equal permutations produce equal keys
+ccstd::string getPermutationKey(const ccstd::string &program, const MacroRecord &defines, const ccstd::vector<uint8_t> &pipelineState) {
+    ccstd::vector<const MacroRecord::value_type *> entries;
+    entries.reserve(defines.size());
+    for (const auto &it : defines) {
+        entries.emplace_back(&it);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto *lhs, const auto *rhs) {
+        return lhs->first < rhs->first;
+    });
+
+    BlobWriter writer;
+    writer.write(program);
+    for (const auto *entry : entries) {
+        writeMacro(writer, entry->first, entry->second);
+    }
+    writer.append(pipelineState.data(), pipelineState.size());
+    const auto &data = writer.getData();
+    return {reinterpret_cast<const char *>(data.data()), data.size()};
+}
+
+} // namespace
+
+PersistentPipelineCache *PersistentPipelineCache::getInstance() {
+    static PersistentPipelineCache instance;
+    return &instance;
+}
+
+uint64_t PersistentPipelineCache::computeFingerprint() const {
+    uint64_t hash = hashBytes(HASH_SEED, &FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    const auto api = _device->getGfxAPI();
+    hash = hashBytes(hash, &api, sizeof(api));
+    for (const auto *str : {&_device->getRenderer(), &_device->getVendor(), &_device->getVersion()}) {
+        hash = hashBytes(hash, str->data(), str->size());
+    }
+    return hash;
+}
+
+bool PersistentPipelineCache::open(gfx::Device *device, const ccstd::string &path) {
+    if (_device) close();
+
+    ccstd::vector<uint8_t> pipelineCache;
+    bool loaded = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _device = device;
+        _path = path.empty() ? FileUtils::getInstance()->getWritablePath() + CACHE_FILE_NAME : path;
+        _fingerprint = computeFingerprint();
+        _stats = {};
+        loaded = readFile(pipelineCache);
+        _stats.pipelineCacheBytes = static_cast<uint32_t>(pipelineCache.size());
+        _timeSinceSave = 0.F;
+    }
+
+    if (!pipelineCache.empty()) {
+        device->mergePipelineCacheData(pipelineCache.data(), static_cast<uint32_t>(pipelineCache.size()));
+    }
+    device->setBinaryCache(this);
+    CC_LOG_INFO("Pipeline cache: %u shader binaries, %u permutations, %u bytes of driver pipeline cache",
+                static_cast<uint32_t>(_binaries.size()), static_cast<uint32_t>(_permutations.size()), _stats.pipelineCacheBytes);
+    return loaded;
+}
+
+bool PersistentPipelineCache::readFile(ccstd::vector<uint8_t> &pipelineCache) {
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(_path)) {
+        resetEntries();
+        return false;
+    }
+
+    Data file = fileUtils->getDataFromFile(_path);
+    return readBlob(file.getBytes(), static_cast<size_t>(file.getSize()), pipelineCache);
+}
+
+bool PersistentPipelineCache::deserialize(const uint8_t *data, size_t size, ccstd::vector<uint8_t> &pipelineCache) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return readBlob(data, size, pipelineCache);
+}
+
+bool PersistentPipelineCache::readBlob(const uint8_t *data, size_t size, ccstd::vector<uint8_t> &pipelineCache) {
+    resetEntries();
+    pipelineCache.clear();
+
+    auto parse = [&]() {
+        BlobReader reader(data, size);
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint64_t fingerprint = 0;
+        if (!reader.read(magic) || !reader.read(version) || !reader.read(fingerprint)) return false;
+        if (magic != CACHE_MAGIC || version != FORMAT_VERSION || fingerprint != _fingerprint) {
+            CC_LOG_INFO("Pipeline cache: discarding %s, it was built for a different engine or device", _path.c_str());
+            return false;
+        }
+
+        // binaries are stored from the least to the most recently used
+        uint32_t binaryCount = 0;
+        if (!reader.read(binaryCount) || binaryCount > reader.remaining()) return false;
+        for (uint32_t i = 0; i < binaryCount; ++i) {
+            uint64_t key = 0;
+            uint32_t binarySize = 0;
+            if (!reader.read(key) || !reader.read(binarySize) || binarySize > reader.remaining()) return false;
+            auto &binary = _binaries[key];
+            _binaryBytes -= static_cast<uint32_t>(binary.data.size());
+            binary.data.resize(binarySize);
+            reader.read(binary.data.data(), binarySize);
+            binary.lastUse = ++_useCounter;
+            _binaryBytes += binarySize;
+        }
+
+        uint32_t permutationCount = 0;
+        if (!reader.read(permutationCount) || permutationCount > reader.remaining()) return false;
+        for (uint32_t i = 0; i < permutationCount; ++i) {
+            Permutation permutation;
+            uint32_t stateSize = 0;
+            if (!reader.read(permutation.program) || !readDefines(reader, permutation.defines) ||
+                !reader.read(stateSize) || stateSize > reader.remaining()) return false;
+            permutation.pipelineState.resize(stateSize);
+            reader.read(permutation.pipelineState.data(), stateSize);
+            permutation.key = getPermutationKey(permutation.program, permutation.defines, permutation.pipelineState);
+            addPermutation(std::move(permutation));
+        }
+
+        uint32_t pipelineCacheSize = 0;
+        if (!reader.read(pipelineCacheSize) || pipelineCacheSize > reader.remaining()) return false;
+        pipelineCache.resize(pipelineCacheSize);
+        return reader.read(pipelineCache.data(), pipelineCacheSize);
+    };
+
+    if (!parse()) {
+        // a truncated file may have been partially read
+        resetEntries();
+        pipelineCache.clear();
+        return false;
+    }
+    // the budget may have been lowered since the file was written
+    evictBinaries();
+    return true;
+}
+
+void PersistentPipelineCache::serialize(const ccstd::vector<uint8_t> &pipelineCache, ccstd::vector<uint8_t> &out) {
+    BlobWriter writer;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        writer.write(CACHE_MAGIC);
+        writer.write(FORMAT_VERSION);
+        writer.write(_fingerprint);
+
+        ccstd::vector<const ccstd::unordered_map<uint64_t, Binary>::value_type *> binaries;
+        binaries.reserve(_binaries.size());
+        for (const auto &it : _binaries) {
+            binaries.emplace_back(&it);
+        }
+        std::sort(binaries.begin(), binaries.end(), [](const auto *lhs, const auto *rhs) {
+            return lhs->second.lastUse < rhs->second.lastUse;
+        });
+
+        writer.write(static_cast<uint32_t>(binaries.size()));
+        for (const auto *it : binaries) {
+            writer.write(it->first);
+            writer.write(static_cast<uint32_t>(it->second.data.size()));
+            writer.append(it->second.data.data(), it->second.data.size());
+        }
+
+        writer.write(static_cast<uint32_t>(_permutations.size()));
+        for (const auto &permutation : _permutations) {
+            writer.write(permutation.program);
+            writeDefines(writer, permutation.defines);
+            writer.write(static_cast<uint32_t>(permutation.pipelineState.size()));
+            writer.append(permutation.pipelineState.data(), permutation.pipelineState.size());
+        }
+        _dirty = false;
+    }
+
+    writer.write(static_cast<uint32_t>(pipelineCache.size()));
+    writer.append(pipelineCache.data(), pipelineCache.size());
+    out = writer.release();
+}
+
+bool PersistentPipelineCache::save() {
+    if (!_device) return false;
+
+    ccstd::vector<uint8_t> pipelineCache;
+    bool hasPipelineCache = _device->getPipelineCacheData(pipelineCache);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _timeSinceSave = 0.F;
+        // the driver pipeline cache grows silently, so it is always written back when present
+        if (!_dirty && !hasPipelineCache) return true;
+    }
+
+    ccstd::vector<uint8_t> blob;
+    serialize(pipelineCache, blob);
+
+    Data data;
+    data.copy(blob.data(), static_cast<uint32_t>(blob.size()));
+    if (!FileUtils::getInstance()->writeDataToFile(data, _path)) {
+        CC_LOG_WARNING("Pipeline cache: failed to write %s", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void PersistentPipelineCache::update(float deltaTime) {
+    if (!_device) return;
+
+    releaseWarmUpPipelineStates(false);
+    if (getPendingWarmUpCount() > 0) {
+        warmUp(UPDATE_WARM_UP_BUDGET);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _timeSinceSave += deltaTime;
+        if (!_dirty || _timeSinceSave < SAVE_INTERVAL) return;
+    }
+    save();
+}
+
+void PersistentPipelineCache::close() {
+    if (!_device) return;
+
+    releaseWarmUpPipelineStates(true);
+    save();
+    _device->setBinaryCache(nullptr);
+    _device = nullptr;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pipeline = nullptr;
+}
+
+void PersistentPipelineCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    resetEntries();
+    if (!_path.empty() && FileUtils::getInstance()->isFileExist(_path)) {
+        FileUtils::getInstance()->removeFile(_path);
+    }
+}
+
+void PersistentPipelineCache::resetEntries() {
+    _binaries.clear();
+    _binaryBytes = 0;
+    _permutations.clear();
+    _permutationKeys.clear();
+    _warmUpCursor = 0;
+    _deferredWarmUps.clear();
+    _dirty = false;
+}
+
+void PersistentPipelineCache::setMaxBinaryBytes(uint32_t bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxBinaryBytes = bytes;
+    evictBinaries();
+}
+
+void PersistentPipelineCache::evictBinaries() {
+    while (_binaryBytes > _maxBinaryBytes && !_binaries.empty()) {
+        auto oldest = std::min_element(_binaries.begin(), _binaries.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.second.lastUse < rhs.second.lastUse;
+        });
+        _binaryBytes -= static_cast<uint32_t>(oldest->second.data.size());
+        _binaries.erase(oldest);
+        ++_stats.evictedBinaries;
+        _dirty = true;
+    }
+}
+
+bool PersistentPipelineCache::load(uint64_t key, ccstd::vector<uint8_t> &data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _binaries.find(key);
+    if (iter == _binaries.end()) {
+        ++_stats.shaderMisses;
+        return false;
+    }
+    ++_stats.shaderHits;
+    iter->second.lastUse = ++_useCounter;
+    data = iter->second.data;
+    return true;
+}
+
+void PersistentPipelineCache::store(uint64_t key, const uint8_t *data, uint32_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &binary = _binaries[key];
+    _binaryBytes -= static_cast<uint32_t>(binary.data.size());
+    binary.data.assign(data, data + size);
+    binary.lastUse = ++_useCounter;
+    _binaryBytes += size;
+    ++_stats.shaderStores;
+    _dirty = true;
+    evictBinaries();
+}
+
+bool PersistentPipelineCache::addPermutation(Permutation &&permutation) {
+    if (_permutationKeys.count(permutation.key)) return false;
+    if (_permutations.size() >= MAX_PERMUTATIONS) {
+        // the oldest permutations are the least likely to be used by the current content
+        _permutationKeys.erase(_permutations.front().key);
+        _permutations.erase(_permutations.begin());
+        if (_warmUpCursor > 0) --_warmUpCursor;
+    }
+    _permutationKeys.emplace(permutation.key);
+    _permutations.push_back(std::move(permutation));
+    return true;
+}
+
+void PersistentPipelineCache::recordPermutation(const ccstd::string &program, const MacroRecord &defines, const gfx::PipelineStateInfo *pipelineState) {
+    Permutation permutation{{}, program, defines, {}};
+    if (pipelineState && pipelineState->renderPass) {
+        BlobWriter writer;
+        writePipelineState(writer, *pipelineState);
+        permutation.pipelineState = writer.release();
+    }
+    permutation.key = getPermutationKey(program, defines, permutation.pipelineState);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (addPermutation(std::move(permutation))) {
+        ++_stats.recordedPermutations;
+        _dirty = true;
+    }
+}
+
+void PersistentPipelineCache::setPipeline(render::PipelineRuntime *pipeline) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pipeline = pipeline;
+}
+
+uint32_t PersistentPipelineCache::warmUp(uint32_t budget) {
+    render::PipelineRuntime *pipeline = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_pipeline) return getPendingWarmUpCountLocked();
+        pipeline = _pipeline;
+    }
+
+    auto *programLib = ProgramLib::getInstance();
+    uint32_t compiled = retryWarmUps(pipeline, budget);
+    while (compiled < budget) {
+        Permutation permutation;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_warmUpCursor >= _permutations.size()) break;
+            permutation = _permutations[_warmUpCursor++];
+        }
+        if (!programLib->hasProgram(permutation.program)) {
+            // effects are usually registered while the first scene loads, after the warm-up started
+            std::lock_guard<std::mutex> lock(_mutex);
+            _deferredWarmUps.push_back({std::move(permutation), 1});
+            continue;
+        }
+
+        warmUpPermutation(pipeline, permutation);
+        ++compiled;
+    }
+    return finishWarmUp(compiled);
+}
+
+void PersistentPipelineCache::warmUpPermutation(render::PipelineRuntime *pipeline, Permutation &permutation) {
+    auto *device = pipeline->getDevice();
+    auto *programLib = ProgramLib::getInstance();
+    // hits the shader binary cache when the permutation was compiled on a previous run
+    auto *shader = programLib->getGFXShader(device, permutation.program, permutation.defines, pipeline);
+    if (!shader || permutation.pipelineState.empty()) return;
+
+    // the pipeline state manager keys its pipelines by objects of this run, so the
+    // pipeline state is only created to get it compiled into the driver pipeline cache
+    gfx::PipelineStateInfo info;
+    gfx::RenderPassInfo renderPassInfo;
+    BlobReader reader(permutation.pipelineState.data(), permutation.pipelineState.size());
+    if (!readPipelineState(reader, info, renderPassInfo)) return;
+
+    WarmUpPipelineState warmUp;
+    warmUp.renderPass = device->createRenderPass(renderPassInfo);
+    info.shader = shader;
+    info.pipelineLayout = programLib->getTemplateInfo(permutation.program)->pipelineLayout;
+    info.renderPass = warmUp.renderPass;
+    warmUp.pipelineState = device->createPipelineState(info);
+    _warmUpPipelineStates.push_back(std::move(warmUp));
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_stats.warmedUpPipelines;
+}
+
+void PersistentPipelineCache::releaseWarmUpPipelineStates(bool all) {
+    _warmUpPipelineStates.erase(std::remove_if(_warmUpPipelineStates.begin(), _warmUpPipelineStates.end(), [all](const auto &warmUp) {
+                                    return all || warmUp.pipelineState->isReady();
+                                }),
+                                _warmUpPipelineStates.end());
+}
+
+uint32_t PersistentPipelineCache::retryWarmUps(render::PipelineRuntime *pipeline, uint32_t budget) {
+    ccstd::vector<DeferredWarmUp> deferred;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        deferred.swap(_deferredWarmUps);
+    }
+    if (deferred.empty()) return 0;
+
+    auto *programLib = ProgramLib::getInstance();
+    uint32_t compiled = 0;
+    ccstd::vector<DeferredWarmUp> remaining;
+    for (auto &warmUp : deferred) {
+        if (compiled >= budget) {
+            remaining.push_back(std::move(warmUp));
+        } else if (programLib->hasProgram(warmUp.permutation.program)) {
+            warmUpPermutation(pipeline, warmUp.permutation);
+            ++compiled;
+        } else if (++warmUp.attempts < MAX_WARM_UP_RETRIES) {
+            remaining.push_back(std::move(warmUp));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // permutations deferred meanwhile go after the older ones
+    remaining.insert(remaining.end(), std::make_move_iterator(_deferredWarmUps.begin()), std::make_move_iterator(_deferredWarmUps.end()));
+    _deferredWarmUps.swap(remaining);
+    return compiled;
+}
+
+uint32_t PersistentPipelineCache::finishWarmUp(uint32_t compiled) {
+    uint32_t pending = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.warmedUpPermutations += compiled;
+        pending = getPendingWarmUpCountLocked();
+    }
+    // the binaries compiled by the warm-up are written right away instead of waiting for the next periodic save
+    if (pending == 0 && compiled > 0) {
+        save();
+    }
+    return pending;
+}
+
+uint32_t PersistentPipelineCache::getPendingWarmUpCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getPendingWarmUpCountLocked();
+}
+
+uint32_t PersistentPipelineCache::getPendingWarmUpCountLocked() const {
+    return static_cast<uint32_t>(_permutations.size() - _warmUpCursor + _deferredWarmUps.size());
+}
+
+PipelineCacheStats PersistentPipelineCache::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    PipelineCacheStats stats = _stats;
+    stats.binaryBytes = _binaryBytes;
+    return stats;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,209 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
+#include "gfx-base/GFXBinaryCache.h"
+#include "renderer/core/PassUtils.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+class PipelineState;
+class RenderPass;
+struct PipelineStateInfo;
+} // namespace gfx
+namespace render {
+class PipelineRuntime;
+}
+namespace pipeline {
+
+struct PipelineCacheStats {
+    uint32_t shaderHits{0};
+    uint32_t shaderMisses{0};
+    uint32_t shaderStores{0};
+    uint32_t recordedPermutations{0};
+    uint32_t warmedUpPermutations{0};
+    // pipeline states created by the warm-up to fill the driver pipeline cache
+    uint32_t warmedUpPipelines{0};
+    // shader binaries dropped to stay within the size budget, least recently used first
+    uint32_t evictedBinaries{0};
+    uint32_t binaryBytes{0};
+    // size of the driver pipeline cache blob handed back to the device on open
+    uint32_t pipelineCacheBytes{0};
+};
+
+/**
+ * Versioned on-disk cache of compiled shader binaries (GL program binaries,
+ * SPIR-V) and the driver pipeline cache blob, plus the list of shader
+ * permutations and pipeline states the pipeline state manager has seen,
+ * for warming up later runs.
+ * The whole file is discarded when the format version or device fingerprint
+ * (API, renderer, vendor, driver version) changes. Shader binaries are kept
+ * within a size budget and permutations within a count budget, the least
+ * recently used binaries and the oldest permutations are evicted first.
+ */
+class CC_DLL PersistentPipelineCache final : public gfx::BinaryCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr uint32_t DEFAULT_MAX_BINARY_BYTES = 64U << 20;
+    static constexpr uint32_t MAX_PERMUTATIONS = 4096;
+    // seconds between the saves made by update
+    static constexpr float SAVE_INTERVAL = 30.F;
+    // times a permutation whose effect is not registered yet is retried before it is given up
+    static constexpr uint32_t MAX_WARM_UP_RETRIES = 600;
+    // permutations update compiles at most per call once their effect got registered
+    static constexpr uint32_t UPDATE_WARM_UP_BUDGET = 4;
+
+    static PersistentPipelineCache *getInstance();
+
+    /**
+     * Loads the cache file and attaches it to the device.
+     * @param path Cache file location, defaults to the writable path.
+     * @return Whether a compatible cache file was found.
+     */
+    bool open(gfx::Device *device, const ccstd::string &path = "");
+    bool save();
+    // saves and detaches from the device
+    void close();
+    // drops every entry and removes the cache file
+    void clear();
+    inline bool isOpen() const { return _device != nullptr; }
+
+    /**
+     * Saves the cache when it changed and SAVE_INTERVAL seconds passed since
+     * the last save, so new entries survive the process being killed.
+     * Also warms up UPDATE_WARM_UP_BUDGET pending permutations per call once
+     * a pipeline is set, and releases the warmed up pipeline states that finished compiling.
+     */
+    void update(float deltaTime);
+
+    void setMaxBinaryBytes(uint32_t bytes);
+    inline uint32_t getMaxBinaryBytes() const { return _maxBinaryBytes; }
+
+    // the cache file layout, the header carries the fingerprint of the open device
+    void serialize(const ccstd::vector<uint8_t> &pipelineCache, ccstd::vector<uint8_t> &out);
+    // leaves the cache empty and returns false when the blob is invalid or belongs to another device
+    bool deserialize(const uint8_t *data, size_t size, ccstd::vector<uint8_t> &pipelineCache);
+
+    bool load(uint64_t key, ccstd::vector<uint8_t> &data) override;
+    void store(uint64_t key, const uint8_t *data, uint32_t size) override;
+
+    /**
+     * Records a shader permutation, along with the render pass, input and
+     * fixed function states of the pipeline state it was used by when given.
+     */
+    void recordPermutation(const ccstd::string &program, const MacroRecord &defines, const gfx::PipelineStateInfo *pipelineState = nullptr);
+
+    // the pipeline warm-ups compile shaders for, warming up waits until one is set
+    void setPipeline(render::PipelineRuntime *pipeline);
+
+    /**
+     * Compiles recorded permutations ahead of their first use, meant to be
+     * called during loading screens. Permutations recorded with a pipeline
+     * state also get it created, which fills the driver pipeline cache.
+     * Permutations whose effect is not registered yet stay pending, they are
+     * retried by later warmUp and update calls up to MAX_WARM_UP_RETRIES times.
+     * @param budget Maximum number of permutations compiled by this call.
+     * The cache is saved once every recorded permutation has been warmed up.
+     * @return Number of permutations still waiting to be warmed up.
+     */
+    uint32_t warmUp(uint32_t budget = UINT32_MAX);
+    uint32_t getPendingWarmUpCount() const;
+
+    PipelineCacheStats getStats() const;
+
+private:
+    struct Binary {
+        ccstd::vector<uint8_t> data;
+        // _useCounter value of the last load or store
+        uint64_t lastUse{0};
+    };
+
+    struct Permutation {
+        ccstd::string key;
+        ccstd::string program;
+        MacroRecord defines;
+        // render pass, input and fixed function states, empty when only the shader was recorded
+        ccstd::vector<uint8_t> pipelineState;
+    };
+
+    struct DeferredWarmUp {
+        Permutation permutation;
+        uint32_t attempts{0};
+    };
+
+    // kept alive until compiled, destroying a pipeline state waits for its compilation
+    struct WarmUpPipelineState {
+        IntrusivePtr<gfx::RenderPass> renderPass;
+        IntrusivePtr<gfx::PipelineState> pipelineState;
+    };
+
+    uint64_t computeFingerprint() const;
+    bool readFile(ccstd::vector<uint8_t> &pipelineCache);
+    bool readBlob(const uint8_t *data, size_t size, ccstd::vector<uint8_t> &pipelineCache);
+    void resetEntries();
+    bool addPermutation(Permutation &&permutation);
+    void evictBinaries();
+    void warmUpPermutation(render::PipelineRuntime *pipeline, Permutation &permutation);
+    uint32_t retryWarmUps(render::PipelineRuntime *pipeline, uint32_t budget);
+    uint32_t finishWarmUp(uint32_t compiled);
+    void releaseWarmUpPipelineStates(bool all);
+    uint32_t getPendingWarmUpCountLocked() const;
+
+    mutable std::mutex _mutex;
+    // weak reference
+    gfx::Device *_device{nullptr};
+    ccstd::string _path;
+    uint64_t _fingerprint{0};
+
+    ccstd::unordered_map<uint64_t, Binary> _binaries;
+    uint64_t _useCounter{0};
+    uint32_t _binaryBytes{0};
+    uint32_t _maxBinaryBytes{DEFAULT_MAX_BINARY_BYTES};
+    ccstd::vector<Permutation> _permutations;
+    ccstd::unordered_set<ccstd::string> _permutationKeys;
+    uint32_t _warmUpCursor{0};
+    // permutations passed by the cursor whose effect was not registered yet, in recording order
+    ccstd::vector<DeferredWarmUp> _deferredWarmUps;
+    // weak reference
+    render::PipelineRuntime *_pipeline{nullptr};
+    // only accessed by the thread calling warmUp and update
+    ccstd::vector<WarmUpPipelineState> _warmUpPipelineStates;
+    bool _dirty{false};
+    float _timeSinceSave{0.F};
+    PipelineCacheStats _stats;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -77,12 +77,33 @@ void PipelineSceneData::activate(gfx::Device *device) {
 void PipelineSceneData::destroy() {
     _shadowFrameBufferMap.clear();
     _validPunctualLights.clear();
+    _spotLightShadowObjects.clear();
+    _spotLightShadowCount = 0;
 
     _occlusionQueryInputAssembler = nullptr;
     _occlusionQueryVertexBuffer = nullptr;
     _occlusionQueryIndicesBuffer = nullptr;
 }
 
+RenderObjectList &PipelineSceneData::addSpotLightShadowObjects(const scene::Light *light) {
+    if (_spotLightShadowCount == _spotLightShadowObjects.size()) {
+        _spotLightShadowObjects.emplace_back();
+    }
+    auto &entry = _spotLightShadowObjects[_spotLightShadowCount++];
+    entry.light = light;
+    entry.objects.clear();
+    return entry.objects;
+}
+
+const RenderObjectList *PipelineSceneData::getSpotLightShadowObjects(const scene::Light *light) const {
+    for (uint32_t i = 0; i < _spotLightShadowCount; ++i) {
+        if (_spotLightShadowObjects[i].light == light) {
+            return &_spotLightShadowObjects[i].objects;
+        }
+    }
+    return nullptr;
+}
+
 void PipelineSceneData::initOcclusionQuery() {
     CC_ASSERT(!_occlusionQueryInputAssembler);
     _occlusionQueryInputAssembler = createOcclusionQueryIA();
@@ -81,6 +81,15 @@ public:
     inline void clearRenderObjects() { _renderObjects.clear(); }
     inline void addValidPunctualLight(scene::Light *light) { _validPunctualLights.emplace_back(light); }
     inline void clearValidPunctualLights() { _validPunctualLights.clear(); }
+    RenderObjectList &addSpotLightShadowObjects(const scene::Light *light);
+    const RenderObjectList *getSpotLightShadowObjects(const scene::Light *light) const;
+    inline void clearSpotLightShadowObjects() { _spotLightShadowCount = 0; }
+    // Reuse the camera frustum culling results of the previous frames for models that did not move.
+    inline bool isVisibilityCacheEnabled() const { return _visibilityCacheEnabled; }
+    inline void setVisibilityCacheEnabled(bool val) { _visibilityCacheEnabled = val; }
+    // Number of culling chunks that are re-validated every frame even if they look unchanged, 0 disables it.
+    inline uint32_t getVisibilityCacheRevalidateChunks() const { return _visibilityCacheRevalidateChunks; }
+    inline void setVisibilityCacheRevalidateChunks(uint32_t val) { _visibilityCacheRevalidateChunks = val; }
     inline float getShadingScale() const { return _shadingScale; }
     inline void setShadingScale(float val) { _shadingScale = val; }
     inline bool getCSMSupported() const { return _csmSupported; }
@@ -120,6 +129,9 @@ protected:
 
     bool _isHDR{true};
     bool _csmSupported{true};
+    bool _visibilityCacheEnabled{false};
+
+    uint32_t _visibilityCacheRevalidateChunks{1};
 
     float _shadingScale{1.0F};
 
@@ -131,6 +143,14 @@ protected:
     ccstd::vector<scene::Pass *> _geometryRendererPasses;  // weak reference
     ccstd::vector<gfx::Shader *> _geometryRendererShaders; // weak reference
 
+    struct SpotLightShadowObjects {
+        const scene::Light *light{nullptr}; // weak reference
+        RenderObjectList objects;
+    };
+    // shadow casters of every shadow enabled spot light, the lists are reused across frames
+    ccstd::vector<SpotLightShadowObjects> _spotLightShadowObjects;
+    uint32_t _spotLightShadowCount{0};
+
     ccstd::unordered_map<const scene::Light *, IntrusivePtr<gfx::Framebuffer>> _shadowFrameBufferMap;
 };
 
@@ -24,6 +24,8 @@
 ****************************************************************************/
 
 #include "PipelineStateManager.h"
+#include <algorithm>
+#include "PersistentPipelineCache.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
 #include "scene/Pass.h"
@@ -31,49 +33,255 @@
 namespace cc {
 namespace pipeline {
 
-ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> PipelineStateManager::psoHashMap;
+namespace {
+
+constexpr uint32_t LOCAL_CACHE_SIZE = 64;
+
+struct LocalCacheSlot {
+    PipelineStateKey key;
+    gfx::PipelineState *pso{nullptr};
+    uint32_t generation{0};
+};
+
+// direct-mapped per-recorder cache, hot pipelines are found without touching any lock
+thread_local ccstd::array<LocalCacheSlot, LOCAL_CACHE_SIZE> localCache;
+
+// hit counts stay with the recording thread and are only summed up when stats are read
+struct HitCounterRegistry {
+    std::mutex mutex;
+    ccstd::vector<const std::atomic<uint32_t> *> counters;
+    uint32_t retired{0};
+};
+
+HitCounterRegistry &getHitCounterRegistry() {
+    static HitCounterRegistry registry;
+    return registry;
+}
+
+struct LocalHitCounter {
+    LocalHitCounter() {
+        auto &registry = getHitCounterRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.counters.push_back(&count);
+    }
+
+    ~LocalHitCounter() {
+        auto &registry = getHitCounterRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.retired += count.load(std::memory_order_relaxed);
+        registry.counters.erase(std::remove(registry.counters.begin(), registry.counters.end(), &count), registry.counters.end());
+    }
+
+    // only the owning thread writes, so a plain store is enough and no cache line is shared
+    void increment() {
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> count{0};
+};
+
+thread_local LocalHitCounter localHits;
+
+inline uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+uint64_t PipelineStateKey::hash() const {
+    uint64_t hash = mix((static_cast<uint64_t>(passHash) << 32) | renderPassHash);
+    hash = mix(hash ^ ((static_cast<uint64_t>(iaHash) << 32) | shaderID));
+    return mix(hash ^ subpass);
+}
+
+ccstd::array<PipelineStateManager::Shard, PipelineStateManager::SHARD_COUNT> PipelineStateManager::shards;
+std::atomic<uint32_t> PipelineStateManager::generation{1};
+std::atomic<uint32_t> PipelineStateManager::pipelineCount{0};
+std::atomic<uint32_t> PipelineStateManager::misses{0};
+std::atomic<uint32_t> PipelineStateManager::collisions{0};
+ccstd::unordered_map<gfx::PipelineState *, std::chrono::steady_clock::time_point> PipelineStateManager::pendingPipelines;
+std::atomic<uint32_t> PipelineStateManager::pendingCount{0};
+AsyncPipelineStats PipelineStateManager::asyncStats;
+float PipelineStateManager::totalCompileMs{0.F};
+std::mutex PipelineStateManager::mutex;
 
 gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *pass,
                                                                    gfx::Shader *shader,
                                                                    gfx::InputAssembler *inputAssembler,
                                                                    gfx::RenderPass *renderPass,
                                                                    uint32_t subpass) {
-    const auto passHash = pass->getHash();
-    const auto renderPassHash = renderPass->getHash();
-    const auto iaHash = inputAssembler->getAttributesHash();
-    const auto shaderID = shader->getTypedID();
-    auto hash = passHash ^ renderPassHash ^ iaHash ^ shaderID;
-    if (subpass != 0) {
-        hash = hash << subpass;
+    // the backend waits for a pending compile when the pipeline is bound
+    return acquirePipelineState(pass, shader, inputAssembler, renderPass, subpass, true);
+}
+
+gfx::PipelineState *PipelineStateManager::getPipelineStateIfReady(const scene::Pass *pass,
+                                                                  gfx::Shader *shader,
+                                                                  gfx::InputAssembler *inputAssembler,
+                                                                  gfx::RenderPass *renderPass,
+                                                                  uint32_t subpass) {
+    return acquirePipelineState(pass, shader, inputAssembler, renderPass, subpass, false);
+}
+
+gfx::PipelineState *PipelineStateManager::findPipelineState(Shard &shard, uint64_t hash, const PipelineStateKey &key) {
+    return shard.lock.lockRead([&]() -> gfx::PipelineState * {
+        auto iter = shard.buckets.find(hash);
+        if (iter == shard.buckets.end()) return nullptr;
+        for (const auto &entry : iter->second) {
+            if (entry.key == key) return entry.pso.get();
+        }
+        return nullptr;
+    });
+}
+
+gfx::PipelineState *PipelineStateManager::acquirePipelineState(const scene::Pass *pass,
+                                                               gfx::Shader *shader,
+                                                               gfx::InputAssembler *inputAssembler,
+                                                               gfx::RenderPass *renderPass,
+                                                               uint32_t subpass,
+                                                               bool allowPending) {
+    const PipelineStateKey key{pass->getHash(), renderPass->getHash(), inputAssembler->getAttributesHash(), shader->getTypedID(), subpass};
+    const uint64_t hash = key.hash();
+    const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+
+    auto &slot = localCache[hash & (LOCAL_CACHE_SIZE - 1)];
+    if (slot.pso && slot.generation == currentGeneration && slot.key == key) {
+        localHits.increment();
+        return slot.pso;
+    }
+
+    auto &shard = shards[hash >> (64 - SHARD_BITS)];
+    auto *pso = findPipelineState(shard, hash, key);
+    if (pso) {
+        localHits.increment();
+    } else {
+        std::lock_guard<std::mutex> lock(mutex);
+        // another recorder may have created it while we were waiting
+        pso = findPipelineState(shard, hash, key);
+        if (!pso) {
+            auto *device = gfx::Device::getInstance();
+            auto *pipelineLayout = pass->getPipelineLayout();
+
+            gfx::PipelineStateInfo info{shader,
+                                        pipelineLayout,
+                                        renderPass,
+                                        {inputAssembler->getAttributes()},
+                                        *(pass->getRasterizerState()),
+                                        *(pass->getDepthStencilState()),
+                                        *(pass->getBlendState()),
+                                        pass->getPrimitive(),
+                                        pass->getDynamicStates(),
+                                        gfx::PipelineBindPoint::GRAPHICS,
+                                        subpass};
+            pso = device->createPipelineState(info);
+
+            shard.lock.lockWrite([&]() {
+                auto &bucket = shard.buckets[hash];
+                if (!bucket.empty()) collisions.fetch_add(1, std::memory_order_relaxed);
+                bucket.push_back({key, pso});
+            });
+            pipelineCount.fetch_add(1, std::memory_order_relaxed);
+            misses.fetch_add(1, std::memory_order_relaxed);
+
+            // remembered so later runs can compile the permutation and its pipeline state during loading
+            PersistentPipelineCache::getInstance()->recordPermutation(pass->getProgram(), pass->getDefines(), &info);
+
+            if (device->isAsyncPipelineCompile() && !pso->isReady()) {
+                pendingPipelines[pso] = std::chrono::steady_clock::now();
+                pendingCount.store(static_cast<uint32_t>(pendingPipelines.size()), std::memory_order_release);
+            }
+        } else {
+            localHits.increment();
+        }
     }
 
-    auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
-    if (!pso) {
-        auto *pipelineLayout = pass->getPipelineLayout();
-
-        pso = gfx::Device::getInstance()->createPipelineState({shader,
-                                                               pipelineLayout,
-                                                               renderPass,
-                                                               {inputAssembler->getAttributes()},
-                                                               *(pass->getRasterizerState()),
-                                                               *(pass->getDepthStencilState()),
-                                                               *(pass->getBlendState()),
-                                                               pass->getPrimitive(),
-                                                               pass->getDynamicStates(),
-                                                               gfx::PipelineBindPoint::GRAPHICS,
-                                                               subpass});
-
-        psoHashMap[static_cast<ccstd::hash_t>(hash)] = pso;
+    if (pendingCount.load(std::memory_order_acquire) && !resolvePending(pso, allowPending)) {
+        return nullptr;
     }
 
+    // pipelines still compiling stay out of the local cache so they keep being checked
+    if (pso->isReady()) {
+        slot.key = key;
+        slot.pso = pso;
+        slot.generation = currentGeneration;
+    }
     return pso;
 }
 
+bool PipelineStateManager::resolvePending(gfx::PipelineState *pso, bool allowPending) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = pendingPipelines.find(pso);
+    if (iter == pendingPipelines.end()) return true;
+
+    if (pso->isReady()) {
+        auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - iter->second).count();
+        pendingPipelines.erase(iter);
+        pendingCount.store(static_cast<uint32_t>(pendingPipelines.size()), std::memory_order_release);
+        ++asyncStats.stallsAvoided;
+        totalCompileMs += elapsed;
+        asyncStats.averageCompileMs = totalCompileMs / static_cast<float>(asyncStats.stallsAvoided);
+        asyncStats.maxCompileMs = std::max(asyncStats.maxCompileMs, elapsed);
+        return true;
+    }
+
+    if (!allowPending) {
+        ++asyncStats.skippedDraws;
+        return false;
+    }
+    return true;
+}
+
 void PipelineStateManager::destroyAll() {
-    for (auto &pair : psoHashMap) {
-        CC_SAFE_DESTROY_NULL(pair.second);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &shard : shards) {
+        shard.lock.lockWrite([&]() {
+            for (auto &bucket : shard.buckets) {
+                for (auto &entry : bucket.second) {
+                    CC_SAFE_DESTROY_NULL(entry.pso);
+                }
+            }
+            shard.buckets.clear();
+        });
+    }
+    pipelineCount.store(0, std::memory_order_relaxed);
+    pendingPipelines.clear();
+    pendingCount.store(0, std::memory_order_release);
+    generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+PipelineStateCacheStats PipelineStateManager::getCacheStats() {
+    PipelineStateCacheStats stats;
+    stats.pipelines = pipelineCount.load(std::memory_order_relaxed);
+    {
+        auto &registry = getHitCounterRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        stats.hits = registry.retired;
+        for (const auto *counter : registry.counters) {
+            stats.hits += counter->load(std::memory_order_relaxed);
+        }
     }
-    psoHashMap.clear();
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.collisions = collisions.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PipelineStateManager::setAsyncCompileEnabled(bool enabled) {
+    gfx::Device::getInstance()->setAsyncPipelineCompile(enabled);
+}
+
+bool PipelineStateManager::isAsyncCompileEnabled() {
+    return gfx::Device::getInstance()->isAsyncPipelineCompile();
+}
+
+AsyncPipelineStats PipelineStateManager::getAsyncStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto stats = asyncStats;
+    stats.pendingPipelines = static_cast<uint32_t>(pendingPipelines.size());
+    return stats;
 }
 
 } // namespace pipeline
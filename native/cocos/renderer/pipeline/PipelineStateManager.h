@@ -25,6 +25,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "base/std/container/array.h"
+#include "base/threading/ReadWriteLock.h"
 #include "cocos/base/Ptr.h"
 #include "gfx-base/GFXDef.h"
 
@@ -34,6 +39,41 @@ class Pass;
 }
 namespace pipeline {
 
+struct PipelineStateKey {
+    ccstd::hash_t passHash{0};
+    ccstd::hash_t renderPassHash{0};
+    ccstd::hash_t iaHash{0};
+    uint32_t shaderID{0};
+    uint32_t subpass{0};
+
+    inline bool operator==(const PipelineStateKey &rhs) const {
+        return passHash == rhs.passHash && renderPassHash == rhs.renderPassHash && iaHash == rhs.iaHash &&
+               shaderID == rhs.shaderID && subpass == rhs.subpass;
+    }
+
+    // 64-bit mix of every field, only used to pick shards and buckets,
+    // lookups are always verified against the full key
+    uint64_t hash() const;
+};
+
+struct PipelineStateCacheStats {
+    uint32_t pipelines{0};
+    uint32_t hits{0};
+    uint32_t misses{0};
+    // distinct keys that landed in an occupied bucket
+    uint32_t collisions{0};
+};
+
+struct AsyncPipelineStats {
+    uint32_t pendingPipelines{0};
+    // pipelines compiled in the background instead of on the render thread
+    uint32_t stallsAvoided{0};
+    uint32_t skippedDraws{0};
+    // from creation until the pipeline was first seen ready
+    float averageCompileMs{0.F};
+    float maxCompileMs{0.F};
+};
+
 class CC_DLL PipelineStateManager {
 public:
     static gfx::PipelineState *getOrCreatePipelineState(const scene::Pass *pass,
@@ -41,10 +81,61 @@ public:
                                                         gfx::InputAssembler *inputAssembler,
                                                         gfx::RenderPass *renderPass,
                                                         uint32_t subpass = 0);
+    /**
+     * Same as getOrCreatePipelineState, but returns nullptr while the pipeline is still
+     * compiling in the background so the caller can skip the draw instead of stalling.
+     */
+    static gfx::PipelineState *getPipelineStateIfReady(const scene::Pass *pass,
+                                                       gfx::Shader *shader,
+                                                       gfx::InputAssembler *inputAssembler,
+                                                       gfx::RenderPass *renderPass,
+                                                       uint32_t subpass = 0);
     static void destroyAll();
 
+    static PipelineStateCacheStats getCacheStats();
+
+    // only takes effect on backends that can compile off the render thread
+    static void setAsyncCompileEnabled(bool enabled);
+    static bool isAsyncCompileEnabled();
+    static AsyncPipelineStats getAsyncStats();
+
 private:
-    static ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> psoHashMap;
+    static gfx::PipelineState *acquirePipelineState(const scene::Pass *pass,
+                                                    gfx::Shader *shader,
+                                                    gfx::InputAssembler *inputAssembler,
+                                                    gfx::RenderPass *renderPass,
+                                                    uint32_t subpass,
+                                                    bool allowPending);
+
+    static constexpr uint32_t SHARD_BITS = 4;
+    static constexpr uint32_t SHARD_COUNT = 1U << SHARD_BITS;
+
+    struct Entry {
+        PipelineStateKey key;
+        IntrusivePtr<gfx::PipelineState> pso;
+    };
+    // lookups from parallel recorders only take the shared side of the lock
+    struct Shard {
+        ReadWriteLock lock;
+        ccstd::unordered_map<uint64_t, ccstd::vector<Entry>> buckets;
+    };
+
+    static gfx::PipelineState *findPipelineState(Shard &shard, uint64_t hash, const PipelineStateKey &key);
+    static bool resolvePending(gfx::PipelineState *pso, bool allowPending);
+
+    static ccstd::array<Shard, SHARD_COUNT> shards;
+    // bumped by destroyAll to invalidate the per-thread lookup caches
+    static std::atomic<uint32_t> generation;
+    static std::atomic<uint32_t> pipelineCount;
+    static std::atomic<uint32_t> misses;
+    static std::atomic<uint32_t> collisions;
+
+    static ccstd::unordered_map<gfx::PipelineState *, std::chrono::steady_clock::time_point> pendingPipelines;
+    static std::atomic<uint32_t> pendingCount;
+    static AsyncPipelineStats asyncStats;
+    static float totalCompileMs;
+    // serializes pipeline creation and the async bookkeeping
+    static std::mutex mutex;
 };
 
 } // namespace pipeline
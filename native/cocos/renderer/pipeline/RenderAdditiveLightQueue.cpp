@@ -99,7 +99,8 @@ void RenderAdditiveLightQueue::recordCommandBuffer(gfx::Device *device, scene::C
             auto *shader = lightPass.shader;
             const auto lights = lightPass.lights;
             auto *ia = subModel->getInputAssembler();
-            auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
+            auto *pso = PipelineStateManager::getPipelineStateIfReady(pass, shader, ia, renderPass);
+            if (!pso) continue;
             auto *descriptorSet = subModel->getDescriptorSet();
 
             cmdBuffer->bindPipelineState(pso);
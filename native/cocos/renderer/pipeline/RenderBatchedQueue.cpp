@@ -39,47 +39,58 @@ void RenderBatchedQueue::clear() {
         it->clear();
     }
     _queues.clear();
+    _renderQueues.clear();
 }
 
-void RenderBatchedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
-    for (const auto *batchedBuffer : _queues) {
-        const auto &batches = batchedBuffer->getBatches();
-        for (const auto &batch : batches) {
-            if (!batch.mergeCount) continue;
+void RenderBatchedQueue::snapshot() {
+    _renderQueues.assign(_queues.cbegin(), _queues.cend());
+}
 
-            auto i = 0U;
-            for (auto *vb : batch.vbs) {
-                cmdBuffer->updateBuffer(vb, batch.vbDatas[i++], vb->getSize());
-            }
-            cmdBuffer->updateBuffer(batch.indexBuffer, batch.indexData, batch.indexBuffer->getSize());
-            cmdBuffer->updateBuffer(batch.ubo, batch.uboData.data(), batch.ubo->getSize());
-        }
+void RenderBatchedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
+    for (auto *batchedBuffer : _queues) {
+        batchedBuffer->uploadBuffers(cmdBuffer);
     }
 }
 
 void RenderBatchedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
                                              gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets) {
     for (const auto *batchedBuffer : _queues) {
-        bool boundPSO = false;
-        const auto &batches = batchedBuffer->getBatches();
-        for (const auto &batch : batches) {
-            if (!batch.mergeCount) continue;
-            if (!boundPSO) {
-                auto *pso = PipelineStateManager::getOrCreatePipelineState(batch.pass, batch.shader, batch.ia, renderPass);
-                cmdBuffer->bindPipelineState(pso);
-                cmdBuffer->bindDescriptorSet(materialSet, batch.pass->getDescriptorSet());
-                boundPSO = true;
-            }
-            if (ds) cmdBuffer->bindDescriptorSet(globalSet, ds, 1, &offset);
-            if (dynamicOffsets) {
-                cmdBuffer->bindDescriptorSet(localSet, batch.descriptorSet, *dynamicOffsets);
-            } else {
-                cmdBuffer->bindDescriptorSet(localSet, batch.descriptorSet, batchedBuffer->getDynamicOffset());
-            }
+        recordBatchedBuffer(batchedBuffer, renderPass, cmdBuffer, ds, offset, dynamicOffsets);
+    }
+}
 
-            cmdBuffer->bindInputAssembler(batch.ia);
-            cmdBuffer->draw(batch.ia);
+void RenderBatchedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                                             gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets, uint32_t begin, uint32_t end) {
+    // ranges index the snapshot, the iteration order of the set is not guaranteed to stay the same across ranges
+    CC_ASSERT(_renderQueues.size() == _queues.size());
+    end = std::min(end, static_cast<uint32_t>(_renderQueues.size()));
+    for (uint32_t i = begin; i < end; ++i) {
+        recordBatchedBuffer(_renderQueues[i], renderPass, cmdBuffer, ds, offset, dynamicOffsets);
+    }
+}
+
+void RenderBatchedQueue::recordBatchedBuffer(const BatchedBuffer *batchedBuffer, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                                             gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets) {
+    bool boundPSO = false;
+    const auto &batches = batchedBuffer->getBatches();
+    for (const auto &batch : batches) {
+        if (!batch.mergeCount) continue;
+        if (!boundPSO) {
+            auto *pso = PipelineStateManager::getPipelineStateIfReady(batch.pass, batch.shader, batch.ia, renderPass);
+            if (!pso) break;
+            cmdBuffer->bindPipelineState(pso);
+            cmdBuffer->bindDescriptorSet(materialSet, batch.pass->getDescriptorSet());
+            boundPSO = true;
+        }
+        if (ds) cmdBuffer->bindDescriptorSet(globalSet, ds, 1, &offset);
+        if (dynamicOffsets) {
+            cmdBuffer->bindDescriptorSet(localSet, batch.descriptorSet, *dynamicOffsets);
+        } else {
+            cmdBuffer->bindDescriptorSet(localSet, batch.descriptorSet, batchedBuffer->getDynamicOffset());
         }
+
+        cmdBuffer->bindInputAssembler(batch.ia);
+        cmdBuffer->draw(batch.ia);
     }
 }
 
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
@@ -49,12 +50,23 @@ public:
     void uploadBuffers(gfx::CommandBuffer *cmdBuff);
     void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
                              gfx::DescriptorSet *ds = nullptr, uint32_t offset = 0, const ccstd::vector<uint32_t> *dynamicOffsets = nullptr);
+    // records the batched buffers in [begin, end) of the order snapshot() fixed,
+    // ranges can be recorded concurrently into different command buffers
+    void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                             gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets, uint32_t begin, uint32_t end);
     void add(BatchedBuffer *batchedBuffer);
+    // fixes the order of the queue in a vector once all buffers are added
+    void snapshot();
     bool empty() const { return _queues.empty(); }
+    uint32_t size() const { return static_cast<uint32_t>(_queues.size()); }
 
 private:
+    void recordBatchedBuffer(const BatchedBuffer *batchedBuffer, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                             gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets);
+
     // weak reference
     ccstd::unordered_set<BatchedBuffer *> _queues;
+    ccstd::vector<BatchedBuffer *> _renderQueues;
 };
 
 } // namespace pipeline
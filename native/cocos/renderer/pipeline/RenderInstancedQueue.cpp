@@ -43,13 +43,19 @@ void RenderInstancedQueue::clear() {
 }
 
 void RenderInstancedQueue::sort() {
-    std::copy(_queues.cbegin(), _queues.cend(), std::back_inserter(_renderQueues));
+    _renderQueues.assign(_queues.cbegin(), _queues.cend());
     auto isOpaque = [](const InstancedBuffer *instance) {
         return instance->getPass()->getBlendState()->targets[0].blend == 0;
     };
     std::stable_partition(_renderQueues.begin(), _renderQueues.end(), isOpaque);
 }
 
+void RenderInstancedQueue::snapshot() {
+    if (_renderQueues.size() != _queues.size()) {
+        _renderQueues.assign(_queues.cbegin(), _queues.cend());
+    }
+}
+
 void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
     for (auto *instanceBuffer : _queues) {
         if (instanceBuffer->hasPendingModels()) {
@@ -60,39 +66,53 @@ void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
 
 void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
                                                gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets) {
-    auto recordCommands = [&](const auto &renderQueue) {
-        for (const auto *instanceBuffer : renderQueue) {
-            if (!instanceBuffer->hasPendingModels()) continue;
-
-            const auto &instances = instanceBuffer->getInstances();
-            const auto *pass = instanceBuffer->getPass();
-            cmdBuffer->bindDescriptorSet(materialSet, pass->getDescriptorSet());
-            gfx::PipelineState *lastPSO = nullptr;
-            for (const auto &instance : instances) {
-                if (!instance.count) {
-                    continue;
-                }
-                auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, instance.shader, instance.ia, renderPass);
-                if (lastPSO != pso) {
-                    cmdBuffer->bindPipelineState(pso);
-                    lastPSO = pso;
-                }
-                if (ds) cmdBuffer->bindDescriptorSet(globalSet, ds, 1, &offset);
-                if (dynamicOffsets) {
-                    cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, *dynamicOffsets);
-                } else {
-                    cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
-                }
-                cmdBuffer->bindInputAssembler(instance.ia);
-                cmdBuffer->draw(instance.ia);
-            }
-        }
-    };
-
     if (_renderQueues.empty()) {
-        recordCommands(_queues);
+        for (const auto *instanceBuffer : _queues) {
+            recordInstancedBuffer(instanceBuffer, renderPass, cmdBuffer, ds, offset, dynamicOffsets);
+        }
     } else {
-        recordCommands(_renderQueues);
+        for (const auto *instanceBuffer : _renderQueues) {
+            recordInstancedBuffer(instanceBuffer, renderPass, cmdBuffer, ds, offset, dynamicOffsets);
+        }
+    }
+}
+
+void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                                               gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets, uint32_t begin, uint32_t end) {
+    // ranges index the snapshot, walking the set to each range would make the recording quadratic
+    CC_ASSERT(_renderQueues.size() == _queues.size());
+    end = std::min(end, static_cast<uint32_t>(_renderQueues.size()));
+    for (uint32_t i = begin; i < end; ++i) {
+        recordInstancedBuffer(_renderQueues[i], renderPass, cmdBuffer, ds, offset, dynamicOffsets);
+    }
+}
+
+void RenderInstancedQueue::recordInstancedBuffer(const InstancedBuffer *instanceBuffer, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                                                 gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets) {
+    if (!instanceBuffer->hasPendingModels()) return;
+
+    const auto &instances = instanceBuffer->getInstances();
+    const auto *pass = instanceBuffer->getPass();
+    cmdBuffer->bindDescriptorSet(materialSet, pass->getDescriptorSet());
+    gfx::PipelineState *lastPSO = nullptr;
+    for (const auto &instance : instances) {
+        if (!instance.count) {
+            continue;
+        }
+        auto *pso = PipelineStateManager::getPipelineStateIfReady(pass, instance.shader, instance.ia, renderPass);
+        if (!pso) continue;
+        if (lastPSO != pso) {
+            cmdBuffer->bindPipelineState(pso);
+            lastPSO = pso;
+        }
+        if (ds) cmdBuffer->bindDescriptorSet(globalSet, ds, 1, &offset);
+        if (dynamicOffsets) {
+            cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, *dynamicOffsets);
+        } else {
+            cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
+        }
+        cmdBuffer->bindInputAssembler(instance.ia);
+        cmdBuffer->draw(instance.ia);
     }
 }
 
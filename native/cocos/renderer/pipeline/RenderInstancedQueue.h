@@ -50,13 +50,23 @@ public:
     ~RenderInstancedQueue() = default;
     void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
                              gfx::DescriptorSet *ds = nullptr, uint32_t offset = 0, const ccstd::vector<uint32_t> *dynamicOffsets = nullptr);
+    // records the instanced buffers in [begin, end) of the order sort() or snapshot() fixed,
+    // ranges can be recorded concurrently into different command buffers
+    void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                             gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets, uint32_t begin, uint32_t end);
     void add(InstancedBuffer *instancedBuffer);
     void uploadBuffers(gfx::CommandBuffer *cmdBuffer);
     void sort();
+    // fixes the order of the queue in a vector once all buffers are added, unless sort() did already
+    void snapshot();
     void clear();
     bool empty() { return _queues.empty(); }
+    uint32_t size() const { return static_cast<uint32_t>(_queues.size()); }
 
 private:
+    void recordInstancedBuffer(const InstancedBuffer *instanceBuffer, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer,
+                               gfx::DescriptorSet *ds, uint32_t offset, const ccstd::vector<uint32_t> *dynamicOffsets);
+
     // `InstancedBuffer *`: weak reference
     ccstd::set<InstancedBuffer *> _queues;
     ccstd::vector<InstancedBuffer *> _renderQueues;
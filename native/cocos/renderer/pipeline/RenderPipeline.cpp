@@ -36,6 +36,7 @@
 #include "RenderFlow.h"
 #include "RenderPipeline.h"
 #include "base/StringUtil.h"
+#include "base/job-system/JobSystem.h"
 #include "base/std/hash/hash.h"
 #include "frame-graph/FrameGraph.h"
 #include "gfx-base/GFXDevice.h"
@@ -175,12 +176,29 @@ bool RenderPipeline::destroy() {
     }
     _commandBuffers.clear();
 
+    for (auto *cmdBuffer : _secondaryCommandBuffers) {
+        CC_SAFE_DESTROY_AND_DELETE(cmdBuffer);
+    }
+    _secondaryCommandBuffers.clear();
+
     PipelineStateManager::destroyAll();
     framegraph::FrameGraph::gc(0);
 
     return Super::destroy();
 }
 
+const gfx::CommandBufferList &RenderPipeline::getSecondaryCommandBuffers(uint32_t count) {
+    while (_secondaryCommandBuffers.size() < count) {
+        _secondaryCommandBuffers.push_back(_device->createCommandBuffer({_device->getQueue(), gfx::CommandBufferType::SECONDARY}));
+    }
+    return _secondaryCommandBuffers;
+}
+
+bool RenderPipeline::isParallelCommandRecording() const {
+    return _parallelCommandRecording && _device->isMultithreadedCommandRecording() &&
+           JobSystem::getInstance()->threadCount() > 1 && !isOcclusionQueryEnabled();
+}
+
 gfx::Color RenderPipeline::getClearcolor(scene::Camera *camera) const {
     auto *const sceneData = getPipelineSceneData();
     gfx::Color clearColor{0.0F, 0.0F, 0.0F, 1.0F};
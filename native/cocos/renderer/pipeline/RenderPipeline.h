@@ -91,6 +91,8 @@ public:
     gfx::DescriptorSetLayout *getDescriptorSetLayout() const;
     inline PipelineSceneData *getPipelineSceneData() const { return _pipelineSceneData; }
     inline const gfx::CommandBufferList &getCommandBuffers() const { return _commandBuffers; }
+    // secondary command buffers for parallel pass recording, the pool grows on demand
+    const gfx::CommandBufferList &getSecondaryCommandBuffers(uint32_t count);
     inline const gfx::QueryPoolList &getQueryPools() const { return _queryPools; }
     inline PipelineUBO *getPipelineUBO() const { return _pipelineUBO; }
     inline const ccstd::string &getConstantMacros() const { return _constantMacros; }
@@ -139,6 +141,15 @@ public:
 #endif
     }
 
+    // record the queues of supported stages into secondary command buffers on the job system,
+    // only takes effect when the device supports multithreaded recording and occlusion query is off
+    bool isParallelCommandRecording() const;
+    inline void setParallelCommandRecording(bool enable) { _parallelCommandRecording = enable; }
+
+    // draw instanced and batched items with drawIndirect, reading their arguments from per-item draw-args buffers
+    inline bool isIndirectDrawEnabled() const { return _indirectDrawEnabled; }
+    inline void setIndirectDrawEnabled(bool enable) { _indirectDrawEnabled = enable; }
+
     inline void resetRenderQueue(bool reset) { _resetRenderQueue = reset; }
     inline bool isRenderQueueReset() const { return _resetRenderQueue; }
 
@@ -160,6 +171,8 @@ protected:
     static void framegraphGC();
 
     gfx::CommandBufferList _commandBuffers;
+    // manage memory manually
+    gfx::CommandBufferList _secondaryCommandBuffers;
     gfx::QueryPoolList _queryPools;
     RenderFlowList _flows;
     ccstd::unordered_map<ccstd::string, InternalBindingInst> _globalBindings;
@@ -199,6 +212,8 @@ protected:
     bool _clusterEnabled{false};
     bool _bloomEnabled{false};
     bool _occlusionQueryEnabled{false};
+    bool _parallelCommandRecording{false};
+    bool _indirectDrawEnabled{false};
 
     bool _resetRenderQueue{true};
 
@@ -25,10 +25,12 @@
 
 #include "RenderQueue.h"
 
+#include <algorithm>
 #include <utility>
 #include "PipelineSceneData.h"
 #include "PipelineStateManager.h"
 #include "RenderPipeline.h"
+#include "RenderQueueSort.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXShader.h"
@@ -41,10 +43,14 @@ namespace pipeline {
 
 RenderQueue::RenderQueue(RenderPipeline *pipeline, RenderQueueCreateInfo desc, bool useOcclusionQuery)
 : _pipeline(pipeline), _passDesc(std::move(desc)), _useOcclusionQuery(useOcclusionQuery) {
+    // a custom comparator can't be expressed as a sort key and is honored as it is
+    _useSortFunc = _passDesc.sortFunc && !getBuiltinSortMode(_passDesc.sortFunc, &_passDesc.sortMode);
 }
 
 void RenderQueue::clear() {
     _queue.clear();
+    _sortKeys.clear();
+    _useCompareFn = false;
 }
 
 bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint32_t subModelIdx, uint32_t passIdx) {
@@ -58,31 +64,43 @@ bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint32_t subMo
 
     auto passPriority = static_cast<uint32_t>(pass->getPriority());
     auto modelPriority = static_cast<uint32_t>(subModel->getPriority());
-    auto shaderId = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(subModel->getShader(passIdx)));
+    auto shaderId = subModel->getShader(passIdx)->getTypedID();
     const auto hash = (0 << 30) | (passPriority << 16) | (modelPriority << 8) | passIdx;
     const auto priority = renderObj.model->getPriority();
     RenderPass renderPass = {priority, hash, renderObj.depth, shaderId, passIdx, subModel};
     _queue.emplace_back(renderPass);
+    if (!_useSortFunc) {
+        _sortKeys.emplace_back(getSortKey(renderPass, _passDesc.sortMode));
+        _useCompareFn = _useCompareFn || !fitsSortKey(renderPass, _passDesc.sortMode);
+    }
 
     return true;
 }
 
 void RenderQueue::sort() {
-#if CC_PLATFORM != CC_PLATFORM_LINUX && CC_PLATFORM != CC_PLATFORM_QNX
-    std::sort(_queue.begin(), _queue.end(), _passDesc.sortFunc);
-#else
-    //cannot use std::function as comparator in algorithms https://gcc.gnu.org/bugzilla/show_bug.cgi?id=65942#c11
-    std::sort(_queue.begin(), _queue.end(), [this](const RenderPass &a, const RenderPass &b) -> bool {
-        return _passDesc.sortFunc(a, b);
-    });
-#endif
+    if (size() < 2) return;
+    if (_useSortFunc) {
+        std::stable_sort(_queue.begin(), _queue.end(), _passDesc.sortFunc);
+        return;
+    }
+    // some pass doesn't fit the sort key, the comparator of the sort mode gives the full order
+    if (_useCompareFn) {
+        std::stable_sort(_queue.begin(), _queue.end(), _passDesc.sortMode == RenderQueueSortMode::BACK_TO_FRONT ? transparentCompareFn : opaqueCompareFn);
+        return;
+    }
+    sortRenderPasses(_queue, _sortKeys, _sortScratch);
 }
 
-void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex) {
+void RenderQueue::recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex) {
+    recordCommandBuffer(device, camera, renderPass, cmdBuff, subpassIndex, 0, size());
+}
+
+void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex, uint32_t begin, uint32_t end) {
     PipelineSceneData *const sceneData = _pipeline->getPipelineSceneData();
     bool enableOcclusionQuery = _pipeline->isOcclusionQueryEnabled() && _useOcclusionQuery;
     auto *queryPool = _pipeline->getQueryPools()[0];
-    for (auto &i : _queue) {
+    for (uint32_t idx = begin; idx < end; ++idx) {
+        const auto &i = _queue[idx];
         const auto *subModel = i.subModel;
         if (enableOcclusionQuery) {
             cmdBuff->beginQuery(queryPool, subModel->getId());
@@ -104,7 +122,11 @@ void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *c
             auto *inputAssembler = subModel->getInputAssembler();
             const auto *pass = subModel->getPass(passIdx);
             auto *shader = subModel->getShader(passIdx);
-            auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
+            auto *pso = PipelineStateManager::getPipelineStateIfReady(pass, shader, inputAssembler, renderPass, subpassIndex);
+            if (!pso) {
+                if (enableOcclusionQuery) cmdBuff->endQuery(queryPool, subModel->getId());
+                continue;
+            }
 
             cmdBuff->bindPipelineState(pso);
             cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
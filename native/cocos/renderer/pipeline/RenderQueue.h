@@ -26,6 +26,7 @@
 #pragma once
 
 #include "Define.h"
+#include "RenderQueueSort.h"
 
 namespace cc {
 namespace scene {
@@ -42,14 +43,24 @@ public:
     void clear();
     bool insertRenderPass(const RenderObject &renderObj, uint32_t subModelIdx, uint32_t passIdx);
     void recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex = 0);
+    // records the sorted passes in [begin, end), ranges can be recorded concurrently into different command buffers
+    void recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex, uint32_t begin, uint32_t end);
     void sort();
     bool empty() { return _queue.empty(); }
+    uint32_t size() const { return static_cast<uint32_t>(_queue.size()); }
 
 private:
     // weak reference
     RenderPipeline *_pipeline{nullptr};
     RenderPassList _queue;
+    // sort keys in insertion order, kept across frames to avoid reallocation
+    ccstd::vector<uint64_t> _sortKeys;
+    RenderPassSortScratch _sortScratch;
     RenderQueueCreateInfo _passDesc;
+    // sortFunc is not one of the built-in comparators, the passes are sorted with it instead of by sort key
+    bool _useSortFunc{false};
+    // a pass of this frame doesn't fit the sort key, the passes are sorted with the comparator of the sort mode
+    bool _useCompareFn{false};
     bool _useOcclusionQuery{false};
 };
 
@@ -0,0 +1,150 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "RenderQueueSort.h"
+
+#include <cstring>
+#include <utility>
+#include "base/std/container/array.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+// maps the float bits to an unsigned integer of the same order, negative values included
+uint32_t getOrderedFloatBits(float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+}
+
+// stable LSD radix sort of the low `bits` bits of the keys, 8 bits per pass, indices are moved along with the keys
+void radixSort(ccstd::vector<uint64_t> &keys, ccstd::vector<uint32_t> &indices,
+               ccstd::vector<uint64_t> &keysTemp, ccstd::vector<uint32_t> &indicesTemp, uint32_t bits) {
+    const auto count = static_cast<uint32_t>(keys.size());
+    keysTemp.resize(count);
+    indicesTemp.resize(count);
+
+    uint64_t *src = keys.data();
+    uint64_t *dst = keysTemp.data();
+    uint32_t *srcIndices = indices.data();
+    uint32_t *dstIndices = indicesTemp.data();
+
+    ccstd::array<uint32_t, 256> histogram;
+    for (uint32_t shift = 0; shift < bits; shift += 8) {
+        histogram.fill(0);
+        for (uint32_t i = 0; i < count; ++i) {
+            ++histogram[(src[i] >> shift) & 0xFF];
+        }
+        // all the keys share this digit, the pass would not move anything
+        if (histogram[(src[0] >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (auto &bucket : histogram) {
+            const uint32_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t pos = histogram[(src[i] >> shift) & 0xFF]++;
+            dst[pos] = src[i];
+            dstIndices[pos] = srcIndices[i];
+        }
+        std::swap(src, dst);
+        std::swap(srcIndices, dstIndices);
+    }
+
+    if (src != keys.data()) {
+        keys.swap(keysTemp);
+        indices.swap(indicesTemp);
+    }
+}
+
+using CompareFn = bool (*)(const RenderPass &, const RenderPass &);
+} // namespace
+
+bool getBuiltinSortMode(const std::function<bool(const RenderPass &, const RenderPass &)> &sortFunc, RenderQueueSortMode *mode) {
+    // target() only matches the exact stored type, so a lambda or a functor calling the built-in comparators is not recognized
+    const auto *fn = sortFunc.target<CompareFn>();
+    if (!fn) {
+        // the stages pass the result of convertQueueSortFunc, which wraps the comparator once more
+        const auto *wrapped = sortFunc.target<RenderQueueSortFunc>();
+        fn = wrapped ? wrapped->target<CompareFn>() : nullptr;
+    }
+    if (fn && *fn == opaqueCompareFn) {
+        *mode = RenderQueueSortMode::FRONT_TO_BACK;
+        return true;
+    }
+    if (fn && *fn == transparentCompareFn) {
+        *mode = RenderQueueSortMode::BACK_TO_FRONT;
+        return true;
+    }
+    return false;
+}
+
+bool fitsSortKey(const RenderPass &renderPass, RenderQueueSortMode mode) {
+    return renderPass.hash <= 0xFFFFFFU && (mode != RenderQueueSortMode::BACK_TO_FRONT || renderPass.priority <= 0xFFU);
+}
+
+// The key reproduces the order of opaqueCompareFn (FRONT_TO_BACK) and transparentCompareFn (BACK_TO_FRONT):
+//   | model priority: 8 | pass hash: 24 | depth: 32 |
+// model priority only takes part in back-to-front queues, and their depth is inverted to get the far passes first.
+uint64_t getSortKey(const RenderPass &renderPass, RenderQueueSortMode mode) {
+    uint64_t depth = getOrderedFloatBits(renderPass.depth);
+    uint64_t priority = 0;
+    if (mode == RenderQueueSortMode::BACK_TO_FRONT) {
+        depth = ~depth & 0xFFFFFFFFU;
+        priority = renderPass.priority & 0xFFU;
+    }
+    return (priority << 56) | (static_cast<uint64_t>(renderPass.hash & 0xFFFFFF) << 32) | depth;
+}
+
+void sortRenderPasses(RenderPassList &queue, const ccstd::vector<uint64_t> &keys, RenderPassSortScratch &scratch) {
+    const auto count = static_cast<uint32_t>(queue.size());
+    if (count < 2) return;
+
+    // sort by shader first, the stable passes over the main key keep that order among passes with equal keys
+    scratch.indices.resize(count);
+    scratch.keys.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        scratch.indices[i] = i;
+        scratch.keys[i] = queue[i].shaderID;
+    }
+    radixSort(scratch.keys, scratch.indices, scratch.keysTemp, scratch.indicesTemp, 32);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        scratch.keys[i] = keys[scratch.indices[i]];
+    }
+    radixSort(scratch.keys, scratch.indices, scratch.keysTemp, scratch.indicesTemp, 64);
+
+    scratch.queue.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        scratch.queue[i] = queue[scratch.indices[i]];
+    }
+    queue.swap(scratch.queue);
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,67 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "Define.h"
+
+namespace cc {
+namespace pipeline {
+
+/**
+ * Finds the sort mode opaqueCompareFn or transparentCompareFn stands for.
+ * @param sortFunc The comparator, either one of the built-in ones or the result of convertQueueSortFunc.
+ * @return False if sortFunc is anything else, mode is left untouched then.
+ */
+bool getBuiltinSortMode(const std::function<bool(const RenderPass &, const RenderPass &)> &sortFunc, RenderQueueSortMode *mode);
+
+/**
+ * Whether the pass can be ordered by its sort key, getSortKey only keeps 8 bits of model priority and 24 bits of pass hash.
+ */
+bool fitsSortKey(const RenderPass &renderPass, RenderQueueSortMode mode);
+
+/**
+ * Packs the pass into a key which orders like opaqueCompareFn (FRONT_TO_BACK) or transparentCompareFn (BACK_TO_FRONT),
+ * the shader id excepted, see sortRenderPasses.
+ */
+uint64_t getSortKey(const RenderPass &renderPass, RenderQueueSortMode mode);
+
+// buffers reused by sortRenderPasses, kept across frames to avoid reallocation
+struct RenderPassSortScratch {
+    ccstd::vector<uint64_t> keys;
+    ccstd::vector<uint64_t> keysTemp;
+    ccstd::vector<uint32_t> indices;
+    ccstd::vector<uint32_t> indicesTemp;
+    RenderPassList queue;
+};
+
+/**
+ * Radix sorts the passes by their sort keys, then by shader id.
+ * @param keys The sort key of each pass, in the same order as queue.
+ */
+void sortRenderPasses(RenderPassList &queue, const ccstd::vector<uint64_t> &keys, RenderPassSortScratch &scratch);
+
+} // namespace pipeline
+} // namespace cc
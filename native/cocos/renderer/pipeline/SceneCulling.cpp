@@ -23,6 +23,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <cstring>
 #include "base/std/container/array.h"
 
 #include "Define.h"
@@ -34,6 +35,7 @@
 #include "core/geometry/Intersect.h"
 #include "core/geometry/Sphere.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "math/Quaternion.h"
 #include "profiler/Profiler.h"
 #include "scene/Camera.h"
@@ -93,39 +95,46 @@ void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Cam
     }
 }
 
-// Todo If you want to optimize the cutting efficiency, you can get it from the octree
-void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera, ShadowTransformInfo *layer) {
-    const auto *sceneData = pipeline->getPipelineSceneData();
-    auto *csmLayers = sceneData->getCSMLayers();
-    const auto *const scene = camera->getScene();
-    const auto *mainLight = scene->getMainLight();
-
-    layer->clearShadowObjects();
-    for (size_t i = 0; i < csmLayers->getLayerObjects().size(); ++i) {
-        const auto *model = csmLayers->getLayerObjects()[i].model;
-        // filter model by view visibility
-        if (model->isEnabled()) {
-            const uint32_t visibility = camera->getVisibility();
-            const auto *node = model->getNode();
-            if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                // frustum culling
-                const bool accurate = model->getWorldBounds()->aabbFrustum(layer->getValidFrustum());
-                if (accurate) {
-                    layer->addShadowObject(genRenderObject(model, camera));
-                    if (layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel())) {
-                        if (static_cast<uint32_t>(mainLight->getCSMOptimizationMode()) == 2 &&
-                            aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum())) {
-                            csmLayers->getLayerObjects().erase(csmLayers->getLayerObjects().begin() + static_cast<uint32_t>(i));
-                            i--;
-                        }
-                    }
-                }
-            }
-        }
+namespace {
+
+// models are culled chunk by chunk against every view, so the bounds of a chunk stay in cache
+constexpr uint32_t CULLING_CHUNK_SIZE = 256;
+
+enum class CullingViewType {
+    CAMERA,
+    CSM_LAYER,
+    SPOT_SHADOW,
+};
+
+struct CullingView {
+    CullingViewType type{CullingViewType::CAMERA};
+    ccstd::array<float, 24> planes{};
+    const geometry::Frustum *frustum{nullptr};
+    ShadowTransformInfo *layer{nullptr};
+    RenderObjectList *objects{nullptr};
+};
+
+void packFrustumPlanes(const geometry::Frustum &frustum, ccstd::array<float, 24> &planes) {
+    for (uint32_t i = 0; i < 6; ++i) {
+        const auto *plane = frustum.planes[i];
+        planes[i * 4 + 0] = plane->n.x;
+        planes[i * 4 + 1] = plane->n.y;
+        planes[i * 4 + 2] = plane->n.z;
+        planes[i * 4 + 3] = plane->d;
     }
 }
 
+void addCullingView(ccstd::vector<CullingView> &views, CullingViewType type, const geometry::Frustum &frustum, RenderObjectList *objects, ShadowTransformInfo *layer = nullptr) {
+    CullingView &view = views.emplace_back();
+    view.type = type;
+    view.frustum = &frustum;
+    view.layer = layer;
+    view.objects = objects;
+    packFrustumPlanes(frustum, view.planes);
+}
+
+} // namespace
+
 void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     CC_PROFILE(SceneCulling);
     PipelineSceneData *const sceneData = pipeline->getPipelineSceneData();
@@ -134,8 +143,9 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     const scene::Skybox *skyBox = sceneData->getSkybox();
     const scene::RenderScene *const scene = camera->getScene();
     scene::DirectionalLight *mainLight = scene->getMainLight();
+    const bool shadowMapEnabled = shadowInfo != nullptr && shadowInfo->isEnabled() && shadowInfo->getType() == scene::ShadowType::SHADOW_MAP;
 
-    if (shadowInfo != nullptr && shadowInfo->isEnabled() && shadowInfo->getType() == scene::ShadowType::SHADOW_MAP) {
+    if (shadowMapEnabled) {
         // update dirLightFrustum
         if (mainLight && mainLight->getNode()) {
             csmLayers->update(sceneData, camera);
@@ -143,6 +153,7 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     }
 
     sceneData->clearRenderObjects();
+    sceneData->clearSpotLightShadowObjects();
     csmLayers->clearCastShadowObjects();
     csmLayers->clearLayerObjects();
 
@@ -150,63 +161,213 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
         sceneData->addRenderObject(genRenderObject(skyBox->getModel(), camera));
     }
 
+    const auto &models = scene->getModels();
+    const auto &modelBounds = scene->getModelBounds();
+    const uint32_t modelCount = modelBounds.size();
+    const auto visibility = camera->getVisibility();
+    const auto isVisible = [&](uint32_t i) {
+        const uint32_t layer = modelBounds.layers[i];
+        return ((modelBounds.flags[i] & scene::ModelBoundsTable::HAS_NODE) && ((visibility & layer) == layer)) ||
+               (visibility & modelBounds.visFlags[i]);
+    };
+
+    // Gather every view that needs a visibility list: the camera itself (unless the octree handles it),
+    // the active CSM layers and the frusta of shadow casting spot lights.
     const scene::Octree *octree = scene->getOctree();
-    if (octree && octree->isEnabled()) {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
+    const bool useOctree = octree && octree->isEnabled();
+    ccstd::vector<CullingView> views;
+    if (!useOctree) {
+        addCullingView(views, CullingViewType::CAMERA, camera->getFrustum(), nullptr);
+    }
+    const bool removeDuplicates = mainLight && mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES;
+    // CSM layers only keep models visible to the camera, so for cameras that see no model, like UI cameras,
+    // the layers are reset but not culled. Spot light shadows don't depend on the camera and are always culled.
+    bool cameraSeesModels = false;
+    for (uint32_t i = 0; shadowMapEnabled && !cameraSeesModels && i < modelCount; ++i) {
+        cameraSeesModels = (modelBounds.flags[i] & scene::ModelBoundsTable::ENABLED) && isVisible(i);
+    }
+    const auto addLayerView = [&](ShadowTransformInfo *layer) {
+        if (cameraSeesModels) {
+            addCullingView(views, CullingViewType::CSM_LAYER, layer->getValidFrustum(), &layer->getShadowObjects(), layer);
+        }
+    };
+    if (shadowMapEnabled && mainLight && mainLight->getNode() && mainLight->isShadowEnabled()) {
+        if (mainLight->isShadowFixedArea()) {
+            ShadowTransformInfo *layer = csmLayers->getSpecialLayer();
+            layer->clearShadowObjects();
+            addLayerView(layer);
+        } else {
+            const auto level = sceneData->getCSMSupported() ? static_cast<uint32_t>(mainLight->getCSMLevel()) : 1U;
+            for (uint32_t i = 0; i < level; ++i) {
+                ShadowTransformInfo *layer = csmLayers->getLayers()[i];
+                layer->clearShadowObjects();
+                addLayerView(layer);
+            }
+        }
+    }
+    if (shadowMapEnabled) {
+        for (const auto *light : sceneData->getValidPunctualLights()) {
+            if (light->getType() == scene::LightType::SPOT) {
+                const auto *spotLight = static_cast<const scene::SpotLight *>(light);
+                if (spotLight->isShadowEnabled()) {
+                    addCullingView(views, CullingViewType::SPOT_SHADOW, spotLight->getFrustum(), &sceneData->addSpotLightShadowObjects(light));
                 }
+            }
+        }
+    }
 
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
+    // Single pass over the model bounds, every chunk is tested against all the views.
+    const float *const bounds[6] = {
+        modelBounds.bounds[0].data(), modelBounds.bounds[1].data(), modelBounds.bounds[2].data(),
+        modelBounds.bounds[3].data(), modelBounds.bounds[4].data(), modelBounds.bounds[5].data()};
+    ccstd::array<uint32_t, CULLING_CHUNK_SIZE> visibleIndices;
+    ccstd::array<RenderObject, CULLING_CHUNK_SIZE> renderObjects;
+    ccstd::array<bool, CULLING_CHUNK_SIZE> renderObjectReady;
+    ccstd::array<bool, CULLING_CHUNK_SIZE> completelyInsideLayer;
+    // render objects only depend on the camera, generate them once per model for all the lists
+    const auto getRenderObject = [&](uint32_t begin, uint32_t i) -> const RenderObject & {
+        const uint32_t local = i - begin;
+        if (!renderObjectReady[local]) {
+            renderObjects[local] = genRenderObject(models[i], camera);
+            renderObjectReady[local] = true;
+        }
+        return renderObjects[local];
+    };
 
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
+    // Chunks whose models did not move reuse the camera culling results of the previous frame,
+    // as long as the camera and the scene layout did not change either.
+    auto &cache = camera->getVisibilityCache();
+    const bool useCache = !useOctree && sceneData->isVisibilityCacheEnabled();
+    const bool cacheValid = useCache && cache.valid && cache.scene == scene &&
+                            cache.layoutVersion == modelBounds.layoutVersion &&
+                            memcmp(cache.matViewProj.m, camera->getMatViewProj().m, sizeof(cache.matViewProj.m)) == 0;
+    const uint32_t chunkCount = (modelCount + CULLING_CHUNK_SIZE - 1) / CULLING_CHUNK_SIZE;
+    uint32_t revalidateBegin = 0;
+    uint32_t revalidateCount = 0;
+    if (useCache) {
+        if (!cacheValid) {
+            cache.visible.assign(modelCount, 0);
+            cache.depths.assign(modelCount, 0.F);
+        }
+        // a round-robin slice of chunks is re-culled every frame even if it looks unchanged
+        revalidateCount = std::min(sceneData->getVisibilityCacheRevalidateChunks(), chunkCount);
+        revalidateBegin = chunkCount ? cache.revalidateCursor % chunkCount : 0;
+        cache.revalidateCursor = revalidateBegin + revalidateCount;
+    } else {
+        cache.valid = false;
+    }
 
-                    if (!modelWorldBounds && (skyBox == nullptr || skyBox->getModel() != model)) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
+    for (uint32_t begin = 0; begin < modelCount; begin += CULLING_CHUNK_SIZE) {
+        const uint32_t count = std::min(CULLING_CHUNK_SIZE, modelCount - begin);
+        const uint32_t end = begin + count;
+        const float *const chunkBounds[6] = {bounds[0] + begin, bounds[1] + begin, bounds[2] + begin, bounds[3] + begin, bounds[4] + begin, bounds[5] + begin};
+        renderObjectReady.fill(false);
+        completelyInsideLayer.fill(false);
+
+        bool chunkFromCache = cacheValid && (begin / CULLING_CHUNK_SIZE + chunkCount - revalidateBegin) % chunkCount >= revalidateCount;
+        for (uint32_t i = begin; chunkFromCache && i < end; ++i) {
+            chunkFromCache = modelBounds.boundsFrames[i] <= cache.frame;
+        }
+        if (chunkFromCache) {
+            // the depth of models without bounds may change without notice, so it is never cached
+            for (uint32_t i = begin; i < end; ++i) {
+                if (cache.visible[i] && (modelBounds.flags[i] & scene::ModelBoundsTable::HAS_BOUNDS)) {
+                    renderObjects[i - begin] = {cache.depths[i], models[i]};
+                    renderObjectReady[i - begin] = true;
                 }
             }
         }
 
-        ccstd::vector<scene::Model *> models;
-        models.reserve(scene->getModels().size() / 4);
-        octree->queryVisibility(camera, camera->getFrustum(), false, models);
-        for (const auto *model : models) {
-            sceneData->addRenderObject(genRenderObject(model, camera));
+        // cast shadow render Object
+        for (uint32_t i = begin; i < end; ++i) {
+            const auto flags = modelBounds.flags[i];
+            if ((flags & scene::ModelBoundsTable::ENABLED) && (flags & scene::ModelBoundsTable::CAST_SHADOW)) {
+                csmLayers->addCastShadowObject(RenderObject(getRenderObject(begin, i)));
+            }
         }
-    } else {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
-
-                // cast shadow render Object
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
-                }
 
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
-                    if (!modelWorldBounds) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                        continue;
+        for (auto &view : views) {
+            if (view.type == CullingViewType::CAMERA && chunkFromCache) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    if (cache.visible[i] && (modelBounds.flags[i] & scene::ModelBoundsTable::ENABLED) && isVisible(i)) {
+                        sceneData->addRenderObject(RenderObject(getRenderObject(begin, i)));
                     }
+                }
+                continue;
+            }
 
-                    // frustum culling
-                    if (modelWorldBounds->aabbFrustum(camera->getFrustum())) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
+            // frustum culling, models without bounds always pass
+            const uint32_t visibleCount = MathUtil::cullAABBs(chunkBounds, count, view.planes.data(), 6, visibleIndices.data());
+            if (view.type == CullingViewType::CAMERA && useCache) {
+                std::fill(cache.visible.begin() + begin, cache.visible.begin() + end, 0);
+                for (uint32_t j = 0; j < visibleCount; ++j) {
+                    const uint32_t i = begin + visibleIndices[j];
+                    cache.visible[i] = 1;
+                    cache.depths[i] = getRenderObject(begin, i).depth;
                 }
             }
+
+            for (uint32_t j = 0; j < visibleCount; ++j) {
+                const uint32_t i = begin + visibleIndices[j];
+                const auto flags = modelBounds.flags[i];
+                if (!(flags & scene::ModelBoundsTable::ENABLED)) {
+                    continue;
+                }
+
+                switch (view.type) {
+                    case CullingViewType::CAMERA:
+                        // filter model by view visibility
+                        if (isVisible(i)) {
+                            sceneData->addRenderObject(RenderObject(getRenderObject(begin, i)));
+                        }
+                        break;
+                    case CullingViewType::CSM_LAYER:
+                        // models completely inside a previous layer are skipped when removing duplicates
+                        if ((flags & scene::ModelBoundsTable::CAST_SHADOW) && (flags & scene::ModelBoundsTable::HAS_BOUNDS) &&
+                            !completelyInsideLayer[i - begin] && isVisible(i)) {
+                            view.objects->emplace_back(getRenderObject(begin, i));
+                            if (removeDuplicates && view.layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel()) &&
+                                aabbFrustumCompletelyInside(*models[i]->getWorldBounds(), *view.frustum)) {
+                                completelyInsideLayer[i - begin] = true;
+                            }
+                        }
+                        break;
+                    case CullingViewType::SPOT_SHADOW:
+                        if ((flags & scene::ModelBoundsTable::CAST_SHADOW) && (flags & scene::ModelBoundsTable::HAS_BOUNDS) &&
+                            (flags & scene::ModelBoundsTable::HAS_NODE)) {
+                            view.objects->emplace_back(getRenderObject(begin, i));
+                        }
+                        break;
+                }
+            }
+        }
+    }
+
+    if (useCache) {
+        cache.valid = true;
+        cache.scene = scene;
+        cache.layoutVersion = modelBounds.layoutVersion;
+        cache.frame = modelBounds.frame;
+        cache.matViewProj = camera->getMatViewProj();
+    }
+
+    if (useOctree) {
+        for (uint32_t i = 0; i < modelCount; ++i) {
+            // filter model by view visibility
+            const auto flags = modelBounds.flags[i];
+            if ((flags & scene::ModelBoundsTable::ENABLED) && !(flags & scene::ModelBoundsTable::HAS_BOUNDS) && isVisible(i)) {
+                const auto *model = models[i].get();
+                if (skyBox == nullptr || skyBox->getModel() != model) {
+                    sceneData->addRenderObject(genRenderObject(model, camera));
+                }
+            }
+        }
+
+        ccstd::vector<scene::Model *> octreeModels;
+        octreeModels.reserve(models.size() / 4);
+        octree->queryVisibility(camera, camera->getFrustum(), false, octreeModels);
+        for (const auto *model : octreeModels) {
+            sceneData->addRenderObject(genRenderObject(model, camera));
         }
     }
 
@@ -43,11 +43,9 @@ namespace pipeline {
 
 struct RenderObject;
 class RenderPipeline;
-class ShadowTransformInfo;
 
 RenderObject genRenderObject(const scene::Model *, const scene::Camera *);
 void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Camera *camera);
-void shadowCulling(const RenderPipeline *, const scene::Camera *, ShadowTransformInfo *);
 void sceneCulling(const RenderPipeline *, scene::Camera *);
 } // namespace pipeline
 } // namespace cc
@@ -72,7 +72,7 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
                         } else {
                             layer = csmLayers->getLayers()[level];
                         }
-                        shadowCulling(_pipeline, camera, layer);
+                        // the layer has been culled together with the camera in sceneCulling
                         const RenderObjectList &dirShadowObjects = layer->getShadowObjects();
                         for (const auto &ro : dirShadowObjects) {
                             add(ro.model);
@@ -82,9 +82,17 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
             } break;
             case scene::LightType::SPOT: {
                 const auto *spotLight = static_cast<const scene::SpotLight *>(light);
-                const RenderObjectList &castShadowObjects = csmLayers->getCastShadowObjects();
                 if (spotLight->isShadowEnabled()) {
-                    geometry::AABB ab;
+                    const RenderObjectList *spotShadowObjects = sceneData->getSpotLightShadowObjects(light);
+                    if (spotShadowObjects) {
+                        // the light has been culled together with the camera in sceneCulling
+                        for (const auto &ro : *spotShadowObjects) {
+                            add(ro.model);
+                        }
+                        break;
+                    }
+
+                    const RenderObjectList &castShadowObjects = csmLayers->getCastShadowObjects();
                     for (const auto &ro : castShadowObjects) {
                         const auto *model = ro.model;
                         if (!model->isEnabled() || !model->isCastShadow() || !model->getNode()) {
@@ -157,7 +165,8 @@ void ShadowMapBatchedQueue::recordCommandBuffer(gfx::Device *device, gfx::Render
         auto *const shader = _shaders[i];
         const auto *pass = _passes[i];
         auto *const ia = subModel->getInputAssembler();
-        auto *const pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
+        auto *const pso = PipelineStateManager::getPipelineStateIfReady(pass, shader, ia, renderPass);
+        if (!pso) continue;
 
         cmdBuffer->bindPipelineState(pso);
         cmdBuffer->bindDescriptorSet(materialSet, pass->getDescriptorSet());
@@ -54,7 +54,8 @@ void UIPhase::render(scene::Camera *camera, gfx::RenderPass *renderPass) {
             auto *shader = batch->getShaders()[i];
             auto *inputAssembler = batch->getInputAssembler();
             auto *ds = batch->getDescriptorSet();
-            auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass);
+            auto *pso = PipelineStateManager::getPipelineStateIfReady(pass, shader, inputAssembler, renderPass);
+            if (!pso) continue;
             cmdBuff->bindPipelineState(pso);
             cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
             cmdBuff->bindInputAssembler(inputAssembler);
@@ -128,6 +128,8 @@ void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     decideProfilerCamera(cameras);
 
     for (auto *camera : cameras) {
+        // sceneCulling builds the spot shadow views from the valid punctual lights
+        validPunctualLightsCulling(this, camera);
         sceneCulling(this, camera);
 
         if (_clusterEnabled) {
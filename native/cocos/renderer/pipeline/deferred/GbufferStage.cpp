@@ -34,6 +34,7 @@
 #include "../RenderQueue.h"
 #include "DeferredPipeline.h"
 #include "MainFlow.h"
+#include "base/job-system/JobSystem.h"
 #include "frame-graph/DevicePass.h"
 #include "frame-graph/DevicePassResourceTable.h"
 #include "frame-graph/Resource.h"
@@ -71,7 +72,7 @@ void GbufferStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint32_t phase = convertPhase(descriptor.stages);
         RenderQueueSortFunc sortFunc = convertQueueSortFunc(descriptor.sortMode);
-        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc, descriptor.sortMode};
         _renderQueues.emplace_back(ccnew RenderQueue(_pipeline, std::move(info), true));
     }
     _planarShadowQueue = ccnew PlanarShadowQueue(_pipeline);
@@ -141,6 +142,73 @@ void GbufferStage::recordCommands(DeferredPipeline *pipeline, scene::Camera *cam
     _batchedQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
 }
 
+void GbufferStage::planParallelRecording() {
+    _recordChunks.clear();
+    _recordChunkOffsets.clear();
+    _recordCommandBuffers.clear();
+    if (!_pipeline->isParallelCommandRecording()) return;
+
+    const ccstd::array<uint32_t, 3> counts = {_renderQueues[0]->size(), _instancedQueue->size(), _batchedQueue->size()};
+    if (counts[0] + counts[1] + counts[2] < PARALLEL_RECORDING_THRESHOLD) return;
+
+    // chunks index the instanced and batched queues by position, fix their order once for this frame
+    _instancedQueue->snapshot();
+    _batchedQueue->snapshot();
+
+    for (uint32_t queue = 0; queue < counts.size(); ++queue) {
+        for (uint32_t begin = 0; begin < counts[queue]; begin += PARALLEL_RECORDING_CHUNK_SIZE) {
+            _recordChunks.push_back({queue, begin, std::min(begin + PARALLEL_RECORDING_CHUNK_SIZE, counts[queue])});
+        }
+    }
+
+    // contiguous chunks per command buffer keep the draw order of each queue
+    const auto chunkCount = utils::toUint(_recordChunks.size());
+    const uint32_t cmdBuffCount = std::min(JobSystem::getInstance()->threadCount() + 1, chunkCount);
+    for (uint32_t i = 0; i <= cmdBuffCount; ++i) {
+        _recordChunkOffsets.push_back(i * chunkCount / cmdBuffCount);
+    }
+    const auto &cmdBuffs = _pipeline->getSecondaryCommandBuffers(cmdBuffCount);
+    _recordCommandBuffers.assign(cmdBuffs.begin(), cmdBuffs.begin() + cmdBuffCount);
+}
+
+void GbufferStage::recordCommandsParallel(DeferredPipeline *pipeline, scene::Camera *camera, const framegraph::DevicePassResourceTable &table) {
+    const auto &cmdBuffs = *table.getSecondaryCommandBuffers();
+    auto *renderPass = table.getRenderPass();
+    const uint32_t subpassIndex = table.getSubpassIndex();
+    const ccstd::array<uint32_t, 1> globalOffsets = {_pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
+
+    auto recordJob = [&](uint32_t index) {
+        auto *cmdBuff = cmdBuffs[index];
+        cmdBuff->begin(renderPass, subpassIndex);
+        cmdBuff->setViewport(table.getViewport());
+        cmdBuff->setScissor(table.getScissor());
+        cmdBuff->bindDescriptorSet(globalSet, pipeline->getDescriptorSet(), utils::toUint(globalOffsets.size()), globalOffsets.data());
+
+        for (uint32_t i = _recordChunkOffsets[index]; i < _recordChunkOffsets[index + 1]; ++i) {
+            const auto &chunk = _recordChunks[i];
+            switch (chunk.queue) {
+                case 0:
+                    _renderQueues[0]->recordCommandBuffer(_device, camera, renderPass, cmdBuff, subpassIndex, chunk.begin, chunk.end);
+                    break;
+                case 1:
+                    _instancedQueue->recordCommandBuffer(_device, renderPass, cmdBuff, nullptr, 0, nullptr, chunk.begin, chunk.end);
+                    break;
+                default:
+                    _batchedQueue->recordCommandBuffer(_device, renderPass, cmdBuff, nullptr, 0, nullptr, chunk.begin, chunk.end);
+                    break;
+            }
+        }
+        cmdBuff->end();
+    };
+
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, utils::toUint(cmdBuffs.size()), 1U, recordJob);
+    g.run();
+    g.waitForAll();
+
+    pipeline->getCommandBuffers()[0]->execute(cmdBuffs.data(), utils::toUint(cmdBuffs.size()));
+}
+
 void GbufferStage::render(scene::Camera *camera) {
     CC_PROFILE(GbufferStageRender);
     struct RenderData {
@@ -223,10 +291,18 @@ void GbufferStage::render(scene::Camera *camera) {
 
         // viewport setup
         builder.setViewport(pipeline->getViewport(camera), pipeline->getScissor(camera));
+
+        if (!_recordCommandBuffers.empty()) {
+            builder.setSecondaryCommandBuffers(_recordCommandBuffers);
+        }
     };
 
     auto gbufferExec = [this, camera](const RenderData & /*data*/, const framegraph::DevicePassResourceTable &table) {
-        recordCommands(static_cast<DeferredPipeline *>(_pipeline), camera, table.getRenderPass());
+        if (table.getSecondaryCommandBuffers()) {
+            recordCommandsParallel(static_cast<DeferredPipeline *>(_pipeline), camera, table);
+        } else {
+            recordCommands(static_cast<DeferredPipeline *>(_pipeline), camera, table.getRenderPass());
+        }
     };
 
     // Command 'updateBuffer' must be recorded outside render passes, cannot put them in execute lambda
@@ -234,6 +310,7 @@ void GbufferStage::render(scene::Camera *camera) {
     auto *cmdBuff = pipeline->getCommandBuffers()[0];
     _instancedQueue->uploadBuffers(cmdBuff);
     _batchedQueue->uploadBuffers(cmdBuff);
+    planParallelRecording();
 
     // if empty == true, gbuffer and lightig passes will be ignored
     bool empty = _renderQueues[0]->empty() && _instancedQueue->empty() && _batchedQueue->empty();
@@ -31,6 +31,9 @@ namespace cc {
 namespace scene {
 class Camera;
 }
+namespace framegraph {
+class DevicePassResourceTable;
+}
 namespace pipeline {
 
 class RenderFlow;
@@ -57,12 +60,29 @@ public:
 private:
     void dispenseRenderObject2Queues();
     void recordCommands(DeferredPipeline *pipeline, scene::Camera *camera, gfx::RenderPass *renderPass);
+    void planParallelRecording();
+    void recordCommandsParallel(DeferredPipeline *pipeline, scene::Camera *camera, const framegraph::DevicePassResourceTable &table);
+
+    // a slice of one of the queues, recorded into a single secondary command buffer
+    struct RecordChunk {
+        uint32_t queue{0};
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
+    // below this many queue items recording inline is cheaper than dispatching jobs
+    static constexpr uint32_t PARALLEL_RECORDING_THRESHOLD = 256;
+    static constexpr uint32_t PARALLEL_RECORDING_CHUNK_SIZE = 64;
 
     static RenderStageInfo initInfo;
     PlanarShadowQueue *_planarShadowQueue = nullptr;
     RenderBatchedQueue *_batchedQueue = nullptr;
     RenderInstancedQueue *_instancedQueue = nullptr;
     uint32_t _phaseID = 0;
+    ccstd::vector<RecordChunk> _recordChunks;
+    // chunks [_recordChunkOffsets[i], _recordChunkOffsets[i + 1]) go to the i-th secondary command buffer
+    ccstd::vector<uint32_t> _recordChunkOffsets;
+    gfx::CommandBufferList _recordCommandBuffers;
 };
 
 } // namespace pipeline
@@ -272,7 +272,7 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint32_t phase = convertPhase(descriptor.stages);
         RenderQueueSortFunc sortFunc = convertQueueSortFunc(descriptor.sortMode);
-        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc, descriptor.sortMode};
         _renderQueues.emplace_back(ccnew RenderQueue(_pipeline, std::move(info), true));
     }
 
@@ -292,7 +292,7 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     _planarShadowQueue = ccnew PlanarShadowQueue(_pipeline);
 
     // create reflection resource
-    RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn};
+    RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn, RenderQueueSortMode::BACK_TO_FRONT};
     _reflectionComp = ccnew ReflectionComp();
     _reflectionComp->init(_device, 8, 8);
 
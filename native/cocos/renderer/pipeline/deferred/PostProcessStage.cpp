@@ -92,7 +92,7 @@ void PostProcessStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
                 break;
         }
 
-        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc, descriptor.sortMode};
         _renderQueues.emplace_back(ccnew RenderQueue(_pipeline, std::move(info)));
     }
 }
@@ -152,6 +152,22 @@ struct ICameraInfo {
     CameraUsage usage{CameraUsage::GAME};
 };
 
+/**
+ * Frustum culling results of a camera kept across frames, see pipeline::sceneCulling.
+ * Entries are indexed like RenderScene::getModels() and are only valid while the scene layout,
+ * the camera view projection and the bounds of the models stay unchanged.
+ */
+struct CameraVisibilityCache {
+    const RenderScene *scene{nullptr};
+    uint32_t layoutVersion{0};
+    uint32_t frame{0};
+    uint32_t revalidateCursor{0};
+    Mat4 matViewProj;
+    bool valid{false};
+    ccstd::vector<uint8_t> visible;
+    ccstd::vector<float> depths;
+};
+
 class Camera : public RefCounted {
 public:
     static constexpr int32_t SKYBOX_FLAG{static_cast<int32_t>(gfx::ClearFlagBit::STENCIL) << 1};
@@ -365,6 +381,8 @@ public:
     inline bool isCullingEnabled() const { return _isCullingEnabled; }
     inline void setCullingEnable(bool val) { _isCullingEnabled = val; }
 
+    inline CameraVisibilityCache &getVisibilityCache() { return _visibilityCache; }
+
 protected:
     void setExposure(float ev100);
 
@@ -432,6 +450,8 @@ private:
 
     uint32_t _systemWindowId{0};
 
+    CameraVisibilityCache _visibilityCache;
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(Camera);
 };
 
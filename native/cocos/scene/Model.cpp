@@ -223,9 +223,18 @@ void Model::updateUBOs(uint32_t stamp) {
         }
     }
 
+    updateSubModels();
+    prepareUBOs(stamp);
+    uploadUBOs();
+}
+
+void Model::updateSubModels() {
     for (SubModel *subModel : _subModels) {
         subModel->update();
     }
+}
+
+void Model::prepareUBOs(uint32_t stamp) {
     _updateStamp = stamp;
     if (!_localDataUpdated) {
         return;
@@ -243,11 +252,19 @@ void Model::updateUBOs(uint32_t stamp) {
         Mat4::inverseTranspose(worldMatrix, &mat4);
 
         mat4ToFloat32Array(mat4, _localData, pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->update(_localData.buffer()->getData());
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+        _localBufferDirty = true;
+    }
+}
+
+void Model::uploadUBOs() {
+    if (!_localBufferDirty) {
+        return;
+    }
+    _localBufferDirty = false;
+    _localBuffer->update(_localData.buffer()->getData());
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    if (pipeline && pipeline->isOcclusionQueryEnabled()) {
+        updateWorldBoundUBOs();
     }
 }
 
@@ -82,6 +82,12 @@ public:
     virtual void updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, Pass *pass);
     virtual void updateTransform(uint32_t stamp);
     virtual void updateUBOs(uint32_t stamp);
+    // First part of updateUBOs, updates the passes and descriptor sets of the sub models on the thread submitting to the device
+    void updateSubModels();
+    // CPU part of updateUBOs, may run on a worker thread once the world transform of the model node is up to date
+    virtual void prepareUBOs(uint32_t stamp);
+    // GPU part of updateUBOs, must run on the thread submitting to the device
+    virtual void uploadUBOs();
     virtual void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
     virtual void updateWorldBoundDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
 
@@ -160,6 +166,7 @@ public:
     inline uint32_t getUpdateStamp() const { return _updateStamp; }
     inline Layers::Enum getVisFlags() const { return _visFlags; }
     inline geometry::AABB *getWorldBounds() const { return _worldBounds; }
+    inline bool isWorldBoundsDirty() const { return _worldBoundsDirty; }
     inline Type getType() const { return _type; };
     inline void setType(Type type) { _type = type; }
     inline OctreeNode *getOctreeNode() const { return _octreeNode; }
@@ -227,6 +234,7 @@ protected:
     bool _isDynamicBatching{false};
     bool _inited{false};
     bool _localDataUpdated{false};
+    bool _localBufferDirty{false};
     bool _worldBoundsDirty{true};
     // For JS
     bool _isCalledFromJS{false};
@@ -24,8 +24,8 @@
  ****************************************************************************/
 
 #include "Octree.h"
-#include <future>
 #include <utility>
+#include "base/job-system/JobSystem.h"
 #include "scene/Camera.h"
 #include "scene/Model.h"
 
@@ -63,6 +63,13 @@ void OctreeInfo::setDepth(uint32_t val) {
     }
 }
 
+void OctreeInfo::setLooseFactor(float val) {
+    _looseFactor = val;
+    if (_resource) {
+        _resource->setLooseFactor(val);
+    }
+}
+
 void OctreeInfo::activate(Octree *resource) {
     _resource = resource;
     _resource->initialize(*this);
@@ -97,6 +104,11 @@ OctreeNode::~OctreeNode() {
     }
 }
 
+void OctreeNode::setBox(const BBox &aabb) {
+    _aabb = aabb;
+    _looseBox = aabb.scale(_owner->getLooseFactor());
+}
+
 BBox OctreeNode::getChildBox(uint32_t index) const {
     cc::Vec3 min = _aabb.min;
     cc::Vec3 max = _aabb.max;
@@ -153,7 +165,8 @@ void OctreeNode::insert(Model *model) { // NOLINT(misc-no-recursion)
         index += modelCenter.y < nodeCenter.y ? 0 : 2;
         index += modelCenter.z < nodeCenter.z ? 0 : 4;
 
-        BBox childBox = getChildBox(index);
+        // the model goes to the child containing its center if it fits in the child's (loose) bounds
+        BBox childBox = getChildBox(index).scale(_owner->getLooseFactor());
         if (childBox.contain(modelBox)) {
             split = true;
 
@@ -250,38 +263,41 @@ void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum
     }
 }
 
-void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
+bool OctreeNode::intersectFrustum(const geometry::Frustum &frustum) const {
     geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
+    geometry::AABB::fromPoints(_looseBox.min, _looseBox.max, &box);
+    return box.aabbFrustum(frustum);
+}
+
+void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
+    if (!intersectFrustum(frustum)) {
         return;
     }
 
-    ccstd::array<std::future<ccstd::vector<Model *>>, OCTREE_CHILDREN_NUM> futures{};
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
+    // every child subtree is queried by a job into its own buffer, the buffers are merged in child order.
+    // the buffers belong to this query so concurrent queries on the same octree do not share them
+    ccstd::array<ccstd::vector<Model *>, OCTREE_CHILDREN_NUM> childResults;
+    auto queryChild = [&](uint32_t i) {
         if (_children[i]) {
-            futures[i] = std::async(std::launch::async, [=, &frustum] {
-                ccstd::vector<Model *> models;
-                _children[i]->queryVisibilitySequentially(camera, frustum, isShadow, models);
-                return models;
-            });
+            _children[i]->queryVisibilitySequentially(camera, frustum, isShadow, childResults[i]);
         }
-    }
+    };
+
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, OCTREE_CHILDREN_NUM, 1U, queryChild);
+    g.run();
 
     doQueryVisibility(camera, frustum, isShadow, results);
 
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            auto models = futures[i].get();
-            results.insert(results.end(), models.begin(), models.end());
-        }
+    g.waitForAll();
+
+    for (const auto &models : childResults) {
+        results.insert(results.end(), models.begin(), models.end());
     }
 }
 
 void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const { // NOLINT(misc-no-recursion)
-    geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
+    if (!intersectFrustum(frustum)) {
         return;
     }
 
@@ -311,6 +327,7 @@ void Octree::initialize(const OctreeInfo &info) {
     _minPos = info.getMinPos();
     _maxPos = info.getMaxPos();
     _maxDepth = std::max(info.getDepth(), 1U);
+    _looseFactor = std::max(info.getLooseFactor(), 1.0F);
     setEnabled(info.isEnabled());
     _root->setBox(BBox{_minPos - expand, _maxPos});
     _root->setDepth(0);
@@ -336,6 +353,16 @@ void Octree::setMaxDepth(uint32_t val) {
     _maxDepth = val;
 }
 
+void Octree::setLooseFactor(float val) {
+    val = std::max(val, 1.0F);
+    if (_looseFactor == val) {
+        return;
+    }
+
+    _looseFactor = val;
+    rebuild(_root->getBox());
+}
+
 void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
     const Vec3 expand{OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE};
     BBox rootBox = _root->getBox();
@@ -343,19 +370,23 @@ void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
         return;
     }
 
+    _maxDepth = std::max(maxDepth, 1U);
+    rebuild(BBox{minPos - expand, maxPos});
+}
+
+void Octree::rebuild(const BBox &rootBox) {
     ccstd::vector<Model *> models;
     _root->gatherModels(models);
 
     delete _root;
     _root = ccnew OctreeNode(this, nullptr);
-    _root->setBox(BBox{minPos - expand, maxPos});
+    _root->setBox(rootBox);
     _root->setDepth(0);
     _root->setIndex(0);
 
-    _maxDepth = std::max(maxDepth, 1U);
-
     for (auto *model : models) {
         model->setOctreeNode(nullptr);
+        _totalCount--;
         insert(model);
     }
 }
@@ -391,6 +422,13 @@ void Octree::remove(Model *model) {
 }
 
 void Octree::update(Model *model) {
+    // in a loose octree the model keeps its node as long as it stays inside the node's loose bounds
+    const OctreeNode *node = model->getOctreeNode();
+    if (isLoose() && node && model->getWorldBounds() &&
+        node->getLooseBox().contain(BBox(*model->getWorldBounds()))) {
+        return;
+    }
+
     insert(model);
 }
 
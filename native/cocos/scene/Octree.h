@@ -43,7 +43,8 @@ constexpr int DEFAULT_OCTREE_DEPTH = 8;
 const Vec3 DEFAULT_WORLD_MIN_POS = {-1024.0F, -1024.0F, -1024.0F};
 const Vec3 DEFAULT_WORLD_MAX_POS = {1024.0F, 1024.0F, 1024.0F};
 const float OCTREE_BOX_EXPAND_SIZE = 10.0F;
-constexpr int USE_MULTI_THRESHOLD = 1024; // use parallel culling if greater than this value
+constexpr float DEFAULT_OCTREE_LOOSE_FACTOR = 1.0F; // 1 means a tight octree, loose octrees usually use 2
+constexpr int USE_MULTI_THRESHOLD = 1024;          // use parallel culling if greater than this value
 
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
@@ -77,6 +78,13 @@ public:
     void setDepth(uint32_t val);
     inline uint32_t getDepth() const { return _depth; }
 
+    /**
+     * @en Scale of the node bounds used for insertion and culling, values greater than 1 enable a loose octree
+     * @zh 节点包围盒的松散系数，大于 1 时启用松散八叉树
+     */
+    void setLooseFactor(float val);
+    inline float getLooseFactor() const { return _looseFactor; }
+
     void activate(Octree *resource);
 
     // JS deserialization require the properties to be public
@@ -85,6 +93,7 @@ public:
     Vec3 _minPos{DEFAULT_WORLD_MIN_POS};
     Vec3 _maxPos{DEFAULT_WORLD_MAX_POS};
     uint32_t _depth{DEFAULT_OCTREE_DEPTH};
+    float _looseFactor{DEFAULT_OCTREE_LOOSE_FACTOR};
 
 private:
     Octree *_resource{nullptr};
@@ -109,6 +118,13 @@ struct CC_DLL BBox final {
         return (min + max) * 0.5F;
     }
 
+    // scale the box around its center
+    inline BBox scale(float factor) const {
+        const cc::Vec3 center = getCenter();
+        const cc::Vec3 halfExtents = (max - min) * (0.5F * factor);
+        return {center - halfExtents, center + halfExtents};
+    }
+
     inline bool operator==(const BBox &box) const {
         return min == box.min && max == box.max;
     }
@@ -138,12 +154,13 @@ private:
     OctreeNode(Octree *owner, OctreeNode *parent);
     ~OctreeNode();
 
-    inline void setBox(const BBox &aabb) { _aabb = aabb; }
+    void setBox(const BBox &aabb);
     inline void setDepth(uint32_t depth) { _depth = depth; }
     inline void setIndex(uint32_t index) { _index = index; }
 
     inline Octree *getOwner() const { return _owner; }
     inline const BBox &getBox() const { return _aabb; }
+    inline const BBox &getLooseBox() const { return _looseBox; }
     BBox getChildBox(uint32_t index) const;
     OctreeNode *getOrCreateChild(uint32_t index);
     void deleteChild(uint32_t index);
@@ -154,6 +171,7 @@ private:
     void gatherModels(ccstd::vector<Model *> &results) const;
     void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
     void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
+    bool intersectFrustum(const geometry::Frustum &frustum) const;
     void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
 
     Octree *_owner{nullptr};
@@ -161,6 +179,7 @@ private:
     ccstd::array<OctreeNode *, OCTREE_CHILDREN_NUM> _children{};
     ccstd::vector<Model *> _models;
     BBox _aabb{};
+    BBox _looseBox{};
     uint32_t _depth{0};
     uint32_t _index{0};
 
@@ -218,16 +237,29 @@ public:
     // return octree depth
     inline uint32_t getMaxDepth() const { return _maxDepth; }
 
+    /**
+     * @en Scale of the node bounds, values greater than 1 enable a loose octree.
+     * Models in a loose octree only move between nodes when they leave the loose bounds of their node.
+     * @zh 节点包围盒的松散系数，大于 1 时启用松散八叉树
+     */
+    void setLooseFactor(float val);
+    inline float getLooseFactor() const { return _looseFactor; }
+    inline bool isLoose() const { return _looseFactor > 1.0F; }
+
     // view frustum culling
     void queryVisibility(Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
 
 private:
     bool isInside(Model *model) const;
     bool isOutside(Model *model) const;
+    void rebuild(const BBox &rootBox);
 
     OctreeNode *_root{nullptr};
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t _totalCount{0};
+    float _looseFactor{DEFAULT_OCTREE_LOOSE_FACTOR};
+
+    friend class OctreeNode;
 
     bool _enabled{false};
     Vec3 _minPos;
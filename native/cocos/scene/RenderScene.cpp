@@ -26,12 +26,16 @@
 #include "scene/RenderScene.h"
 #include "scene/Camera.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <utility>
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformStore.h"
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -45,6 +49,84 @@
 
 namespace cc {
 namespace scene {
+
+void ModelBoundsTable::add(const Model *model) {
+    for (auto &arr : bounds) {
+        arr.emplace_back(0.F);
+    }
+    layers.emplace_back(0);
+    visFlags.emplace_back(0);
+    flags.emplace_back(0);
+    boundsFrames.emplace_back(frame);
+    ++layoutVersion;
+
+    const index_t idx = size() - 1;
+    updateBounds(idx, model);
+    updateFlags(idx, model);
+}
+
+void ModelBoundsTable::erase(index_t idx) {
+    for (auto &arr : bounds) {
+        arr.erase(arr.begin() + idx);
+    }
+    layers.erase(layers.begin() + idx);
+    visFlags.erase(visFlags.begin() + idx);
+    flags.erase(flags.begin() + idx);
+    boundsFrames.erase(boundsFrames.begin() + idx);
+    ++layoutVersion;
+}
+
+void ModelBoundsTable::clear() {
+    for (auto &arr : bounds) {
+        arr.clear();
+    }
+    layers.clear();
+    visFlags.clear();
+    flags.clear();
+    boundsFrames.clear();
+    ++layoutVersion;
+}
+
+void ModelBoundsTable::updateBounds(index_t idx, const Model *model) {
+    boundsFrames[idx] = frame;
+    const auto *worldBounds = model->getWorldBounds();
+    if (worldBounds) {
+        const Vec3 &center = worldBounds->getCenter();
+        const Vec3 &halfExtents = worldBounds->getHalfExtents();
+        bounds[0][idx] = center.x;
+        bounds[1][idx] = center.y;
+        bounds[2][idx] = center.z;
+        bounds[3][idx] = halfExtents.x;
+        bounds[4][idx] = halfExtents.y;
+        bounds[5][idx] = halfExtents.z;
+        flags[idx] |= HAS_BOUNDS;
+    } else {
+        // Models without bounds are never culled.
+        for (index_t i = 0; i < 3; ++i) {
+            bounds[i][idx] = 0.F;
+            bounds[i + 3][idx] = FLT_MAX;
+        }
+        flags[idx] &= static_cast<uint8_t>(~HAS_BOUNDS);
+    }
+}
+
+void ModelBoundsTable::updateFlags(index_t idx, const Model *model) {
+    uint8_t value = flags[idx] & HAS_BOUNDS;
+    if (model->isEnabled()) {
+        value |= ENABLED;
+    }
+    if (model->isCastShadow()) {
+        value |= CAST_SHADOW;
+    }
+    const auto *node = model->getNode();
+    if (node) {
+        value |= HAS_NODE;
+        layers[idx] = node->getLayer();
+    }
+    visFlags[idx] = static_cast<uint32_t>(model->getVisFlags());
+    flags[idx] = value;
+}
+
 RenderScene::RenderScene() = default;
 
 RenderScene::~RenderScene() = default;
@@ -66,6 +148,9 @@ void RenderScene::setMainLight(DirectionalLight *dl) {
 void RenderScene::update(uint32_t stamp) {
     CC_PROFILE(RenderSceneUpdate);
 
+    if (_transformStore) {
+        _transformStore->update();
+    }
     if (_mainLight) {
         _mainLight->update();
     }
@@ -75,17 +160,110 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &spotLight : _spotLights) {
         spotLight->update();
     }
-    for (const auto &model : _models) {
+    ++_modelBounds.frame;
+    bool parallel = _parallelUpdateEnabled && _models.size() >= PARALLEL_UPDATE_THRESHOLD && JobSystem::getInstance()->threadCount() > 1;
+    if (parallel) {
+        // disabled models are skipped by both paths, they don't count towards the threshold
+        const auto enabledCount = std::count_if(_models.begin(), _models.end(), [](const IntrusivePtr<Model> &model) { return model->isEnabled(); });
+        parallel = enabledCount >= PARALLEL_UPDATE_THRESHOLD;
+    }
+    if (parallel) {
+        updateModelsParallel(stamp);
+    } else {
+        updateModels(stamp);
+    }
+
+    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
+    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
+    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+}
+
+void RenderScene::updateModels(uint32_t stamp) {
+    for (index_t i = 0; i < _models.size(); ++i) {
+        Model *model = _models[i];
         if (model->isEnabled()) {
             model->updateTransform(stamp);
             model->updateUBOs(stamp);
+            if (model->isWorldBoundsDirty()) {
+                _modelBounds.updateBounds(i, model);
+            }
             model->updateOctree();
         }
+        _modelBounds.updateFlags(i, model);
     }
+}
 
-    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
-    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
-    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+void RenderScene::updateModelsParallel(uint32_t stamp) {
+    CC_PROFILE(RenderSceneUpdateModelsParallel);
+    // Serial pass: models implemented in JS are updated right away, the other ones update their sub models first as
+    // updateUBOs does, and get their node world transforms resolved here so that workers only read shared ancestors.
+    // Skinning models sharing a skinning root also share their joint transforms, they are kept together so that one
+    // worker walks them.
+    _updateOrder.clear();
+    _skinningModelOrder.clear();
+    for (index_t i = 0; i < _models.size(); ++i) {
+        Model *model = _models[i];
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (model->isModelImplementedInJS()) {
+            model->updateTransform(stamp);
+            model->updateUBOs(stamp);
+            continue;
+        }
+        model->updateSubModels();
+        Node *node = model->getTransform();
+        node->updateWorldTransform();
+        if (model->getType() == Model::Type::SKINNING) {
+            _skinningModelOrder.emplace_back(node, i);
+        } else {
+            _updateOrder.emplace_back(i);
+        }
+    }
+    std::sort(_skinningModelOrder.begin(), _skinningModelOrder.end());
+
+    _updateJobOffsets.clear();
+    for (index_t i = 0; i < _updateOrder.size(); i += MODELS_PER_UPDATE_JOB) {
+        _updateJobOffsets.emplace_back(i);
+    }
+    uint32_t jobSize = MODELS_PER_UPDATE_JOB;
+    for (index_t i = 0; i < _skinningModelOrder.size(); ++i) {
+        const bool sameRoot = i > 0 && _skinningModelOrder[i - 1].first == _skinningModelOrder[i].first;
+        if (jobSize >= MODELS_PER_UPDATE_JOB && !sameRoot) {
+            _updateJobOffsets.emplace_back(static_cast<uint32_t>(_updateOrder.size()));
+            jobSize = 0;
+        }
+        _updateOrder.emplace_back(_skinningModelOrder[i].second);
+        ++jobSize;
+    }
+    _updateJobOffsets.emplace_back(static_cast<uint32_t>(_updateOrder.size()));
+
+    // Parallel pass: transforms, bounds and CPU side uniform data
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, static_cast<uint32_t>(_updateJobOffsets.size() - 1), 1U, [this, stamp](uint32_t job) {
+        for (uint32_t i = _updateJobOffsets[job]; i < _updateJobOffsets[job + 1]; ++i) {
+            Model *model = _models[_updateOrder[i]];
+            model->updateTransform(stamp);
+            model->prepareUBOs(stamp);
+        }
+    });
+    g.run();
+    g.waitForAll();
+
+    // Serial merge: GPU uploads, bounds table and octree
+    for (index_t i = 0; i < _models.size(); ++i) {
+        Model *model = _models[i];
+        if (model->isEnabled()) {
+            if (!model->isModelImplementedInJS()) {
+                model->uploadUBOs();
+            }
+            if (model->isWorldBoundsDirty()) {
+                _modelBounds.updateBounds(i, model);
+            }
+            model->updateOctree();
+        }
+        _modelBounds.updateFlags(i, model);
+    }
 }
 
 void RenderScene::destroy() {
@@ -188,6 +366,7 @@ void RenderScene::removeSpotLights() {
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
     _models.emplace_back(model);
+    _modelBounds.add(model);
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
@@ -200,6 +379,7 @@ void RenderScene::removeModel(Model *model) {
             _octree->remove(*iter);
         }
         model->detachFromScene();
+        _modelBounds.erase(static_cast<index_t>(iter - _models.begin()));
         _models.erase(iter);
     } else {
         CC_LOG_WARNING("Try to remove invalid model.");
@@ -215,6 +395,7 @@ void RenderScene::removeModels() {
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
+    _modelBounds.clear();
 }
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
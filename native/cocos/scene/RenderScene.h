@@ -28,6 +28,7 @@
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/TypeDef.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
 
@@ -36,6 +37,7 @@ namespace cc {
 class Node;
 class SkinningModel;
 class BakedSkinningModel;
+class TransformStore;
 
 namespace scene {
 
@@ -56,6 +58,40 @@ struct IRenderSceneInfo {
     ccstd::string name;
 };
 
+/**
+ * Structure-of-arrays copy of the world bounds and visibility masks of the models in a scene.
+ * Entries are indexed the same way as RenderScene::getModels(), so the culling loop can run
+ * over contiguous arrays without touching Model, Node or AABB objects.
+ */
+struct ModelBoundsTable {
+    enum Flag : uint8_t {
+        ENABLED = 1 << 0,
+        HAS_NODE = 1 << 1,
+        HAS_BOUNDS = 1 << 2,
+        CAST_SHADOW = 1 << 3,
+    };
+
+    void add(const Model *model);
+    void erase(index_t idx);
+    void clear();
+    void updateBounds(index_t idx, const Model *model);
+    void updateFlags(index_t idx, const Model *model);
+
+    inline uint32_t size() const { return static_cast<uint32_t>(flags.size()); }
+
+    // Center x/y/z and half extents x/y/z, models without bounds get infinite extents.
+    ccstd::vector<float> bounds[6];
+    ccstd::vector<uint32_t> layers;
+    ccstd::vector<uint32_t> visFlags;
+    ccstd::vector<uint8_t> flags;
+    // Value of `frame` when the bounds of the model last changed.
+    ccstd::vector<uint32_t> boundsFrames;
+    // Incremented by every RenderScene::update.
+    uint32_t frame{0};
+    // Incremented whenever models are added or removed.
+    uint32_t layoutVersion{0};
+};
+
 class RenderScene : public RefCounted {
 public:
     RenderScene();
@@ -103,10 +139,25 @@ public:
     inline const ccstd::vector<IntrusivePtr<SpotLight>> &getSpotLights() const { return _spotLights; }
     inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
     inline Octree *getOctree() const { return _octree; }
+    inline const ModelBoundsTable &getModelBounds() const { return _modelBounds; }
     void updateOctree(Model *model);
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
+    // world transforms of the store are brought up to date at the start of update(), before models read them
+    inline void setTransformStore(TransformStore *store) { _transformStore = store; }
+    inline TransformStore *getTransformStore() const { return _transformStore; }
+
+    // from PARALLEL_UPDATE_THRESHOLD enabled models on, update() spreads them over the job system unless this is disabled
+    inline void setParallelUpdateEnabled(bool enabled) { _parallelUpdateEnabled = enabled; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
+    // below this many enabled models update() runs on the calling thread
+    static constexpr uint32_t PARALLEL_UPDATE_THRESHOLD = 128;
+    static constexpr uint32_t MODELS_PER_UPDATE_JOB = 32;
 
 private:
+    void updateModels(uint32_t stamp);
+    void updateModelsParallel(uint32_t stamp);
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
@@ -116,7 +167,15 @@ private:
     ccstd::vector<IntrusivePtr<SphereLight>> _sphereLights;
     ccstd::vector<IntrusivePtr<SpotLight>> _spotLights;
     ccstd::vector<DrawBatch2D *> _batches;
+    ModelBoundsTable _modelBounds;
     Octree *_octree{nullptr};
+    // weak reference, owned by the scene node
+    TransformStore *_transformStore{nullptr};
+    bool _parallelUpdateEnabled{true};
+    // scratch data of updateModelsParallel
+    ccstd::vector<std::pair<Node *, index_t>> _skinningModelOrder;
+    ccstd::vector<index_t> _updateOrder;
+    ccstd::vector<uint32_t> _updateJobOffsets;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/models/BakedSkinningModel.h"
+#include "3d/skeletal-animation/BakedAnimationCrowd.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+IntrusivePtr<BakedSkinningModel> createModel(Node *node) {
+    IntrusivePtr<BakedSkinningModel> model = ccnew BakedSkinningModel();
+    model->initialize();
+    model->setTransform(node);
+    return model;
+}
+} // namespace
+
+TEST(bakedAnimationCrowdTest, sharesFrameBuffers) {
+    IntrusivePtr<BakedAnimationCrowd> crowd = ccnew BakedAnimationCrowd();
+    BakedCrowdClip clip;
+    clip.frameCount = 10;
+    clip.sample = 10.F;
+    const index_t walk = crowd->addClip(clip);
+
+    IntrusivePtr<Node> node = ccnew Node();
+    auto a = createModel(node);
+    auto b = createModel(node);
+    auto c = createModel(node);
+
+    logLabel = "models at the same frame share one uniform buffer";
+    crowd->addModel(a, walk, 0.F);
+    crowd->addModel(b, walk, 0.F);
+    crowd->addModel(c, walk, 0.55F);
+    ExpectEq(a->getCrowd() == crowd && a->getAnimInfoBuffer() != nullptr, true);
+    ExpectEq(a->getAnimInfoBuffer() == b->getAnimInfoBuffer(), true);
+    ExpectEq(a->getAnimInfoBuffer() != c->getAnimInfoBuffer(), true);
+    ExpectEq(crowd->getFrameBufferCount() == 2, true);
+
+    logLabel = "reaching a frame rebinds the buffer of that frame";
+    auto *fifthFrame = c->getAnimInfoBuffer();
+    crowd->update(0.55F, Vec3::ZERO);
+    ExpectEq(a->getAnimInfoBuffer() == fifthFrame && b->getAnimInfoBuffer() == fifthFrame, true);
+    ExpectEq(c->getAnimInfoBuffer() != fifthFrame, true);
+    ExpectEq(crowd->getFrameBufferCount() == 3, true);
+
+    logLabel = "leaving the crowd restores the model's own buffer";
+    crowd->removeModel(b);
+    ExpectEq(b->getCrowd() == nullptr && b->getAnimInfoBuffer() == nullptr, true);
+
+    logLabel = "animation info synced from scripts while in the crowd is restored when leaving";
+    crowd->addModel(b, walk, 0.F);
+    auto *crowdBuffer = b->getAnimInfoBuffer();
+    auto *scriptBuffer = c->getAnimInfoBuffer();
+    Float32Array animInfo{4};
+    Uint8Array animInfoDirty{1};
+    b->syncAnimInfoForJS(scriptBuffer, animInfo, animInfoDirty);
+    ExpectEq(b->getAnimInfoBuffer() == crowdBuffer, true);
+    crowd->removeModel(b);
+    ExpectEq(b->getAnimInfoBuffer() == scriptBuffer, true);
+    ExpectEq(crowd->getModelCount() == 2, true);
+
+    crowd->clear();
+    ExpectEq(a->getCrowd() == nullptr && c->getCrowd() == nullptr, true);
+    ExpectEq(crowd->getFrameBufferCount() == 0, true);
+    a->destroy();
+    b->destroy();
+    c->destroy();
+}
+
+TEST(bakedAnimationCrowdTest, distantModelsUpdateLessOften) {
+    IntrusivePtr<BakedAnimationCrowd> crowd = ccnew BakedAnimationCrowd();
+    BakedCrowdClip clip;
+    clip.frameCount = 100;
+    // 1.5 frames per update, so every evaluation lands on a new frame
+    clip.sample = 15.F;
+    const index_t walk = crowd->addClip(clip);
+    crowd->setLODLevels({{50.F, 4}});
+
+    IntrusivePtr<Node> nearNode = ccnew Node();
+    IntrusivePtr<Node> farNode = ccnew Node();
+    farNode->setPosition(100.F, 0.F, 0.F);
+    auto nearModel = createModel(nearNode);
+    auto farModel = createModel(farNode);
+    crowd->addModel(nearModel, walk, 0.F);
+    crowd->addModel(farModel, walk, 0.F);
+
+    // the first update measures the distances, the far model then only advances every 4 frames
+    crowd->update(0.1F, Vec3::ZERO);
+    uint32_t nearChanges = 0;
+    uint32_t farChanges = 0;
+    for (uint32_t i = 0; i < 8; ++i) {
+        auto *nearBuffer = nearModel->getAnimInfoBuffer();
+        auto *farBuffer = farModel->getAnimInfoBuffer();
+        crowd->update(0.1F, Vec3::ZERO);
+        nearChanges += nearModel->getAnimInfoBuffer() != nearBuffer;
+        farChanges += farModel->getAnimInfoBuffer() != farBuffer;
+    }
+    logLabel = "the near model advances every frame";
+    ExpectEq(nearChanges == 8, true);
+    logLabel = "the far model advances on its LOD ticks only";
+    ExpectEq(farChanges == 2, true);
+
+    crowd->clear();
+    nearModel->destroy();
+    farModel->destroy();
+}
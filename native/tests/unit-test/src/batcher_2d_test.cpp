@@ -0,0 +1,409 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <array>
+#include <memory>
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/RenderDrawInfo.h"
+#include "2d/renderer/RenderEntity.h"
+#include "2d/renderer/UIMeshBuffer.h"
+#include "core/Root.h"
+#include "core/assets/EffectAsset.h"
+#include "core/assets/Material.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/core/ProgramLib.h"
+#include "scene/DrawBatch2D.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+// position, uv and color
+constexpr uint8_t STRIDE = 9;
+constexpr uint32_t QUAD_VERTICES = 4;
+constexpr uint32_t QUAD_INDICES = 6;
+constexpr uint32_t MAX_QUADS = 32;
+
+struct Quad {
+    Node *node{nullptr};
+    RenderEntity *entity{nullptr};
+    std::array<float, QUAD_VERTICES * STRIDE> local{};
+    std::array<uint16_t, QUAD_INDICES> indices{};
+};
+
+struct BatchInfo {
+    scene::DrawBatch2D *batch{nullptr};
+    gfx::InputAssembler *ia{nullptr};
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+};
+
+struct FrameInfo {
+    ccstd::vector<BatchInfo> batches;
+    ccstd::vector<uint16_t> indices;
+    ccstd::vector<float> vertices;
+    Batcher2dReorderStats reorderStats;
+};
+
+// writes the entity attributes the way JS does, through the shared buffer
+EntityAttrLayout *getSharedAttrs(RenderEntity *entity) {
+    uint8_t *data = nullptr;
+    size_t length = 0;
+    entity->getEntitySharedBufferForJS()->getArrayBufferData(&data, &length);
+    return reinterpret_cast<EntityAttrLayout *>(data);
+}
+
+// draws quads of one material from a single mesh buffer, as sprites do
+class UIScene {
+public:
+    explicit UIScene(bool incremental) {
+        if (ProgramLib::getInstance() == nullptr) {
+            _programLib = std::make_unique<ProgramLib>();
+        }
+        IShaderInfo shader;
+        shader.name = "batcher-2d-test";
+        shader.hash = 1;
+        IPassInfoFull pass;
+        pass.program = shader.name;
+        ITechniqueInfo technique;
+        technique.passes.emplace_back(pass);
+        _effect = ccnew EffectAsset();
+        _effect->setShaders({shader});
+        _effect->setTechniques({technique});
+        ProgramLib::getInstance()->registerEffect(_effect);
+        _material = ccnew Material();
+        IMaterialInfo info;
+        info.effectAsset = _effect;
+        _material->initialize(info);
+        _otherMaterial = ccnew Material();
+        _otherMaterial->initialize(info);
+
+        _meshBuffer = std::make_unique<UIMeshBuffer>();
+        _meshBuffer->syncSharedBufferToNative(_meshLayout.data());
+        _meshBuffer->setVData(_vData.data());
+        _meshBuffer->setIData(_iData.data());
+        _meshBuffer->initialize(Root::getInstance()->getDevice(),
+                                {{gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F},
+                                 {gfx::ATTR_NAME_TEX_COORD, gfx::Format::RG32F},
+                                 {gfx::ATTR_NAME_COLOR, gfx::Format::RGBA32F}},
+                                static_cast<uint32_t>(_vData.size()), static_cast<uint32_t>(_iData.size()));
+
+        _batcher = std::make_unique<Batcher2d>();
+        _batcher->initialize();
+        _batcher->setIncrementalEnabled(incremental);
+        _batcher->syncMeshBuffersToNative(0, {_meshBuffer.get()});
+    }
+
+    ~UIScene() {
+        _batcher.reset();
+        _roots.clear();
+    }
+
+    Node *addRoot() {
+        Node *root = _roots.emplace_back(ccnew Node()).get();
+        root->setActiveInHierarchy(true);
+        ccstd::vector<Node *> rootNodes;
+        for (const auto &node : _roots) {
+            rootNodes.emplace_back(node.get());
+        }
+        _batcher->syncRootNodesToNative(std::move(rootNodes));
+        return root;
+    }
+
+    Quad *addQuad(Node *parent, bool otherMaterial = false) {
+        CC_ASSERT(_quads.size() < MAX_QUADS);
+        auto index = static_cast<uint32_t>(_quads.size());
+        auto *quad = _quads.emplace_back(std::make_unique<Quad>()).get();
+        quad->node = ccnew Node();
+        parent->addChild(quad->node);
+        quad->node->setActiveInHierarchy(true);
+        quad->entity = ccnew RenderEntity(RenderEntityType::STATIC);
+        quad->entity->setNode(quad->node);
+        quad->entity->setStaticDrawInfoSize(1);
+        getSharedAttrs(quad->entity)->enabledIndex = 1;
+
+        for (uint32_t i = 0; i < QUAD_VERTICES; ++i) {
+            quad->local[i * STRIDE] = static_cast<float>(i % 2);
+            quad->local[i * STRIDE + 1] = static_cast<float>(i / 2);
+        }
+        auto first = static_cast<uint16_t>(index * QUAD_VERTICES);
+        quad->indices = {first, static_cast<uint16_t>(first + 1), static_cast<uint16_t>(first + 2),
+                         static_cast<uint16_t>(first + 2), static_cast<uint16_t>(first + 1), static_cast<uint16_t>(first + 3)};
+
+        auto *drawInfo = quad->entity->getStaticRenderDrawInfo(0);
+        drawInfo->setMeshBuffer(_meshBuffer.get());
+        drawInfo->setStride(STRIDE);
+        drawInfo->setVbCount(QUAD_VERTICES);
+        drawInfo->setIbCount(QUAD_INDICES);
+        drawInfo->setDataHash(1);
+        drawInfo->setVertDirty(true);
+        drawInfo->setMaterial(otherMaterial ? _otherMaterial : _material);
+        drawInfo->setVDataBuffer(_vData.data());
+        drawInfo->setIDataBuffer(_iData.data());
+        drawInfo->setVbBuffer(_vData.data() + index * QUAD_VERTICES * STRIDE);
+        drawInfo->setIbBuffer(quad->indices.data());
+        drawInfo->setRender2dBufferToNative(reinterpret_cast<uint8_t *>(quad->local.data()));
+
+        // MeshBufferLayout, the vertices are allocated by JS
+        _meshLayout[0] = (index + 1) * QUAD_VERTICES * STRIDE * sizeof(float);
+        _meshLayout[1] = (index + 1) * QUAD_VERTICES;
+        _meshBuffer->setDirty(true);
+        return quad;
+    }
+
+    // runs the batcher the way Root does in a frame
+    FrameInfo frame() {
+        FrameInfo info;
+        _batcher->update();
+        for (auto *batch : _batcher->getBatches()) {
+            auto *ia = batch->getInputAssembler();
+            info.batches.push_back({batch, ia, ia->getFirstIndex(), ia->getIndexCount()});
+        }
+        info.reorderStats = _batcher->getReorderStats();
+        info.indices.assign(_iData.begin(), _iData.begin() + _meshBuffer->getIndexOffset());
+        info.vertices.assign(_vData.begin(), _vData.begin() + _meshBuffer->getByteOffset() / sizeof(float));
+        _batcher->uploadBuffers();
+        _batcher->reset();
+        Node::resetChangedFlags();
+        return info;
+    }
+
+    inline uint16_t *getIData() { return _iData.data(); }
+    inline float *getVData() { return _vData.data(); }
+    inline Batcher2d *getBatcher() { return _batcher.get(); }
+
+private:
+    std::unique_ptr<ProgramLib> _programLib;
+    IntrusivePtr<EffectAsset> _effect;
+    IntrusivePtr<Material> _material;
+    IntrusivePtr<Material> _otherMaterial;
+    std::array<uint32_t, 4> _meshLayout{};
+    std::array<float, MAX_QUADS * QUAD_VERTICES * STRIDE> _vData{};
+    std::array<uint16_t, MAX_QUADS * QUAD_INDICES> _iData{};
+    std::unique_ptr<UIMeshBuffer> _meshBuffer;
+    ccstd::vector<IntrusivePtr<Node>> _roots;
+    ccstd::vector<std::unique_ptr<Quad>> _quads;
+    std::unique_ptr<Batcher2d> _batcher;
+};
+
+bool isSameBatch(const BatchInfo &a, const BatchInfo &b) {
+    return a.batch == b.batch && a.ia == b.ia && a.firstIndex == b.firstIndex && a.indexCount == b.indexCount;
+}
+
+bool isSameDraw(const BatchInfo &a, const BatchInfo &b) {
+    return a.firstIndex == b.firstIndex && a.indexCount == b.indexCount;
+}
+} // namespace
+
+TEST(batcher2dTest, cacheHit) {
+    UIScene scene{true};
+    auto *rootA = scene.addRoot();
+    auto *rootB = scene.addRoot();
+    auto *quad = scene.addQuad(rootA);
+    scene.addQuad(rootA);
+    scene.addQuad(rootB);
+
+    logLabel = "test that no batch spans two roots";
+    auto first = scene.frame();
+    ExpectEq(first.batches.size() == 2, true);
+    ExpectEq(first.batches[0].firstIndex == 0 && first.batches[0].indexCount == 12, true);
+    ExpectEq(first.batches[1].firstIndex == 12 && first.batches[1].indexCount == 6, true);
+
+    logLabel = "test that unchanged roots reuse their batches without copying their indices again";
+    scene.getIData()[0] = 0xFFFF;
+    auto second = scene.frame();
+    ExpectEq(second.batches.size() == 2, true);
+    ExpectEq(isSameBatch(first.batches[0], second.batches[0]) && isSameBatch(first.batches[1], second.batches[1]), true);
+    ExpectEq(scene.getIData()[0] == 0xFFFF, true);
+    scene.getIData()[0] = 0;
+
+    logLabel = "test that moved nodes keep their batches and only refill their vertices";
+    quad->node->setPosition(5.F, 0.F, 0.F);
+    auto third = scene.frame();
+    ExpectEq(isSameBatch(first.batches[0], third.batches[0]) && isSameBatch(first.batches[1], third.batches[1]), true);
+    ExpectEq(IsEqualF(scene.getVData()[0], 5.F) && IsEqualF(scene.getVData()[STRIDE], 6.F), true);
+}
+
+TEST(batcher2dTest, subtreeInvalidation) {
+    UIScene scene{true};
+    auto *rootA = scene.addRoot();
+    auto *rootB = scene.addRoot();
+    auto *quad = scene.addQuad(rootA);
+    scene.addQuad(rootA);
+    scene.addQuad(rootB);
+    auto first = scene.frame();
+
+    logLabel = "test that attaching a node only rebuilds the batches of its root";
+    scene.addQuad(rootB);
+    scene.getIData()[0] = 0xFFFF;
+    auto second = scene.frame();
+    ExpectEq(second.batches.size() == 2, true);
+    ExpectEq(isSameBatch(first.batches[0], second.batches[0]), true);
+    ExpectEq(scene.getIData()[0] == 0xFFFF, true);
+    ExpectEq(second.batches[1].firstIndex == 12 && second.batches[1].indexCount == 12, true);
+    scene.getIData()[0] = 0;
+
+    logLabel = "test that a root whose indices move is rebuilt after a change before it";
+    getSharedAttrs(quad->entity)->enabledIndex = 0;
+    auto third = scene.frame();
+    ExpectEq(third.batches.size() == 2, true);
+    ExpectEq(third.batches[0].firstIndex == 0 && third.batches[0].indexCount == 6, true);
+    ExpectEq(third.batches[1].firstIndex == 6 && third.batches[1].indexCount == 12, true);
+
+    logLabel = "test that deactivating a node invalidates its root";
+    quad->node->setActiveInHierarchy(false);
+    getSharedAttrs(quad->entity)->enabledIndex = 1;
+    auto fourth = scene.frame();
+    ExpectEq(fourth.batches[0].indexCount == 6 && fourth.batches[1].firstIndex == 6, true);
+    quad->node->setActiveInHierarchy(true);
+    auto fifth = scene.frame();
+    ExpectEq(fifth.batches[0].indexCount == 12 && fifth.batches[1].firstIndex == 12, true);
+}
+
+TEST(batcher2dTest, sameBatchesAsFullRebuild) {
+    logLabel = "test that incremental batching produces the batches and buffers of a full rebuild";
+    // each step changes the scene before the frame
+    auto run = [](bool incremental) {
+        UIScene scene{incremental};
+        auto *rootA = scene.addRoot();
+        auto *rootB = scene.addRoot();
+        auto *a0 = scene.addQuad(rootA);
+        auto *a1 = scene.addQuad(a0->node);
+        auto *b0 = scene.addQuad(rootB);
+        ccstd::vector<FrameInfo> frames;
+        frames.emplace_back(scene.frame());
+        frames.emplace_back(scene.frame());
+        a1->node->setPosition(3.F, 4.F, 0.F);
+        frames.emplace_back(scene.frame());
+        scene.addQuad(rootB);
+        frames.emplace_back(scene.frame());
+        a0->node->setPosition(-1.F, 2.F, 0.F);
+        getSharedAttrs(b0->entity)->enabledIndex = 0;
+        frames.emplace_back(scene.frame());
+        getSharedAttrs(b0->entity)->colorR = 128;
+        getSharedAttrs(b0->entity)->colorDirtyBit = 1;
+        getSharedAttrs(b0->entity)->enabledIndex = 1;
+        frames.emplace_back(scene.frame());
+        frames.emplace_back(scene.frame());
+        return frames;
+    };
+    auto expected = run(false);
+    auto actual = run(true);
+    ExpectEq(expected.size() == actual.size(), true);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const auto &lhs = expected[i];
+        const auto &rhs = actual[i];
+        bool same = lhs.batches.size() == rhs.batches.size() && lhs.indices == rhs.indices && lhs.vertices == rhs.vertices;
+        for (size_t j = 0; same && j < lhs.batches.size(); ++j) {
+            same = isSameDraw(lhs.batches[j], rhs.batches[j]);
+        }
+        EXPECT_TRUE(same) << "frame " << i;
+    }
+}
+
+TEST(batcher2dTest, reorder) {
+    UIScene scene{false};
+    scene.getBatcher()->setReorderEnabled(true);
+    auto *root = scene.addRoot();
+    // unit quads side by side, 2 apart, so that none of them overlap
+    auto addQuadAt = [&](float x, bool otherMaterial) {
+        auto *quad = scene.addQuad(root, otherMaterial);
+        quad->node->setPosition(x, 0.F, 0.F);
+        return quad;
+    };
+
+    logLabel = "test that a draw moves ahead of a draw it does not overlap to merge";
+    addQuadAt(0.F, false);
+    addQuadAt(2.F, true);
+    addQuadAt(4.F, false);
+    auto first = scene.frame();
+    ExpectEq(first.reorderStats.batchesBefore == 3 && first.reorderStats.batchesAfter == 2, true);
+    ExpectEq(first.batches.size() == 2, true);
+    ExpectEq(first.batches[0].indexCount == 12 && first.batches[1].indexCount == 6, true);
+
+    logLabel = "test that overlapping bounds block the merge";
+    // overlaps the quad of the other material, which has to stay drawn before it
+    addQuadAt(2.5F, false);
+    auto second = scene.frame();
+    ExpectEq(second.reorderStats.batchesBefore == 4 && second.reorderStats.batchesAfter == 3, true);
+    ExpectEq(second.batches.size() == 3, true);
+    ExpectEq(second.batches[0].indexCount == 12 && second.batches[1].indexCount == 6 && second.batches[2].indexCount == 6, true);
+
+    scene.getBatcher()->setReorderEnabled(false);
+    auto third = scene.frame();
+    ExpectEq(third.reorderStats.batchesBefore == 0 && third.reorderStats.batchesAfter == 0, true);
+    ExpectEq(third.batches.size() == 3, true);
+}
+
+TEST(batcher2dTest, reorderMaterialMismatch) {
+    auto run = [](bool otherMaterial) {
+        UIScene scene{false};
+        scene.getBatcher()->setReorderEnabled(true);
+        auto *root = scene.addRoot();
+        scene.addQuad(root)->node->setPosition(0.F, 0.F, 0.F);
+        scene.addQuad(root, otherMaterial)->node->setPosition(2.F, 0.F, 0.F);
+        return scene.frame();
+    };
+
+    logLabel = "test that draws of the same hash merge with the same material";
+    auto same = run(false);
+    ExpectEq(same.reorderStats.batchesAfter == 1 && same.batches.size() == 1, true);
+
+    logLabel = "test that a material mismatch never merges, even without overlaps";
+    auto other = run(true);
+    ExpectEq(other.reorderStats.batchesAfter == 2 && other.batches.size() == 2, true);
+}
+
+TEST(batcher2dTest, reorderSearchDepth) {
+    auto run = [](uint32_t blockers) {
+        UIScene scene{false};
+        scene.getBatcher()->setReorderEnabled(true);
+        auto *root = scene.addRoot();
+        float x = 0.F;
+        scene.addQuad(root)->node->setPosition(x, 0.F, 0.F);
+        // the other material with distinct hashes, so that every one of them is a batch of its own
+        for (uint32_t i = 0; i < blockers; ++i) {
+            auto *quad = scene.addQuad(root, true);
+            quad->node->setPosition(x += 2.F, 0.F, 0.F);
+            quad->entity->getStaticRenderDrawInfo(0)->setDataHash(100 + i);
+        }
+        scene.addQuad(root)->node->setPosition(x + 2.F, 0.F, 0.F);
+        return scene.frame();
+    };
+
+    logLabel = "test that a draw merges into a batch at the search depth";
+    auto within = run(Batcher2d::REORDER_SEARCH_DEPTH - 1);
+    ExpectEq(within.reorderStats.batchesBefore == Batcher2d::REORDER_SEARCH_DEPTH + 1, true);
+    ExpectEq(within.reorderStats.batchesAfter == Batcher2d::REORDER_SEARCH_DEPTH, true);
+    ExpectEq(within.batches[0].indexCount == 12, true);
+
+    logLabel = "test that batches beyond the search depth are not searched";
+    auto beyond = run(Batcher2d::REORDER_SEARCH_DEPTH);
+    ExpectEq(beyond.reorderStats.batchesBefore == Batcher2d::REORDER_SEARCH_DEPTH + 2, true);
+    ExpectEq(beyond.reorderStats.batchesAfter == Batcher2d::REORDER_SEARCH_DEPTH + 2, true);
+    ExpectEq(beyond.batches[0].indexCount == 6, true);
+}
@@ -0,0 +1,175 @@
+/****************************************************************************
+Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformStore.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+using namespace cc;
+
+// two hierarchies with the same local transforms, one updated through the store, the other lazily by Node
+struct TwinHierarchy {
+    IntrusivePtr<Node> flattenedRoot{ccnew Node("flattened")};
+    IntrusivePtr<Node> lazyRoot{ccnew Node("lazy")};
+    // also keeps the nodes alive on their own, so removed subtrees are only freed when the test drops them
+    std::vector<IntrusivePtr<Node>> flattened;
+    std::vector<IntrusivePtr<Node>> lazy;
+
+    // breadth of the tree shrinks with depth so both deep chains and wide levels are covered
+    explicit TwinHierarchy(uint32_t nodeCount) {
+        uint32_t seed = 1;
+        auto next = [&seed]() {
+            seed = seed * 1664525U + 1013904223U;
+            return static_cast<float>(seed >> 8) / static_cast<float>(1U << 24);
+        };
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            const uint32_t parent = i ? static_cast<uint32_t>(next() * static_cast<float>(i)) : 0;
+            const Vec3 position{next() * 10.F - 5.F, next() * 10.F - 5.F, next() * 10.F - 5.F};
+            const Vec3 euler{next() * 360.F, next() * 360.F, next() * 360.F};
+            const Vec3 scale{0.8F + next() * 0.4F, 0.8F + next() * 0.4F, 0.8F + next() * 0.4F};
+            add(flattened, flattenedRoot, parent, position, euler, scale);
+            add(lazy, lazyRoot, parent, position, euler, scale);
+        }
+    }
+
+    static void add(std::vector<IntrusivePtr<Node>> &nodes, Node *root, uint32_t parent, const Vec3 &position, const Vec3 &euler, const Vec3 &scale) {
+        auto *node = ccnew Node;
+        node->setPosition(position);
+        node->setRotationFromEuler(euler);
+        node->setScale(scale);
+        node->setParent(nodes.empty() ? root : nodes[parent].get());
+        nodes.emplace_back(node);
+    }
+
+    void moveNode(uint32_t idx, const Vec3 &position) {
+        flattened[idx]->setPosition(position);
+        lazy[idx]->setPosition(position);
+    }
+
+    void reparent(uint32_t idx, uint32_t parent) {
+        flattened[idx]->setParent(flattened[parent]);
+        lazy[idx]->setParent(lazy[parent]);
+    }
+
+    // detaches the subtree of the idx-th node in both hierarchies and releases it, returns its size
+    uint32_t remove(uint32_t idx) {
+        uint32_t removed = 0;
+        for (size_t i = 0; i < flattened.size(); ++i) {
+            if (i != idx && flattened[i] && flattened[i]->isChildOf(flattened[idx])) {
+                flattened[i] = nullptr;
+                lazy[i] = nullptr;
+                ++removed;
+            }
+        }
+        flattened[idx]->setParent(nullptr);
+        lazy[idx]->setParent(nullptr);
+        flattened[idx] = nullptr;
+        lazy[idx] = nullptr;
+        return removed + 1;
+    }
+
+    void checkWorldMatrices() {
+        for (size_t i = 0; i < flattened.size(); ++i) {
+            if (!flattened[i]) continue;
+            // the store has to leave nothing for the lazy path to do
+            ExpectEq(flattened[i]->getDirtyFlag() == 0, true);
+            lazy[i]->updateWorldTransform();
+            const auto &expected = lazy[i]->getWorldMatrix();
+            const auto &actual = flattened[i]->getWorldMatrix();
+            // both paths do the same math, but may get there through different dirty bits
+            for (uint32_t j = 0; j < 16; ++j) {
+                ExpectEq(std::fabs(actual.m[j] - expected.m[j]) <= 1e-4F * std::max(1.F, std::fabs(expected.m[j])), true);
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST(TransformStoreTest, matchesLazyUpdate) {
+    logLabel = "flattened world transforms have to match Node::updateWorldTransform";
+    TwinHierarchy hierarchy{300};
+    hierarchy.flattenedRoot->setPosition(1.F, 2.F, 3.F);
+    hierarchy.lazyRoot->setPosition(1.F, 2.F, 3.F);
+    TransformStore store{hierarchy.flattenedRoot};
+
+    store.update();
+    EXPECT_EQ(store.getNodeCount(), 300U);
+    hierarchy.checkWorldMatrices();
+
+    // only some branches dirty, including one under the root
+    hierarchy.moveNode(0, {4.F, 5.F, 6.F});
+    hierarchy.moveNode(150, {-1.F, 0.F, 1.F});
+    hierarchy.moveNode(299, {0.F, 7.F, 0.F});
+    store.update();
+    hierarchy.checkWorldMatrices();
+}
+
+TEST(TransformStoreTest, serialAndParallel) {
+    logLabel = "hierarchies split into jobs have to update the same way as the serial path";
+    // the first size stays on the calling thread, the second is split into jobs run on the job system
+    for (uint32_t nodeCount : {TransformStore::PARALLEL_NODE_COUNT / 2, TransformStore::PARALLEL_NODE_COUNT * 8}) {
+        TwinHierarchy hierarchy{nodeCount};
+        TransformStore store{hierarchy.flattenedRoot};
+
+        store.update();
+        EXPECT_EQ(store.getNodeCount(), nodeCount);
+        hierarchy.checkWorldMatrices();
+
+        for (uint32_t i = 0; i < nodeCount; i += 37) {
+            hierarchy.moveNode(i, {static_cast<float>(i % 7), 1.F, -static_cast<float>(i % 5)});
+        }
+        store.update();
+        hierarchy.checkWorldMatrices();
+    }
+}
+
+TEST(TransformStoreTest, rebuildsOnHierarchyChange) {
+    logLabel = "the flattened layout has to follow reparenting and removed nodes";
+    TwinHierarchy hierarchy{TransformStore::PARALLEL_NODE_COUNT * 2};
+    TransformStore store{hierarchy.flattenedRoot};
+    store.update();
+
+    // move a subtree below the last node laid out outside of it
+    const auto nodeCount = static_cast<uint32_t>(hierarchy.flattened.size());
+    uint32_t target = nodeCount - 1;
+    while (hierarchy.flattened[target]->isChildOf(hierarchy.flattened[1])) --target;
+    hierarchy.reparent(1, target);
+    store.update();
+    EXPECT_EQ(store.getNodeCount(), nodeCount);
+    hierarchy.checkWorldMatrices();
+
+    // release a subtree, the store must not touch the freed nodes any more
+    const uint32_t removed = hierarchy.remove(2);
+    hierarchy.moveNode(0, {2.F, 2.F, 2.F});
+    store.update();
+    EXPECT_EQ(store.getNodeCount(), nodeCount - removed);
+    hierarchy.checkWorldMatrices();
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "cocos/3d/models/CPUSkinning.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/MathUtil.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/math/Vec3.h"
+#include "cocos/math/Vec4.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+constexpr uint32_t JOINT_COUNT = 6;
+constexpr uint32_t VERTEX_COUNT = 9;
+
+// Interleaved position, normal, uv and tangent, the uv is left untouched by skinning.
+constexpr uint32_t STRIDE = sizeof(float) * 12;
+const cc::CPUSkinningLayout LAYOUT{STRIDE, 0, sizeof(float) * 3, sizeof(float) * 8};
+
+std::vector<float> createPalette() {
+    std::vector<const float *> worldPointers;
+    std::vector<cc::Mat4> worlds(JOINT_COUNT);
+    std::vector<cc::Mat4> bindposes(JOINT_COUNT);
+    std::vector<float> bounds(JOINT_COUNT * 6, 0.F);
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        const auto f = static_cast<float>(i);
+        cc::Quaternion rotation;
+        cc::Quaternion::createFromAxisAngle(cc::Vec3(1, 0.5F, 0.2F).getNormalized(), 0.3F * f, &rotation);
+        cc::Mat4::fromRTS(rotation, cc::Vec3(f, 0.5F * f, -f), cc::Vec3(1, 1 + 0.1F * f, 1), &worlds[i]);
+        cc::Mat4::fromRTS(cc::Quaternion::identity(), cc::Vec3(0, -f, 0), cc::Vec3::ONE, &bindposes[i]);
+        worldPointers.push_back(worlds[i].m);
+    }
+    std::vector<float> palette(JOINT_COUNT * 12);
+    cc::Vec3 boundsMin;
+    cc::Vec3 boundsMax;
+    cc::MathUtil::computeSkinningPalette(worldPointers.data(), bindposes[0].m, bounds.data(), JOINT_COUNT, palette.data(), &boundsMin.x, &boundsMax.x);
+    return palette;
+}
+
+cc::CPUSkinningStreams createStreams() {
+    cc::CPUSkinningStreams streams;
+    streams.vertexCount = VERTEX_COUNT;
+    for (uint32_t v = 0; v < VERTEX_COUNT; ++v) {
+        const auto f = static_cast<float>(v);
+        streams.positions.insert(streams.positions.end(), {f, 1 - f, 0.5F * f});
+        streams.normals.insert(streams.normals.end(), {0, 1, 0});
+        streams.tangents.insert(streams.tangents.end(), {1, 0, 0, v % 2 ? 1.F : -1.F});
+        streams.joints.insert(streams.joints.end(), {static_cast<uint16_t>(v % JOINT_COUNT), static_cast<uint16_t>((v + 1) % JOINT_COUNT), static_cast<uint16_t>((v + 3) % JOINT_COUNT), 0});
+        streams.weights.insert(streams.weights.end(), {0.5F, 0.3F, 0.2F, 0});
+    }
+    return streams;
+}
+
+// What the skinning shader chunk computes: the weighted sum of the joint matrices applied to vec4 attributes.
+cc::Vec4 skinReference(const std::vector<float> &palette, const cc::CPUSkinningStreams &streams, uint32_t v, const cc::Vec4 &attribute) {
+    cc::Vec4 result{0, 0, 0, 0};
+    for (uint32_t i = 0; i < 4; ++i) {
+        const float *joint = palette.data() + streams.joints[v * 4 + i] * 12;
+        const cc::Mat4 jointMatrix{
+            joint[0], joint[4], joint[8], joint[3],
+            joint[1], joint[5], joint[9], joint[7],
+            joint[2], joint[6], joint[10], joint[11],
+            0, 0, 0, 1};
+        cc::Vec4 skinned;
+        jointMatrix.transformVector(attribute, &skinned);
+        result += skinned * streams.weights[v * 4 + i];
+    }
+    return result;
+}
+
+bool equalsVec3(const float *actual, const cc::Vec4 &expected) {
+    return IsEqualF(actual[0], expected.x) && IsEqualF(actual[1], expected.y) && IsEqualF(actual[2], expected.z);
+}
+
+} // namespace
+
+TEST(cpuSkinningTest, skinVertices) {
+    logLabel = "test the CPU skinning kernel against the shader formula";
+    const std::vector<float> palette = createPalette();
+    const cc::CPUSkinningStreams streams = createStreams();
+
+    std::vector<float> vertices(VERTEX_COUNT * 12, 7.F);
+    // two ranges, the way the vertex jobs split a sub mesh
+    cc::skinVertices(streams, palette.data(), JOINT_COUNT, 0, 4, reinterpret_cast<uint8_t *>(vertices.data()), LAYOUT);
+    cc::skinVertices(streams, palette.data(), JOINT_COUNT, 4, VERTEX_COUNT, reinterpret_cast<uint8_t *>(vertices.data()), LAYOUT);
+
+    bool matches = true;
+    for (uint32_t v = 0; v < VERTEX_COUNT; ++v) {
+        const float *vertex = vertices.data() + v * 12;
+        const float *position = streams.positions.data() + v * 3;
+        const float *normal = streams.normals.data() + v * 3;
+        const float *tangent = streams.tangents.data() + v * 4;
+        matches = matches && equalsVec3(vertex, skinReference(palette, streams, v, cc::Vec4(position[0], position[1], position[2], 1)));
+        matches = matches && equalsVec3(vertex + 3, skinReference(palette, streams, v, cc::Vec4(normal[0], normal[1], normal[2], 0)));
+        matches = matches && vertex[6] == 7.F && vertex[7] == 7.F;
+        matches = matches && equalsVec3(vertex + 8, skinReference(palette, streams, v, cc::Vec4(tangent[0], tangent[1], tangent[2], 0)));
+        matches = matches && vertex[11] == tangent[3];
+    }
+    ExpectEq(matches, true);
+}
+
+TEST(cpuSkinningTest, morphVertices) {
+    logLabel = "test the CPU morph kernel";
+    const cc::CPUSkinningStreams source = createStreams();
+    std::vector<cc::CPUMorphTarget> targets(2);
+    for (uint32_t v = 0; v < VERTEX_COUNT; ++v) {
+        targets[0].positions.insert(targets[0].positions.end(), {1, 0, 0});
+        targets[0].tangents.insert(targets[0].tangents.end(), {0, 1, 0});
+        targets[1].positions.insert(targets[1].positions.end(), {0, 0, static_cast<float>(v)});
+        targets[1].normals.insert(targets[1].normals.end(), {1, 0, 0});
+    }
+    const float weights[] = {0.5F, 2.F};
+
+    cc::CPUSkinningStreams morphed = source;
+    cc::morphVertices(source, targets, weights, 0, VERTEX_COUNT, &morphed);
+
+    bool matches = true;
+    for (uint32_t v = 0; v < VERTEX_COUNT; ++v) {
+        const auto f = static_cast<float>(v);
+        matches = matches && IsEqualF(morphed.positions[v * 3], source.positions[v * 3] + 0.5F);
+        matches = matches && IsEqualF(morphed.positions[v * 3 + 2], source.positions[v * 3 + 2] + 2.F * f);
+        matches = matches && IsEqualF(morphed.normals[v * 3], 2.F) && IsEqualF(morphed.normals[v * 3 + 1], 1.F);
+        matches = matches && IsEqualF(morphed.tangents[v * 4 + 1], 0.5F) && morphed.tangents[v * 4 + 3] == source.tangents[v * 4 + 3];
+    }
+    ExpectEq(matches, true);
+}
@@ -0,0 +1,134 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/RefCounted.h"
+#include "gtest/gtest.h"
+#include "renderer/frame-graph/ResourceAllocator.h"
+
+#include "utils.h"
+
+using namespace cc;
+using namespace framegraph;
+
+namespace {
+int32_t liveResources = 0;
+
+class FakeBuffer final : public RefCounted {
+public:
+    FakeBuffer() { ++liveResources; }
+    ~FakeBuffer() override { --liveResources; }
+};
+
+struct FakeBufferCreator final {
+    FakeBuffer *operator()(const gfx::BufferInfo & /*desc*/) const {
+        return ccnew FakeBuffer();
+    }
+};
+
+using Allocator = ResourceAllocator<FakeBuffer, gfx::BufferInfo, FakeBufferCreator>;
+
+gfx::BufferInfo makeDesc(uint32_t size) {
+    gfx::BufferInfo desc;
+    desc.usage = gfx::BufferUsageBit::STORAGE;
+    desc.memUsage = gfx::MemoryUsageBit::DEVICE;
+    desc.size = size;
+    return desc;
+}
+} // namespace
+
+TEST(frameGraphResourceAllocatorTest, reuseAndBudget) {
+    auto &allocator = Allocator::getInstance();
+    uint32_t slotA = 0;
+    uint32_t slotB = 0;
+    uint32_t slotC = 0;
+
+    logLabel = "allocate two buffers of the same descriptor";
+    auto *a = allocator.alloc(makeDesc(64), slotA);
+    auto *b = allocator.alloc(makeDesc(64), slotB);
+    EXPECT_NE(a, b);
+    ExpectEq(allocator.getStats().misses == 2, true);
+    ExpectEq(allocator.getStats().residentBytes == 128, true);
+
+    logLabel = "the most recently released buffer is reused";
+    allocator.free(slotA);
+    allocator.free(slotB);
+    allocator.tick();
+    auto *c = allocator.alloc(makeDesc(64), slotC);
+    EXPECT_EQ(c, b);
+    ExpectEq(allocator.getStats().hits == 1, true);
+
+    logLabel = "other descriptors do not share the pool";
+    uint32_t slotD = 0;
+    auto *d = allocator.alloc(makeDesc(256), slotD);
+    EXPECT_NE(d, a);
+    ExpectEq(allocator.getStats().residentBytes == 384, true);
+
+    logLabel = "the least recently used buffer is evicted when over budget";
+    allocator.free(slotD);
+    allocator.setBudget(330);
+    allocator.tick();
+    ExpectEq(allocator.getStats().evictions == 1, true);
+    ExpectEq(allocator.getStats().residentBytes == 320, true);
+    allocator.setBudget(0);
+
+    logLabel = "gc destroys buffers unused for enough frames";
+    allocator.free(slotC);
+    allocator.tick();
+    allocator.gc(1);
+    ExpectEq(allocator.getStats().residentCount == 0, true);
+    ExpectEq(liveResources == 0, true);
+}
+
+TEST(frameGraphResourceAllocatorTest, bufferAliasing) {
+    using Traits = ResourceAllocatorTraits<gfx::BufferInfo>;
+
+    logLabel = "storage buffers of different sizes share the largest one";
+    auto small = makeDesc(64);
+    auto large = makeDesc(256);
+    small.stride = small.size;
+    large.stride = large.size;
+    ExpectEq(Traits::canAlias(small, large), true);
+    Traits::merge(small, large);
+    ExpectEq(small.size == 256 && small.stride == 256, true);
+
+    logLabel = "element strides must match";
+    auto elements = makeDesc(64);
+    elements.stride = 16;
+    ExpectEq(Traits::canAlias(elements, large), false);
+
+    logLabel = "uniform buffers only alias buffers of the same size";
+    auto uniform = makeDesc(64);
+    uniform.usage = gfx::BufferUsageBit::UNIFORM;
+    uniform.stride = uniform.size;
+    ExpectEq(Traits::canAlias(uniform, large), false);
+    auto storage = makeDesc(64);
+    storage.stride = storage.size;
+    ExpectEq(Traits::canAlias(uniform, storage), true);
+
+    logLabel = "memory usages must match";
+    auto host = makeDesc(256);
+    host.stride = host.size;
+    host.memUsage = gfx::MemoryUsageBit::HOST;
+    ExpectEq(Traits::canAlias(host, large), false);
+}
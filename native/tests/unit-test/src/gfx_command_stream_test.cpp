@@ -0,0 +1,373 @@
+/****************************************************************************
+Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "cocos/base/threading/MessageQueue.h"
+#include "cocos/renderer/gfx-agent/CommandStream.h"
+#include "cocos/renderer/gfx-base/GFXCommandBuffer.h"
+#include "cocos/renderer/gfx-empty/EmptyCommandBuffer.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+using namespace cc;
+using namespace cc::gfx;
+
+// remembers the hot calls the command stream batches, in order, and ignores everything else
+class RecordingCommandBuffer final : public CommandBuffer {
+public:
+    struct Call {
+        CommandStream::Opcode opcode{CommandStream::Opcode::DRAW};
+        const void *object{nullptr};
+        uint32_t set{0};
+        std::vector<uint32_t> dynamicOffsets;
+        DrawInfo drawInfo;
+        Viewport viewport;
+        Rect rect;
+
+        bool operator==(const Call &rhs) const {
+            return opcode == rhs.opcode && object == rhs.object && set == rhs.set && dynamicOffsets == rhs.dynamicOffsets &&
+                   !memcmp(&drawInfo, &rhs.drawInfo, sizeof(DrawInfo)) &&
+                   !memcmp(&viewport, &rhs.viewport, sizeof(Viewport)) &&
+                   !memcmp(&rect, &rhs.rect, sizeof(Rect));
+        }
+    };
+
+    std::vector<Call> calls;
+
+    void bindPipelineState(PipelineState *pso) override {
+        calls.push_back({CommandStream::Opcode::BIND_PIPELINE_STATE, pso});
+    }
+    void bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) override {
+        calls.push_back({CommandStream::Opcode::BIND_DESCRIPTOR_SET, descriptorSet, set, {dynamicOffsets, dynamicOffsets + dynamicOffsetCount}});
+    }
+    void bindInputAssembler(InputAssembler *ia) override {
+        calls.push_back({CommandStream::Opcode::BIND_INPUT_ASSEMBLER, ia});
+    }
+    void draw(const DrawInfo &info) override {
+        Call call{CommandStream::Opcode::DRAW};
+        call.drawInfo = info;
+        calls.push_back(call);
+    }
+    void setViewport(const Viewport &vp) override {
+        Call call{CommandStream::Opcode::SET_VIEWPORT};
+        call.viewport = vp;
+        calls.push_back(call);
+    }
+    void setScissor(const Rect &rect) override {
+        Call call{CommandStream::Opcode::SET_SCISSOR};
+        call.rect = rect;
+        calls.push_back(call);
+    }
+
+    void begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, uint32_t /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint32_t /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, uint32_t /*ref*/, uint32_t /*mask*/) override {}
+    void nextSubpass() override {}
+    void updateBuffer(Buffer * /*buff*/, const void * /*data*/, uint32_t /*size*/, uint32_t /*offset*/) override {}
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint32_t /*count*/, Filter /*filter*/) override {}
+    void execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void pipelineBarrier(const GeneralBarrier * /*barrier*/, const BufferBarrier *const * /*bufferBarriers*/, const Buffer *const * /*buffers*/, uint32_t /*bufferBarrierCount*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint32_t /*textureBarrierCount*/) override {}
+    void beginQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void endQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void resetQueryPool(QueryPool * /*queryPool*/) override {}
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+struct FakeObjects {
+    // never dereferenced, only used as distinct handles
+    std::vector<uint64_t> storage;
+
+    explicit FakeObjects(uint32_t count) : storage(count * 3) {}
+    PipelineState *pso(uint32_t i) { return reinterpret_cast<PipelineState *>(&storage[i * 3]); }
+    DescriptorSet *descriptorSet(uint32_t i) { return reinterpret_cast<DescriptorSet *>(&storage[i * 3 + 1]); }
+    InputAssembler *ia(uint32_t i) { return reinterpret_cast<InputAssembler *>(&storage[i * 3 + 2]); }
+};
+
+// the one message per call encoding CommandBufferAgent used before the command stream
+void recordMessages(MessageQueue *queue, CommandBuffer *commandBuffer, FakeObjects &objects, uint32_t drawCount) {
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        const DrawInfo drawInfo{6, 0, 6, i, 0, 1, 0};
+        const Rect scissor{0, 0, i, i};
+        ENQUEUE_MESSAGE_2(
+            queue, CommandBufferSetScissor,
+            actor, commandBuffer,
+            rect, scissor,
+            {
+                actor->setScissor(rect);
+            });
+
+        ENQUEUE_MESSAGE_2(
+            queue, CommandBufferBindPipelineState,
+            actor, commandBuffer,
+            pso, objects.pso(i),
+            {
+                actor->bindPipelineState(pso);
+            });
+
+        for (uint32_t set = 0; set < 2; ++set) {
+            const uint32_t dynamicOffsetCount = set;
+            auto *dynamicOffsets = dynamicOffsetCount ? queue->allocate<uint32_t>(dynamicOffsetCount) : nullptr;
+            if (dynamicOffsets) dynamicOffsets[0] = i * 256;
+            ENQUEUE_MESSAGE_5(
+                queue, CommandBufferBindDescriptorSet,
+                actor, commandBuffer,
+                set, set,
+                descriptorSet, objects.descriptorSet(i),
+                dynamicOffsetCount, dynamicOffsetCount,
+                dynamicOffsets, dynamicOffsets,
+                {
+                    actor->bindDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets);
+                });
+        }
+
+        ENQUEUE_MESSAGE_2(
+            queue, CommandBufferBindInputAssembler,
+            actor, commandBuffer,
+            ia, objects.ia(i),
+            {
+                actor->bindInputAssembler(ia);
+            });
+
+        ENQUEUE_MESSAGE_2(
+            queue, CommandBufferDraw,
+            actor, commandBuffer,
+            info, drawInfo,
+            {
+                actor->draw(info);
+            });
+    }
+}
+
+// ships the stream as one message, the way CommandBufferAgent::flushStream does, returns the message size
+uint32_t flushStream(MessageQueue *queue, CommandStream *stream, CommandBuffer *commandBuffer) {
+    stream->finish();
+    const uint32_t size = stream->size();
+    auto *data = queue->allocateAndCopy<uint8_t>(size, stream->data());
+    stream->clear();
+    ENQUEUE_MESSAGE_3(
+        queue, CommandBufferExecuteStream,
+        actor, commandBuffer,
+        data, data,
+        size, size,
+        {
+            CommandStream::execute(actor, data, size);
+        });
+    return size;
+}
+
+// the same calls through the command stream, flushed the way CommandBufferAgent does
+void recordStream(MessageQueue *queue, CommandStream *stream, CommandBuffer *commandBuffer, FakeObjects &objects, uint32_t drawCount) {
+    auto flushIfFull = [&]() {
+        if (stream->full()) flushStream(queue, stream, commandBuffer);
+    };
+
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        const DrawInfo drawInfo{6, 0, 6, i, 0, 1, 0};
+        const uint32_t dynamicOffset = i * 256;
+        stream->setScissor({0, 0, i, i});
+        flushIfFull();
+        stream->bindPipelineState(objects.pso(i));
+        flushIfFull();
+        stream->bindDescriptorSet(0, objects.descriptorSet(i), 0, nullptr);
+        flushIfFull();
+        stream->bindDescriptorSet(1, objects.descriptorSet(i), 1, &dynamicOffset);
+        flushIfFull();
+        stream->bindInputAssembler(objects.ia(i));
+        stream->draw(drawInfo);
+        flushIfFull();
+    }
+    flushStream(queue, stream, commandBuffer);
+}
+
+void replay(MessageQueue *queue) {
+    queue->finishWriting();
+    queue->flushMessages();
+    MessageQueue::freeChunksInFreeQueue(queue);
+}
+
+double elapsedNanoseconds(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+} // namespace
+
+TEST(gfxCommandStreamTest, encoding) {
+    logLabel = "check the record layout of the batched command stream";
+    using Opcode = CommandStream::Opcode;
+    FakeObjects objects{4};
+    CommandStream stream;
+    const uint32_t dynamicOffset = 0;
+
+    // one header shared by both descriptor set bindings, the input assembler is folded into the draw
+    stream.bindPipelineState(objects.pso(0));
+    stream.bindDescriptorSet(0, objects.descriptorSet(0), 1, &dynamicOffset);
+    stream.bindDescriptorSet(1, objects.descriptorSet(0), 0, nullptr);
+    stream.bindInputAssembler(objects.ia(0));
+    stream.draw({});
+    stream.bindInputAssembler(objects.ia(1));
+    stream.draw({});
+    stream.finish();
+
+    uint32_t expected = CommandStream::HEADER_SIZE + CommandStream::getPayloadSize(Opcode::BIND_PIPELINE_STATE) +
+                        CommandStream::HEADER_SIZE + CommandStream::getPayloadSize(Opcode::BIND_DESCRIPTOR_SET, 1) + CommandStream::getPayloadSize(Opcode::BIND_DESCRIPTOR_SET, 0) +
+                        CommandStream::HEADER_SIZE + CommandStream::getPayloadSize(Opcode::DRAW) * 2;
+    EXPECT_EQ(stream.size(), expected);
+
+    // a trailing input assembler binding is only written out when finishing
+    stream.bindInputAssembler(objects.ia(2));
+    EXPECT_FALSE(stream.empty());
+    EXPECT_EQ(stream.size(), expected);
+    stream.finish();
+    expected += CommandStream::HEADER_SIZE + CommandStream::getPayloadSize(Opcode::BIND_INPUT_ASSEMBLER);
+    EXPECT_EQ(stream.size(), expected);
+
+    // payloads keep the pointers they carry aligned whatever the ABI
+    for (auto opcode : {Opcode::BIND_PIPELINE_STATE, Opcode::BIND_INPUT_ASSEMBLER, Opcode::DRAW, Opcode::SET_VIEWPORT, Opcode::SET_SCISSOR}) {
+        EXPECT_EQ(CommandStream::getPayloadSize(opcode) % alignof(void *), 0U);
+    }
+    for (uint32_t count = 0; count < 4; ++count) {
+        EXPECT_EQ(CommandStream::getPayloadSize(Opcode::BIND_DESCRIPTOR_SET, count) % 8, 0U);
+    }
+
+    stream.clear();
+    EXPECT_TRUE(stream.empty());
+}
+
+TEST(gfxCommandStreamTest, replayMatchesMessages) {
+    logLabel = "replaying the command stream has to issue the same calls as per call messages";
+
+    auto *queue = ccnew MessageQueue;
+    queue->setImmediateMode(false);
+    RecordingCommandBuffer messageCalls;
+    RecordingCommandBuffer streamCalls;
+    CommandStream stream;
+
+    // the largest count spans several flushes of the stream
+    for (uint32_t drawCount : {1U, 64U, 2000U}) {
+        FakeObjects objects{drawCount};
+        messageCalls.calls.clear();
+        streamCalls.calls.clear();
+
+        recordMessages(queue, &messageCalls, objects, drawCount);
+        replay(queue);
+        recordStream(queue, &stream, &streamCalls, objects, drawCount);
+        replay(queue);
+
+        EXPECT_EQ(messageCalls.calls.size(), drawCount * 6U);
+        ExpectEq(messageCalls.calls == streamCalls.calls, true);
+        EXPECT_TRUE(stream.empty());
+    }
+
+    CC_SAFE_DELETE(queue);
+}
+
+TEST(gfxCommandStreamTest, longRunsWithoutDraws) {
+    logLabel = "state changes without draws in between are flushed before a message outgrows its chunk";
+
+    auto *queue = ccnew MessageQueue;
+    queue->setImmediateMode(false);
+    RecordingCommandBuffer streamCalls;
+    CommandStream stream;
+
+    constexpr uint32_t CALL_COUNT = 20000;
+    uint32_t largestMessage = 0;
+    for (uint32_t i = 0; i < CALL_COUNT; ++i) {
+        stream.setViewport({0, 0, i, i});
+        stream.setScissor({0, 0, i, i});
+        if (stream.full()) largestMessage = std::max(largestMessage, flushStream(queue, &stream, &streamCalls));
+    }
+    largestMessage = std::max(largestMessage, flushStream(queue, &stream, &streamCalls));
+    replay(queue);
+
+    EXPECT_EQ(streamCalls.calls.size(), CALL_COUNT * 2U);
+    EXPECT_LT(largestMessage, MessageQueue::MEMORY_CHUNK_SIZE / 2);
+
+    CC_SAFE_DELETE(queue);
+}
+
+// timing only, run it with --gtest_also_run_disabled_tests
+TEST(gfxCommandStreamTest, DISABLED_benchmarkDrawCounts) {
+    logLabel = "benchmark the batched command stream against per call messages on gfx-empty";
+    const uint32_t iterations = 50;
+
+    auto *queue = ccnew MessageQueue;
+    queue->setImmediateMode(false);
+    auto *commandBuffer = ccnew EmptyCommandBuffer;
+    CommandStream stream;
+
+    for (uint32_t drawCount : {500U, 2000U, 8000U}) {
+        FakeObjects objects{drawCount};
+        double messageProducer = 0.0;
+        double messageConsumer = 0.0;
+        double streamProducer = 0.0;
+        double streamConsumer = 0.0;
+
+        for (uint32_t i = 0; i < iterations; ++i) {
+            auto t0 = std::chrono::steady_clock::now();
+            recordMessages(queue, commandBuffer, objects, drawCount);
+            queue->finishWriting();
+            auto t1 = std::chrono::steady_clock::now();
+            queue->flushMessages();
+            auto t2 = std::chrono::steady_clock::now();
+            MessageQueue::freeChunksInFreeQueue(queue);
+            messageProducer += elapsedNanoseconds(t0, t1);
+            messageConsumer += elapsedNanoseconds(t1, t2);
+
+            t0 = std::chrono::steady_clock::now();
+            recordStream(queue, &stream, commandBuffer, objects, drawCount);
+            queue->finishWriting();
+            t1 = std::chrono::steady_clock::now();
+            queue->flushMessages();
+            t2 = std::chrono::steady_clock::now();
+            MessageQueue::freeChunksInFreeQueue(queue);
+            streamProducer += elapsedNanoseconds(t0, t1);
+            streamConsumer += elapsedNanoseconds(t1, t2);
+        }
+
+        const double scale = 1.0 / (iterations * drawCount);
+        printf("command encoding, %5u draws: producer %6.1f -> %6.1f ns/draw, consumer %6.1f -> %6.1f ns/draw\n",
+               drawCount, messageProducer * scale, streamProducer * scale, messageConsumer * scale, streamConsumer * scale);
+        EXPECT_TRUE(stream.empty());
+    }
+
+    CC_SAFE_DELETE(commandBuffer);
+    CC_SAFE_DELETE(queue);
+}
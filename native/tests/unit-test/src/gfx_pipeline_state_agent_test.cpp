@@ -0,0 +1,84 @@
+/****************************************************************************
+Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+
+#include <atomic>
+#include "cocos/base/threading/MessageQueue.h"
+#include "cocos/renderer/gfx-agent/DeviceAgent.h"
+#include "cocos/renderer/gfx-agent/PipelineStateAgent.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+using namespace cc;
+using namespace cc::gfx;
+
+// like a backend that compiles on init, not ready before the device thread initialized it
+class CompilingPipelineState final : public PipelineState {
+public:
+    bool isReady() const override { return _compiled.load(std::memory_order_acquire); }
+
+protected:
+    void doInit(const PipelineStateInfo & /*info*/) override { _compiled.store(true, std::memory_order_release); }
+    void doDestroy() override { _compiled.store(false, std::memory_order_release); }
+
+    std::atomic<bool> _compiled{false};
+};
+
+} // namespace
+
+TEST(gfxPipelineStateAgentTest, readyWithoutAsyncCompile) {
+    auto *deviceAgent = DeviceAgent::getInstance();
+    // the device thread isn't detached in this build
+    if (!deviceAgent) return;
+
+    IntrusivePtr<Shader> shader = deviceAgent->createShader(ShaderInfo{});
+    IntrusivePtr<PipelineLayout> pipelineLayout = deviceAgent->createPipelineLayout(PipelineLayoutInfo{});
+    PipelineStateInfo info;
+    info.shader = shader;
+    info.pipelineLayout = pipelineLayout;
+
+    // owned and deleted by the agent
+    auto *actor = ccnew CompilingPipelineState();
+    IntrusivePtr<PipelineStateAgent> pso = ccnew PipelineStateAgent(actor);
+    pso->initialize(info);
+
+    logLabel = "test that the empty device compiles pipelines synchronously";
+    ExpectEq(deviceAgent->isAsyncPipelineCompile(), false);
+
+    logLabel = "test that the init message hasn't reached the device thread yet";
+    ExpectEq(actor->isReady(), false);
+
+    logLabel = "test that the agent is ready before the device thread initialized the actor";
+    ExpectEq(pso->isReady(), true);
+
+    logLabel = "test that the actor is ready once the device thread initialized it";
+    deviceAgent->getMessageQueue()->kickAndWait();
+    ExpectEq(actor->isReady(), true);
+    ExpectEq(pso->isReady(), true);
+
+    pso->destroy();
+    deviceAgent->getMessageQueue()->kickAndWait();
+}
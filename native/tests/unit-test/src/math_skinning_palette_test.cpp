@@ -0,0 +1,137 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/MathUtil.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/math/Vec3.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+struct Skeleton {
+    std::vector<cc::Mat4> worlds;
+    std::vector<cc::Mat4> bindposes;
+    std::vector<float> bounds;
+    std::vector<const float *> worldPointers;
+};
+
+Skeleton createSkeleton(uint32_t jointCount) {
+    Skeleton skeleton;
+    skeleton.worlds.resize(jointCount);
+    skeleton.bindposes.resize(jointCount);
+    for (uint32_t i = 0; i < jointCount; ++i) {
+        const auto f = static_cast<float>(i);
+        cc::Quaternion rotation;
+        cc::Quaternion::createFromAxisAngle(cc::Vec3(0.2F, 1, 0.4F).getNormalized(), 0.1F * f, &rotation);
+        cc::Mat4::fromRTS(rotation, cc::Vec3(0.1F * f, f, 0), cc::Vec3(1, 1 + 0.01F * f, 0.5F), &skeleton.worlds[i]);
+        cc::Mat4::fromRTS(cc::Quaternion::identity(), cc::Vec3(0, -f, 0), cc::Vec3::ONE, &skeleton.bindposes[i]);
+        skeleton.bounds.insert(skeleton.bounds.end(), {0.01F * f, 0.5F, -0.2F, 0.1F, 0.5F, 0.1F + 0.01F * f});
+        skeleton.worldPointers.push_back(skeleton.worlds[i].m);
+    }
+    return skeleton;
+}
+
+// the per joint path SkinningModel used before computeSkinningPalette:
+// AABB::transform for the bounds in updateTransform, Mat4::multiply and uploadJointData in prepareUBOs
+void computePalettePerJoint(const Skeleton &skeleton, float *palette, cc::Vec3 *boundsMin, cc::Vec3 *boundsMax) {
+    *boundsMin = cc::Vec3{INFINITY, INFINITY, INFINITY};
+    *boundsMax = cc::Vec3{-INFINITY, -INFINITY, -INFINITY};
+    cc::geometry::AABB bound;
+    cc::geometry::AABB ab1;
+    cc::Vec3 v31;
+    cc::Vec3 v32;
+    cc::Mat4 mat4;
+    for (size_t i = 0; i < skeleton.worlds.size(); ++i) {
+        const float *packed = skeleton.bounds.data() + i * 6;
+        bound.set(cc::Vec3{packed[0], packed[1], packed[2]}, cc::Vec3{packed[3], packed[4], packed[5]});
+        bound.transform(skeleton.worlds[i], &ab1);
+        ab1.getBoundary(&v31, &v32);
+        cc::Vec3::min(*boundsMin, v31, boundsMin);
+        cc::Vec3::max(*boundsMax, v32, boundsMax);
+
+        cc::Mat4::multiply(skeleton.worlds[i], skeleton.bindposes[i], &mat4);
+        float *dst = palette + i * 12;
+        memcpy(dst, mat4.m, sizeof(float) * 12);
+        dst[3] = mat4.m[12];
+        dst[7] = mat4.m[13];
+        dst[11] = mat4.m[14];
+    }
+}
+
+} // namespace
+
+TEST(mathSkinningPaletteTest, matchesPerJointPath) {
+    logLabel = "compare MathUtil computeSkinningPalette with the per joint skinning path";
+    for (uint32_t jointCount : {1U, 30U, 60U, 120U}) {
+        Skeleton skeleton = createSkeleton(jointCount);
+        std::vector<float> expectedPalette(jointCount * 12);
+        std::vector<float> palette(jointCount * 12);
+        cc::Vec3 expectedMin;
+        cc::Vec3 expectedMax;
+        cc::Vec3 boundsMin;
+        cc::Vec3 boundsMax;
+
+        computePalettePerJoint(skeleton, expectedPalette.data(), &expectedMin, &expectedMax);
+        cc::MathUtil::computeSkinningPalette(skeleton.worldPointers.data(), skeleton.bindposes[0].m, skeleton.bounds.data(), jointCount,
+                                             palette.data(), &boundsMin.x, &boundsMax.x);
+
+        bool paletteMatches = true;
+        for (uint32_t i = 0; i < jointCount * 12; ++i) {
+            paletteMatches = paletteMatches && IsEqualF(expectedPalette[i], palette[i]);
+        }
+        ExpectEq(paletteMatches, true);
+        ExpectEq(expectedMin.approxEquals(boundsMin) && expectedMax.approxEquals(boundsMax), true);
+    }
+}
+
+TEST(mathSkinningPaletteTest, rootBoundJoint) {
+    logLabel = "a joint bound to the skinning root reads Mat4::IDENTITY like getWorldMatrix(nullptr) did";
+    const uint32_t jointCount = 4;
+    Skeleton skeleton = createSkeleton(jointCount);
+    // joint path "" resolves to the skinning root, which has no joint transform
+    skeleton.worlds[0] = cc::Mat4::IDENTITY;
+    skeleton.worldPointers[0] = cc::Mat4::IDENTITY.m;
+    std::vector<float> expectedPalette(jointCount * 12);
+    std::vector<float> palette(jointCount * 12);
+    cc::Vec3 expectedMin;
+    cc::Vec3 expectedMax;
+    cc::Vec3 boundsMin;
+    cc::Vec3 boundsMax;
+
+    computePalettePerJoint(skeleton, expectedPalette.data(), &expectedMin, &expectedMax);
+    cc::MathUtil::computeSkinningPalette(skeleton.worldPointers.data(), skeleton.bindposes[0].m, skeleton.bounds.data(), jointCount,
+                                         palette.data(), &boundsMin.x, &boundsMax.x);
+
+    bool paletteMatches = true;
+    for (uint32_t i = 0; i < jointCount * 12; ++i) {
+        paletteMatches = paletteMatches && IsEqualF(expectedPalette[i], palette[i]);
+    }
+    ExpectEq(paletteMatches, true);
+    ExpectEq(expectedMin.approxEquals(boundsMin) && expectedMax.approxEquals(boundsMax), true);
+}
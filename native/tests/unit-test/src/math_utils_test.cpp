@@ -23,6 +23,9 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "gtest/gtest.h"
 #include "cocos/math/Vec2.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/math/Vec3.h"
 #include "cocos/math/Math.h"
 #include "cocos/math/MathUtil.h"
 #include "utils.h"
@@ -41,4 +44,79 @@ TEST(mathUtilsTest, test9) {
     logLabel = "test the MathUtil lerp function";
     float res = cc::MathUtil::lerp(2, 15, 0.8);
     ExpectEq(IsEqualF(res, 12.3999996), true);
-}
\ No newline at end of file
+}
+TEST(mathUtilsTest, cullAABBs) {
+    logLabel = "test the MathUtil cullAABBs function";
+    // planes of the unit cube, normals point to the inside
+    const float planes[] = {
+        1, 0, 0, -1,
+        -1, 0, 0, -1,
+        0, 1, 0, -1,
+        0, -1, 0, -1,
+        0, 0, 1, -1,
+        0, 0, -1, -1,
+    };
+    // 7 boxes so that both the SIMD batch and the scalar tail are exercised
+    std::vector<float> centerX{0, 3, -1.5F, 0, 0, 2.5F, 0};
+    std::vector<float> centerY{0, 0, 0, 5, 0, 0, -1.2F};
+    std::vector<float> centerZ{0, 0, 0, 0, -3, 0, 0};
+    std::vector<float> halfX{0.5F, 1, 1, 1, 1, 2, 1};
+    std::vector<float> halfY{0.5F, 1, 1, 1, 1, 1, 0.5F};
+    std::vector<float> halfZ{0.5F, 1, 1, 1, 1.5F, 1, 1};
+    const float *const bounds[6] = {centerX.data(), centerY.data(), centerZ.data(), halfX.data(), halfY.data(), halfZ.data()};
+
+    std::vector<uint32_t> indices(centerX.size());
+    uint32_t count = cc::MathUtil::cullAABBs(bounds, static_cast<uint32_t>(centerX.size()), planes, 6, indices.data());
+    ExpectEq(count == 4, true);
+    ExpectEq(indices[0] == 0 && indices[1] == 2 && indices[2] == 5 && indices[3] == 6, true);
+}
+TEST(mathUtilsTest, computeSkinningPalette) {
+    logLabel = "test the MathUtil computeSkinningPalette function";
+    const uint32_t jointCount = 5;
+    std::vector<cc::Mat4> worlds(jointCount);
+    std::vector<cc::Mat4> bindposes(jointCount);
+    std::vector<float> bounds;
+    std::vector<const float *> worldPointers;
+    for (uint32_t i = 0; i < jointCount; ++i) {
+        cc::Quaternion rotation;
+        cc::Quaternion::createFromAxisAngle(cc::Vec3(0.3F, 1, 0.2F).getNormalized(), 0.4F * static_cast<float>(i), &rotation);
+        cc::Mat4::fromRTS(rotation, cc::Vec3(static_cast<float>(i), 1, -2), cc::Vec3(1, 1.5F, 0.5F + static_cast<float>(i)), &worlds[i]);
+        cc::Mat4::fromRTS(cc::Quaternion::identity(), cc::Vec3(-1, static_cast<float>(i), 0), cc::Vec3::ONE, &bindposes[i]);
+        bounds.insert(bounds.end(), {0.1F * static_cast<float>(i), 0, 1, 0.5F, 1, 0.25F});
+        worldPointers.push_back(worlds[i].m);
+    }
+
+    std::vector<float> palette(jointCount * 12);
+    cc::Vec3 boundsMin;
+    cc::Vec3 boundsMax;
+    cc::MathUtil::computeSkinningPalette(worldPointers.data(), bindposes[0].m, bounds.data(), jointCount, palette.data(), &boundsMin.x, &boundsMax.x);
+
+    bool paletteMatches = true;
+    cc::Vec3 expectedMin{INFINITY, INFINITY, INFINITY};
+    cc::Vec3 expectedMax{-INFINITY, -INFINITY, -INFINITY};
+    for (uint32_t i = 0; i < jointCount; ++i) {
+        cc::Mat4 skinning;
+        cc::Mat4::multiply(worlds[i], bindposes[i], &skinning);
+        const float expected[12] = {
+            skinning.m[0], skinning.m[1], skinning.m[2], skinning.m[12],
+            skinning.m[4], skinning.m[5], skinning.m[6], skinning.m[13],
+            skinning.m[8], skinning.m[9], skinning.m[10], skinning.m[14]};
+        for (uint32_t j = 0; j < 12; ++j) {
+            paletteMatches = paletteMatches && IsEqualF(palette[i * 12 + j], expected[j]);
+        }
+
+        const float *bound = bounds.data() + i * 6;
+        const float *m = worlds[i].m;
+        cc::Vec3 center{bound[0], bound[1], bound[2]};
+        center.transformMat4(center, worlds[i]);
+        cc::Vec3 extent{
+            std::abs(m[0]) * bound[3] + std::abs(m[4]) * bound[4] + std::abs(m[8]) * bound[5],
+            std::abs(m[1]) * bound[3] + std::abs(m[5]) * bound[4] + std::abs(m[9]) * bound[5],
+            std::abs(m[2]) * bound[3] + std::abs(m[6]) * bound[4] + std::abs(m[10]) * bound[5]};
+        cc::Vec3::min(expectedMin, center - extent, &expectedMin);
+        cc::Vec3::max(expectedMax, center + extent, &expectedMax);
+    }
+    ExpectEq(paletteMatches, true);
+    ExpectEq(IsEqualF(boundsMin.x, expectedMin.x) && IsEqualF(boundsMin.y, expectedMin.y) && IsEqualF(boundsMin.z, expectedMin.z), true);
+    ExpectEq(IsEqualF(boundsMax.x, expectedMax.x) && IsEqualF(boundsMax.y, expectedMax.y) && IsEqualF(boundsMax.z, expectedMax.z), true);
+}
@@ -0,0 +1,209 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "base/memory/Memory.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+#if CC_USE_MEMORY_TAGGING
+
+TEST(MemoryTagTest, scope) {
+    const auto bytes = MemoryTracker::getBytes(MemoryTag::AUDIO);
+    const auto count = MemoryTracker::getCount(MemoryTag::AUDIO);
+
+    void *ptr = nullptr;
+    {
+        CC_MEMORY_TAG_SCOPE(AUDIO);
+        EXPECT_EQ(MemoryTracker::getCurrentTag(), MemoryTag::AUDIO);
+        ptr = CC_MALLOC(100);
+    }
+    EXPECT_EQ(MemoryTracker::getCurrentTag(), MemoryTag::UNTAGGED);
+    EXPECT_EQ(MemoryTracker::getTag(ptr), MemoryTag::AUDIO);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::AUDIO), bytes + 100);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::AUDIO), count + 1);
+
+    // grows and shrinks under the tag it was allocated with
+    ptr = CC_REALLOC(ptr, 300);
+    EXPECT_EQ(MemoryTracker::getTag(ptr), MemoryTag::AUDIO);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::AUDIO), bytes + 300);
+    ptr = CC_REALLOC(ptr, 50);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::AUDIO), bytes + 50);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::AUDIO), count + 1);
+
+    CC_FREE(ptr);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::AUDIO), bytes);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::AUDIO), count);
+}
+
+TEST(MemoryTagTest, nestedScope) {
+    CC_MEMORY_TAG_SCOPE(ASSETS);
+    {
+        CC_MEMORY_TAG_SCOPE(GFX);
+        EXPECT_EQ(MemoryTracker::getCurrentTag(), MemoryTag::GFX);
+    }
+    EXPECT_EQ(MemoryTracker::getCurrentTag(), MemoryTag::ASSETS);
+}
+
+TEST(MemoryTagTest, aligned) {
+    const auto bytes = MemoryTracker::getBytes(MemoryTag::GFX);
+
+    void *ptr = nullptr;
+    {
+        CC_MEMORY_TAG_SCOPE(GFX);
+        ptr = CC_MALLOC_ALIGN(64, 64);
+    }
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::GFX), bytes + 64);
+
+    CC_FREE_ALIGN(ptr);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::GFX), bytes);
+}
+
+TEST(MemoryTagTest, freedOnAnotherThread) {
+    const auto bytes = MemoryTracker::getBytes(MemoryTag::SPINE);
+
+    void *ptr = nullptr;
+    {
+        CC_MEMORY_TAG_SCOPE(SPINE);
+        ptr = CC_MALLOC(32);
+    }
+    std::thread([ptr] {
+        // scopes are per thread, the allocation still knows its tag
+        EXPECT_EQ(MemoryTracker::getCurrentTag(), MemoryTag::UNTAGGED);
+        CC_FREE(ptr);
+    }).join();
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::SPINE), bytes);
+}
+
+TEST(MemoryTagTest, mismatchedFree) {
+    // memory from malloc carries no stamp, CC_FREE releases it without touching any counter
+    void *plain = malloc(24);
+    memset(plain, 0, 24);
+    const auto untaggedBytes = MemoryTracker::getBytes(MemoryTag::UNTAGGED);
+    const auto untaggedCount = MemoryTracker::getCount(MemoryTag::UNTAGGED);
+    CC_FREE(plain);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::UNTAGGED), untaggedBytes);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::UNTAGGED), untaggedCount);
+
+    // and CC_MALLOC memory handed to free(), as third-party deleters do, is released correctly and stays counted
+    const auto bytes = MemoryTracker::getBytes(MemoryTag::BINDINGS);
+    const auto count = MemoryTracker::getCount(MemoryTag::BINDINGS);
+    void *ptr = nullptr;
+    {
+        CC_MEMORY_TAG_SCOPE(BINDINGS);
+        ptr = CC_MALLOC(4000);
+    }
+    free(ptr);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::BINDINGS), bytes + 4000);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::BINDINGS), count + 1);
+}
+
+TEST(MemoryTagTest, untrackedContent) {
+    // whatever an untracked block holds, e.g. what looks like a tag stamp in its last bytes, it is not taken for tracked memory
+    constexpr uint32_t stamp = 0x43435407U;
+    constexpr size_t size = 64;
+    auto *words = static_cast<uint32_t *>(malloc(size));
+    for (size_t i = 0; i < size / sizeof(uint32_t); ++i) {
+        words[i] = stamp;
+    }
+    uint64_t bytes[static_cast<size_t>(MemoryTag::COUNT)];
+    uint32_t counts[static_cast<size_t>(MemoryTag::COUNT)];
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::COUNT); ++i) {
+        bytes[i] = MemoryTracker::getBytes(static_cast<MemoryTag>(i));
+        counts[i] = MemoryTracker::getCount(static_cast<MemoryTag>(i));
+    }
+
+    EXPECT_EQ(MemoryTracker::getTag(words), MemoryTag::UNTAGGED);
+    {
+        CC_MEMORY_TAG_SCOPE(AUDIO);
+        // reallocating keeps it untracked
+        words = static_cast<uint32_t *>(CC_REALLOC(words, size * 2));
+        for (size_t i = 0; i < size * 2 / sizeof(uint32_t); ++i) {
+            words[i] = stamp;
+        }
+    }
+    CC_FREE(words);
+
+    // nothing is counted, counters may only go down when the block reuses the address of a tracked one released with free()
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::COUNT); ++i) {
+        EXPECT_LE(MemoryTracker::getBytes(static_cast<MemoryTag>(i)), bytes[i]);
+        EXPECT_LE(MemoryTracker::getCount(static_cast<MemoryTag>(i)), counts[i]);
+    }
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::AUDIO), bytes[static_cast<size_t>(MemoryTag::AUDIO)]);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::UNTAGGED), bytes[static_cast<size_t>(MemoryTag::UNTAGGED)]);
+}
+
+TEST(MemoryTagTest, manyAllocations) {
+    // enough live blocks to grow the address table several times
+    const auto bytes = MemoryTracker::getBytes(MemoryTag::ASSETS);
+    const auto count = MemoryTracker::getCount(MemoryTag::ASSETS);
+    std::vector<void *> blocks;
+    blocks.reserve(10000);
+    {
+        CC_MEMORY_TAG_SCOPE(ASSETS);
+        for (uint32_t i = 0; i < 10000; ++i) {
+            blocks.push_back(CC_MALLOC(16));
+        }
+    }
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::ASSETS), bytes + 16 * 10000);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::ASSETS), count + 10000);
+    for (uint32_t i = 0; i < 10000; i += 2) {
+        CC_FREE(blocks[i]);
+    }
+    for (uint32_t i = 1; i < 10000; i += 2) {
+        EXPECT_EQ(MemoryTracker::getTag(blocks[i]), MemoryTag::ASSETS);
+        CC_FREE(blocks[i]);
+    }
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::ASSETS), bytes);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::ASSETS), count);
+}
+
+    #if CC_USE_MEMORY_TAGGING_NEW
+
+TEST(MemoryTagTest, newAllocations) {
+    const auto bytes = MemoryTracker::getBytes(MemoryTag::DRAGONBONES);
+    const auto count = MemoryTracker::getCount(MemoryTag::DRAGONBONES);
+
+    uint64_t *object = nullptr;
+    {
+        CC_MEMORY_TAG_SCOPE(DRAGONBONES);
+        object = ccnew uint64_t[8];
+    }
+    EXPECT_EQ(MemoryTracker::getTag(object), MemoryTag::DRAGONBONES);
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::DRAGONBONES), bytes + sizeof(uint64_t) * 8);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::DRAGONBONES), count + 1);
+
+    delete[] object;
+    EXPECT_EQ(MemoryTracker::getBytes(MemoryTag::DRAGONBONES), bytes);
+    EXPECT_EQ(MemoryTracker::getCount(MemoryTag::DRAGONBONES), count);
+}
+
+    #endif
+
+#endif
@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXInputAssembler.h"
+#include "renderer/pipeline/IndirectDraw.h"
+
+#include "utils.h"
+
+using namespace cc;
+using namespace pipeline;
+
+TEST(pipelineIndirectDrawTest, drawArgs) {
+    gfx::DrawInfo drawInfo;
+    drawInfo.indexCount = 36;
+    drawInfo.firstIndex = 6;
+    drawInfo.vertexOffset = 2;
+    drawInfo.firstInstance = 5;
+
+    const auto args = getIndirectDrawArgs(drawInfo, 17);
+    logLabel = "geometry is kept";
+    ExpectEq(args.indexCount == 36 && args.firstIndex == 6 && args.vertexOffset == 2, true);
+    logLabel = "instances start at the compacted buffer";
+    ExpectEq(args.instanceCount == 17 && args.firstInstance == 0, true);
+}
+
+TEST(pipelineIndirectDrawTest, switchesInputAssembler) {
+    // the tests run on gfx-empty, behind gfx-validator in debug builds, which checks the draw-args buffer and its uploads
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    constexpr uint32_t STRIDE = 12;
+    auto *vb = device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        64 * STRIDE,
+        STRIDE,
+    });
+    gfx::InputAssemblerInfo iaInfo = {{{"a_position", gfx::Format::RGB32F}}, {vb}};
+    auto *ia = device->createInputAssembler(iaInfo);
+    ia->setVertexCount(24);
+
+    gfx::Buffer *indirectBuffer = nullptr;
+    gfx::DrawInfo uploadedArgs;
+    setIndirectDraw(device, ia, indirectBuffer, uploadedArgs, true);
+    logLabel = "indirect input assembler";
+    ExpectEq(indirectBuffer != nullptr && ia->getIndirectBuffer() == indirectBuffer, true);
+    ExpectEq(ia->getVertexCount() == 24, true);
+
+    auto *cmdBuff = device->getCommandBuffer();
+    cmdBuff->begin();
+    logLabel = "draw args are uploaded once";
+    ExpectEq(updateIndirectDrawArgs(cmdBuff, indirectBuffer, getIndirectDrawArgs(ia->getDrawInfo(), 8), uploadedArgs), true);
+    ExpectEq(updateIndirectDrawArgs(cmdBuff, indirectBuffer, getIndirectDrawArgs(ia->getDrawInfo(), 8), uploadedArgs), false);
+    logLabel = "a new compacted count is uploaded";
+    ExpectEq(updateIndirectDrawArgs(cmdBuff, indirectBuffer, getIndirectDrawArgs(ia->getDrawInfo(), 9), uploadedArgs), true);
+    ExpectEq(uploadedArgs.instanceCount == 9 && uploadedArgs.vertexCount == 24, true);
+    cmdBuff->end();
+
+    logLabel = "unchanged mode keeps the input assembler";
+    auto *indirectIA = ia;
+    setIndirectDraw(device, ia, indirectBuffer, uploadedArgs, true);
+    ExpectEq(ia == indirectIA, true);
+
+    logLabel = "direct input assembler";
+    setIndirectDraw(device, ia, indirectBuffer, uploadedArgs, false);
+    ExpectEq(indirectBuffer == nullptr && ia->getIndirectBuffer() == nullptr, true);
+    ExpectEq(ia->getVertexCount() == 24 && uploadedArgs.instanceCount == 0, true);
+
+    CC_SAFE_DESTROY_AND_DELETE(ia);
+    CC_SAFE_DESTROY_AND_DELETE(vb);
+}
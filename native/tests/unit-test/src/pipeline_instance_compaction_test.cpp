@@ -0,0 +1,205 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/InstanceCompaction.h"
+
+#include "utils.h"
+
+using namespace cc;
+using namespace pipeline;
+
+namespace {
+constexpr uint32_t STRIDE = 48;
+constexpr uint32_t INSTANCE_COUNT = 200;
+
+// straightforward gather of the visible instances the compaction has to agree with
+ccstd::vector<uint8_t> referenceCompaction(const ccstd::vector<uint8_t> &instances, const ccstd::vector<uint32_t> &visible) {
+    ccstd::vector<uint8_t> result;
+    for (auto index : visible) {
+        result.insert(result.end(), instances.begin() + index * STRIDE, instances.begin() + (index + 1) * STRIDE);
+    }
+    return result;
+}
+} // namespace
+
+TEST(pipelineInstanceCompactionTest, compactVisibleInstances) {
+    std::mt19937 rng(7);
+    ccstd::vector<uint8_t> instances(INSTANCE_COUNT * STRIDE);
+    for (auto &byte : instances) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    ccstd::vector<uint8_t> dst(INSTANCE_COUNT * STRIDE);
+    uint32_t validCount = 0;
+    for (uint32_t frame = 0; frame < 8; ++frame) {
+        ccstd::vector<uint32_t> visible;
+        for (uint32_t i = 0; i < INSTANCE_COUNT; ++i) {
+            if (rng() % 3) visible.push_back(i);
+        }
+        ccstd::vector<const uint8_t *> sources;
+        for (auto index : visible) {
+            sources.push_back(instances.data() + index * STRIDE);
+        }
+
+        const auto count = static_cast<uint32_t>(visible.size());
+        const auto dirty = compactVisibleInstances(sources.data(), count, STRIDE, dst.data(), validCount);
+        validCount = std::max(validCount, dirty.last);
+
+        logLabel = "frame " + std::to_string(frame);
+        ExpectEq(dirty.first <= dirty.last && dirty.last <= count, true);
+        ExpectEq(memcmp(dst.data(), referenceCompaction(instances, visible).data(), count * STRIDE) == 0, true);
+
+        // the same visible set again uploads nothing
+        ExpectEq(compactVisibleInstances(sources.data(), count, STRIDE, dst.data(), validCount).empty(), true);
+    }
+}
+
+TEST(pipelineInstanceCompactionTest, onlyChangedRangeIsDirty) {
+    ccstd::vector<uint8_t> instances(INSTANCE_COUNT * STRIDE, 1);
+    ccstd::vector<const uint8_t *> sources;
+    for (uint32_t i = 0; i < INSTANCE_COUNT; ++i) {
+        sources.push_back(instances.data() + i * STRIDE);
+    }
+
+    ccstd::vector<uint8_t> dst(INSTANCE_COUNT * STRIDE);
+    logLabel = "first upload";
+    auto dirty = compactVisibleInstances(sources.data(), INSTANCE_COUNT, STRIDE, dst.data(), 0);
+    ExpectEq(dirty.first == 0U && dirty.last == INSTANCE_COUNT, true);
+
+    logLabel = "single moved instance";
+    instances[37 * STRIDE + 5] = 2;
+    dirty = compactVisibleInstances(sources.data(), INSTANCE_COUNT, STRIDE, dst.data(), INSTANCE_COUNT);
+    ExpectEq(dirty.first == 37U && dirty.last == 38U, true);
+
+    logLabel = "last instance only";
+    instances[(INSTANCE_COUNT - 1) * STRIDE] = 2;
+    dirty = compactVisibleInstances(sources.data(), INSTANCE_COUNT, STRIDE, dst.data(), INSTANCE_COUNT);
+    ExpectEq(dirty.first == INSTANCE_COUNT - 1 && dirty.last == INSTANCE_COUNT, true);
+
+    logLabel = "two moved instances";
+    instances[12 * STRIDE] = 3;
+    instances[80 * STRIDE] = 3;
+    dirty = compactVisibleInstances(sources.data(), INSTANCE_COUNT, STRIDE, dst.data(), INSTANCE_COUNT);
+    ExpectEq(dirty.first == 12U && dirty.last == 81U, true);
+
+    logLabel = "slots beyond the valid count";
+    dirty = compactVisibleInstances(sources.data(), INSTANCE_COUNT, STRIDE, dst.data(), 150);
+    ExpectEq(dirty.first == 150U && dirty.last == INSTANCE_COUNT, true);
+}
+
+TEST(pipelineInstanceCompactionTest, compactVisibleVertices) {
+    // batched models contribute a varying number of vertices each
+    constexpr uint32_t MODEL_COUNT = 40;
+    std::mt19937 rng(11);
+    ccstd::vector<ccstd::vector<uint8_t>> models(MODEL_COUNT);
+    for (auto &model : models) {
+        model.resize((1 + rng() % 6) * STRIDE);
+        for (auto &byte : model) {
+            byte = static_cast<uint8_t>(rng());
+        }
+    }
+
+    ccstd::vector<uint8_t> dst(MODEL_COUNT * 6 * STRIDE);
+    uint32_t validCount = 0;
+    for (uint32_t frame = 0; frame < 8; ++frame) {
+        ccstd::vector<const uint8_t *> sources;
+        ccstd::vector<uint32_t> vertexCounts;
+        ccstd::vector<uint8_t> reference;
+        for (const auto &model : models) {
+            if (!(rng() % 3)) continue;
+            sources.push_back(model.data());
+            vertexCounts.push_back(static_cast<uint32_t>(model.size()) / STRIDE);
+            reference.insert(reference.end(), model.begin(), model.end());
+        }
+
+        const auto count = static_cast<uint32_t>(sources.size());
+        const auto vertexCount = static_cast<uint32_t>(reference.size()) / STRIDE;
+        const auto dirty = compactVisibleVertices(sources.data(), vertexCounts.data(), count, STRIDE, dst.data(), validCount);
+        validCount = std::max(validCount, vertexCount);
+
+        logLabel = "frame " + std::to_string(frame);
+        ExpectEq(dirty.first <= dirty.last && dirty.last <= vertexCount, true);
+        ExpectEq(memcmp(dst.data(), reference.data(), reference.size()) == 0, true);
+
+        // the same visible set again uploads nothing
+        ExpectEq(compactVisibleVertices(sources.data(), vertexCounts.data(), count, STRIDE, dst.data(), validCount).empty(), true);
+    }
+
+    logLabel = "a changed model dirties its own vertices";
+    ccstd::vector<const uint8_t *> sources = {models[0].data(), models[1].data(), models[2].data()};
+    ccstd::vector<uint32_t> vertexCounts;
+    for (uint32_t i = 0; i < 3; ++i) {
+        vertexCounts.push_back(static_cast<uint32_t>(models[i].size()) / STRIDE);
+    }
+    const uint32_t total = vertexCounts[0] + vertexCounts[1] + vertexCounts[2];
+    compactVisibleVertices(sources.data(), vertexCounts.data(), 3, STRIDE, dst.data(), 0);
+    models[1][0] ^= 0xFF;
+    auto dirty = compactVisibleVertices(sources.data(), vertexCounts.data(), 3, STRIDE, dst.data(), total);
+    ExpectEq(dirty.first == vertexCounts[0] && dirty.last == vertexCounts[0] + vertexCounts[1], true);
+}
+
+TEST(pipelineInstanceCompactionTest, uploadsThroughDevice) {
+    // the tests run on gfx-empty, behind gfx-validator in debug builds, which checks every upload against the buffer
+    auto *device = gfx::Device::getInstance();
+    ASSERT_NE(device, nullptr);
+    auto *vb = device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        INSTANCE_COUNT * STRIDE,
+        STRIDE,
+    });
+
+    ccstd::vector<uint8_t> instances(INSTANCE_COUNT * STRIDE, 3);
+    ccstd::vector<const uint8_t *> sources;
+    for (uint32_t i = 0; i < INSTANCE_COUNT; i += 2) {
+        sources.push_back(instances.data() + i * STRIDE);
+    }
+    ccstd::vector<uint8_t> dst(INSTANCE_COUNT * STRIDE);
+    const auto count = static_cast<uint32_t>(sources.size());
+    auto dirty = compactVisibleInstances(sources.data(), count, STRIDE, dst.data(), 0);
+    logLabel = "upload fits the instance buffer";
+    ExpectEq(dirty.first == 0U && dirty.last == count && count * STRIDE <= vb->getSize(), true);
+
+    auto *cmdBuff = device->getCommandBuffer();
+    cmdBuff->begin();
+    cmdBuff->updateBuffer(vb, dst.data(), dirty.last * STRIDE);
+
+    // a change in the last instance uploads only its slot
+    instances[(INSTANCE_COUNT - 2) * STRIDE] = 4;
+    dirty = compactVisibleInstances(sources.data(), count, STRIDE, dst.data(), count);
+    ExpectEq(dirty.first == count - 1 && dirty.last == count, true);
+    const uint32_t offset = dirty.first * STRIDE;
+    cmdBuff->updateBuffer(vb, dst.data() + offset, (dirty.last - dirty.first) * STRIDE, offset);
+    cmdBuff->end();
+
+    CC_SAFE_DESTROY_AND_DELETE(vb);
+}
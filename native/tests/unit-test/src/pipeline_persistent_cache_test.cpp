@@ -0,0 +1,186 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <cstring>
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXRenderPass.h"
+#include "renderer/pipeline/PersistentPipelineCache.h"
+
+#include "utils.h"
+
+using namespace cc;
+using namespace pipeline;
+
+namespace {
+ccstd::vector<uint8_t> makeBinary(uint8_t seed, uint32_t size) {
+    ccstd::vector<uint8_t> binary(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        binary[i] = static_cast<uint8_t>(seed + i);
+    }
+    return binary;
+}
+
+void store(PersistentPipelineCache &cache, uint64_t key, const ccstd::vector<uint8_t> &binary) {
+    cache.store(key, binary.data(), static_cast<uint32_t>(binary.size()));
+}
+
+bool contains(PersistentPipelineCache &cache, uint64_t key, const ccstd::vector<uint8_t> &expected) {
+    ccstd::vector<uint8_t> data;
+    return cache.load(key, data) && data == expected;
+}
+} // namespace
+
+TEST(pipelinePersistentCacheTest, saveAndLoad) {
+    logLabel = "test that a saved pipeline cache blob loads back";
+    const auto first = makeBinary(1, 64);
+    const auto second = makeBinary(7, 300);
+    const ccstd::vector<uint8_t> pipelineCache{1, 2, 3, 4, 5};
+
+    PersistentPipelineCache cache;
+    store(cache, 11, first);
+    store(cache, 22, second);
+    ccstd::vector<uint8_t> blob;
+    cache.serialize(pipelineCache, blob);
+
+    PersistentPipelineCache restored;
+    ccstd::vector<uint8_t> restoredPipelineCache;
+    ExpectEq(restored.deserialize(blob.data(), blob.size(), restoredPipelineCache), true);
+    ExpectEq(restoredPipelineCache == pipelineCache, true);
+    ExpectEq(contains(restored, 11, first), true);
+    ExpectEq(contains(restored, 22, second), true);
+    ExpectEq(contains(restored, 33, first), false);
+    EXPECT_EQ(restored.getStats().binaryBytes, first.size() + second.size());
+}
+
+TEST(pipelinePersistentCacheTest, invalidBlob) {
+    logLabel = "test that invalid pipeline cache blobs are rejected";
+    const auto binary = makeBinary(3, 128);
+    PersistentPipelineCache cache;
+    store(cache, 11, binary);
+    ccstd::vector<uint8_t> blob;
+    cache.serialize({9, 9, 9}, blob);
+
+    PersistentPipelineCache restored;
+    ccstd::vector<uint8_t> pipelineCache;
+    bool allTruncationsRejected = true;
+    for (size_t size = 0; size < blob.size(); ++size) {
+        allTruncationsRejected = allTruncationsRejected && !restored.deserialize(blob.data(), size, pipelineCache);
+        allTruncationsRejected = allTruncationsRejected && pipelineCache.empty() && !contains(restored, 11, binary);
+    }
+    ExpectEq(allTruncationsRejected, true);
+
+    auto corrupted = blob;
+    corrupted[0] ^= 0xFF;
+    ExpectEq(restored.deserialize(corrupted.data(), corrupted.size(), pipelineCache), false);
+
+    // a count larger than the rest of the blob must not be trusted
+    corrupted = blob;
+    const uint32_t hugeCount = 0xFFFFFFFFU;
+    memcpy(corrupted.data() + sizeof(uint32_t) * 2 + sizeof(uint64_t), &hugeCount, sizeof(hugeCount));
+    ExpectEq(restored.deserialize(corrupted.data(), corrupted.size(), pipelineCache), false);
+    EXPECT_EQ(restored.getStats().binaryBytes, 0U);
+
+    // a rejected blob leaves nothing behind that would block a valid one
+    ExpectEq(restored.deserialize(blob.data(), blob.size(), pipelineCache), true);
+    ExpectEq(contains(restored, 11, binary), true);
+}
+
+TEST(pipelinePersistentCacheTest, evictLeastRecentlyUsed) {
+    logLabel = "test that the pipeline cache stays within its size budget";
+    const auto binary = makeBinary(5, 100);
+    PersistentPipelineCache cache;
+    cache.setMaxBinaryBytes(250);
+    store(cache, 1, binary);
+    store(cache, 2, binary);
+    ExpectEq(contains(cache, 1, binary), true);
+    store(cache, 3, binary);
+
+    ExpectEq(contains(cache, 2, binary), false);
+    ExpectEq(contains(cache, 1, binary) && contains(cache, 3, binary), true);
+    EXPECT_EQ(cache.getStats().evictedBinaries, 1U);
+    EXPECT_EQ(cache.getStats().binaryBytes, 200U);
+
+    // the blob keeps the usage order, so a smaller budget keeps the most recently used binary
+    ccstd::vector<uint8_t> blob;
+    cache.serialize({}, blob);
+    PersistentPipelineCache restored;
+    restored.setMaxBinaryBytes(100);
+    ccstd::vector<uint8_t> pipelineCache;
+    ExpectEq(restored.deserialize(blob.data(), blob.size(), pipelineCache), true);
+    ExpectEq(contains(restored, 3, binary), true);
+    ExpectEq(contains(restored, 1, binary), false);
+}
+
+TEST(pipelinePersistentCacheTest, pipelineStatePermutations) {
+    logLabel = "test that permutations keep the pipeline states they were recorded with";
+    auto *device = gfx::Device::getInstance();
+    gfx::RenderPassInfo renderPassInfo;
+    renderPassInfo.colorAttachments.emplace_back();
+    renderPassInfo.colorAttachments[0].format = gfx::Format::RGBA8;
+    renderPassInfo.depthStencilAttachment.format = gfx::Format::DEPTH_STENCIL;
+    IntrusivePtr<gfx::RenderPass> renderPass = device->createRenderPass(renderPassInfo);
+    renderPassInfo.colorAttachments[0].format = gfx::Format::RGBA16F;
+    IntrusivePtr<gfx::RenderPass> hdrRenderPass = device->createRenderPass(renderPassInfo);
+
+    gfx::PipelineStateInfo info;
+    info.renderPass = renderPass;
+    info.inputState.attributes.push_back({"a_position", gfx::Format::RGB32F});
+    info.blendState.targets[0].blend = 1;
+    MacroRecord defines;
+    defines["USE_INSTANCING"] = true;
+    defines["CC_FORWARD_ADD"] = 1;
+
+    PersistentPipelineCache cache;
+    cache.recordPermutation("test-program", defines);
+    cache.recordPermutation("test-program", defines, &info);
+    cache.recordPermutation("test-program", defines, &info);
+    EXPECT_EQ(cache.getPendingWarmUpCount(), 2U);
+
+    auto culled = info;
+    culled.rasterizerState.cullMode = gfx::CullMode::NONE;
+    auto hdr = info;
+    hdr.renderPass = hdrRenderPass;
+    cache.recordPermutation("test-program", defines, &culled);
+    cache.recordPermutation("test-program", defines, &hdr);
+    EXPECT_EQ(cache.getStats().recordedPermutations, 4U);
+
+    ccstd::vector<uint8_t> blob;
+    cache.serialize({}, blob);
+    PersistentPipelineCache restored;
+    ccstd::vector<uint8_t> pipelineCache;
+    ExpectEq(restored.deserialize(blob.data(), blob.size(), pipelineCache), true);
+    EXPECT_EQ(restored.getPendingWarmUpCount(), 4U);
+
+    // the restored permutations keep their keys, recording them again adds nothing
+    restored.recordPermutation("test-program", defines, &info);
+    restored.recordPermutation("test-program", defines, &hdr);
+    restored.recordPermutation("test-program", defines);
+    EXPECT_EQ(restored.getStats().recordedPermutations, 0U);
+
+    // nothing is warmed up before a pipeline is set
+    EXPECT_EQ(restored.warmUp(), 4U);
+    EXPECT_EQ(restored.getStats().warmedUpPipelines, 0U);
+}
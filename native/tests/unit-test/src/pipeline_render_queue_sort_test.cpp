@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <algorithm>
+#include <random>
+#include "gtest/gtest.h"
+#include "renderer/pipeline/RenderQueueSort.h"
+
+#include "utils.h"
+
+using namespace cc;
+using namespace pipeline;
+
+namespace {
+constexpr uint32_t PASS_COUNT = 500;
+
+// few distinct values per field, so every tie-break of the comparators is exercised
+RenderPassList makePasses(uint32_t seed) {
+    std::mt19937 rng(seed);
+    RenderPassList passes(PASS_COUNT);
+    for (auto &pass : passes) {
+        pass.priority = rng() % 4;
+        pass.hash = ((rng() % 3) << 16) | ((rng() % 3) << 8) | (rng() % 2);
+        pass.depth = static_cast<float>(static_cast<int>(rng() % 9) - 4) * 0.5F;
+        pass.shaderID = rng() % 5;
+    }
+    return passes;
+}
+
+bool samePasses(const RenderPassList &lhs, const RenderPassList &rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const RenderPass &a, const RenderPass &b) {
+        return a.priority == b.priority && a.hash == b.hash && a.depth == b.depth && a.shaderID == b.shaderID;
+    });
+}
+
+void testSortMode(RenderQueueSortMode mode, bool (*compareFn)(const RenderPass &, const RenderPass &)) {
+    RenderPassSortScratch scratch;
+    for (uint32_t seed = 0; seed < 4; ++seed) {
+        auto passes = makePasses(seed);
+        ccstd::vector<uint64_t> keys;
+        for (const auto &pass : passes) {
+            ExpectEq(fitsSortKey(pass, mode), true);
+            keys.push_back(getSortKey(pass, mode));
+        }
+
+        auto expected = passes;
+        std::stable_sort(expected.begin(), expected.end(), compareFn);
+        sortRenderPasses(passes, keys, scratch);
+        ExpectEq(samePasses(passes, expected), true);
+    }
+}
+} // namespace
+
+TEST(pipelineRenderQueueSortTest, matchesComparators) {
+    logLabel = "front to back keys order like opaqueCompareFn";
+    testSortMode(RenderQueueSortMode::FRONT_TO_BACK, opaqueCompareFn);
+
+    logLabel = "back to front keys order like transparentCompareFn";
+    testSortMode(RenderQueueSortMode::BACK_TO_FRONT, transparentCompareFn);
+}
+
+TEST(pipelineRenderQueueSortTest, fitsSortKey) {
+    RenderPass pass;
+    pass.priority = 0x100;
+
+    logLabel = "model priority only counts in back to front queues";
+    ExpectEq(fitsSortKey(pass, RenderQueueSortMode::FRONT_TO_BACK), true);
+    ExpectEq(fitsSortKey(pass, RenderQueueSortMode::BACK_TO_FRONT), false);
+
+    logLabel = "the pass hash is limited to 24 bits";
+    pass.priority = 0;
+    pass.hash = 0x1000000;
+    ExpectEq(fitsSortKey(pass, RenderQueueSortMode::FRONT_TO_BACK), false);
+}
+
+TEST(pipelineRenderQueueSortTest, getBuiltinSortMode) {
+    auto mode = RenderQueueSortMode::FRONT_TO_BACK;
+
+    logLabel = "the comparators are recognized";
+    ExpectEq(getBuiltinSortMode(transparentCompareFn, &mode), true);
+    ExpectEq(mode == RenderQueueSortMode::BACK_TO_FRONT, true);
+    ExpectEq(getBuiltinSortMode(opaqueCompareFn, &mode), true);
+    ExpectEq(mode == RenderQueueSortMode::FRONT_TO_BACK, true);
+
+    logLabel = "so are the comparators wrapped by convertQueueSortFunc";
+    ExpectEq(getBuiltinSortMode(convertQueueSortFunc(RenderQueueSortMode::BACK_TO_FRONT), &mode), true);
+    ExpectEq(mode == RenderQueueSortMode::BACK_TO_FRONT, true);
+
+    logLabel = "anything else is a custom comparator, even if it calls a built-in one";
+    mode = RenderQueueSortMode::FRONT_TO_BACK;
+    auto lambda = [](const RenderPass &a, const RenderPass &b) { return transparentCompareFn(a, b); };
+    ExpectEq(getBuiltinSortMode(lambda, &mode), false);
+    ExpectEq(mode == RenderQueueSortMode::FRONT_TO_BACK, true);
+}
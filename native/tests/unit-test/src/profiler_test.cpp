@@ -0,0 +1,404 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include "base/Data.h"
+#include "base/StringUtil.h"
+#include "gtest/gtest.h"
+#include "platform/FileUtils.h"
+#include "profiler/Profiler.h"
+#include "rapidjson/document.h"
+
+using namespace cc;
+
+namespace {
+
+// the ring size of a thread timeline
+constexpr uint32_t TIMELINE_CAPACITY = 1U << 14U;
+
+// the test runner has no file system of its own
+std::unique_ptr<FileUtils> ensureFileUtils() {
+    if (FileUtils::getInstance()) return nullptr;
+    return std::unique_ptr<FileUtils>(createFileUtils());
+}
+
+ccstd::string getTestPath(const char *name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void recordBlocks(Profiler &profiler, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        AutoProfiler outer(&profiler, "Outer");
+        AutoProfiler inner(&profiler, "Inner");
+    }
+}
+
+// one frame on the main thread and one on a worker, both with nested blocks
+void captureTwoThreads(Profiler &profiler) {
+    profiler.beginCapture();
+    profiler.beginFrame();
+    profiler.getObjectStats().renders["DrawCalls"] = 7U;
+    recordBlocks(profiler, 2U);
+    std::thread worker([&profiler]() {
+        profiler.setThreadName("Worker");
+        recordBlocks(profiler, 3U);
+    });
+    worker.join();
+    profiler.endFrame();
+    profiler.endCapture();
+}
+
+class BinaryReader {
+public:
+    explicit BinaryReader(const Data &data) : _data(data.getBytes()), _size(data.getSize()) {}
+
+    template <typename T>
+    T read() {
+        T value{};
+        if (_offset + sizeof(T) <= _size) {
+            memcpy(&value, _data + _offset, sizeof(T));
+        }
+        _offset += sizeof(T);
+        return value;
+    }
+
+    ccstd::string readString() {
+        const auto size = read<uint32_t>();
+        ccstd::string str;
+        if (_offset + size <= _size) {
+            str.assign(reinterpret_cast<const char *>(_data + _offset), size);
+        }
+        _offset += size;
+        return str;
+    }
+
+    inline bool isEnd() const { return _offset == _size; }
+
+private:
+    const unsigned char *_data{nullptr};
+    size_t _size{0U};
+    size_t _offset{0U};
+};
+
+} // namespace
+
+TEST(profilerTest, chromeTraceExport) {
+    auto fileUtils = ensureFileUtils();
+    Profiler profiler;
+    captureTwoThreads(profiler);
+
+    const auto &capture = profiler.getCapture();
+    ASSERT_EQ(capture.frames.size(), 1U);
+    EXPECT_EQ(capture.droppedEvents, 0U);
+    EXPECT_EQ(capture.events.size(), 10U);
+    ASSERT_EQ(capture.threadNames.size(), 2U);
+    EXPECT_EQ(capture.threadNames[0], "MainThread");
+    EXPECT_EQ(capture.threadNames[1], "Worker");
+
+    const auto path = getTestPath("profiler-test.json");
+    ASSERT_TRUE(profiler.exportChromeTrace(path));
+    const auto json = FileUtils::getInstance()->getStringFromFile(path);
+    FileUtils::getInstance()->removeFile(path);
+
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    ASSERT_FALSE(document.HasParseError());
+    EXPECT_STREQ(document["displayTimeUnit"].GetString(), "ms");
+    EXPECT_FALSE(document.HasMember("metadata"));
+
+    uint32_t threadNames = 0U;
+    uint32_t frames = 0U;
+    uint32_t events = 0U;
+    uint32_t workerEvents = 0U;
+    uint32_t counters = 0U;
+    const auto &traceEvents = document["traceEvents"];
+    ASSERT_TRUE(traceEvents.IsArray());
+    for (const auto &event : traceEvents.GetArray()) {
+        const ccstd::string phase = event["ph"].GetString();
+        const ccstd::string name = event["name"].GetString();
+        if (phase == "M") {
+            EXPECT_EQ(name, "thread_name");
+            const ccstd::string threadName = event["args"]["name"].GetString();
+            // the frames get a track of their own after the threads
+            const auto tid = event["tid"].GetUint();
+            EXPECT_EQ(threadName, tid < capture.threadNames.size() ? capture.threadNames[tid] : "Frames");
+            ++threadNames;
+        } else if (phase == "X" && event["tid"].GetUint() == capture.threadNames.size()) {
+            EXPECT_EQ(name, "Frame 0");
+            EXPECT_GE(event["dur"].GetDouble(), 0.0);
+            ++frames;
+        } else if (phase == "X") {
+            EXPECT_TRUE(name == "Outer" || name == "Inner");
+            EXPECT_GE(event["dur"].GetDouble(), 0.0);
+            workerEvents += event["tid"].GetUint() == 1U ? 1U : 0U;
+            ++events;
+        } else if (phase == "C") {
+            EXPECT_EQ(name, "renders.DrawCalls");
+            EXPECT_EQ(event["args"]["value"].GetUint(), 7U);
+            ++counters;
+        } else {
+            ADD_FAILURE() << "unexpected phase " << phase;
+        }
+    }
+    EXPECT_EQ(threadNames, 3U);
+    EXPECT_EQ(frames, 1U);
+    EXPECT_EQ(events, 10U);
+    EXPECT_EQ(workerEvents, 6U);
+    EXPECT_EQ(counters, 1U);
+}
+
+TEST(profilerTest, binaryCaptureExport) {
+    auto fileUtils = ensureFileUtils();
+    Profiler profiler;
+    captureTwoThreads(profiler);
+    const auto &capture = profiler.getCapture();
+
+    const auto path = getTestPath("profiler-test.ccpf");
+    ASSERT_TRUE(profiler.exportBinaryCapture(path));
+    const auto data = FileUtils::getInstance()->getDataFromFile(path);
+    FileUtils::getInstance()->removeFile(path);
+
+    BinaryReader reader(data);
+    EXPECT_EQ(reader.read<uint32_t>(), 0x46504343U);
+    EXPECT_EQ(reader.read<uint32_t>(), 2U);
+    EXPECT_EQ(reader.read<uint32_t>(), 0U);
+
+    ASSERT_EQ(reader.read<uint32_t>(), 2U);
+    EXPECT_EQ(reader.readString(), "MainThread");
+    EXPECT_EQ(reader.readString(), "Worker");
+
+    // interned in the order of the first use
+    const auto nameCount = reader.read<uint32_t>();
+    ASSERT_EQ(nameCount, 2U);
+    ccstd::vector<ccstd::string> names;
+    for (uint32_t i = 0; i < nameCount; ++i) {
+        names.push_back(reader.readString());
+    }
+    EXPECT_EQ(names[0], ccstd::string(capture.events[0].name));
+
+    const auto eventCount = reader.read<uint32_t>();
+    ASSERT_EQ(eventCount, capture.events.size());
+    for (const auto &event : capture.events) {
+        EXPECT_EQ(reader.read<uint64_t>(), event.begin);
+        EXPECT_EQ(reader.read<uint32_t>(), static_cast<uint32_t>(event.end - event.begin));
+        const auto name = reader.read<uint32_t>();
+        ASSERT_LT(name, names.size());
+        EXPECT_EQ(names[name], ccstd::string(event.name));
+        EXPECT_EQ(reader.read<uint16_t>(), event.threadIndex);
+        EXPECT_EQ(reader.read<uint16_t>(), event.depth);
+        EXPECT_EQ(reader.read<uint32_t>(), 0U);
+    }
+
+    ASSERT_EQ(reader.read<uint32_t>(), 1U);
+    EXPECT_EQ(reader.read<uint64_t>(), capture.frames[0].begin);
+    EXPECT_EQ(reader.read<uint64_t>(), capture.frames[0].end);
+
+    ASSERT_EQ(reader.read<uint32_t>(), 1U);
+    EXPECT_EQ(reader.readString(), "renders.DrawCalls");
+    ASSERT_EQ(reader.read<uint32_t>(), 1U);
+    EXPECT_EQ(reader.read<uint32_t>(), 0U);
+    EXPECT_EQ(reader.read<uint32_t>(), 0U);
+    EXPECT_EQ(reader.read<uint32_t>(), 7U);
+    EXPECT_TRUE(reader.isEnd());
+}
+
+TEST(profilerTest, droppedEvents) {
+    Profiler profiler;
+    profiler.beginCapture();
+    profiler.beginFrame();
+    // each iteration closes two blocks, overflowing the ring within the frame
+    recordBlocks(profiler, TIMELINE_CAPACITY / 2U + 50U);
+    profiler.endFrame();
+    profiler.endCapture();
+
+    // the oldest slot left may be overwritten while it is read, so it is discarded as well
+    const auto &capture = profiler.getCapture();
+    EXPECT_EQ(capture.events.size(), TIMELINE_CAPACITY - 1U);
+    EXPECT_EQ(capture.droppedEvents, 101U);
+
+    // nothing is lost as long as every frame fits
+    profiler.beginCapture();
+    for (uint32_t i = 0; i < 4U; ++i) {
+        profiler.beginFrame();
+        recordBlocks(profiler, TIMELINE_CAPACITY / 4U);
+        profiler.endFrame();
+    }
+    profiler.endCapture();
+    EXPECT_EQ(profiler.getCapture().events.size(), TIMELINE_CAPACITY * 2U);
+    EXPECT_EQ(profiler.getCapture().droppedEvents, 0U);
+}
+
+TEST(profilerTest, tornReads) {
+    Profiler profiler;
+    profiler.beginCapture();
+
+    // the worker keeps overwriting its ring while the main thread collects it
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> recorded{0U};
+    std::thread worker([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            AutoProfiler block(&profiler, "Block");
+            recorded.fetch_add(1U, std::memory_order_relaxed);
+        }
+    });
+    for (uint32_t i = 0; i < 20U; ++i) {
+        profiler.beginFrame();
+        profiler.endFrame();
+    }
+    stop = true;
+    worker.join();
+    profiler.endCapture();
+
+    // every block closed is either collected or accounted as dropped
+    const auto &capture = profiler.getCapture();
+    EXPECT_EQ(capture.events.size() + capture.droppedEvents, recorded.load());
+    for (size_t i = 1; i < capture.events.size(); ++i) {
+        EXPECT_LE(capture.events[i - 1].begin, capture.events[i].begin);
+        EXPECT_LE(capture.events[i].begin, capture.events[i].end);
+    }
+}
+
+TEST(profilerTest, exitedThreadTimelinesReused) {
+    Profiler profiler;
+    profiler.beginCapture();
+    for (uint32_t i = 0; i < 8U; ++i) {
+        std::thread worker([&profiler]() {
+            recordBlocks(profiler, 1U);
+        });
+        worker.join();
+    }
+    profiler.endCapture();
+
+    // short-lived threads one after another share a single track
+    const auto &capture = profiler.getCapture();
+    ASSERT_EQ(capture.threadNames.size(), 1U);
+    EXPECT_EQ(capture.threadNames[0], "Thread 0");
+    EXPECT_EQ(capture.events.size(), 16U);
+    EXPECT_EQ(capture.droppedEvents, 0U);
+}
+
+TEST(profilerTest, hitchDump) {
+    auto fileUtils = ensureFileUtils();
+    auto *fs = FileUtils::getInstance();
+    const auto directory = getTestPath("");
+    auto getDumpPath = [&](uint32_t hitch) {
+        return StringUtil::format("%shitch-%u.json", directory.c_str(), hitch);
+    };
+    for (uint32_t hitch = 1; hitch <= 3; ++hitch) {
+        fs->removeFile(getDumpPath(hitch));
+    }
+
+    {
+        Profiler profiler;
+        ProfilerHitchOptions options;
+        options.thresholdMs = 50.F;
+        options.historyFrames = 4U;
+        options.directory = directory;
+        profiler.setHitchDetection(options);
+
+        auto runFrame = [&profiler](uint32_t index, bool stall) {
+            profiler.beginFrame();
+            profiler.getObjectStats().renders["DrawCalls"] = index;
+            recordBlocks(profiler, 1U);
+            if (stall) {
+                AutoProfiler block(&profiler, "Stall");
+                std::this_thread::sleep_for(std::chrono::milliseconds(80));
+            }
+            profiler.endFrame();
+        };
+
+        // dumped two frames after the hitch, once the other threads are done with it
+        for (uint32_t i = 0; i < 7U; ++i) {
+            runFrame(i, i == 4U);
+        }
+        EXPECT_EQ(profiler.getHitchCount(), 1U);
+
+        // within a history length of the last dump, counted but not dumped
+        runFrame(7U, true);
+        runFrame(8U, false);
+        EXPECT_EQ(profiler.getHitchCount(), 2U);
+
+        runFrame(9U, true);
+        runFrame(10U, false);
+        runFrame(11U, false);
+        EXPECT_EQ(profiler.getHitchCount(), 3U);
+    } // joins the writer
+
+    EXPECT_TRUE(fs->isFileExist(getDumpPath(1U)));
+    EXPECT_FALSE(fs->isFileExist(getDumpPath(2U)));
+    EXPECT_TRUE(fs->isFileExist(getDumpPath(3U)));
+
+    const auto json = fs->getStringFromFile(getDumpPath(1U));
+    for (uint32_t hitch = 1; hitch <= 3; ++hitch) {
+        fs->removeFile(getDumpPath(hitch));
+    }
+
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    ASSERT_FALSE(document.HasParseError());
+
+    // the stats snapshot of the hitched frame
+    ASSERT_TRUE(document.HasMember("metadata"));
+    const auto &metadata = document["metadata"];
+    EXPECT_GT(metadata["frameTimeMs"].GetDouble(), 50.0);
+    EXPECT_EQ(metadata["thresholdMs"].GetDouble(), 50.0);
+    EXPECT_TRUE(metadata.HasMember("coreStats"));
+    EXPECT_TRUE(metadata.HasMember("memories"));
+    EXPECT_EQ(metadata["renders"]["DrawCalls"]["total"].GetUint(), 4U);
+    bool stallBlock = false;
+    for (const auto &block : metadata["blocks"].GetArray()) {
+        stallBlock |= ccstd::string(block["name"].GetString()) == "Stall";
+    }
+    EXPECT_TRUE(stallBlock);
+
+    // the last four frames, the hitch included, with their blocks and counters
+    const uint32_t frameTrack = 1U;
+    uint32_t frames = 0U;
+    uint32_t blocks = 0U;
+    uint32_t stalls = 0U;
+    ccstd::vector<uint32_t> counters;
+    for (const auto &event : document["traceEvents"].GetArray()) {
+        const ccstd::string phase = event["ph"].GetString();
+        const ccstd::string name = event["name"].GetString();
+        if (phase == "X" && event["tid"].GetUint() == frameTrack) {
+            ++frames;
+        } else if (phase == "X") {
+            ++blocks;
+            stalls += name == "Stall" ? 1U : 0U;
+        } else if (phase == "C") {
+            EXPECT_EQ(name, "renders.DrawCalls");
+            counters.push_back(event["args"]["value"].GetUint());
+        }
+    }
+    EXPECT_EQ(frames, 4U);
+    EXPECT_EQ(blocks, 9U);
+    EXPECT_EQ(stalls, 1U);
+    EXPECT_EQ(counters, ccstd::vector<uint32_t>({3U, 4U, 5U, 6U}));
+}
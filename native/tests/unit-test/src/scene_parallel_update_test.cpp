@@ -0,0 +1,234 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include "3d/assets/Mesh.h"
+#include "3d/assets/Skeleton.h"
+#include "3d/misc/CreateMesh.h"
+#include "3d/models/SkinningModel.h"
+#include "core/Root.h"
+#include "core/geometry/AABB.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t STATIC_MODELS = scene::RenderScene::PARALLEL_UPDATE_THRESHOLD + 20;
+constexpr uint32_t SKINNING_ROOTS = 3;
+constexpr uint32_t MODELS_PER_SKINNING_ROOT = 4;
+
+gfx::Buffer *createLocalBuffer() {
+    return Root::getInstance()->getDevice()->createBuffer({
+        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+        pipeline::UBOLocal::SIZE,
+        pipeline::UBOLocal::SIZE,
+    });
+}
+
+// two joints, every vertex weighted on both
+Mesh *createSkinnedMesh() {
+    IGeometry geometry;
+    geometry.positions = {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1};
+    geometry.customAttributes = ccstd::vector<CustomAttribute>{
+        {{gfx::ATTR_NAME_JOINTS, gfx::Format::RGBA32F}, {0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0}},
+        {{gfx::ATTR_NAME_WEIGHTS, gfx::Format::RGBA32F}, {0.5F, 0.5F, 0, 0, 0.7F, 0.3F, 0, 0, 0.2F, 0.8F, 0, 0, 0.9F, 0.1F, 0, 0}},
+    };
+    return MeshUtils::createMesh(geometry);
+}
+
+Skeleton *createSkeleton() {
+    auto *skeleton = ccnew Skeleton();
+    skeleton->setJoints({"j0", "j0/j1"});
+    Mat4 bindpose;
+    Mat4::createTranslation(0.F, -1.F, 0.F, &bindpose);
+    skeleton->setBindposes({Mat4::IDENTITY, bindpose});
+    return skeleton;
+}
+
+// the same hierarchy in every scene, the nodes are looked up by index to animate them
+class ModelScene {
+public:
+    ModelScene(bool parallel, Skeleton *skeleton, Mesh *mesh) {
+        _scene = ccnew scene::RenderScene();
+        _scene->initialize({"parallel-update-test"});
+        _scene->setParallelUpdateEnabled(parallel);
+
+        // static models in chains of four below shared parents
+        for (uint32_t i = 0; i < STATIC_MODELS; ++i) {
+            Node *parent = i % 4 ? _nodes.back().get() : nullptr;
+            Node *node = addNode(parent, "");
+            node->setPosition(static_cast<float>(i), 1.F, 0.F);
+            IntrusivePtr<scene::Model> model = ccnew scene::Model();
+            model->initialize();
+            model->setTransform(node);
+            model->setNode(node);
+            model->createBoundingShape(Vec3(-1.F, -1.F, -1.F), Vec3(1.F, 2.F, 1.F));
+            model->setLocalBuffer(createLocalBuffer());
+            // disabled models are skipped by both paths
+            model->setEnabled(i % 17 != 5);
+            addModel(model);
+        }
+
+        // skinning models bound to the same roots share their joint transforms
+        for (uint32_t r = 0; r < SKINNING_ROOTS; ++r) {
+            Node *root = addNode(nullptr, "");
+            root->setPosition(0.F, 0.F, static_cast<float>(r) * 5.F);
+            Node *j0 = addNode(root, "j0");
+            Node *j1 = addNode(j0, "j1");
+            j1->setPosition(0.F, 1.F, 0.F);
+            for (uint32_t m = 0; m < MODELS_PER_SKINNING_ROOT; ++m) {
+                IntrusivePtr<SkinningModel> model = ccnew SkinningModel();
+                model->initialize();
+                model->bindSkeleton(skeleton, root, mesh);
+                model->setNode(root);
+                model->createBoundingShape(Vec3(-1.F, -1.F, -1.F), Vec3(1.F, 1.F, 1.F));
+                model->setLocalBuffer(createLocalBuffer());
+                addModel(model.get());
+                // interleaved with the static models in the scene order
+                std::swap(_models[(r * MODELS_PER_SKINNING_ROOT + m) * 7], _models.back());
+            }
+        }
+        for (const auto &model : _models) {
+            _scene->addModel(model);
+        }
+    }
+
+    ~ModelScene() {
+        _scene->removeModels();
+        for (const auto &model : _models) {
+            model->destroy();
+        }
+    }
+
+    inline Node *getNode(uint32_t index) const { return _nodes[index]; }
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+    inline scene::RenderScene *getScene() const { return _scene; }
+    inline const ccstd::vector<IntrusivePtr<scene::Model>> &getModels() const { return _models; }
+
+private:
+    Node *addNode(Node *parent, const ccstd::string &name) {
+        Node *node = _nodes.emplace_back(ccnew Node(name)).get();
+        if (parent) {
+            parent->addChild(node);
+        }
+        return node;
+    }
+
+    void addModel(scene::Model *model) {
+        _models.emplace_back(model);
+    }
+
+    IntrusivePtr<scene::RenderScene> _scene;
+    ccstd::vector<IntrusivePtr<Node>> _nodes;
+    ccstd::vector<IntrusivePtr<scene::Model>> _models;
+};
+
+bool isSameLocalData(const scene::Model *lhs, const scene::Model *rhs) {
+    const auto lhsData = lhs->getLocalData();
+    const auto rhsData = rhs->getLocalData();
+    return lhsData.length() == rhsData.length() &&
+           memcmp(lhsData.buffer()->getData() + lhsData.byteOffset(), rhsData.buffer()->getData() + rhsData.byteOffset(), lhsData.byteLength()) == 0;
+}
+
+bool isSameWorldBounds(const scene::Model *lhs, const scene::Model *rhs) {
+    const auto *lhsBounds = lhs->getWorldBounds();
+    const auto *rhsBounds = rhs->getWorldBounds();
+    return lhsBounds && rhsBounds && lhsBounds->getCenter() == rhsBounds->getCenter() && lhsBounds->getHalfExtents() == rhsBounds->getHalfExtents();
+}
+
+bool isSameBoundsTable(const scene::ModelBoundsTable &lhs, const scene::ModelBoundsTable &rhs) {
+    for (uint32_t i = 0; i < 6; ++i) {
+        if (lhs.bounds[i] != rhs.bounds[i]) return false;
+    }
+    return lhs.flags == rhs.flags && lhs.boundsFrames == rhs.boundsFrames && lhs.layers == rhs.layers && lhs.visFlags == rhs.visFlags;
+}
+
+} // namespace
+
+TEST(sceneParallelUpdateTest, sameAsSerialUpdate) {
+    const auto jointUniformCapacity = pipeline::SkinningJointCapacity::jointUniformCapacity;
+    pipeline::SkinningJointCapacity::jointUniformCapacity = 30;
+    IntrusivePtr<Skeleton> skeleton = createSkeleton();
+    IntrusivePtr<Mesh> mesh = createSkinnedMesh();
+    {
+        ModelScene serial{false, skeleton, mesh};
+        ModelScene parallel{true, skeleton, mesh};
+
+        // each step changes both scenes the same way before the frame
+        auto animate = [](ModelScene &scene, uint32_t frame) {
+            for (uint32_t i = frame % 3; i < scene.getNodeCount(); i += 3) {
+                Node *node = scene.getNode(i);
+                const auto angle = static_cast<float>(frame * 7 + i) * 0.1F;
+                if (node->getName() == "j1") {
+                    // moves the joint only, the skinning root stays where it is
+                    node->setPosition(std::sin(angle), 1.F, std::cos(angle));
+                } else {
+                    Quaternion rotation;
+                    Quaternion::createFromAxisAngle(Vec3(0.F, 1.F, 0.F), angle, &rotation);
+                    node->setRotation(rotation);
+                    node->setScale(1.F + 0.1F * static_cast<float>(frame), 1.F, 1.F);
+                }
+            }
+        };
+
+        for (uint32_t frame = 1; frame <= 6; ++frame) {
+            if (frame > 1) {
+                animate(serial, frame);
+                animate(parallel, frame);
+            }
+            serial.getScene()->update(frame);
+            parallel.getScene()->update(frame);
+            Node::resetChangedFlags();
+
+            bool sameLocalData = true;
+            bool sameWorldBounds = true;
+            const auto &serialModels = serial.getModels();
+            const auto &parallelModels = parallel.getModels();
+            for (size_t i = 0; i < serialModels.size(); ++i) {
+                sameLocalData = sameLocalData && isSameLocalData(serialModels[i], parallelModels[i]);
+                sameWorldBounds = sameWorldBounds && isSameWorldBounds(serialModels[i], parallelModels[i]);
+            }
+            logLabel = "test that the parallel update produces the local UBOs of the serial update";
+            EXPECT_TRUE(sameLocalData) << "frame " << frame;
+            logLabel = "test that the parallel update produces the world bounds of the serial update";
+            EXPECT_TRUE(sameWorldBounds) << "frame " << frame;
+            EXPECT_TRUE(isSameBoundsTable(serial.getScene()->getModelBounds(), parallel.getScene()->getModelBounds())) << "frame " << frame;
+        }
+
+        logLabel = "test that the skinning models sharing a root got their bounds from the animated joints";
+        const auto *bounds = serial.getModels()[0]->getWorldBounds();
+        ExpectEq(serial.getModels()[0]->getType() == scene::Model::Type::SKINNING && bounds->getHalfExtents() != Vec3(1.F, 1.F, 1.F), true);
+    }
+    pipeline::SkinningJointCapacity::jointUniformCapacity = jointUniformCapacity;
+}
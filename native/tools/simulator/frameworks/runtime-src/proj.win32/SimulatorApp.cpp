@@ -674,7 +674,7 @@ std::string SimulatorApp::getApplicationExePath() {
     std::u16string u16ApplicationName;
     char* applicationExePath = convertTCharToUtf8(szFileName);
     std::string path(applicationExePath);
-    CC_SAFE_FREE(applicationExePath);
+    CC_SAFE_DELETE_ARRAY(applicationExePath);
 
     return path;
 }
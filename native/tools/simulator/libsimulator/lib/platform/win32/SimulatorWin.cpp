@@ -719,7 +719,7 @@ std::string SimulatorWin::getApplicationExePath()
     std::u16string u16ApplicationName;
     char *applicationExePath = convertTCharToUtf8(szFileName);
     std::string path(applicationExePath);
-    CC_SAFE_FREE(applicationExePath);
+    CC_SAFE_DELETE_ARRAY(applicationExePath);
 
     return path;
 }
@@ -816,7 +816,7 @@ LRESULT CALLBACK SimulatorWin::windowProc(HWND hWnd, UINT uMsg, WPARAM wParam, L
             DragQueryFileW(hDrop, fileIndex, buffer, length + 1);
             char *utf8 = SimulatorWin::convertTCharToUtf8(buffer);
             std::string firstFile(utf8);
-            CC_SAFE_FREE(utf8);
+            CC_SAFE_DELETE_ARRAY(utf8);
             DragFinish(hDrop);
 
             // broadcast drop event